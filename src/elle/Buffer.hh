@@ -106,6 +106,12 @@ namespace elle
     shrink_to_fit();
   private:
     static Size _next_size(Size);
+    /// Move the content back to the start of the allocation.
+    void
+    _compact();
+    /// Bytes dropped from the front, not reclaimed yet: the allocation
+    /// starts at _contents - _headroom.
+    ELLE_ATTRIBUTE(Size, headroom);
 
   public:
     static constexpr Size max_size = std::numeric_limits<Size>::max();
@@ -118,7 +124,9 @@ namespace elle
     void
     append(void const* data, Size size);
     /// Drop a number of bytes.
-    /// Costly, as it memmoves the remaing bytes.
+    ///
+    /// Constant time: the bytes are skipped, not moved, and reclaimed when
+    /// the buffer next reallocates.
     void
     pop_front(Size size = 1);
     /// A subset of this buffer.
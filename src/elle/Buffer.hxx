@@ -24,6 +24,7 @@ namespace elle
     : _size(static_cast<Size>(size))
     , _capacity(size)
     , _contents(nullptr)
+    , _headroom(0)
   {
     if ((this->_contents =
          static_cast<Byte*>(::malloc(this->_capacity))) == nullptr)
@@ -0,0 +1,380 @@
+#include <elle/SegmentedBuffer.hh>
+
+#include <algorithm>
+#include <cstring>
+
+#include <elle/Exception.hh>
+#include <elle/IOStream.hh>
+#include <elle/assert.hh>
+#include <elle/log.hh>
+
+ELLE_LOG_COMPONENT("elle.SegmentedBuffer");
+
+namespace elle
+{
+  namespace
+  {
+    /// Read the segments of a SegmentedBuffer one after the other.
+    class SegmentsStreamBuffer
+      : public StreamBuffer
+    {
+    public:
+      SegmentsStreamBuffer(std::vector<ConstWeakBuffer> segments)
+        : _segments(std::move(segments))
+        , _pos(0)
+      {}
+
+    protected:
+      WeakBuffer
+      write_buffer() override
+      {
+        throw Exception("the buffer is in input mode");
+      }
+
+      WeakBuffer
+      read_buffer() override
+      {
+        if (this->_pos < this->_segments.size())
+        {
+          auto const& segment = this->_segments[this->_pos++];
+          return WeakBuffer(const_cast<Buffer::Byte*>(segment.contents()),
+                            segment.size());
+        }
+        else
+          return WeakBuffer(nullptr, 0);
+      }
+
+    private:
+      std::vector<ConstWeakBuffer> _segments;
+      std::size_t _pos;
+    };
+  }
+
+  /*-------------.
+  | Construction |
+  `-------------*/
+
+  SegmentedBuffer::Size const SegmentedBuffer::default_slab_size = 16384;
+
+  SegmentedBuffer::SegmentedBuffer(Size slab_size)
+    : _size(0)
+    , _slab_size(std::max(slab_size, Size(1)))
+  {}
+
+  SegmentedBuffer::SegmentedBuffer(Buffer&& buffer)
+    : SegmentedBuffer()
+  {
+    this->append(std::move(buffer));
+  }
+
+  SegmentedBuffer::SegmentedBuffer(ConstWeakBuffer data)
+    : SegmentedBuffer()
+  {
+    this->append(data);
+  }
+
+  ConstWeakBuffer
+  SegmentedBuffer::Segment::view() const
+  {
+    return ConstWeakBuffer(this->slab->contents() + this->offset, this->size);
+  }
+
+  /*-----------.
+  | Properties |
+  `-----------*/
+
+  bool
+  SegmentedBuffer::empty() const
+  {
+    return this->_size == 0;
+  }
+
+  SegmentedBuffer::Byte
+  SegmentedBuffer::operator [](Size i) const
+  {
+    ELLE_ASSERT_LT(i, this->_size);
+    auto const location = this->_locate(i);
+    return location.first->view().contents()[location.second];
+  }
+
+  std::vector<ConstWeakBuffer>
+  SegmentedBuffer::segments() const
+  {
+    auto res = std::vector<ConstWeakBuffer>{};
+    res.reserve(this->_segments.size());
+    for (auto const& segment: this->_segments)
+      res.emplace_back(segment.view());
+    return res;
+  }
+
+  ConstWeakBuffer
+  SegmentedBuffer::front() const
+  {
+    if (this->_segments.empty())
+      return {};
+    return this->_segments.front().view();
+  }
+
+  Buffer
+  SegmentedBuffer::buffer() const
+  {
+    auto res = Buffer(this->_size);
+    this->copy(0, this->_size, res.mutable_contents());
+    return res;
+  }
+
+  std::string
+  SegmentedBuffer::string() const
+  {
+    auto res = std::string(this->_size, '\0');
+    this->copy(0, this->_size, &res[0]);
+    return res;
+  }
+
+  /*-----------.
+  | Operations |
+  `-----------*/
+
+  void
+  SegmentedBuffer::append(void const* data, Size size)
+  {
+    ELLE_ASSERT(data || !size);
+    auto bytes = static_cast<Byte const*>(data);
+    this->_size += size;
+    // Fill the last slab if nobody else can see its free space.
+    if (!this->_segments.empty())
+    {
+      auto& last = this->_segments.back();
+      auto& slab = *last.slab;
+      if (last.slab.use_count() == 1 &&
+          last.offset + last.size == slab.size())
+      {
+        auto const chunk = std::min(size, slab.capacity() - slab.size());
+        slab.append(bytes, chunk);
+        last.size += chunk;
+        bytes += chunk;
+        size -= chunk;
+      }
+    }
+    if (size)
+    {
+      auto slab = std::make_shared<Buffer>();
+      slab->capacity(std::max(size, this->_slab_size));
+      slab->append(bytes, size);
+      this->_segments.push_back(Segment{std::move(slab), 0, size});
+    }
+  }
+
+  void
+  SegmentedBuffer::append(ConstWeakBuffer data)
+  {
+    this->append(data.contents(), data.size());
+  }
+
+  void
+  SegmentedBuffer::append(Buffer&& buffer)
+  {
+    if (buffer.empty())
+      return;
+    auto const size = buffer.size();
+    this->_size += size;
+    this->_segments.push_back(
+      Segment{std::make_shared<Buffer>(std::move(buffer)), 0, size});
+  }
+
+  void
+  SegmentedBuffer::append(SegmentedBuffer const& other)
+  {
+    // Copy first: other may be this.
+    auto segments = other._segments;
+    this->_size += other._size;
+    for (auto& segment: segments)
+      this->_segments.push_back(std::move(segment));
+  }
+
+  void
+  SegmentedBuffer::pop_front(Size size)
+  {
+    ELLE_ASSERT_LTE(size, this->_size);
+    this->_size -= size;
+    while (size)
+    {
+      auto& front = this->_segments.front();
+      if (size < front.size)
+      {
+        front.offset += size;
+        front.size -= size;
+        return;
+      }
+      size -= front.size;
+      this->_segments.pop_front();
+    }
+  }
+
+  SegmentedBuffer
+  SegmentedBuffer::range(Size start, Size end) const
+  {
+    ELLE_ASSERT_LTE(start, end);
+    ELLE_ASSERT_LTE(end, this->_size);
+    auto res = SegmentedBuffer(this->_slab_size);
+    if (start == end)
+      return res;
+    auto location = this->_locate(start);
+    auto it = location.first;
+    auto offset = location.second;
+    auto remaining = end - start;
+    res._size = remaining;
+    while (remaining)
+    {
+      auto const size = std::min(remaining, it->size - offset);
+      res._segments.push_back(Segment{it->slab, it->offset + offset, size});
+      remaining -= size;
+      offset = 0;
+      ++it;
+    }
+    return res;
+  }
+
+  SegmentedBuffer
+  SegmentedBuffer::range(Size start) const
+  {
+    return this->range(start, this->_size);
+  }
+
+  ConstWeakBuffer
+  SegmentedBuffer::contiguous(Size size)
+  {
+    ELLE_ASSERT_LTE(size, this->_size);
+    if (size == 0)
+      return {};
+    auto const& front = this->_segments.front();
+    if (front.size >= size)
+      return ConstWeakBuffer(front.view().contents(), size);
+    ELLE_DEBUG("merge leading segments into %s bytes", size);
+    auto slab = std::make_shared<Buffer>(size);
+    this->copy(0, size, slab->mutable_contents());
+    this->pop_front(size);
+    this->_segments.push_front(Segment{std::move(slab), 0, size});
+    this->_size += size;
+    return this->_segments.front().view();
+  }
+
+  void
+  SegmentedBuffer::copy(Size offset, Size size, void* output) const
+  {
+    ELLE_ASSERT_LTE(offset + size, this->_size);
+    if (!size)
+      return;
+    auto out = static_cast<Byte*>(output);
+    auto location = this->_locate(offset);
+    auto it = location.first;
+    offset = location.second;
+    while (size)
+    {
+      auto const chunk = std::min(size, it->size - offset);
+      std::memcpy(out, it->view().contents() + offset, chunk);
+      out += chunk;
+      size -= chunk;
+      offset = 0;
+      ++it;
+    }
+  }
+
+  SegmentedBuffer::Size
+  SegmentedBuffer::find(Byte byte, Size start) const
+  {
+    if (start >= this->_size)
+      return this->_size;
+    auto location = this->_locate(start);
+    auto offset = location.second;
+    auto position = start - offset;
+    for (auto it = location.first; it != this->_segments.end(); ++it)
+    {
+      auto const view = it->view();
+      if (auto found = static_cast<Byte const*>(
+            std::memchr(view.contents() + offset, byte, view.size() - offset)))
+        return position + (found - view.contents());
+      position += view.size();
+      offset = 0;
+    }
+    return this->_size;
+  }
+
+  std::pair<std::deque<SegmentedBuffer::Segment>::const_iterator,
+            SegmentedBuffer::Size>
+  SegmentedBuffer::_locate(Size offset) const
+  {
+    auto it = this->_segments.begin();
+    while (it != this->_segments.end() && offset >= it->size)
+    {
+      offset -= it->size;
+      ++it;
+    }
+    return {it, offset};
+  }
+
+  /*--------------.
+  | Serialization |
+  `--------------*/
+
+  std::streambuf*
+  SegmentedBuffer::istreambuf() const
+  {
+    return new SegmentsStreamBuffer(this->segments());
+  }
+
+  /*---------------------.
+  | Relational Operators |
+  `---------------------*/
+
+  bool
+  SegmentedBuffer::operator ==(SegmentedBuffer const& other) const
+  {
+    if (this->_size != other._size)
+      return false;
+    auto it = other._segments.begin();
+    auto offset = Size(0);
+    for (auto const& segment: this->_segments)
+    {
+      auto const view = segment.view();
+      auto done = Size(0);
+      while (done < view.size())
+      {
+        auto const chunk = std::min(view.size() - done, it->size - offset);
+        if (std::memcmp(view.contents() + done,
+                        it->view().contents() + offset, chunk))
+          return false;
+        done += chunk;
+        offset += chunk;
+        if (offset == it->size)
+        {
+          ++it;
+          offset = 0;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool
+  SegmentedBuffer::operator ==(ConstWeakBuffer const& other) const
+  {
+    if (this->_size != other.size())
+      return false;
+    auto position = other.contents();
+    for (auto const& segment: this->_segments)
+    {
+      auto const view = segment.view();
+      if (std::memcmp(view.contents(), position, view.size()))
+        return false;
+      position += view.size();
+    }
+    return true;
+  }
+
+  std::ostream&
+  operator <<(std::ostream& stream, SegmentedBuffer const& buffer)
+  {
+    return stream << buffer.buffer();
+  }
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <elle/Buffer.hh>
+#include <elle/attribute.hh>
+
+namespace elle
+{
+  /// A byte sequence stored as a chain of shared slabs.
+  ///
+  /// Unlike Buffer, memory is released from the front one dropped segment
+  /// at a time and appending never moves existing data. Copies and ranges share
+  /// the underlying slabs instead of duplicating the bytes, which are
+  /// therefore immutable once appended.
+  ///
+  /// @code{.cc}
+  ///
+  /// auto b = elle::SegmentedBuffer{};
+  /// b.append(elle::Buffer("GET / HTTP/1.1\r\n"));
+  /// b.append(socket.read_some(4096));
+  /// auto line = b.contiguous(16);
+  /// b.pop_front(16);
+  /// for (auto const& segment: b.segments())
+  ///   output.write(segment);
+  ///
+  /// @endcode
+  class ELLE_API SegmentedBuffer
+  {
+  /*------.
+  | Types |
+  `------*/
+  public:
+    using Self = SegmentedBuffer;
+    using Size = Buffer::Size;
+    using Byte = Buffer::Byte;
+
+  /*-------------.
+  | Construction |
+  `-------------*/
+  public:
+    /// An empty buffer.
+    ///
+    /// @param slab_size Capacity of slabs allocated to hold copied data.
+    explicit
+    SegmentedBuffer(Size slab_size = default_slab_size);
+    /// A buffer adopting the content of @a buffer, without copy.
+    SegmentedBuffer(Buffer&& buffer);
+    /// A buffer holding a copy of @a data.
+    explicit
+    SegmentedBuffer(ConstWeakBuffer data);
+    /// Default capacity of slabs.
+    static Size const default_slab_size;
+
+  /*-----------.
+  | Properties |
+  `-----------*/
+  public:
+    /// Number of bytes.
+    ELLE_ATTRIBUTE_R(Size, size);
+    /// Whether the buffer holds no byte.
+    bool
+    empty() const;
+    /// Get byte at position @a i, linear in the number of segments.
+    Byte
+    operator [](Size i) const;
+    /// The contiguous chunks making up the content, e.g. for vectored
+    /// writes. Valid until the buffer is modified.
+    std::vector<ConstWeakBuffer>
+    segments() const;
+    /// The first contiguous chunk, empty if the buffer is.
+    ConstWeakBuffer
+    front() const;
+    /// A contiguous copy of the content.
+    Buffer
+    buffer() const;
+    /// The content as a string.
+    std::string
+    string() const;
+
+  /*-----------.
+  | Operations |
+  `-----------*/
+  public:
+    /// Append a copy of @a data.
+    void
+    append(void const* data, Size size);
+    /// Append a copy of @a data.
+    void
+    append(ConstWeakBuffer data);
+    /// Append @a buffer, without copy.
+    void
+    append(Buffer&& buffer);
+    /// Append @a other, sharing its slabs.
+    void
+    append(SegmentedBuffer const& other);
+    /// Drop @a size bytes from the front.
+    void
+    pop_front(Size size = 1);
+    /// The bytes in [@a start, @a end), sharing this buffer's slabs.
+    SegmentedBuffer
+    range(Size start, Size end) const;
+    /// The bytes from @a start onward, sharing this buffer's slabs.
+    SegmentedBuffer
+    range(Size start) const;
+    /// The first @a size bytes as a contiguous view.
+    ///
+    /// Merges the leading segments if they are too small, which is the only
+    /// case where data is copied. Valid until the buffer is modified.
+    ConstWeakBuffer
+    contiguous(Size size);
+    /// Copy @a size bytes starting at @a offset to @a output.
+    void
+    copy(Size offset, Size size, void* output) const;
+    /// Position of the first occurrence of @a byte at or after @a start, or
+    /// size() if there is none.
+    Size
+    find(Byte byte, Size start = 0) const;
+
+  /*--------------.
+  | Serialization |
+  `--------------*/
+  public:
+    /// Construct an input streambuf from the buffer.
+    std::streambuf*
+    istreambuf() const;
+
+  /*---------------------.
+  | Relational Operators |
+  `---------------------*/
+  public:
+    bool
+    operator ==(SegmentedBuffer const& other) const;
+    bool
+    operator ==(ConstWeakBuffer const& other) const;
+
+  /*---------.
+  | Segments |
+  `---------*/
+  private:
+    struct Segment
+    {
+      std::shared_ptr<Buffer> slab;
+      Size offset;
+      Size size;
+      ConstWeakBuffer
+      view() const;
+    };
+    /// The segment holding byte @a offset and the offset within it.
+    std::pair<std::deque<Segment>::const_iterator, Size>
+    _locate(Size offset) const;
+    ELLE_ATTRIBUTE(std::deque<Segment>, segments);
+    ELLE_ATTRIBUTE_R(Size, slab_size);
+  };
+
+  ELLE_API
+  std::ostream&
+  operator <<(std::ostream& stream, SegmentedBuffer const& buffer);
+}
@@ -30,6 +30,7 @@ namespace elle
     if (elle::os::getenv("ELLE_REAL_ASSERT", false))
     {
       ELLE_ERR("%s: (%s:%s)", message.c_str(), file, line);
+      elle::log::flush();
       std::abort();
     }
     else
@@ -59,11 +59,24 @@ namespace elle
     this->_start = now();
   }
 
+  // The component is dynamic, so these cannot go through the logging macros
+  // whose cache is per call site.
+
   void
   Bench::log()
   {
-    char const* _trace_component_ = this->_name.c_str();
-    ELLE_TRACE(
+    if (!elle::log::detail::Send::active(elle::log::Logger::Level::trace,
+                                         elle::log::Logger::Type::info,
+                                         this->_name))
+      return;
+    elle::log::detail::Send send(
+      elle::log::Logger::Level::trace,
+      elle::log::Logger::Type::info,
+      false,
+      this->_name,
+      __FILE__,
+      __LINE__,
+      ELLE_COMPILER_PRETTY_FUNCTION,
       "%s: AVG %s, MIN %s, MAX %s, COUNT %s", this->_name,
       std::round(double(this->_sum *
                         this->_roundfactor /
@@ -73,6 +86,10 @@ namespace elle
 
   void Bench::show()
   {
+    if (!elle::log::detail::Send::active(elle::log::Logger::Level::trace,
+                                         elle::log::Logger::Type::info,
+                                         this->_name))
+      return;
     elle::log::detail::Send send(
       elle::log::Logger::Level::trace,
       elle::log::Logger::Type::info,
@@ -0,0 +1,124 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#ifndef INFINIT_WINDOWS
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <elle/Buffer.hh>
+#include <elle/Exception.hh>
+#include <elle/err.hh>
+#include <elle/finally.hh>
+#include <elle/log/BinaryLogger.hh>
+#include <elle/log/TextLogger.hh>
+
+static
+void
+usage(std::ostream& output)
+{
+  output << "Usage: log-render [--level LEVELS] [--from TIME] [--to TIME] LOG\n"
+         << "\n"
+         << "Render a binary log, as written with ELLE_LOG_BINARY, as text.\n"
+         << "\n"
+         << "  --level LEVELS  levels to render, like ELLE_LOG_LEVEL\n"
+         << "                  (default: DUMP)\n"
+         << "  --from TIME     skip messages before TIME, in universal time\n"
+         << "                  (e.g. \"2017-03-14 15:09:26\")\n"
+         << "  --to TIME       skip messages from TIME on\n";
+}
+
+static
+void
+render(std::string const& path,
+       std::string const& levels,
+       boost::posix_time::ptime from,
+       boost::posix_time::ptime to)
+{
+  elle::log::TextLogger logger(
+    std::cout, levels, true, true, true, true, true, true);
+  logger.buffered(true);
+#ifndef INFINIT_WINDOWS
+  auto const fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    elle::err("unable to open %s: %s", path, std::strerror(errno));
+  elle::SafeFinally close([&] { ::close(fd); });
+  struct stat st;
+  if (::fstat(fd, &st))
+    elle::err("unable to stat %s: %s", path, std::strerror(errno));
+  if (st.st_size == 0)
+    elle::err("%s is empty", path);
+  auto const data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED)
+    elle::err("unable to map %s: %s", path, std::strerror(errno));
+  elle::SafeFinally unmap([&] { ::munmap(data, st.st_size); });
+  ::madvise(data, st.st_size, MADV_SEQUENTIAL);
+  auto reader = elle::log::BinaryLogReader(
+    elle::ConstWeakBuffer(data, st.st_size));
+#else
+  auto input = std::ifstream(path, std::ios::binary);
+  if (!input)
+    elle::err("unable to open %s", path);
+  auto const contents = std::string(std::istreambuf_iterator<char>(input),
+                                    std::istreambuf_iterator<char>());
+  auto reader = elle::log::BinaryLogReader(
+    elle::ConstWeakBuffer(contents.data(), contents.size()));
+#endif
+  reader.replay(logger, from, to);
+  logger.flush();
+}
+
+int
+main(int argc, char** argv)
+{
+  try
+  {
+    auto levels = std::string("DUMP");
+    auto from = boost::posix_time::ptime(boost::posix_time::min_date_time);
+    auto to = boost::posix_time::ptime(boost::posix_time::max_date_time);
+    auto path = std::string{};
+    for (int i = 1; i < argc; ++i)
+    {
+      auto const arg = std::string(argv[i]);
+      auto const value = [&]
+        {
+          if (i + 1 == argc)
+            elle::err("missing value for %s", arg);
+          return std::string(argv[++i]);
+        };
+      if (arg == "--help" || arg == "-h")
+      {
+        usage(std::cout);
+        return 0;
+      }
+      else if (arg == "--level")
+        levels = value();
+      else if (arg == "--from")
+        from = boost::posix_time::time_from_string(value());
+      else if (arg == "--to")
+        to = boost::posix_time::time_from_string(value());
+      else if (path.empty())
+        path = arg;
+      else
+        elle::err("unexpected argument: %s", arg);
+    }
+    if (path.empty())
+    {
+      usage(std::cerr);
+      return 1;
+    }
+    render(path, levels, from, to);
+    return 0;
+  }
+  catch (...)
+  {
+    std::cerr << "log-render: " << elle::exception_string() << std::endl;
+    return 1;
+  }
+}
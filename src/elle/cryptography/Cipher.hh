@@ -35,7 +35,9 @@ namespace elle
       cbc,
       ecb,
       cfb,
-      ofb
+      ofb,
+      /// Authenticated encryption, only available for AES.
+      gcm
     };
 
     /*----------.
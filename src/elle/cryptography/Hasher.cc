@@ -0,0 +1,134 @@
+#include <elle/cryptography/Hasher.hh>
+
+#include <istream>
+#include <memory>
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+
+#include <elle/assert.hh>
+#include <elle/log.hh>
+#include <elle/printf.hh>
+
+#include <elle/cryptography/Error.hh>
+#include <elle/cryptography/cryptography.hh>
+
+ELLE_LOG_COMPONENT("elle.cryptography.Hasher");
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace
+    {
+      // Small enough to stay in cache while every digest consumes it.
+      std::size_t const read_block_size = 65536;
+    }
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    Hasher::Hasher(Oneway const oneway)
+      : Hasher(std::vector<Oneway>{oneway})
+    {}
+
+    Hasher::Hasher(std::vector<Oneway> oneways)
+      : _oneways(std::move(oneways))
+    {
+      ELLE_ASSERT(!this->_oneways.empty());
+      cryptography::require();
+      for (std::size_t i = 0; i < this->_oneways.size(); ++i)
+      {
+        this->_contexts.emplace_back(::EVP_MD_CTX_create());
+        if (!this->_contexts.back())
+          throw Error(
+            elle::sprintf("unable to allocate a digest context: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+      }
+      this->_initialize();
+    }
+
+    void
+    Hasher::_initialize()
+    {
+      for (std::size_t i = 0; i < this->_oneways.size(); ++i)
+        if (::EVP_DigestInit_ex(this->_contexts[i].get(),
+                                oneway::resolve(this->_oneways[i]),
+                                nullptr) <= 0)
+          throw Error(
+            elle::sprintf("unable to initialize the digest process: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+    }
+
+    /*--------.
+    | Methods |
+    `--------*/
+
+    Hasher&
+    Hasher::update(elle::ConstWeakBuffer const& data)
+    {
+      ELLE_DUMP("%s: update with %s bytes", this, data.size());
+      if (data.size() == 0)
+        return *this;
+      for (auto& context: this->_contexts)
+        if (::EVP_DigestUpdate(context.get(),
+                               data.contents(),
+                               data.size()) <= 0)
+          throw Error(
+            elle::sprintf("unable to apply the digest function: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+      return *this;
+    }
+
+    Hasher&
+    Hasher::update(std::istream& input)
+    {
+      auto block = std::make_unique<char[]>(read_block_size);
+      while (true)
+      {
+        input.read(block.get(), read_block_size);
+        if (input.bad())
+          throw Error(
+            elle::sprintf("unable to read the input stream: %s",
+                          input.rdstate()));
+        if (input.gcount() == 0)
+          break;
+        this->update(
+          elle::ConstWeakBuffer(block.get(), input.gcount()));
+        if (input.eof())
+          break;
+      }
+      return *this;
+    }
+
+    elle::Buffer
+    Hasher::finalize()
+    {
+      ELLE_ASSERT_EQ(this->_oneways.size(), 1u);
+      return std::move(this->finalize_all().front());
+    }
+
+    std::vector<elle::Buffer>
+    Hasher::finalize_all()
+    {
+      std::vector<elle::Buffer> digests;
+      digests.reserve(this->_contexts.size());
+      for (auto& context: this->_contexts)
+      {
+        elle::Buffer digest(EVP_MD_CTX_size(context.get()));
+        unsigned int size = 0;
+        if (::EVP_DigestFinal_ex(context.get(),
+                                 digest.mutable_contents(),
+                                 &size) <= 0)
+          throw Error(
+            elle::sprintf("unable to finalize the digest process: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+        digest.size(size);
+        digests.emplace_back(std::move(digest));
+      }
+      this->_initialize();
+      return digests;
+    }
+  }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <iosfwd>
+#include <vector>
+
+#include <elle/Buffer.hh>
+#include <elle/attribute.hh>
+#include <elle/cryptography/Oneway.hh>
+#include <elle/cryptography/fwd.hh>
+#include <elle/cryptography/types.hh>
+
+namespace elle
+{
+  namespace cryptography
+  {
+    /// Incremental digest computation.
+    ///
+    /// Data is fed through update() as it becomes available, without being
+    /// copied, and the digests are produced by finalize(). Several oneway
+    /// functions can be computed over the same data in a single pass, e.g.
+    /// S3's Content-MD5 and x-amz-content-sha256.
+    ///
+    /// @code{.cc}
+    ///
+    /// Hasher hasher({Oneway::md5, Oneway::sha256});
+    /// hasher.update(header);
+    /// hasher.update(payload);
+    /// auto digests = hasher.finalize_all();
+    ///
+    /// @endcode
+    ///
+    /// The hasher is reset after finalization and can be reused.
+    class Hasher
+    {
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// A hasher computing a single digest.
+      Hasher(Oneway const oneway);
+      /// A hasher computing one digest per given function.
+      Hasher(std::vector<Oneway> oneways);
+      Hasher(Hasher&& other) = default;
+
+    /*--------.
+    | Methods |
+    `--------*/
+    public:
+      /// Feed @a data to every digest.
+      Hasher&
+      update(elle::ConstWeakBuffer const& data);
+      /// Feed the remaining content of @a input to every digest.
+      Hasher&
+      update(std::istream& input);
+      /// Return the digest and reset; the hasher must compute one only.
+      elle::Buffer
+      finalize();
+      /// Return the digests, in the order of the functions, and reset.
+      std::vector<elle::Buffer>
+      finalize_all();
+    private:
+      void
+      _initialize();
+
+    /*-----------.
+    | Attributes |
+    `-----------*/
+    private:
+      ELLE_ATTRIBUTE_R(std::vector<Oneway>, oneways);
+      ELLE_ATTRIBUTE(std::vector<types::EVP_MD_CTX>, contexts);
+    };
+  }
+}
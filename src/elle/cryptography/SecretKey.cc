@@ -3,10 +3,20 @@
 #include <elle/cryptography/Cipher.hh>
 #include <elle/cryptography/cryptography.hh>
 #include <elle/cryptography/raw.hh>
+#include <elle/cryptography/Error.hh>
+#include <elle/cryptography/types.hh>
 
 #include <elle/serialization/Serializer.hh>
+#include <elle/finally.hh>
 #include <elle/log.hh>
 
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+#include <iterator>
+#include <mutex>
+
 //
 // ---------- Class -----------------------------------------------------------
 //
@@ -15,6 +25,116 @@ namespace elle
 {
   namespace cryptography
   {
+    /*---------.
+    | Schedule |
+    `---------*/
+
+    class SecretKey::Schedule
+    {
+    public:
+      Schedule(::EVP_CIPHER const* cipher,
+               elle::ConstWeakBuffer const& password)
+        : _cipher(cipher)
+      {
+        // Derive the key once, from a fixed label keyed by the password:
+        // nonces, not salts, keep codes apart.
+        static char const label[] = "elle.cryptography.aead";
+        unsigned int size = sizeof (this->_key);
+        if (::HMAC(::EVP_sha256(),
+                   password.contents(), password.size(),
+                   reinterpret_cast<unsigned char const*>(label),
+                   sizeof (label) - 1,
+                   this->_key, &size) == nullptr)
+          throw Error(
+            elle::sprintf("unable to derive the key: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+      }
+
+      ~Schedule()
+      {
+        ::OPENSSL_cleanse(this->_key, sizeof (this->_key));
+      }
+
+      /// A context whose key schedule is expanded, ready for a nonce.
+      types::EVP_CIPHER_CTX
+      acquire(bool encrypt)
+      {
+        {
+          std::lock_guard<std::mutex> lock(this->_mutex);
+          auto& pool = this->_pools[encrypt];
+          if (!pool.empty())
+          {
+            auto res = std::move(pool.back());
+            pool.pop_back();
+            return res;
+          }
+        }
+        types::EVP_CIPHER_CTX context(::EVP_CIPHER_CTX_new());
+        if (!context)
+          throw Error("unable to allocate a cipher context");
+        auto init = encrypt ? ::EVP_EncryptInit_ex : ::EVP_DecryptInit_ex;
+        if (init(context.get(), this->_cipher, nullptr, this->_key, nullptr)
+            <= 0)
+          throw Error(
+            elle::sprintf("unable to initialize the cipher context: %s",
+                          ::ERR_error_string(ERR_get_error(), nullptr)));
+        return context;
+      }
+
+      void
+      release(bool encrypt, types::EVP_CIPHER_CTX context)
+      {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_pools[encrypt].push_back(std::move(context));
+      }
+
+    private:
+      ::EVP_CIPHER const* _cipher;
+      unsigned char _key[32];
+      std::mutex _mutex;
+      std::vector<types::EVP_CIPHER_CTX> _pools[2];
+    };
+
+    std::shared_ptr<SecretKey::Schedule>
+    SecretKey::_schedule(Cipher const cipher) const
+    {
+      int index = 0;
+      switch (cipher)
+      {
+        case Cipher::aes128:
+          index = 0;
+          break;
+        case Cipher::aes192:
+          index = 1;
+          break;
+        case Cipher::aes256:
+          index = 2;
+          break;
+        default:
+          throw Error(
+            elle::sprintf("the cipher '%s' has no authenticated mode",
+                          cipher));
+      }
+      auto& slot = this->_schedules[index];
+      auto res = std::atomic_load(&slot);
+      if (!res)
+      {
+        auto schedule = std::make_shared<Schedule>(
+          cipher::resolve(cipher, Mode::gcm), this->_password);
+        // Keep whichever schedule won a concurrent creation.
+        if (std::atomic_compare_exchange_strong(&slot, &res, schedule))
+          res = std::move(schedule);
+      }
+      return res;
+    }
+
+    static
+    bool
+    _aead(elle::ConstWeakBuffer const& code)
+    {
+      return code.size() > 0 && code[0] == constants::aead::version;
+    }
+
     /*-------------.
     | Construction |
     `-------------*/
@@ -37,12 +157,16 @@ namespace elle
     SecretKey::SecretKey(SecretKey const& other)
       : _password(other._password.contents(), other._password.size())
     {
+      // Same password, same derived keys.
+      for (unsigned i = 0; i < this->_schedules.size(); ++i)
+        this->_schedules[i] = std::atomic_load(&other._schedules[i]);
       // Make sure the cryptographic system is set up.
       cryptography::require();
     }
 
     SecretKey::SecretKey(SecretKey&& other)
       : _password(std::move(other._password))
+      , _schedules(std::move(other._schedules))
     {
       // Make sure the cryptographic system is set up.
       cryptography::require();
@@ -58,6 +182,12 @@ namespace elle
                         Mode const mode,
                         Oneway const oneway) const
     {
+      if (mode == Mode::gcm)
+      {
+        elle::Buffer code(plain.size() + constants::aead::overhead);
+        code.size(this->encipher(plain, code, cipher));
+        return code;
+      }
       elle::IOStream _plain(plain.istreambuf());
       std::stringstream _code;
       this->encipher(_plain, _code,
@@ -71,6 +201,13 @@ namespace elle
                         Mode const mode,
                         Oneway const oneway) const
     {
+      if (_aead(code))
+      {
+        elle::Buffer plain(code.size() - std::min<std::size_t>(
+                             code.size(), constants::aead::overhead));
+        plain.size(this->decipher(code, plain));
+        return plain;
+      }
       elle::IOStream _code(code.istreambuf());
       std::stringstream _plain;
       this->decipher(_code, _plain,
@@ -85,6 +222,15 @@ namespace elle
                         Mode const mode,
                         Oneway const oneway) const
     {
+      if (mode == Mode::gcm)
+      {
+        auto const input = std::string(std::istreambuf_iterator<char>(plain),
+                                       std::istreambuf_iterator<char>());
+        auto const output = this->encipher(input, cipher, mode, oneway);
+        code.write(reinterpret_cast<char const*>(output.contents()),
+                   output.size());
+        return;
+      }
       ::EVP_CIPHER const* function_cipher = cipher::resolve(cipher, mode);
       ::EVP_MD const* function_oneway = oneway::resolve(oneway);
       raw::symmetric::encipher(this->_password,
@@ -101,7 +247,18 @@ namespace elle
                         Mode const mode,
                         Oneway const oneway) const
     {
-      ::EVP_CIPHER const* function_cipher = cipher::resolve(cipher, mode);
+      if (code.peek() == constants::aead::version)
+      {
+        auto const input = std::string(std::istreambuf_iterator<char>(code),
+                                       std::istreambuf_iterator<char>());
+        auto const output = this->decipher(input, cipher, mode, oneway);
+        plain.write(reinterpret_cast<char const*>(output.contents()),
+                    output.size());
+        return;
+      }
+      // Salted codes are never produced in gcm mode.
+      ::EVP_CIPHER const* function_cipher =
+        cipher::resolve(cipher, mode == Mode::gcm ? defaults::mode : mode);
       ::EVP_MD const* function_oneway = oneway::resolve(oneway);
       raw::symmetric::decipher(this->_password,
                                function_cipher,
@@ -110,6 +267,32 @@ namespace elle
                                plain);
     }
 
+    std::size_t
+    SecretKey::encipher(elle::ConstWeakBuffer const& plain,
+                        elle::WeakBuffer code,
+                        Cipher const cipher) const
+    {
+      auto schedule = this->_schedule(cipher);
+      auto context = schedule->acquire(true);
+      auto res = raw::symmetric::aead::seal(
+        context.get(), static_cast<uint8_t>(cipher), plain, code);
+      schedule->release(true, std::move(context));
+      return res;
+    }
+
+    std::size_t
+    SecretKey::decipher(elle::ConstWeakBuffer const& code,
+                        elle::WeakBuffer plain) const
+    {
+      if (!_aead(code) || code.size() < 2)
+        throw Error("the code is not an authenticated one");
+      auto schedule = this->_schedule(static_cast<Cipher>(code[1]));
+      auto context = schedule->acquire(false);
+      auto res = raw::symmetric::aead::open(context.get(), code, plain);
+      schedule->release(false, std::move(context));
+      return res;
+    }
+
     uint32_t
     SecretKey::size() const
     {
@@ -157,6 +340,10 @@ namespace elle
     SecretKey::serialize(elle::serialization::Serializer& serializer)
     {
       serializer.serialize("password", this->_password);
+      // Schedules were derived from the previous password.
+      if (serializer.in())
+        for (auto& schedule: this->_schedules)
+          std::atomic_store(&schedule, std::shared_ptr<Schedule>());
     }
   }
 }
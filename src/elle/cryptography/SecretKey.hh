@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <memory>
 #include <utility>
 
 #include <boost/operators.hpp>
@@ -12,6 +14,7 @@
 #include <elle/cryptography/fwd.hh>
 #include <elle/cryptography/Oneway.hh>
 #include <elle/cryptography/Cipher.hh>
+#include <elle/cryptography/constants.hh>
 
 //
 // ---------- Class -----------------------------------------------------------
@@ -22,6 +25,11 @@ namespace elle
   namespace cryptography
   {
     /// Represent a secret key for symmetric cryptosystem operations.
+    ///
+    /// The gcm mode provides authenticated encryption: its key is derived
+    /// once from the password and its expanded key schedule cached in
+    /// contexts that are reused across calls. Deciphering tells the AEAD and
+    /// the legacy salted formats apart, whatever the requested mode.
     class SecretKey
       : public elle::Printable
       , private boost::totally_ordered<SecretKey>
@@ -84,6 +92,19 @@ namespace elle
                Cipher const cipher = defaults::cipher,
                Mode const mode = defaults::mode,
                Oneway const oneway = defaults::oneway) const;
+      /// Encipher \a plain into \a code with an AEAD mode and return the
+      /// code size, without allocating. \a code must hold
+      /// constants::aead::overhead bytes more than \a plain, which may lie
+      /// constants::aead::header_size bytes into \a code to encipher in place.
+      std::size_t
+      encipher(elle::ConstWeakBuffer const& plain,
+               elle::WeakBuffer code,
+               Cipher const cipher = defaults::cipher) const;
+      /// Decipher an AEAD \a code into \a plain and return the plain size.
+      /// \a plain may lie constants::aead::header_size bytes into \a code.
+      std::size_t
+      decipher(elle::ConstWeakBuffer const& code,
+               elle::WeakBuffer plain) const;
       /// Return the size, in bytes, of the secret key.
       uint32_t
       size() const;
@@ -123,6 +144,13 @@ namespace elle
       `-----------*/
     private:
       ELLE_ATTRIBUTE_R(elle::Buffer, password);
+      /// A derived AEAD key with its pools of initialized contexts.
+      class Schedule;
+      std::shared_ptr<Schedule>
+      _schedule(Cipher const cipher) const;
+      /// One lazily created schedule per AES key size.
+      using Schedules = std::array<std::shared_ptr<Schedule>, 3>;
+      ELLE_ATTRIBUTE(Schedules, schedules, mutable);
     };
   }
 }
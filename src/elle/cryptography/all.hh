@@ -3,8 +3,10 @@
 #include <elle/cryptography/Cipher.hh>
 #include <elle/cryptography/Cryptosystem.hh>
 #include <elle/cryptography/Error.hh>
+#include <elle/cryptography/Hasher.hh>
 #include <elle/cryptography/Oneway.hh>
 #include <elle/cryptography/SecretKey.hh>
+#include <elle/cryptography/batch.hh>
 #include <elle/cryptography/bn.hh>
 #include <elle/cryptography/cryptography.hh>
 #include <elle/cryptography/raw.hh>
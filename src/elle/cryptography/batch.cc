@@ -0,0 +1,21 @@
+#include <elle/cryptography/batch.hh>
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace batch
+    {
+      /*----------.
+      | Functions |
+      `----------*/
+
+      void
+      sequential(std::size_t count, Job const& job)
+      {
+        for (std::size_t i = 0; i < count; ++i)
+          job(i);
+      }
+    }
+  }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace elle
+{
+  namespace cryptography
+  {
+    /// Run many independent operations at once, such as checking every
+    /// signature of a block.
+    namespace batch
+    {
+      /// A job applied to every index of a batch.
+      using Job = std::function<void (std::size_t index)>;
+      /// Apply a job to every index in [0, count), possibly concurrently from
+      /// several system threads, and return once they are all done.
+      ///
+      /// elle::reactor::background_parallel fits, spreading the jobs over the
+      /// background pool without blocking the scheduler.
+      using Runner = std::function<void (std::size_t count, Job const& job)>;
+
+      /*----------.
+      | Functions |
+      `----------*/
+
+      /// Run the jobs one after the other, in the calling thread.
+      void
+      sequential(std::size_t count, Job const& job);
+    }
+  }
+}
@@ -13,6 +13,20 @@ namespace elle
 
       /// The size of the chunk to process iteratively from the streams.
       static uint32_t const stream_block_size = 524288;
+
+      /// The layout of authenticated symmetric codes: a version byte, the
+      /// cipher, a nonce, the cipher text and the authentication tag.
+      namespace aead
+      {
+        /// Leading byte of AEAD codes, distinct from the legacy "Salted__"
+        /// magic so both formats can be told apart.
+        static uint8_t const version = 1;
+        static uint32_t const nonce_size = 12;
+        static uint32_t const tag_size = 16;
+        static uint32_t const header_size = 2 + nonce_size;
+        /// How much larger than its plain text a code is.
+        static uint32_t const overhead = header_size + tag_size;
+      }
     }
   }
 }
@@ -41,6 +41,28 @@ namespace elle
         if (ctx != nullptr)
           ::EVP_PKEY_CTX_free(ctx);
       }
+
+      /*-----------.
+      | EVP_MD_CTX |
+      `-----------*/
+
+      void
+      EVP_MD_CTX::operator ()(::EVP_MD_CTX* ctx)
+      {
+        if (ctx != nullptr)
+          ::EVP_MD_CTX_destroy(ctx);
+      }
+
+      /*---------------.
+      | EVP_CIPHER_CTX |
+      `---------------*/
+
+      void
+      EVP_CIPHER_CTX::operator ()(::EVP_CIPHER_CTX* ctx)
+      {
+        if (ctx != nullptr)
+          ::EVP_CIPHER_CTX_free(ctx);
+      }
     }
   }
 }
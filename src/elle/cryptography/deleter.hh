@@ -41,6 +41,26 @@ namespace elle
         void
         operator ()(::EVP_PKEY_CTX* ctx);
       };
+
+      /*-----------.
+      | EVP_MD_CTX |
+      `-----------*/
+
+      struct EVP_MD_CTX
+      {
+        void
+        operator ()(::EVP_MD_CTX* ctx);
+      };
+
+      /*---------------.
+      | EVP_CIPHER_CTX |
+      `---------------*/
+
+      struct EVP_CIPHER_CTX
+      {
+        void
+        operator ()(::EVP_CIPHER_CTX* ctx);
+      };
     }
   }
 }
@@ -161,9 +161,10 @@ namespace elle
       elle::Buffer
       PrivateKey::sign(elle::ConstWeakBuffer const& plain) const
       {
-        elle::IOStream _plain(plain.istreambuf());
-
-        return (this->sign(_plain));
+        return (raw::asymmetric::sign(
+                  this->_key.get(),
+                  oneway::resolve(this->_digest_algorithm),
+                  plain));
       }
 
       elle::Buffer
@@ -269,6 +270,40 @@ namespace elle
   }
 }
 
+//
+// ---------- Batch -----------------------------------------------------------
+//
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace dsa
+    {
+      namespace privatekey
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        std::vector<elle::Buffer>
+        sign(std::vector<Signing> const& signings,
+             batch::Runner const& run)
+        {
+          std::vector<elle::Buffer> signatures(signings.size());
+          run(signings.size(),
+              [&] (std::size_t i)
+              {
+                auto const& s = signings[i];
+                signatures[i] = s.key.sign(s.plain);
+              });
+          return signatures;
+        }
+      }
+    }
+  }
+}
+
 namespace std
 {
   size_t
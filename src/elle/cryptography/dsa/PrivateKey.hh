@@ -1,6 +1,7 @@
 #pragma once
 
 #include <utility>
+#include <vector>
 
 
 #include <boost/operators.hpp>
@@ -8,6 +9,7 @@
 #include <elle/attribute.hh>
 #include <elle/operator.hh>
 #include <elle/serialization.hh>
+#include <elle/cryptography/batch.hh>
 #include <elle/cryptography/fwd.hh>
 #include <elle/cryptography/types.hh>
 #include <elle/cryptography/Oneway.hh>
@@ -107,6 +109,39 @@ namespace elle
   }
 }
 
+//
+// ---------- Batch -----------------------------------------------------------
+//
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace dsa
+    {
+      namespace privatekey
+      {
+        /// A plain text to sign.
+        struct Signing
+        {
+          PrivateKey const& key;
+          elle::ConstWeakBuffer plain;
+        };
+
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Sign every plain text through \a run and return the signatures,
+        /// in order.
+        std::vector<elle::Buffer>
+        sign(std::vector<Signing> const& signings,
+             batch::Runner const& run = batch::sequential);
+      }
+    }
+  }
+}
+
 namespace std
 {
   template <>
@@ -193,8 +193,11 @@ namespace elle
       PublicKey::verify(elle::ConstWeakBuffer const& signature,
                         elle::ConstWeakBuffer const& plain) const
       {
-        elle::IOStream _plain(plain.istreambuf());
-        return (this->verify(signature, _plain));
+        return (raw::asymmetric::verify(
+                  this->_key.get(),
+                  oneway::resolve(this->_digest_algorithm),
+                  signature,
+                  plain));
       }
 
       bool
@@ -297,6 +300,41 @@ namespace elle
   }
 }
 
+//
+// ---------- Batch -----------------------------------------------------------
+//
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace dsa
+    {
+      namespace publickey
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        std::vector<bool>
+        verify(std::vector<Verification> const& verifications,
+               batch::Runner const& run)
+        {
+          // Concurrent writes to distinct bits of a vector<bool> race.
+          std::vector<char> results(verifications.size(), false);
+          run(verifications.size(),
+              [&] (std::size_t i)
+              {
+                auto const& v = verifications[i];
+                results[i] = v.key.verify(v.signature, v.plain);
+              });
+          return std::vector<bool>(results.begin(), results.end());
+        }
+      }
+    }
+  }
+}
+
 namespace std
 {
   size_t
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <utility>
+#include <vector>
 
 #include <boost/operators.hpp>
 
@@ -9,6 +10,7 @@
 #include <elle/serialization/Serializer.hh>
 #include <elle/serialization.hh>
 #include <elle/cryptography/dsa/PrivateKey.hh>
+#include <elle/cryptography/batch.hh>
 #include <elle/cryptography/fwd.hh>
 #include <elle/cryptography/types.hh>
 #include <elle/cryptography/Oneway.hh>
@@ -113,6 +115,40 @@ namespace elle
   }
 }
 
+//
+// ---------- Batch -----------------------------------------------------------
+//
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace dsa
+    {
+      namespace publickey
+      {
+        /// A signature to check against the plain text it claims to sign.
+        struct Verification
+        {
+          PublicKey const& key;
+          elle::ConstWeakBuffer signature;
+          elle::ConstWeakBuffer plain;
+        };
+
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Verify every signature through \a run and return, in order,
+        /// whether each one is valid.
+        std::vector<bool>
+        verify(std::vector<Verification> const& verifications,
+               batch::Runner const& run = batch::sequential);
+      }
+    }
+  }
+}
+
 namespace std
 {
   template <>
@@ -1,5 +1,8 @@
+# include <openssl/err.h>
 # include <openssl/evp.h>
 
+#include <elle/cryptography/Error.hh>
+#include <elle/cryptography/cryptography.hh>
 #include <elle/cryptography/hash.hh>
 #include <elle/cryptography/raw.hh>
 
@@ -18,9 +21,20 @@ namespace elle
     hash(elle::ConstWeakBuffer const& plain,
          Oneway const oneway)
     {
-      elle::IOStream _plain(plain.istreambuf());
+      cryptography::require();
+      ::EVP_MD const* function = oneway::resolve(oneway);
+      elle::Buffer digest(EVP_MD_size(function));
+      unsigned int size(0);
+      // Digest in place, in a single update.
+      if (::EVP_Digest(plain.contents(), plain.size(),
+                       digest.mutable_contents(), &size,
+                       function, nullptr) <= 0)
+        throw Error(
+          elle::sprintf("unable to apply the digest function: %s",
+                        ::ERR_error_string(ERR_get_error(), nullptr)));
+      digest.size(size);
 
-      return (hash(_plain, oneway));
+      return (digest);
     }
 
     elle::Buffer
@@ -41,5 +55,20 @@ namespace elle
 
       return (raw::hash(function, plain));
     }
+
+    std::vector<elle::Buffer>
+    hash(std::vector<elle::ConstWeakBuffer> const& plains,
+         Oneway const oneway,
+         batch::Runner const& run)
+    {
+      std::vector<elle::Buffer> digests(plains.size());
+      run(plains.size(),
+          [&] (std::size_t i)
+          {
+            digests[i] = hash(plains[i], oneway);
+          });
+
+      return (digests);
+    }
   }
 }
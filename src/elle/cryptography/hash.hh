@@ -3,8 +3,10 @@
 
 # include <elle/cryptography/fwd.hh>
 # include <elle/cryptography/Oneway.hh>
+# include <elle/cryptography/batch.hh>
 
 # include <iosfwd>
+# include <vector>
 
 namespace elle
 {
@@ -25,6 +27,14 @@ namespace elle
     elle::Buffer
     hash(std::istream& plain,
          Oneway const oneway);
+    /// Hash every plain text independently and return their digests.
+    ///
+    /// Meant for many small buffers: pass a concurrent runner to spread them
+    /// across threads.
+    std::vector<elle::Buffer>
+    hash(std::vector<elle::ConstWeakBuffer> const& plains,
+         Oneway const oneway,
+         batch::Runner const& run = batch::sequential);
   }
 }
 
@@ -210,14 +210,16 @@ namespace elle
           return (plain);
         }
 
+        /// Sign what \a update feeds to the context.
+        static
         elle::Buffer
-        sign(::EVP_PKEY* key,
-             ::EVP_MD const* oneway,
-             std::istream& plain,
-             std::function<void (::EVP_MD_CTX*,
-                                 ::EVP_PKEY_CTX*)> prolog,
-             std::function<void (::EVP_MD_CTX*,
-                                 ::EVP_PKEY_CTX*)> epilog)
+        _sign(::EVP_PKEY* key,
+              ::EVP_MD const* oneway,
+              std::function<void (::EVP_MD_CTX*)> const& update,
+              std::function<void (::EVP_MD_CTX*,
+                                  ::EVP_PKEY_CTX*)> const& prolog,
+              std::function<void (::EVP_MD_CTX*,
+                                  ::EVP_PKEY_CTX*)> const& epilog)
         {
           // Make sure the cryptographic system is set up.
           cryptography::require();
@@ -240,27 +242,7 @@ namespace elle
           if (prolog)
             prolog(&context, ctx);
 
-          // Sign the plain's stream.
-          unsigned char* _input = buffers().first;
-
-          while (!plain.eof())
-          {
-            // Read the plain's input stream and put a block of data in a
-            // temporary buffer.
-            plain.read(reinterpret_cast<char*>(_input), constants::stream_block_size);
-            if (plain.bad())
-              throw Error(
-                elle::sprintf("unable to read the plain's input stream: %s",
-                              plain.rdstate()));
-
-            // Update the signature context.
-            if (::EVP_DigestSignUpdate(&context,
-                                       _input,
-                                       plain.gcount()) <= 0)
-              throw Error(
-                elle::sprintf("unable to apply the signature function: %s",
-                              ::ERR_error_string(ERR_get_error(), nullptr)));
-          }
+          update(&context);
 
           // Finalize the signature.
           size_t size(0);
@@ -300,15 +282,17 @@ namespace elle
           return (signature);
         }
 
+        /// Verify the signature of what \a update feeds to the context.
+        static
         bool
-        verify(::EVP_PKEY* key,
-               ::EVP_MD const* oneway,
-               elle::ConstWeakBuffer const& signature,
-               std::istream& plain,
-               std::function<void (::EVP_MD_CTX*,
-                                   ::EVP_PKEY_CTX*)> prolog,
-               std::function<void (::EVP_MD_CTX*,
-                                   ::EVP_PKEY_CTX*)> epilog)
+        _verify(::EVP_PKEY* key,
+                ::EVP_MD const* oneway,
+                elle::ConstWeakBuffer const& signature,
+                std::function<void (::EVP_MD_CTX*)> const& update,
+                std::function<void (::EVP_MD_CTX*,
+                                    ::EVP_PKEY_CTX*)> const& prolog,
+                std::function<void (::EVP_MD_CTX*,
+                                    ::EVP_PKEY_CTX*)> const& epilog)
         {
           // Make sure the cryptographic system is set up.
           cryptography::require();
@@ -331,27 +315,7 @@ namespace elle
           if (prolog)
             prolog(&context, ctx);
 
-          // Verify the signature's stream.
-          unsigned char* _input = buffers().first;
-
-          while (!plain.eof())
-          {
-            // Read the plain's input stream and put a block of data in a
-            // temporary buffer.
-            plain.read(reinterpret_cast<char*>(_input), constants::stream_block_size);
-            if (plain.bad())
-              throw Error(
-                elle::sprintf("unable to read the plain's input stream: %s",
-                              plain.rdstate()));
-
-            // Update the verify context.
-            if (::EVP_DigestVerifyUpdate(&context,
-                                         _input,
-                                         plain.gcount()) <= 0)
-              throw Error(
-                elle::sprintf("unable to apply the verify function: %s",
-                              ::ERR_error_string(ERR_get_error(), nullptr)));
-          }
+          update(&context);
 
           if (epilog)
             epilog(&context, ctx);
@@ -383,6 +347,135 @@ namespace elle
           elle::unreachable();
         }
 
+        elle::Buffer
+        sign(::EVP_PKEY* key,
+             ::EVP_MD const* oneway,
+             std::istream& plain,
+             std::function<void (::EVP_MD_CTX*,
+                                 ::EVP_PKEY_CTX*)> prolog,
+             std::function<void (::EVP_MD_CTX*,
+                                 ::EVP_PKEY_CTX*)> epilog)
+        {
+          return _sign(
+            key, oneway,
+            [&] (::EVP_MD_CTX* context)
+            {
+              // Sign the plain's stream.
+              unsigned char* _input = buffers().first;
+
+              while (!plain.eof())
+              {
+                // Read the plain's input stream and put a block of data in a
+                // temporary buffer.
+                plain.read(reinterpret_cast<char*>(_input),
+                           constants::stream_block_size);
+                if (plain.bad())
+                  throw Error(
+                    elle::sprintf("unable to read the plain's input stream: %s",
+                                  plain.rdstate()));
+
+                // Update the signature context.
+                if (::EVP_DigestSignUpdate(context,
+                                           _input,
+                                           plain.gcount()) <= 0)
+                  throw Error(
+                    elle::sprintf("unable to apply the signature function: "
+                                  "%s",
+                                  ::ERR_error_string(ERR_get_error(),
+                                                     nullptr)));
+              }
+            },
+            prolog, epilog);
+        }
+
+        elle::Buffer
+        sign(::EVP_PKEY* key,
+             ::EVP_MD const* oneway,
+             elle::ConstWeakBuffer const& plain,
+             std::function<void (::EVP_MD_CTX*,
+                                 ::EVP_PKEY_CTX*)> prolog,
+             std::function<void (::EVP_MD_CTX*,
+                                 ::EVP_PKEY_CTX*)> epilog)
+        {
+          return _sign(
+            key, oneway,
+            [&] (::EVP_MD_CTX* context)
+            {
+              if (::EVP_DigestSignUpdate(context,
+                                         plain.contents(),
+                                         plain.size()) <= 0)
+                throw Error(
+                  elle::sprintf("unable to apply the signature function: %s",
+                                ::ERR_error_string(ERR_get_error(), nullptr)));
+            },
+            prolog, epilog);
+        }
+
+        bool
+        verify(::EVP_PKEY* key,
+               ::EVP_MD const* oneway,
+               elle::ConstWeakBuffer const& signature,
+               std::istream& plain,
+               std::function<void (::EVP_MD_CTX*,
+                                   ::EVP_PKEY_CTX*)> prolog,
+               std::function<void (::EVP_MD_CTX*,
+                                   ::EVP_PKEY_CTX*)> epilog)
+        {
+          return _verify(
+            key, oneway, signature,
+            [&] (::EVP_MD_CTX* context)
+            {
+              // Verify the signature's stream.
+              unsigned char* _input = buffers().first;
+
+              while (!plain.eof())
+              {
+                // Read the plain's input stream and put a block of data in a
+                // temporary buffer.
+                plain.read(reinterpret_cast<char*>(_input),
+                           constants::stream_block_size);
+                if (plain.bad())
+                  throw Error(
+                    elle::sprintf("unable to read the plain's input stream: %s",
+                                  plain.rdstate()));
+
+                // Update the verify context.
+                if (::EVP_DigestVerifyUpdate(context,
+                                             _input,
+                                             plain.gcount()) <= 0)
+                  throw Error(
+                    elle::sprintf("unable to apply the verify function: %s",
+                                  ::ERR_error_string(ERR_get_error(),
+                                                     nullptr)));
+              }
+            },
+            prolog, epilog);
+        }
+
+        bool
+        verify(::EVP_PKEY* key,
+               ::EVP_MD const* oneway,
+               elle::ConstWeakBuffer const& signature,
+               elle::ConstWeakBuffer const& plain,
+               std::function<void (::EVP_MD_CTX*,
+                                   ::EVP_PKEY_CTX*)> prolog,
+               std::function<void (::EVP_MD_CTX*,
+                                   ::EVP_PKEY_CTX*)> epilog)
+        {
+          return _verify(
+            key, oneway, signature,
+            [&] (::EVP_MD_CTX* context)
+            {
+              if (::EVP_DigestVerifyUpdate(context,
+                                           plain.contents(),
+                                           plain.size()) <= 0)
+                throw Error(
+                  elle::sprintf("unable to apply the verify function: %s",
+                                ::ERR_error_string(ERR_get_error(), nullptr)));
+            },
+            prolog, epilog);
+        }
+
         elle::Buffer
         agree(::EVP_PKEY* own,
               ::EVP_PKEY* peer,
@@ -826,6 +919,142 @@ namespace elle
 
           ELLE_CRYPTOGRAPHY_FINALLY_ABORT(context);
         }
+
+        namespace aead
+        {
+          std::size_t
+          seal(::EVP_CIPHER_CTX* context,
+               uint8_t cipher,
+               elle::ConstWeakBuffer const& plain,
+               elle::WeakBuffer code)
+          {
+            if (code.size() < plain.size() + constants::aead::overhead)
+              throw Error(
+                elle::sprintf("the code buffer is too small: %s bytes for "
+                              "%s bytes of plain text",
+                              code.size(), plain.size()));
+            unsigned char* header = code.mutable_contents();
+            header[0] = constants::aead::version;
+            header[1] = cipher;
+            unsigned char* nonce = header + 2;
+            if (::RAND_bytes(nonce, constants::aead::nonce_size) <= 0)
+              throw Error(
+                elle::sprintf("unable to generate a nonce: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+            // Only set the nonce, the key schedule is kept from the context
+            // initialization.
+            if (::EVP_EncryptInit_ex(context,
+                                     nullptr,
+                                     nullptr,
+                                     nullptr,
+                                     nonce) <= 0)
+              throw Error(
+                elle::sprintf("unable to initialize the encryption process: "
+                              "%s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+            // Authenticate the header along with the text.
+            int size(0);
+            if (::EVP_EncryptUpdate(context,
+                                    nullptr,
+                                    &size,
+                                    header,
+                                    constants::aead::header_size) <= 0)
+              throw Error(
+                elle::sprintf("unable to authenticate the header: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+            unsigned char* output = header + constants::aead::header_size;
+            size = 0;
+            if (plain.size() > 0 &&
+                ::EVP_EncryptUpdate(context,
+                                    output,
+                                    &size,
+                                    plain.contents(),
+                                    plain.size()) <= 0)
+              throw Error(
+                elle::sprintf("unable to apply the encryption function: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+            int size_final(0);
+            if (::EVP_EncryptFinal_ex(context,
+                                      output + size,
+                                      &size_final) <= 0)
+              throw Error(
+                elle::sprintf("unable to finalize the encryption process: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+            size += size_final;
+            if (::EVP_CIPHER_CTX_ctrl(context,
+                                      EVP_CTRL_GCM_GET_TAG,
+                                      constants::aead::tag_size,
+                                      output + size) <= 0)
+              throw Error(
+                elle::sprintf("unable to retrieve the authentication tag: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+            return constants::aead::header_size + size +
+              constants::aead::tag_size;
+          }
+
+          std::size_t
+          open(::EVP_CIPHER_CTX* context,
+               elle::ConstWeakBuffer const& code,
+               elle::WeakBuffer plain)
+          {
+            if (code.size() < constants::aead::overhead)
+              throw Error(
+                elle::sprintf("the code is too short: %s bytes", code.size()));
+            if (code[0] != constants::aead::version)
+              throw Error(
+                elle::sprintf("unsupported code version: %s", int(code[0])));
+            auto const length = code.size() - constants::aead::overhead;
+            if (plain.size() < length)
+              throw Error(
+                elle::sprintf("the plain buffer is too small: %s bytes for "
+                              "%s bytes of code",
+                              plain.size(), code.size()));
+            unsigned char const* header = code.contents();
+            if (::EVP_DecryptInit_ex(context,
+                                     nullptr,
+                                     nullptr,
+                                     nullptr,
+                                     header + 2) <= 0)
+              throw Error(
+                elle::sprintf("unable to initialize the decryption process: "
+                              "%s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+            int size(0);
+            if (::EVP_DecryptUpdate(context,
+                                    nullptr,
+                                    &size,
+                                    header,
+                                    constants::aead::header_size) <= 0)
+              throw Error(
+                elle::sprintf("unable to authenticate the header: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+            size = 0;
+            if (length > 0 &&
+                ::EVP_DecryptUpdate(context,
+                                    plain.mutable_contents(),
+                                    &size,
+                                    header + constants::aead::header_size,
+                                    length) <= 0)
+              throw Error(
+                elle::sprintf("unable to apply the decryption function: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+            auto tag = const_cast<unsigned char*>(
+              header + code.size() - constants::aead::tag_size);
+            if (::EVP_CIPHER_CTX_ctrl(context,
+                                      EVP_CTRL_GCM_SET_TAG,
+                                      constants::aead::tag_size,
+                                      tag) <= 0)
+              throw Error(
+                elle::sprintf("unable to set the authentication tag: %s",
+                              ::ERR_error_string(ERR_get_error(), nullptr)));
+            int size_final(0);
+            if (::EVP_DecryptFinal_ex(context,
+                                      plain.mutable_contents() + size,
+                                      &size_final) <= 0)
+              throw Error("the code failed authentication");
+            return size + size_final;
+          }
+        }
       }
     }
   }
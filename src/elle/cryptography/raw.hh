@@ -51,6 +51,15 @@ namespace elle
                                  ::EVP_PKEY_CTX*)> prolog = nullptr,
              std::function<void (::EVP_MD_CTX*,
                                  ::EVP_PKEY_CTX*)> epilog = nullptr);
+        /// Sign the given plain text, in a single pass.
+        elle::Buffer
+        sign(::EVP_PKEY* key,
+             ::EVP_MD const* oneway,
+             elle::ConstWeakBuffer const& plain,
+             std::function<void (::EVP_MD_CTX*,
+                                 ::EVP_PKEY_CTX*)> prolog = nullptr,
+             std::function<void (::EVP_MD_CTX*,
+                                 ::EVP_PKEY_CTX*)> epilog = nullptr);
         /// Return true if the signature is valid according to the given plain.
         bool
         verify(::EVP_PKEY* key,
@@ -61,6 +70,17 @@ namespace elle
                                    ::EVP_PKEY_CTX*)> prolog = nullptr,
                std::function<void (::EVP_MD_CTX*,
                                    ::EVP_PKEY_CTX*)> epilog = nullptr);
+        /// Return true if the signature is valid according to the given plain,
+        /// checked in a single pass.
+        bool
+        verify(::EVP_PKEY* key,
+               ::EVP_MD const* oneway,
+               elle::ConstWeakBuffer const& signature,
+               elle::ConstWeakBuffer const& plain,
+               std::function<void (::EVP_MD_CTX*,
+                                   ::EVP_PKEY_CTX*)> prolog = nullptr,
+               std::function<void (::EVP_MD_CTX*,
+                                   ::EVP_PKEY_CTX*)> epilog = nullptr);
         /// Agree on a shared key between two key pairs: between a one's private
         /// key and a peer's public key.
         elle::Buffer
@@ -119,6 +139,26 @@ namespace elle
                  std::ostream& plain,
                  std::function<void (::EVP_CIPHER_CTX*)> prolog = nullptr,
                  std::function<void (::EVP_CIPHER_CTX*)> epilog = nullptr);
+
+        /// Authenticated encryption on contexts whose key is already set,
+        /// following the constants::aead layout.
+        namespace aead
+        {
+          /// Seal the plain text into the code buffer and return the code
+          /// size. The plain text may lie exactly constants::aead::header_size
+          /// bytes into the code buffer to be enciphered in place.
+          std::size_t
+          seal(::EVP_CIPHER_CTX* context,
+               uint8_t cipher,
+               elle::ConstWeakBuffer const& plain,
+               elle::WeakBuffer code);
+          /// Authenticate and open the code into the plain buffer, return the
+          /// plain text size.
+          std::size_t
+          open(::EVP_CIPHER_CTX* context,
+               elle::ConstWeakBuffer const& code,
+               elle::WeakBuffer plain);
+        }
       }
     }
   }
@@ -230,9 +230,17 @@ namespace elle
                        Padding const padding,
                        Oneway const oneway) const
       {
-        auto is = elle::IOStream(plain.istreambuf());
-        return this->sign(is,
-                          padding, oneway);
+        auto prolog =
+          [padding](::EVP_MD_CTX* context, ::EVP_PKEY_CTX* ctx)
+          {
+            padding::pad(ctx, padding);
+          };
+
+        return raw::asymmetric::sign(
+                  this->_key.get(),
+                  oneway::resolve(oneway),
+                  plain,
+                  prolog);
       }
 
       elle::Buffer
@@ -437,6 +445,49 @@ namespace elle
   }
 }
 
+//
+// ---------- Batch -----------------------------------------------------------
+//
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      namespace privatekey
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        std::vector<elle::Buffer>
+        sign(std::vector<Signing> const& signings,
+             batch::Runner const& run,
+             Padding const padding,
+             Oneway const oneway)
+        {
+          auto const function = oneway::resolve(oneway);
+          auto prolog =
+            [padding](::EVP_MD_CTX* context, ::EVP_PKEY_CTX* ctx)
+            {
+              padding::pad(ctx, padding);
+            };
+          std::vector<elle::Buffer> signatures(signings.size());
+          run(signings.size(),
+              [&] (std::size_t i)
+              {
+                auto const& s = signings[i];
+                signatures[i] = raw::asymmetric::sign(
+                  s.key.key().get(), function, s.plain, prolog);
+              });
+          return signatures;
+        }
+      }
+    }
+  }
+}
+
 namespace std
 {
   size_t
@@ -2,11 +2,13 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <boost/operators.hpp>
 
 #include <elle/serialization.hh>
 
+#include <elle/cryptography/batch.hh>
 #include <elle/cryptography/fwd.hh>
 #include <elle/cryptography/types.hh>
 #include <elle/cryptography/Oneway.hh>
@@ -199,6 +201,41 @@ namespace elle
   }
 }
 
+//
+// ---------- Batch -----------------------------------------------------------
+//
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      namespace privatekey
+      {
+        /// A plain text to sign.
+        struct Signing
+        {
+          PrivateKey const& key;
+          elle::ConstWeakBuffer plain;
+        };
+
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Sign every plain text through \a run and return the signatures,
+        /// in order.
+        std::vector<elle::Buffer>
+        sign(std::vector<Signing> const& signings,
+             batch::Runner const& run = batch::sequential,
+             Padding const padding = defaults::signature_padding,
+             Oneway const oneway = defaults::oneway);
+      }
+    }
+  }
+}
+
 namespace std
 {
   template <>
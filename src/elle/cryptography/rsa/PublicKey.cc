@@ -214,8 +214,18 @@ namespace elle
                          Padding const padding,
                          Oneway const oneway) const
       {
-        elle::IOStream _plain(plain.istreambuf());
-        return this->_verify(signature, _plain, padding, oneway);
+        auto prolog =
+          [padding](::EVP_MD_CTX* context, ::EVP_PKEY_CTX* ctx)
+          {
+            padding::pad(ctx, padding);
+          };
+
+        return (raw::asymmetric::verify(
+                  this->_key.get(),
+                  oneway::resolve(oneway),
+                  signature,
+                  plain,
+                  prolog));
       }
 
       bool
@@ -424,6 +434,51 @@ namespace elle
   }
 }
 
+//
+// ---------- Batch -----------------------------------------------------------
+//
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      namespace publickey
+      {
+        /*----------.
+        | Functions |
+        `----------*/
+
+        std::vector<bool>
+        verify(std::vector<Verification> const& verifications,
+               batch::Runner const& run,
+               Padding const padding,
+               Oneway const oneway)
+        {
+          ELLE_TRACE_SCOPE("verify %s signatures", verifications.size());
+          auto const function = oneway::resolve(oneway);
+          auto prolog =
+            [padding](::EVP_MD_CTX* context, ::EVP_PKEY_CTX* ctx)
+            {
+              padding::pad(ctx, padding);
+            };
+          // Concurrent writes to distinct bits of a vector<bool> race.
+          std::vector<char> results(verifications.size(), false);
+          run(verifications.size(),
+              [&] (std::size_t i)
+              {
+                auto const& v = verifications[i];
+                results[i] = raw::asymmetric::verify(
+                  v.key.key().get(), function, v.signature, v.plain, prolog);
+              });
+          return std::vector<bool>(results.begin(), results.end());
+        }
+      }
+    }
+  }
+}
+
 namespace std
 {
   size_t
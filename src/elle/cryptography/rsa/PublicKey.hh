@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <boost/operators.hpp>
 
@@ -9,6 +10,7 @@
 #include <elle/operator.hh>
 #include <elle/serialization.hh>
 
+#include <elle/cryptography/batch.hh>
 #include <elle/cryptography/fwd.hh>
 #include <elle/cryptography/types.hh>
 #include <elle/cryptography/Oneway.hh>
@@ -213,6 +215,43 @@ namespace elle
   }
 }
 
+//
+// ---------- Batch -----------------------------------------------------------
+//
+
+namespace elle
+{
+  namespace cryptography
+  {
+    namespace rsa
+    {
+      namespace publickey
+      {
+        /// A signature to check against the plain text it claims to sign.
+        struct Verification
+        {
+          PublicKey const& key;
+          elle::ConstWeakBuffer signature;
+          elle::ConstWeakBuffer plain;
+        };
+
+        /*----------.
+        | Functions |
+        `----------*/
+
+        /// Verify every signature through \a run and return, in order,
+        /// whether each one is valid. Errors are thrown as by
+        /// PublicKey::verify.
+        std::vector<bool>
+        verify(std::vector<Verification> const& verifications,
+               batch::Runner const& run = batch::sequential,
+               Padding const padding = defaults::signature_padding,
+               Oneway const oneway = defaults::oneway);
+      }
+    }
+  }
+}
+
 namespace std
 {
   template <>
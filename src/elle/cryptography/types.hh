@@ -15,6 +15,9 @@ namespace elle
       using BIGNUM = std::unique_ptr<BIGNUM, deleter::BIGNUM>;
       using EVP_PKEY = std::unique_ptr<EVP_PKEY, deleter::EVP_PKEY>;
       using EVP_PKEY_CTX = std::unique_ptr<EVP_PKEY_CTX, deleter::EVP_PKEY_CTX>;
+      using EVP_MD_CTX = std::unique_ptr<EVP_MD_CTX, deleter::EVP_MD_CTX>;
+      using EVP_CIPHER_CTX =
+        std::unique_ptr<EVP_CIPHER_CTX, deleter::EVP_CIPHER_CTX>;
     }
   }
 }
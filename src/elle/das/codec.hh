@@ -0,0 +1,588 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <elle/Buffer.hh>
+#include <elle/attribute.hh>
+#include <elle/err.hh>
+#include <elle/serialization/binary/SerializerIn.hh>
+#include <elle/serialization/binary/SerializerOut.hh>
+#include <elle/serialization/json/Error.hh>
+
+#include <elle/das/model.hh>
+#include <elle/das/serializer.hh>
+
+namespace elle
+{
+  namespace das
+  {
+    template <typename O, typename M = typename DefaultModel<O>::type>
+    struct BinaryCodec;
+
+    namespace _details
+    {
+      /// Append to the buffer of a binary serializer.
+      class BinaryEncoder
+      {
+      public:
+        BinaryEncoder(serialization::binary::SerializerOut& serializer)
+          : _serializer(serializer)
+          , _buffer(serializer.buffer())
+        {}
+
+        void
+        number(int64_t n)
+        {
+          serialization::binary::SerializerOut::serialize_number(
+            this->_buffer, n);
+        }
+
+        void
+        write(void const* data, std::size_t size)
+        {
+          this->_buffer.append(data, size);
+        }
+
+        /// Serializer for the fields not encoded statically.
+        ELLE_ATTRIBUTE_RX(serialization::binary::SerializerOut&, serializer);
+        ELLE_ATTRIBUTE(elle::Buffer&, buffer);
+      };
+
+      /// Consume the input of a binary serializer.
+      class BinaryDecoder
+      {
+      public:
+        /// The name of the field being decoded, for errors only.
+        using Name = std::string (*)();
+
+        BinaryDecoder(serialization::binary::SerializerIn& serializer)
+          : _serializer(serializer)
+          , _position()
+          , _end()
+        {
+          this->resume();
+        }
+
+        int64_t
+        number()
+        {
+          int64_t res;
+          this->_position +=
+            serialization::binary::SerializerIn::serialize_number(
+              elle::ConstWeakBuffer(this->_position,
+                                    this->_end - this->_position),
+              res);
+          return res;
+        }
+
+        void
+        read(void* data, std::size_t size, Name name)
+        {
+          this->_check(size, name);
+          std::memcpy(data, this->_position, size);
+          this->_position += size;
+        }
+
+        /// A size-prefixed view of the input.
+        elle::ConstWeakBuffer
+        view(Name name)
+        {
+          auto const size = this->number();
+          if (size < 0)
+            elle::err<serialization::Error>(
+              "negative size when deserializing \"%s\": %s", name(), size);
+          this->_check(size, name);
+          auto const res = elle::ConstWeakBuffer(this->_position, size);
+          this->_position += size;
+          return res;
+        }
+
+        /// Let the serializer resume after what was decoded.
+        void
+        sync()
+        {
+          this->_serializer.skip(
+            this->_position - this->_serializer.remaining().contents());
+        }
+
+        /// Resume after what the serializer decoded.
+        void
+        resume()
+        {
+          auto const remaining = this->_serializer.remaining();
+          this->_position = remaining.contents();
+          this->_end = remaining.contents() + remaining.size();
+        }
+
+        /// Number of bytes left in the input.
+        std::size_t
+        left() const
+        {
+          return this->_end - this->_position;
+        }
+
+        /// Serializer for the fields not decoded statically.
+        ELLE_ATTRIBUTE_RX(serialization::binary::SerializerIn&, serializer);
+
+      private:
+        void
+        _check(int64_t size, Name name)
+        {
+          if (this->_end - this->_position < size)
+            elle::err<serialization::Error>(
+              "short read when deserializing \"%s\": expected %s, got %s",
+              name(), size, this->_end - this->_position);
+        }
+
+        ELLE_ATTRIBUTE(elle::Buffer::Byte const*, position);
+        ELLE_ATTRIBUTE(elle::Buffer::Byte const*, end);
+      };
+
+      /// Whether T is encoded as a number by the binary serializer.
+      template <typename T>
+      constexpr
+      bool
+      binary_integer()
+      {
+        return
+          std::is_same<T, int8_t>::value ||
+          std::is_same<T, uint8_t>::value ||
+          std::is_same<T, int16_t>::value ||
+          std::is_same<T, uint16_t>::value ||
+          std::is_same<T, int32_t>::value ||
+          std::is_same<T, uint32_t>::value ||
+          std::is_same<T, int64_t>::value ||
+          std::is_same<T, uint64_t>::value ||
+          std::is_same<T, long>::value ||
+          std::is_same<T, unsigned long>::value;
+      }
+
+      /// Whether T is serialized with elle::das::Serializer.
+      template <typename T>
+      constexpr
+      bool
+      das_serialized(...)
+      {
+        return false;
+      }
+
+      template <typename T>
+      constexpr
+      std::enable_if_t<
+        std::is_base_of<
+          Serializer<T, typename serialization::Serialize<T>::Model>,
+          serialization::Serialize<T>>::value,
+        bool>
+      das_serialized(int)
+      {
+        return true;
+      }
+
+      template <typename T>
+      std::enable_if_t<sizeof(T) == sizeof(int64_t), T>
+      binary_narrow(int64_t value, BinaryDecoder::Name)
+      {
+        return static_cast<T>(value);
+      }
+
+      template <typename T>
+      std::enable_if_t<sizeof(T) < sizeof(int64_t), T>
+      binary_narrow(int64_t value, BinaryDecoder::Name name)
+      {
+        using limits = std::numeric_limits<T>;
+        if (value > limits::max())
+          throw serialization::json::Overflow(
+            name(), sizeof(T) * 8, true, value);
+        if (value < limits::min())
+          throw serialization::json::Overflow(
+            name(), sizeof(T) * 8, false, value);
+        return value;
+      }
+
+      /// How to encode and decode a T statically.
+      ///
+      /// Types without a specialization are dynamic: they go through the
+      /// serializer.
+      template <typename T, typename Enable = void>
+      struct BinaryValue
+      {
+        static bool constexpr dynamic = true;
+      };
+
+      template <typename T>
+      struct BinaryValue<T, std::enable_if_t<binary_integer<T>()>>
+      {
+        static bool constexpr dynamic = false;
+
+        static
+        void
+        encode(T const& v, BinaryEncoder& e)
+        {
+          e.number(v);
+        }
+
+        static
+        T
+        decode(BinaryDecoder& d, BinaryDecoder::Name name)
+        {
+          return binary_narrow<T>(d.number(), name);
+        }
+      };
+
+      template <>
+      struct BinaryValue<bool>
+      {
+        static bool constexpr dynamic = false;
+
+        static
+        void
+        encode(bool v, BinaryEncoder& e)
+        {
+          e.number(v ? 1 : 0);
+        }
+
+        static
+        bool
+        decode(BinaryDecoder& d, BinaryDecoder::Name name)
+        {
+          auto const v = d.number();
+          if (v != 0 && v != 1)
+            throw serialization::json::Overflow(name(), 1, true, v);
+          return v;
+        }
+      };
+
+      template <>
+      struct BinaryValue<double>
+      {
+        static bool constexpr dynamic = false;
+
+        static
+        void
+        encode(double v, BinaryEncoder& e)
+        {
+          e.write(&v, sizeof v);
+        }
+
+        static
+        double
+        decode(BinaryDecoder& d, BinaryDecoder::Name name)
+        {
+          double res;
+          d.read(&res, sizeof res, name);
+          return res;
+        }
+      };
+
+      template <>
+      struct BinaryValue<std::string>
+      {
+        static bool constexpr dynamic = false;
+
+        static
+        void
+        encode(std::string const& v, BinaryEncoder& e)
+        {
+          e.number(v.size());
+          e.write(v.data(), v.size());
+        }
+
+        static
+        std::string
+        decode(BinaryDecoder& d, BinaryDecoder::Name name)
+        {
+          auto const view = d.view(name);
+          return std::string(reinterpret_cast<char const*>(view.contents()),
+                             view.size());
+        }
+      };
+
+      template <>
+      struct BinaryValue<elle::Buffer>
+      {
+        static bool constexpr dynamic = false;
+
+        static
+        void
+        encode(elle::Buffer const& v, BinaryEncoder& e)
+        {
+          e.number(v.size());
+          e.write(v.contents(), v.size());
+        }
+
+        static
+        elle::Buffer
+        decode(BinaryDecoder& d, BinaryDecoder::Name name)
+        {
+          auto const view = d.view(name);
+          return elle::Buffer(view.contents(), view.size());
+        }
+      };
+
+      template <typename T, typename A>
+      struct BinaryValue<std::vector<T, A>,
+                         std::enable_if_t<!BinaryValue<T>::dynamic>>
+      {
+        static bool constexpr dynamic = false;
+
+        static
+        void
+        encode(std::vector<T, A> const& v, BinaryEncoder& e)
+        {
+          e.number(v.size());
+          for (auto const& elt: v)
+            BinaryValue<T>::encode(elt, e);
+        }
+
+        static
+        std::vector<T, A>
+        decode(BinaryDecoder& d, BinaryDecoder::Name name)
+        {
+          int const count = d.number();
+          auto res = std::vector<T, A>{};
+          // Every element takes at least one byte: do not trust the count
+          // blindly.
+          if (count > 0)
+            res.reserve(std::min(std::size_t(count), d.left()));
+          for (int i = 0; i < count; ++i)
+            res.emplace_back(BinaryValue<T>::decode(d, name));
+          return res;
+        }
+      };
+
+      template <typename T>
+      struct BinaryValue<boost::optional<T>,
+                         std::enable_if_t<!BinaryValue<T>::dynamic>>
+      {
+        static bool constexpr dynamic = false;
+
+        static
+        void
+        encode(boost::optional<T> const& v, BinaryEncoder& e)
+        {
+          BinaryValue<bool>::encode(bool(v), e);
+          if (v)
+            BinaryValue<T>::encode(*v, e);
+        }
+
+        static
+        boost::optional<T>
+        decode(BinaryDecoder& d, BinaryDecoder::Name name)
+        {
+          auto res = boost::optional<T>{};
+          if (BinaryValue<bool>::decode(d, name))
+            res.emplace(BinaryValue<T>::decode(d, name));
+          return res;
+        }
+      };
+
+      template <typename T>
+      struct BinaryValue<T, std::enable_if_t<das_serialized<T>(0)>>
+      {
+        static bool constexpr dynamic = false;
+        using Codec =
+          BinaryCodec<T, typename serialization::Serialize<T>::Model>;
+
+        static
+        void
+        encode(T const& v, BinaryEncoder& e)
+        {
+          Codec::_encode(v, e);
+        }
+
+        static
+        T
+        decode(BinaryDecoder& d, BinaryDecoder::Name)
+        {
+          return Codec::_decode(d);
+        }
+      };
+    }
+
+    /// Encode and decode objects to binary with code generated from their
+    /// model at compile time.
+    ///
+    /// The output is the same as elle::das::Serializer over a
+    /// serialization::binary::SerializerOut, byte for byte, but fields are
+    /// encoded inline instead of through the virtual Serializer interface.
+    ///
+    /// Integers, booleans, doubles, strings, buffers, and std::vector and
+    /// boost::optional thereof are encoded statically, as are objects
+    /// serialized with das. Any other field, e.g. a polymorphic pointer,
+    /// falls back to the serializer.
+    ///
+    /// \code{.cc}
+    ///
+    /// using Codec = elle::das::BinaryCodec<Device>;
+    /// auto const buffer = Codec::encode(Device{42, "towel"});
+    /// assert(buffer == elle::serialization::binary::serialize(
+    ///                    Device{42, "towel"}));
+    /// auto const device = Codec::decode(buffer);
+    ///
+    /// \endcode
+    template <typename O, typename M>
+    struct BinaryCodec
+    {
+      /// Encode @a o with @a s.
+      ///
+      /// @pre @a s writes to a buffer.
+      static
+      void
+      encode(O const& o, serialization::binary::SerializerOut& s)
+      {
+        _details::BinaryEncoder e(s);
+        _encode(o, e);
+      }
+
+      /// Encode @a o as a complete binary serialization.
+      static
+      elle::Buffer
+      encode(O const& o, bool versioned = true)
+      {
+        auto res = elle::Buffer{};
+        {
+          serialization::binary::SerializerOut s(res, versioned);
+          encode(o, s);
+        }
+        return res;
+      }
+
+      /// Decode an O from @a s.
+      ///
+      /// @pre @a s reads from memory.
+      static
+      O
+      decode(serialization::binary::SerializerIn& s)
+      {
+        _details::BinaryDecoder d(s);
+        auto res = _decode(d);
+        d.sync();
+        return res;
+      }
+
+      /// Decode an O from a complete binary serialization.
+      static
+      O
+      decode(elle::ConstWeakBuffer input, bool versioned = true)
+      {
+        serialization::binary::SerializerIn s(input, versioned);
+        return decode(s);
+      }
+
+    private:
+      template <typename F>
+      using Field = _details::BinaryValue<
+        typename M::template FieldType<F>::type>;
+
+      template <typename F, typename Enable = void>
+      struct Encode
+      {
+        using type = int;
+        static
+        int
+        value(O const& o, _details::BinaryEncoder& e)
+        {
+          e.serializer().serialize(F::name(), M::template FieldType<F>::get(o));
+          return 0;
+        }
+      };
+
+      template <typename F>
+      struct Encode<F, std::enable_if_t<!Field<F>::dynamic>>
+      {
+        using type = int;
+        static
+        int
+        value(O const& o, _details::BinaryEncoder& e)
+        {
+          Field<F>::encode(M::template FieldType<F>::get(o), e);
+          return 0;
+        }
+      };
+
+      template <typename F, typename Enable = void>
+      struct Decode
+      {
+        using type = typename M::template FieldType<F>::type;
+        static
+        type
+        value(_details::BinaryDecoder& d)
+        {
+          d.sync();
+          auto res = d.serializer().template deserialize<type>(F::name());
+          d.resume();
+          return res;
+        }
+      };
+
+      template <typename F>
+      struct Decode<F, std::enable_if_t<!Field<F>::dynamic>>
+      {
+        using type = typename M::template FieldType<F>::type;
+        static
+        type
+        value(_details::BinaryDecoder& d)
+        {
+          return Field<F>::decode(d, &F::name);
+        }
+      };
+
+      template <typename F>
+      struct DecodeAssign
+      {
+        using type = bool;
+        static
+        bool
+        value(_details::BinaryDecoder& d, O& o)
+        {
+          F::attr_get(o) = Decode<F>::value(d);
+          return false;
+        }
+      };
+
+      static
+      void
+      _encode(O const& o, _details::BinaryEncoder& e)
+      {
+        M::Fields::template map<Encode>::value(o, e);
+      }
+
+      /// Decode by constructor.
+      template <typename MM = M>
+      static
+      std::enable_if_t<
+        MM::Types::template apply<std::is_constructible, O>::value, O>
+      _decode(_details::BinaryDecoder& d)
+      {
+        return std::forward_tuple(
+          [] (auto&& ... args) -> O
+          {
+            return O(std::move(args)...);
+          },
+          M::Fields::template map<Decode>::value(d));
+      }
+
+      /// Decode via default construct and fields assignment.
+      template <typename MM = M>
+      static
+      std::enable_if_t<
+        !MM::Types::template apply<std::is_constructible, O>::value, O>
+      _decode(_details::BinaryDecoder& d)
+      {
+        O res;
+        M::Fields::template map<DecodeAssign>::value(d, res);
+        return res;
+      }
+
+      template <typename T, typename E>
+      friend struct _details::BinaryValue;
+    };
+  }
+}
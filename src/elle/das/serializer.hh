@@ -29,6 +29,8 @@ namespace elle
     template <typename O, typename M = typename DefaultModel<O>::type>
     struct Serializer
     {
+      using Model = M;
+
       template <typename T>
       struct Serialize
       {
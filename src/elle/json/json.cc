@@ -1,4 +1,14 @@
-#include <json_spirit/reader.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <locale>
+#include <sstream>
+
+#if defined __SSE2__ && (defined __GNUC__ || defined __clang__)
+# define ELLE_JSON_SSE2
+# include <emmintrin.h>
+#endif
+
 #include <json_spirit/value.h>
 #include <json_spirit/writer.h>
 
@@ -20,44 +30,506 @@ namespace elle
 
     namespace
     {
-      Json
-      from_spirit(json_spirit::Value const& value)
+      bool
+      is_space(int c)
+      {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+      }
+
+      /// Characters that end a run of plain string contents.
+      bool
+      is_special(int c)
+      {
+        return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+      }
+
+      /*--------.
+      | Sources |
+      `--------*/
+
+      /// Characters read from contiguous memory, scanned 16 bytes at a time
+      /// where possible.
+      class BufferSource
       {
-        switch (value.type())
+      public:
+        BufferSource(char const* begin, char const* end)
+          : _begin(begin)
+          , _current(begin)
+          , _end(end)
+        {}
+
+        int
+        peek() const
+        {
+          return this->_current < this->_end ?
+            static_cast<unsigned char>(*this->_current) : EOF;
+        }
+
+        int
+        get()
+        {
+          return this->_current < this->_end ?
+            static_cast<unsigned char>(*this->_current++) : EOF;
+        }
+
+        std::size_t
+        offset() const
+        {
+          return this->_current - this->_begin;
+        }
+
+        void
+        skip_whitespace()
         {
-          case json_spirit::Value::OBJECT_TYPE:
+#ifdef ELLE_JSON_SSE2
+          auto const space = _mm_set1_epi8(' ');
+          auto const tab = _mm_set1_epi8('\t');
+          auto const nl = _mm_set1_epi8('\n');
+          auto const cr = _mm_set1_epi8('\r');
+          while (this->_end - this->_current >= 16)
           {
-            auto res = Object{};
-            for (auto const& element: value.getObject())
+            auto const chunk = _mm_loadu_si128(
+              reinterpret_cast<__m128i const*>(this->_current));
+            auto const blank = _mm_or_si128(
+              _mm_or_si128(_mm_cmpeq_epi8(chunk, space),
+                           _mm_cmpeq_epi8(chunk, tab)),
+              _mm_or_si128(_mm_cmpeq_epi8(chunk, nl),
+                           _mm_cmpeq_epi8(chunk, cr)));
+            auto const mask = ~_mm_movemask_epi8(blank) & 0xffff;
+            if (mask)
             {
-              // Enforce evulation order.
-              auto key = Config::get_name(element);
-              auto value = from_spirit(Config::get_value(element));
-              res.emplace(key, value);
+              this->_current += __builtin_ctz(mask);
+              return;
             }
-            return res;
+            this->_current += 16;
           }
-          case json_spirit::Value::ARRAY_TYPE:
+#endif
+          while (this->_current < this->_end && is_space(*this->_current))
+            ++this->_current;
+        }
+
+        /// Append characters up to the next quote, backslash or control
+        /// character.
+        void
+        scan_string(std::string& output)
+        {
+          auto const start = this->_current;
+#ifdef ELLE_JSON_SSE2
+          auto const quote = _mm_set1_epi8('"');
+          auto const backslash = _mm_set1_epi8('\\');
+          auto const control = _mm_set1_epi8(0x1f);
+          while (this->_end - this->_current >= 16)
           {
-            auto res = Array{};
-            for (auto const& element: value.getArray())
-              res.emplace_back(from_spirit(element));
-            return res;
+            auto const chunk = _mm_loadu_si128(
+              reinterpret_cast<__m128i const*>(this->_current));
+            auto const special = _mm_or_si128(
+              _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                           _mm_cmpeq_epi8(chunk, backslash)),
+              // Unsigned chunk <= 0x1f.
+              _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+            auto const mask = _mm_movemask_epi8(special);
+            if (mask)
+            {
+              this->_current += __builtin_ctz(mask);
+              output.append(start, this->_current);
+              return;
+            }
+            this->_current += 16;
           }
-          case json_spirit::Value::STRING_TYPE:
-            return value.getString();
-          case json_spirit::Value::BOOL_TYPE:
-            return value.getBool();
-          case json_spirit::Value::INT_TYPE:
-            return value.getInt64();
-          case json_spirit::Value::REAL_TYPE:
-            return value.getReal();
-          case json_spirit::Value::NULL_TYPE:
-            return NullType();
-          default:
-            ELLE_ABORT("unknown JSON value type");
+#endif
+          while (this->_current < this->_end && !is_special(*this->_current))
+            ++this->_current;
+          output.append(start, this->_current);
         }
-      }
+
+      private:
+        char const* _begin;
+        char const* _current;
+        char const* _end;
+      };
+
+      /// Characters read from a stream buffer, one at a time so the stream
+      /// is left right after the JSON value.
+      class StreamSource
+      {
+      public:
+        StreamSource(std::streambuf& buffer)
+          : _buffer(buffer)
+          , _offset(0)
+        {}
+
+        int
+        peek()
+        {
+          return this->_buffer.sgetc();
+        }
+
+        int
+        get()
+        {
+          auto const res = this->_buffer.sbumpc();
+          if (res != EOF)
+            ++this->_offset;
+          return res;
+        }
+
+        std::size_t
+        offset() const
+        {
+          return this->_offset;
+        }
+
+        void
+        skip_whitespace()
+        {
+          int c;
+          while ((c = this->peek()) != EOF && is_space(c))
+            this->get();
+        }
+
+        void
+        scan_string(std::string& output)
+        {
+          int c;
+          while ((c = this->peek()) != EOF && !is_special(c))
+          {
+            output += static_cast<char>(c);
+            this->get();
+          }
+        }
+
+      private:
+        std::streambuf& _buffer;
+        std::size_t _offset;
+      };
+
+      /*-------.
+      | Parser |
+      `-------*/
+
+      /// Recursive descent parser building the Json tree straight from the
+      /// source, without intermediate representation.
+      ///
+      /// Integers are read as int64_t (or uint64_t values reinterpreted as
+      /// such when they overflow), other numbers as double. When a key is
+      /// duplicated, the last value is kept. Trailing commas are accepted.
+      template <typename Source>
+      class Parser
+      {
+      public:
+        Parser(Source& source)
+          : _source(source)
+          , _depth(0)
+        {}
+
+        Json
+        value()
+        {
+          this->_source.skip_whitespace();
+          switch (this->_source.peek())
+          {
+            case '{':
+              return this->_object();
+            case '[':
+              return this->_array();
+            case '"':
+            {
+              auto res = std::string{};
+              this->_string(res);
+              return res;
+            }
+            case 't':
+              this->_literal("true");
+              return true;
+            case 'f':
+              this->_literal("false");
+              return false;
+            case 'n':
+              this->_literal("null");
+              return NullType();
+            case '-': case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+              return this->_number();
+            case EOF:
+              this->_error("unexpected end of input");
+            default:
+              this->_error("unexpected character");
+          }
+        }
+
+      private:
+        /// Maximum nesting of arrays and objects.
+        static int constexpr max_depth = 1024;
+
+        ELLE_COMPILER_ATTRIBUTE_NORETURN
+        void
+        _error(std::string const& what)
+        {
+          throw ParseError(elle::sprintf("JSON error at offset %s: %s",
+                                         this->_source.offset(), what));
+        }
+
+        void
+        _expect(char c)
+        {
+          if (this->_source.get() != c)
+            this->_error(elle::sprintf("expected '%c'", c));
+        }
+
+        void
+        _enter()
+        {
+          if (++this->_depth > max_depth)
+            this->_error("nesting too deep");
+        }
+
+        Json
+        _object()
+        {
+          this->_enter();
+          this->_source.get();
+          auto res = Object{};
+          this->_source.skip_whitespace();
+          if (this->_source.peek() == '}')
+            this->_source.get();
+          else
+            while (true)
+            {
+              this->_source.skip_whitespace();
+              // Like json_spirit, tolerate a trailing comma.
+              if (this->_source.peek() == '}' && !res.empty())
+              {
+                this->_source.get();
+                break;
+              }
+              if (this->_source.peek() != '"')
+                this->_error("expected object key");
+              auto key = std::string{};
+              this->_string(key);
+              this->_source.skip_whitespace();
+              this->_expect(':');
+              auto value = this->value();
+              res[std::move(key)] = std::move(value);
+              this->_source.skip_whitespace();
+              auto const c = this->_source.get();
+              if (c == '}')
+                break;
+              else if (c != ',')
+                this->_error("expected ',' or '}'");
+            }
+          --this->_depth;
+          return res;
+        }
+
+        Json
+        _array()
+        {
+          this->_enter();
+          this->_source.get();
+          auto res = Array{};
+          this->_source.skip_whitespace();
+          if (this->_source.peek() == ']')
+            this->_source.get();
+          else
+            while (true)
+            {
+              this->_source.skip_whitespace();
+              if (this->_source.peek() == ']' && !res.empty())
+              {
+                this->_source.get();
+                break;
+              }
+              res.emplace_back(this->value());
+              this->_source.skip_whitespace();
+              auto const c = this->_source.get();
+              if (c == ']')
+                break;
+              else if (c != ',')
+                this->_error("expected ',' or ']'");
+            }
+          --this->_depth;
+          return res;
+        }
+
+        void
+        _string(std::string& res)
+        {
+          this->_source.get();
+          while (true)
+          {
+            this->_source.scan_string(res);
+            auto const c = this->_source.get();
+            if (c == '"')
+              return;
+            else if (c == '\\')
+              this->_escape(res);
+            else if (c == EOF)
+              this->_error("unterminated string");
+            else
+              this->_error("control character in string");
+          }
+        }
+
+        void
+        _escape(std::string& res)
+        {
+          switch (auto const c = this->_source.get())
+          {
+            case '"': case '\\': case '/':
+              res += static_cast<char>(c);
+              return;
+            case 'b':
+              res += '\b';
+              return;
+            case 'f':
+              res += '\f';
+              return;
+            case 'n':
+              res += '\n';
+              return;
+            case 'r':
+              res += '\r';
+              return;
+            case 't':
+              res += '\t';
+              return;
+            case 'u':
+            {
+              auto code = this->_hex();
+              if (code >= 0xd800 && code < 0xdc00)
+              {
+                this->_expect('\\');
+                this->_expect('u');
+                auto const low = this->_hex();
+                if (low < 0xdc00 || low >= 0xe000)
+                  this->_error("invalid UTF-16 surrogate pair");
+                code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+              }
+              else if (code >= 0xdc00 && code < 0xe000)
+                this->_error("invalid UTF-16 surrogate pair");
+              utf8(res, code);
+              return;
+            }
+            default:
+              this->_error("invalid escape sequence");
+          }
+        }
+
+        uint32_t
+        _hex()
+        {
+          auto res = uint32_t(0);
+          for (int i = 0; i < 4; ++i)
+          {
+            auto const c = this->_source.get();
+            res <<= 4;
+            if (c >= '0' && c <= '9')
+              res |= c - '0';
+            else if (c >= 'a' && c <= 'f')
+              res |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+              res |= c - 'A' + 10;
+            else
+              this->_error("invalid unicode escape");
+          }
+          return res;
+        }
+
+        void
+        _literal(char const* literal)
+        {
+          for (; *literal; ++literal)
+            if (this->_source.get() != *literal)
+              this->_error("invalid literal");
+        }
+
+        Json
+        _number()
+        {
+          auto& text = this->_number_text;
+          text.clear();
+          auto integral = true;
+          auto digits = [&]
+            {
+              auto const size = text.size();
+              int c;
+              while ((c = this->_source.peek()) >= '0' && c <= '9')
+                text += static_cast<char>(this->_source.get());
+              if (text.size() == size)
+                this->_error("invalid number");
+            };
+          if (this->_source.peek() == '-')
+            text += static_cast<char>(this->_source.get());
+          digits();
+          if (this->_source.peek() == '.')
+          {
+            integral = false;
+            text += static_cast<char>(this->_source.get());
+            digits();
+          }
+          if (this->_source.peek() == 'e' || this->_source.peek() == 'E')
+          {
+            integral = false;
+            text += static_cast<char>(this->_source.get());
+            if (this->_source.peek() == '+' || this->_source.peek() == '-')
+              text += static_cast<char>(this->_source.get());
+            digits();
+          }
+          if (integral)
+          {
+            errno = 0;
+            auto const res = std::strtoll(text.c_str(), nullptr, 10);
+            if (errno != ERANGE)
+              return int64_t(res);
+            if (text[0] != '-')
+            {
+              errno = 0;
+              auto const ures = std::strtoull(text.c_str(), nullptr, 10);
+              if (errno != ERANGE)
+                return static_cast<int64_t>(ures);
+            }
+          }
+          // std::strtod honors the global locale's decimal separator.
+          std::istringstream input(text);
+          input.imbue(std::locale::classic());
+          auto res = 0.;
+          input >> res;
+          if (input.fail())
+            this->_error(elle::sprintf("invalid number: %s", text));
+          return res;
+        }
+
+        static
+        void
+        utf8(std::string& res, uint32_t code)
+        {
+          if (code < 0x80)
+            res += static_cast<char>(code);
+          else if (code < 0x800)
+          {
+            res += static_cast<char>(0xc0 | (code >> 6));
+            res += static_cast<char>(0x80 | (code & 0x3f));
+          }
+          else if (code < 0x10000)
+          {
+            res += static_cast<char>(0xe0 | (code >> 12));
+            res += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            res += static_cast<char>(0x80 | (code & 0x3f));
+          }
+          else
+          {
+            res += static_cast<char>(0xf0 | (code >> 18));
+            res += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+            res += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            res += static_cast<char>(0x80 | (code & 0x3f));
+          }
+        }
+
+        Source& _source;
+        int _depth;
+        /// Reused buffer for number literals.
+        std::string _number_text;
+      };
 
       json_spirit::Value
       to_spirit(Json const& any)
@@ -66,7 +538,7 @@ namespace elle
         if (any.type() == typeid(OrderedObject))
         {
           auto res = Config::Object_type{};
-          for (auto const& element: boost::any_cast<OrderedObject>(any))
+          for (auto const& element: boost::any_cast<OrderedObject const&>(any))
           {
             auto key = element.first;
             auto value = to_spirit(element.second);
@@ -77,7 +549,7 @@ namespace elle
         else if (any.type() == typeid(Object))
         {
           auto res = Config::Object_type{};
-          for (auto const& element: boost::any_cast<Object>(any))
+          for (auto const& element: boost::any_cast<Object const&>(any))
           {
             auto key = element.first;
             auto value = to_spirit(element.second);
@@ -88,7 +560,7 @@ namespace elle
         else if (any.type() == typeid(Array))
         {
           auto res = Config::Array_type{};
-          for (auto const& element: boost::any_cast<Array>(any))
+          for (auto const& element: boost::any_cast<Array const&>(any))
             res.emplace_back(to_spirit(element));
           return res;
         }
@@ -136,21 +608,22 @@ namespace elle
     read(std::istream& stream)
     {
       ELLE_TRACE_SCOPE("read json from stream");
-      json_spirit::Value value;
-      if (!json_spirit::read(stream, value))
-        throw ParseError(elle::sprintf("JSON error"));
-      return from_spirit(value);
+      auto source = StreamSource(*stream.rdbuf());
+      return Parser<StreamSource>(source).value();
     }
 
     Json
     read(std::string const& json)
     {
-      std::stringstream s(json);
-      auto res = read(s);
+      ELLE_TRACE_SCOPE("read json from string");
+      auto source = BufferSource(json.data(), json.data() + json.size());
+      auto res = Parser<BufferSource>(source).value();
+      source.skip_whitespace();
+      if (source.peek() != EOF)
       {
-        std::string word;
-        if (s >> word)
-          elle::err("garbage at end of JSON value: %s", word);
+        auto const rest = json.substr(source.offset());
+        elle::err("garbage at end of JSON value: %s",
+                  rest.substr(0, rest.find_first_of(" \t\n\r")));
       }
       return res;
     }
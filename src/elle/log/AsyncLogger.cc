@@ -0,0 +1,390 @@
+#include <elle/log/AsyncLogger.hh>
+
+#include <exception>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <elle/Exception.hh>
+#include <elle/assert.hh>
+#include <elle/compiler.hh>
+#include <elle/log/Send.hh>
+#include <elle/printf.hh>
+#include <elle/unreachable.hh>
+
+namespace elle
+{
+  namespace log
+  {
+    /*------.
+    | Queue |
+    `------*/
+
+    struct AsyncLogger::Record
+    {
+      Level level;
+      Type type;
+      std::string component;
+      Time time;
+      std::string message;
+      Tags tags;
+      int indentation;
+      std::string file;
+      unsigned int line;
+      std::string function;
+      /// Component width of the producing logger when pushed.
+      unsigned int component_max_size;
+    };
+
+    /// Bounded multiple producers, single consumer queue.
+    ///
+    /// Each cell carries a sequence number telling whether it is ready to be
+    /// written by the producer claiming that position, or read by the
+    /// consumer. Producers only contend on the tail index.
+    class AsyncLogger::Queue
+    {
+    public:
+      Queue(std::size_t capacity)
+        : _mask(_round(capacity) - 1)
+        , _cells(new Cell[this->_mask + 1])
+        , _tail(0)
+        , _head(0)
+      {
+        for (std::size_t i = 0; i <= this->_mask; ++i)
+          this->_cells[i].sequence.store(i, std::memory_order_relaxed);
+      }
+
+      /// Push a record, unless the queue is full.
+      bool
+      push(Record& record)
+      {
+        auto pos = this->_tail.load(std::memory_order_relaxed);
+        while (true)
+        {
+          auto& cell = this->_cells[pos & this->_mask];
+          auto const seq = cell.sequence.load(std::memory_order_acquire);
+          auto const diff = static_cast<std::intptr_t>(seq - pos);
+          if (diff == 0)
+          {
+            if (this->_tail.compare_exchange_weak(
+                  pos, pos + 1, std::memory_order_relaxed))
+            {
+              cell.record = std::move(record);
+              cell.sequence.store(pos + 1, std::memory_order_release);
+              return true;
+            }
+          }
+          else if (diff < 0)
+            return false;
+          else
+            pos = this->_tail.load(std::memory_order_relaxed);
+        }
+      }
+
+      /// Pop a record, if any. Must only be called by the consumer.
+      bool
+      pop(Record& record)
+      {
+        auto& cell = this->_cells[this->_head & this->_mask];
+        if (cell.sequence.load(std::memory_order_acquire) != this->_head + 1)
+          return false;
+        record = std::move(cell.record);
+        cell.sequence.store(this->_head + this->_mask + 1,
+                            std::memory_order_release);
+        ++this->_head;
+        return true;
+      }
+
+      std::size_t
+      capacity() const
+      {
+        return this->_mask + 1;
+      }
+
+    private:
+      static
+      std::size_t
+      _round(std::size_t capacity)
+      {
+        auto res = std::size_t(2);
+        while (res < capacity)
+          res *= 2;
+        return res;
+      }
+
+      struct Cell
+      {
+        std::atomic<std::size_t> sequence;
+        Record record;
+      };
+      std::size_t _mask;
+      std::unique_ptr<Cell[]> _cells;
+      std::atomic<std::size_t> _tail;
+      /// Consumer position, only accessed by the consumer.
+      std::size_t _head;
+    };
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    namespace
+    {
+      std::terminate_handler&
+      previous_terminate()
+      {
+        static std::terminate_handler res = nullptr;
+        return res;
+      }
+
+      /// Do not lose the last words of a dying process.
+      void
+      flush_and_terminate()
+      {
+        try
+        {
+          elle::log::flush();
+        }
+        catch (...)
+        {}
+        if (auto previous = previous_terminate())
+          previous();
+        std::abort();
+      }
+    }
+
+    std::size_t const AsyncLogger::default_capacity = 1 << 14;
+
+    AsyncLogger::AsyncLogger(std::unique_ptr<Logger> target,
+                             std::string const& log_level,
+                             std::size_t capacity,
+                             Overflow overflow)
+      : Super(log_level)
+      , _target(std::move(target))
+      , _overflow(overflow)
+      , _queue(std::make_unique<Queue>(capacity))
+      , _pushed(0)
+      , _written(0)
+      , _dropped(0)
+      , _failed(0)
+      , _error()
+      , _sleeping(false)
+      , _stopping(false)
+    {
+      ELLE_ASSERT(this->_target);
+      this->_concurrent = true;
+      this->_target->buffered(true);
+      static auto const installed = []
+        {
+          previous_terminate() = std::set_terminate(&flush_and_terminate);
+          return true;
+        }();
+      (void) installed;
+      this->_writer = std::thread([this] { this->_write(); });
+    }
+
+    AsyncLogger::~AsyncLogger()
+    {
+      this->_stopping = true;
+      this->_wake();
+      this->_writer.join();
+    }
+
+    /*----------.
+    | Messaging |
+    `----------*/
+
+    std::size_t
+    AsyncLogger::dropped() const
+    {
+      return this->_dropped.load();
+    }
+
+    std::size_t
+    AsyncLogger::written() const
+    {
+      return this->_written.load();
+    }
+
+    std::size_t
+    AsyncLogger::failed() const
+    {
+      return this->_failed.load();
+    }
+
+    void
+    AsyncLogger::_message(Level level,
+                          elle::log::Logger::Type type,
+                          std::string const& component,
+                          Time const& time,
+                          std::string const& message,
+                          Tags const& tags,
+                          int indentation,
+                          std::string const& file,
+                          unsigned int line,
+                          std::string const& function)
+    {
+      auto record = Record{
+        level, type, component, time, message, tags, indentation,
+        file, line, function, this->component_max_size()};
+      while (!this->_queue->push(record))
+      {
+        if (this->_overflow == Overflow::drop)
+        {
+          ++this->_dropped;
+          return;
+        }
+        this->_wake();
+        std::this_thread::yield();
+      }
+      ++this->_pushed;
+      if (this->_sleeping.load())
+        this->_wake();
+    }
+
+    void
+    AsyncLogger::_flush()
+    {
+      // The writer would wait for itself, e.g. when terminating because of
+      // the target: flush what is written already.
+      if (std::this_thread::get_id() == this->_writer.get_id())
+      {
+        this->_target->_flush();
+        return;
+      }
+      auto const target = this->_pushed.load();
+      this->_wake();
+      auto lock = std::unique_lock<std::mutex>(this->_mutex);
+      this->_progress.wait(
+        lock, [&] { return this->_written.load() >= target; });
+    }
+
+    /*-------.
+    | Writer |
+    `-------*/
+
+    void
+    AsyncLogger::_wake()
+    {
+      auto lock = std::unique_lock<std::mutex>(this->_mutex);
+      this->_available.notify_one();
+    }
+
+    void
+    AsyncLogger::_emit(Level level,
+                       Type type,
+                       std::string const& component,
+                       Time const& time,
+                       std::string const& message,
+                       Tags const& tags,
+                       int indentation,
+                       std::string const& file,
+                       unsigned int line,
+                       std::string const& function,
+                       unsigned int component_max_size)
+    {
+      auto& target = *this->_target;
+      target._component_max_size =
+        std::max(target._component_max_size.load(), component_max_size);
+      try
+      {
+        target._message(level, type, component, time, message, tags,
+                        indentation, file, line, function);
+      }
+      catch (...)
+      {
+        // Escaping the writer thread would terminate the process.
+        ++this->_failed;
+        this->_error = elle::exception_string();
+      }
+    }
+
+    void
+    AsyncLogger::_write()
+    {
+      auto record = Record{};
+      auto popped = std::size_t(0);
+      auto reported = std::size_t(0);
+      auto reported_failed = std::size_t(0);
+      while (true)
+      {
+        auto batch = std::size_t(0);
+        while (batch < this->_queue->capacity() && this->_queue->pop(record))
+        {
+          this->_emit(record.level, record.type, record.component,
+                      record.time, record.message, record.tags,
+                      record.indentation, record.file, record.line,
+                      record.function, record.component_max_size);
+          ++batch;
+        }
+        popped += batch;
+        auto const dropped = this->_dropped.load();
+        if (dropped != reported)
+        {
+          static auto const component = std::string("elle.log.AsyncLogger");
+          this->_emit(
+            Level::log, Type::warning, component,
+            boost::posix_time::microsec_clock::local_time(),
+            elle::sprintf("dropped %s records, queue is full",
+                          dropped - reported),
+            {}, 0, __FILE__, __LINE__, ELLE_COMPILER_PRETTY_FUNCTION,
+            component.size());
+          reported = dropped;
+        }
+        auto const failed = this->_failed.load();
+        if (failed != reported_failed)
+        {
+          static auto const component = std::string("elle.log.AsyncLogger");
+          this->_emit(
+            Level::log, Type::error, component,
+            boost::posix_time::microsec_clock::local_time(),
+            elle::sprintf("failed to write %s records: %s",
+                          failed - reported_failed, this->_error),
+            {}, 0, __FILE__, __LINE__, ELLE_COMPILER_PRETTY_FUNCTION,
+            component.size());
+          // Not to report again if the target failed on the report itself.
+          reported_failed = this->_failed.load();
+        }
+        if (batch)
+        {
+          try
+          {
+            this->_target->_flush();
+          }
+          catch (...)
+          {
+            // Records are written, only not flushed yet: the next batch
+            // will try again.
+          }
+          {
+            auto lock = std::unique_lock<std::mutex>(this->_mutex);
+            this->_written += batch;
+          }
+          this->_progress.notify_all();
+          continue;
+        }
+        auto lock = std::unique_lock<std::mutex>(this->_mutex);
+        if (this->_stopping)
+          break;
+        // Producers check this flag after pushing: raise it, then check for
+        // records pushed meanwhile before sleeping.
+        this->_sleeping = true;
+        if (this->_pushed.load() == popped)
+          this->_available.wait_for(lock, std::chrono::milliseconds(100));
+        this->_sleeping = false;
+      }
+    }
+
+    std::ostream&
+    operator <<(std::ostream& output, AsyncLogger::Overflow overflow)
+    {
+      switch (overflow)
+      {
+      case AsyncLogger::Overflow::block:
+        return output << "block";
+      case AsyncLogger::Overflow::drop:
+        return output << "drop";
+      }
+      elle::unreachable();
+    }
+  }
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <elle/log/Logger.hh>
+
+namespace elle
+{
+  namespace log
+  {
+    /// Logger handing messages over to another one in a background thread.
+    ///
+    /// Producers push formatted records in a bounded lock-free queue and
+    /// return immediately. A single writer thread feeds them to the target
+    /// logger in batches, flushing it once per batch instead of once per
+    /// message. Levels are those of the AsyncLogger, the target's are not
+    /// consulted.
+    ///
+    /// @code{.cc}
+    ///
+    /// elle::log::logger(
+    ///   std::make_unique<elle::log::AsyncLogger>(
+    ///     std::make_unique<elle::log::TextLogger>(std::cerr)));
+    ///
+    /// @endcode
+    class ELLE_API AsyncLogger
+      : public Logger
+    {
+    /*------.
+    | Types |
+    `------*/
+    public:
+      using Self = AsyncLogger;
+      using Super = Logger;
+      /// What to do with records when the queue is full.
+      enum class Overflow
+      {
+        /// Wait for the writer to make room.
+        block,
+        /// Drop the record and count it.
+        drop,
+      };
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// Create an asynchronous logger.
+      ///
+      /// @param target    Logger to write records with.
+      /// @param log_level Levels specification, like $ELLE_LOG_LEVEL.
+      /// @param capacity  Queue size, rounded up to a power of two.
+      /// @param overflow  Policy when the queue is full.
+      AsyncLogger(std::unique_ptr<Logger> target,
+                  std::string const& log_level = "",
+                  std::size_t capacity = default_capacity,
+                  Overflow overflow = Overflow::block);
+      /// Write out pending records and stop the writer.
+      ~AsyncLogger();
+      /// Default queue size.
+      static std::size_t const default_capacity;
+
+    /*----------.
+    | Messaging |
+    `----------*/
+    public:
+      /// Number of records dropped because the queue was full.
+      std::size_t
+      dropped() const;
+      /// Number of records handed to the target.
+      std::size_t
+      written() const;
+      /// Number of records the target threw on, counted as written.
+      std::size_t
+      failed() const;
+      ELLE_ATTRIBUTE_R(std::unique_ptr<Logger>, target);
+      ELLE_ATTRIBUTE_R(Overflow, overflow);
+    protected:
+      void
+      _message(Level level,
+               elle::log::Logger::Type type,
+               std::string const& component,
+               Time const& time,
+               std::string const& message,
+               Tags const& tags,
+               int indentation,
+               std::string const& file,
+               unsigned int line,
+               std::string const& function) override;
+      /// Wait until all records pushed so far are written and flushed.
+      void
+      _flush() override;
+
+    /*-------.
+    | Writer |
+    `-------*/
+    private:
+      struct Record;
+      class Queue;
+      void
+      _write();
+      /// Hand a record to the target.
+      void
+      _emit(Level level,
+            Type type,
+            std::string const& component,
+            Time const& time,
+            std::string const& message,
+            Tags const& tags,
+            int indentation,
+            std::string const& file,
+            unsigned int line,
+            std::string const& function,
+            unsigned int component_max_size);
+      /// Wake the writer up if it sleeps.
+      void
+      _wake();
+      ELLE_ATTRIBUTE(std::unique_ptr<Queue>, queue);
+      ELLE_ATTRIBUTE(std::atomic<std::size_t>, pushed);
+      ELLE_ATTRIBUTE(std::atomic<std::size_t>, written);
+      ELLE_ATTRIBUTE(std::atomic<std::size_t>, dropped);
+      ELLE_ATTRIBUTE(std::atomic<std::size_t>, failed);
+      /// Last error thrown by the target, only accessed by the writer.
+      ELLE_ATTRIBUTE(std::string, error);
+      ELLE_ATTRIBUTE(std::atomic<bool>, sleeping);
+      ELLE_ATTRIBUTE(std::atomic<bool>, stopping);
+      ELLE_ATTRIBUTE(std::mutex, mutex);
+      /// Signaled when records are available or the logger stops.
+      ELLE_ATTRIBUTE(std::condition_variable, available);
+      /// Signaled when a batch is written.
+      ELLE_ATTRIBUTE(std::condition_variable, progress);
+      ELLE_ATTRIBUTE(std::thread, writer);
+    };
+
+    ELLE_API
+    std::ostream&
+    operator <<(std::ostream& output, AsyncLogger::Overflow overflow);
+  }
+}
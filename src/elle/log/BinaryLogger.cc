@@ -0,0 +1,279 @@
+#include <elle/log/BinaryLogger.hh>
+
+#include <cstring>
+#include <ostream>
+#include <set>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <elle/err.hh>
+
+namespace elle
+{
+  namespace log
+  {
+    namespace
+    {
+      auto const epoch =
+        boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1));
+
+      // Not elle::serialization's numbers: they log, and a logger must not.
+      void
+      write_number(elle::Buffer& output, uint64_t n)
+      {
+        elle::Buffer::Byte bytes[10];
+        auto size = 0;
+        do
+        {
+          bytes[size] = n & 0x7f;
+          n >>= 7;
+          if (n)
+            bytes[size] |= 0x80;
+          ++size;
+        }
+        while (n);
+        output.append(bytes, size);
+      }
+
+      void
+      write_bytes(elle::Buffer& output, std::string const& s)
+      {
+        write_number(output, s.size());
+        output.append(s.data(), s.size());
+      }
+
+      /// Thrown when reaching the end of the log amid a record.
+      struct Truncated
+      {};
+    }
+
+    /*-------.
+    | Writer |
+    `-------*/
+
+    std::string const BinaryLogger::magic("ELLELOG\x01", 8);
+    std::size_t const BinaryLogger::max_strings = 1 << 16;
+
+    BinaryLogger::BinaryLogger(std::ostream& out,
+                               std::string const& log_level)
+      : Logger(log_level)
+      , _output(out)
+      , _strings()
+      , _definitions()
+      , _record()
+    {
+      this->time_universal(true);
+      this->time_microsec(true);
+      this->_output.write(magic.data(), magic.size());
+    }
+
+    void
+    BinaryLogger::_string(std::string const& s)
+    {
+      auto it = this->_strings.find(s);
+      if (it == this->_strings.end())
+      {
+        if (this->_strings.size() >= max_strings)
+        {
+          write_number(this->_record, 0);
+          write_bytes(this->_record, s);
+          return;
+        }
+        it = this->_strings.emplace(s, this->_strings.size() + 1).first;
+        this->_definitions.append("s", 1);
+        write_number(this->_definitions, it->second);
+        write_bytes(this->_definitions, s);
+      }
+      write_number(this->_record, it->second);
+    }
+
+    void
+    BinaryLogger::_message(Level level,
+                           elle::log::Logger::Type type,
+                           std::string const& component,
+                           Time const& time,
+                           std::string const& message,
+                           Tags const& tags,
+                           int indentation,
+                           std::string const& file,
+                           unsigned int line,
+                           std::string const& function)
+    {
+      this->_definitions.reset();
+      this->_record.reset();
+      this->_record.append("m", 1);
+      write_number(this->_record, static_cast<uint64_t>(level));
+      write_number(this->_record, static_cast<uint64_t>(type));
+      this->_string(component);
+      write_number(this->_record, (time - epoch).total_microseconds());
+      write_number(this->_record, indentation);
+      write_number(this->_record, tags.size());
+      for (auto const& tag: tags)
+      {
+        this->_string(tag.first);
+        this->_string(tag.second);
+      }
+      this->_string(file);
+      write_number(this->_record, line);
+      this->_string(function);
+      write_bytes(this->_record, message);
+      this->_output.write(
+        reinterpret_cast<char const*>(this->_definitions.contents()),
+        this->_definitions.size());
+      this->_output.write(
+        reinterpret_cast<char const*>(this->_record.contents()),
+        this->_record.size());
+      if (!this->buffered())
+        this->_output.flush();
+    }
+
+    void
+    BinaryLogger::_flush()
+    {
+      this->_output.flush();
+    }
+
+    /*-------.
+    | Reader |
+    `-------*/
+
+    BinaryLogReader::BinaryLogReader(elle::ConstWeakBuffer data)
+      : _data(data)
+      , _position(data.contents())
+      , _strings(1)
+    {
+      auto const& magic = BinaryLogger::magic;
+      if (data.size() < magic.size() ||
+          std::memcmp(data.contents(), magic.data(), magic.size()))
+        elle::err("not a binary log");
+      this->_position += magic.size();
+    }
+
+    uint64_t
+    BinaryLogReader::_number()
+    {
+      auto const end = this->_data.contents() + this->_data.size();
+      uint64_t res = 0;
+      for (auto shift = 0; ; shift += 7)
+      {
+        if (this->_position == end)
+          throw Truncated();
+        if (shift >= 64)
+          elle::err("invalid number in binary log");
+        auto const c = *this->_position++;
+        res |= uint64_t(c & 0x7f) << shift;
+        if (!(c & 0x80))
+          return res;
+      }
+    }
+
+    std::string
+    BinaryLogReader::_bytes()
+    {
+      auto const size = this->_number();
+      auto const end = this->_data.contents() + this->_data.size();
+      if (size > uint64_t(end - this->_position))
+        throw Truncated();
+      auto res = std::string(
+        reinterpret_cast<char const*>(this->_position), size);
+      this->_position += size;
+      return res;
+    }
+
+    std::string
+    BinaryLogReader::_string()
+    {
+      auto const id = this->_number();
+      if (id == 0)
+        return this->_bytes();
+      if (id >= this->_strings.size())
+        elle::err("undefined string %s in binary log", id);
+      return this->_strings[id];
+    }
+
+    bool
+    BinaryLogReader::next(Record& record)
+    {
+      auto const end = this->_data.contents() + this->_data.size();
+      try
+      {
+        while (this->_position != end)
+        {
+          auto const kind = *this->_position++;
+          if (kind == 's')
+          {
+            auto const id = this->_number();
+            auto s = this->_bytes();
+            if (id != this->_strings.size())
+              elle::err("unexpected string %s in binary log, expected %s",
+                        id, this->_strings.size());
+            this->_strings.emplace_back(std::move(s));
+          }
+          else if (kind == 'm')
+          {
+            auto const level = this->_number();
+            if (level > static_cast<uint64_t>(Logger::Level::dump))
+              elle::err("invalid level in binary log: %s", level);
+            record.level = static_cast<Logger::Level>(level);
+            auto const type = this->_number();
+            if (type > static_cast<uint64_t>(Logger::Type::error))
+              elle::err("invalid type in binary log: %s", type);
+            record.type = static_cast<Logger::Type>(type);
+            record.component = this->_string();
+            record.time =
+              epoch + boost::posix_time::microseconds(this->_number());
+            record.indentation = this->_number();
+            record.tags.resize(this->_number());
+            for (auto& tag: record.tags)
+            {
+              tag.first = this->_string();
+              tag.second = this->_string();
+            }
+            record.file = this->_string();
+            record.line = this->_number();
+            record.function = this->_string();
+            record.message = this->_bytes();
+            return true;
+          }
+          else
+            elle::err("invalid record in binary log: %s", int(kind));
+        }
+      }
+      catch (Truncated const&)
+      {
+        this->_position = end;
+      }
+      return false;
+    }
+
+    std::size_t
+    BinaryLogReader::replay(Logger& logger,
+                            boost::posix_time::ptime begin,
+                            boost::posix_time::ptime end)
+    {
+      auto const position = this->_position;
+      auto const strings = this->_strings.size();
+      auto record = Record{};
+      // Go through the whole log once first, so components are aligned on
+      // the widest displayed one from the start.
+      auto seen = std::set<std::pair<std::string, Logger::Level>>{};
+      while (this->next(record))
+        if (seen.emplace(record.component, record.level).second)
+          logger.component_is_active(record.component, record.level);
+      this->_position = position;
+      this->_strings.resize(strings);
+      auto res = std::size_t(0);
+      while (this->next(record))
+        if (begin <= record.time && record.time < end &&
+            logger.component_is_active(record.component, record.level))
+        {
+          logger._message(record.level, record.type, record.component,
+                          record.time, record.message, record.tags,
+                          record.indentation, record.file, record.line,
+                          record.function);
+          ++res;
+        }
+      return res;
+    }
+  }
+}
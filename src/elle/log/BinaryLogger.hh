@@ -0,0 +1,129 @@
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <elle/Buffer.hh>
+#include <elle/log/Logger.hh>
+
+namespace elle
+{
+  namespace log
+  {
+    /// Logger writing compact binary records, to be rendered offline.
+    ///
+    /// Components, tags, file and function names are interned: each distinct
+    /// string is written once and referred to by a number afterwards. Times
+    /// are written as microseconds since the epoch, in universal time, and no
+    /// text rendering whatsoever happens when logging.
+    ///
+    /// The stream starts with a magic header and carries two kinds of
+    /// records, all numbers being unsigned LEB128:
+    ///
+    /// - `s` id size bytes: define string `id`.
+    /// - `m` level type component time indentation tags-count
+    ///       (tag-name tag-value)* file line function size bytes: a message.
+    ///
+    /// String references are ids, or 0 followed by size and bytes for strings
+    /// not interned because the table is full.
+    ///
+    /// @see BinaryLogReader to read records back.
+    class ELLE_API BinaryLogger
+      : public Logger
+    {
+    public:
+      /// Create a binary logger.
+      ///
+      /// @param out       Stream to write records to.
+      /// @param log_level Levels specification, like $ELLE_LOG_LEVEL.
+      BinaryLogger(std::ostream& out,
+                   std::string const& log_level = "");
+      /// The magic header starting binary logs.
+      static std::string const magic;
+      /// The maximum number of interned strings.
+      static std::size_t const max_strings;
+    protected:
+      void
+      _message(Level level,
+               elle::log::Logger::Type type,
+               std::string const& component,
+               Time const& time,
+               std::string const& message,
+               Tags const& tags,
+               int indentation,
+               std::string const& file,
+               unsigned int line,
+               std::string const& function) override;
+      void
+      _flush() override;
+    private:
+      /// Append a reference to @a s to the record, defining it if needed.
+      void
+      _string(std::string const& s);
+      ELLE_ATTRIBUTE_R(std::ostream&, output);
+      ELLE_ATTRIBUTE(
+        (std::unordered_map<std::string, std::size_t>), strings);
+      /// String definitions preceding the record being built.
+      ELLE_ATTRIBUTE(elle::Buffer, definitions);
+      ELLE_ATTRIBUTE(elle::Buffer, record);
+    };
+
+    /// Reader of BinaryLogger records.
+    ///
+    /// Works on memory, typically a mapped file, which must outlive the
+    /// reader.
+    class ELLE_API BinaryLogReader
+    {
+    public:
+      using Tags = std::vector<std::pair<std::string, std::string>>;
+      /// A decoded message.
+      struct Record
+      {
+        Logger::Level level;
+        Logger::Type type;
+        std::string component;
+        boost::posix_time::ptime time;
+        int indentation;
+        Tags tags;
+        std::string file;
+        unsigned int line;
+        std::string function;
+        std::string message;
+      };
+
+      /// Start reading @a data.
+      ///
+      /// @throw elle::Error if @a data is not a binary log.
+      BinaryLogReader(elle::ConstWeakBuffer data);
+      /// Read the next record.
+      ///
+      /// @returns Whether a record was read, false at the end of the log.
+      /// @throw elle::Error if the log is corrupted. A log truncated in the
+      ///        middle of a record, by a crash for instance, is not an error.
+      bool
+      next(Record& record);
+      /// Feed records within [@a begin, @a end) to @a logger, filtered by its
+      /// levels specification, contexts aside.
+      ///
+      /// @returns The number of records fed.
+      std::size_t
+      replay(Logger& logger,
+             boost::posix_time::ptime begin = boost::posix_time::min_date_time,
+             boost::posix_time::ptime end = boost::posix_time::max_date_time);
+    private:
+      uint64_t
+      _number();
+      std::string
+      _bytes();
+      std::string
+      _string();
+      ELLE_ATTRIBUTE(elle::ConstWeakBuffer, data);
+      ELLE_ATTRIBUTE(elle::Buffer::Byte const*, position);
+      /// Strings defined so far, by id. Id 0 is reserved.
+      ELLE_ATTRIBUTE(std::vector<std::string>, strings);
+    };
+  }
+}
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <elle/log/CompositeLogger.hh>
 
 namespace elle
@@ -20,16 +22,36 @@ namespace elle
                unsigned int line,
                std::string const& function)
     {
-      /* We bounce to message and not _message so that each child logger can
-         have its own settings.
-         We must reproduce Send's behavior regarding indent and categories.
+      /* Forward the record as captured by the caller, which may have been on
+         another thread, e.g. for an AsyncLogger: we must not take the time,
+         tags or indentation of the current thread.
+         Each child logger keeps its own levels. Context filters however
+         depend on the component stack of the caller, so they cannot be
+         evaluated here: contextual components are let through.
       */
-      for (auto& l: _loggers)
+      for (auto& l: this->_loggers)
       {
-        l->indentation() = indentation + 1;
-        l->component_level(component); // for max size computation
-        l->message(level, type, component, message, file, line, function);
+        if (!l->component_is_contextual(component) &&
+            !l->component_is_active(component, level))
+          continue;
+        l->_component_max_size =
+          std::max({l->_component_max_size.load(),
+                    this->_component_max_size.load(),
+                    static_cast<unsigned int>(component.size())});
+        l->buffered(this->buffered());
+        auto lock = l->_concurrent
+          ? std::unique_lock<std::recursive_mutex>()
+          : std::unique_lock<std::recursive_mutex>(l->_mutex);
+        l->_message(level, type, component, time, message, tags,
+                    indentation, file, line, function);
       }
     }
+
+    void
+    CompositeLogger::_flush()
+    {
+      for (auto& l: _loggers)
+        l->flush();
+    }
   }
 }
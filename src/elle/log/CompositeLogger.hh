@@ -24,6 +24,8 @@ namespace elle
                std::string const& file,
                unsigned int line,
                std::string const& function) override;
+      void
+      _flush() override;
     };
   }
 }
@@ -20,6 +20,7 @@
 #include <elle/Plugin.hh>
 #include <elle/assert.hh>
 #include <elle/log/Logger.hh>
+#include <elle/log/Send.hh>
 #include <elle/os/environ.hh>
 #include <elle/printf.hh>
 #include <elle/system/getpid.hh>
@@ -119,6 +120,8 @@ namespace elle
       : _indentation(std::make_unique<PlainIndentation>())
       , _time_universal(false)
       , _time_microsec(false)
+      , _buffered(false)
+      , _concurrent(false)
       , _component_max_size(0)
     {
       this->_setup_indentation();
@@ -128,7 +131,7 @@ namespace elle
       );
       auto levels = elle::os::getenv("ELLE_LOG_LEVEL", log_level);
       if (!levels.empty())
-        this->_setup_levels(levels);
+        this->levels(levels);
     }
 
     Logger::~Logger()
@@ -153,10 +156,11 @@ namespace elle
     }
 
     void
-    Logger::_setup_levels(std::string const& levels)
+    Logger::levels(std::string const& levels)
     {
       using tokenizer = boost::tokenizer<boost::char_separator<char>>;
       auto sep = boost::char_separator<char>{","};
+      auto patterns = std::vector<Filter>{};
       for (auto& level: tokenizer{levels, sep})
       {
         static auto re =
@@ -171,14 +175,20 @@ namespace elle
 
         auto m = std::smatch{};
         if (std::regex_match(level, m, re))
-          this->_component_patterns
-            .emplace_back(m[1],
-                          m[2].length() ? m[2].str() : "*",
-                          parse_level(m[3]));
+          patterns.emplace_back(m[1],
+                                m[2].length() ? m[2].str() : "*",
+                                parse_level(m[3]));
         else
           throw elle::Exception(
             elle::sprintf("invalid level specification: %s", level));
       }
+      std::lock_guard<std::recursive_mutex> lock(_mutex);
+      this->_component_patterns = std::move(patterns);
+      this->_component_levels.clear();
+      this->_levels = levels;
+      // Bump while still holding the lock, so call sites that observe the
+      // new generation are bound to compute their level with new filters.
+      detail::invalidate();
     }
 
     /*----------.
@@ -194,11 +204,22 @@ namespace elle
                     unsigned int line,
                     std::string const& function)
     {
-      std::lock_guard<std::recursive_mutex> lock(_mutex);
-
-      if (!this->component_is_active(component, level))
-        return;
+      if (this->component_is_active(component, level))
+        this->_send(level, type, component, msg, file, line, function);
+    }
 
+    void
+    Logger::_send(Level level,
+                  elle::log::Logger::Type type,
+                  std::string const& component,
+                  std::string const& msg,
+                  std::string const& file,
+                  unsigned int line,
+                  std::string const& function)
+    {
+      auto lock = this->_concurrent
+        ? std::unique_lock<std::recursive_mutex>()
+        : std::unique_lock<std::recursive_mutex>(this->_mutex);
       int indent = this->indentation();
       auto tags = Tags{};
       for (auto const& tag: elle::Plugin<Tag>::plugins())
@@ -220,12 +241,26 @@ namespace elle
           level, Type::error, component, time,
           elle::sprintf("negative indentation level on log: %s", msg),
           tags, 0, file, line, function);
+        this->flush();
         std::abort();
       }
       this->_message(level, type, component, time, msg, tags,
                      indent - 1, file, line, function);
     }
 
+    void
+    Logger::flush()
+    {
+      auto lock = this->_concurrent
+        ? std::unique_lock<std::recursive_mutex>()
+        : std::unique_lock<std::recursive_mutex>(this->_mutex);
+      this->_flush();
+    }
+
+    void
+    Logger::_flush()
+    {}
+
     /*--------.
     | Enabled |
     `--------*/
@@ -277,11 +312,29 @@ namespace elle
       // Update the max width of displayed component names.
       if (res)
         this->_component_max_size =
-          std::max(this->_component_max_size,
+          std::max(this->_component_max_size.load(),
                    static_cast<unsigned int>(name.size()));
       return res;
     }
 
+    unsigned int
+    Logger::component_max_size() const
+    {
+      return this->_component_max_size.load();
+    }
+
+    bool
+    Logger::component_is_contextual(std::string const& name)
+    {
+      std::lock_guard<std::recursive_mutex> lock(_mutex);
+      using boost::algorithm::any_of;
+      return any_of(this->_component_patterns,
+                    [&] (Filter const& filter)
+                    {
+                      return !filter.context.empty() && filter.match(name);
+                    });
+    }
+
     Logger::Level
     Logger::component_level(std::string const& name)
     {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -94,10 +95,6 @@ namespace elle
       void
       _setup_indentation();
 
-      /// Process a string formatted like $ELLE_LOG_LEVEL.
-      void
-      _setup_levels(std::string const& levels);
-
     /*------------.
     | Indentation |
     `------------*/
@@ -129,6 +126,22 @@ namespace elle
                    std::string const& file,
                    unsigned int line,
                    std::string const& function);
+      /// Write out messages held by the sink, if any.
+      void
+      flush();
+      /// Whether the sink may hold messages until flush() instead of writing
+      /// them out one by one.
+      ELLE_ATTRIBUTE_RW(bool, buffered);
+    private:
+      /// Emit a message whose component is known to be active.
+      void
+      _send(Level level,
+            elle::log::Logger::Type type,
+            std::string const& component,
+            std::string const& message,
+            std::string const& file,
+            unsigned int line,
+            std::string const& function);
     protected:
       using Tags = std::vector<std::pair<std::string, std::string>>;
       using Time = boost::posix_time::ptime;
@@ -144,17 +157,36 @@ namespace elle
                std::string const& file,
                unsigned int line,
                std::string const& function) = 0;
+      virtual
+      void
+      _flush();
+      /// Whether _message is safe to call concurrently, in which case it is
+      /// not serialized by the logger mutex.
+      bool _concurrent;
+      friend class AsyncLogger;
+      friend class BinaryLogReader;
       friend class CompositeLogger;
 
     /*-----------.
     | Components |
     `-----------*/
     public:
+      /// Replace the level specification, formatted like $ELLE_LOG_LEVEL.
+      ///
+      /// Takes effect immediately on every call site, in every thread.
+      void
+      levels(std::string const& levels);
+
       /// Whether participates as a context or as a component for this
       /// level.
       bool
       component_is_active(std::string const& name, Level level = Level::log);
 
+      /// Whether the level of this component depends on the component stack,
+      /// i.e., whether some context filter applies to it.
+      bool
+      component_is_contextual(std::string const& name);
+
       /// Log level in the current context of components.
       Level
       component_level(std::string const& name);
@@ -213,11 +245,19 @@ namespace elle
 
       /// Translation of $ELLE_LOG_LEVEL into ordered filters.
       std::vector<Filter> _component_patterns;
+      /// The specification _component_patterns stem from.
+      ELLE_ATTRIBUTE_R(std::string, levels);
       /// A cache of the decoding of $ELLE_LOG_LEVEL: component-name
       /// => Level.  Filled only for unconditional levels (i.e., when
       /// $ELLE_LOG_LEVEL uses no context specification).
       std::unordered_map<std::string, Level> _component_levels;
-      ELLE_ATTRIBUTE_R(unsigned int, component_max_size);
+    public:
+      /// Width of the longest active component name so far.
+      unsigned int
+      component_max_size() const;
+    private:
+      /// Read by sinks without the logger mutex.
+      std::atomic<unsigned int> _component_max_size;
       /// Nested components.
       ELLE_ATTRIBUTE_R(component_stack_t, component_stack);
     };
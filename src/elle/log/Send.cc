@@ -2,6 +2,8 @@
 #include <mutex>
 
 #include <elle/Exception.hh>
+#include <elle/log/AsyncLogger.hh>
+#include <elle/log/BinaryLogger.hh>
 #include <elle/log/Send.hh>
 #include <elle/log/SysLogger.hh>
 #include <elle/log/TextLogger.hh>
@@ -22,6 +24,14 @@ namespace elle
         return logger;
       }
 
+      /// The current logger, readable without taking log_mutex.
+      std::atomic<Logger*>&
+      _current()
+      {
+        static std::atomic<Logger*> current{nullptr};
+        return current;
+      }
+
       std::mutex&
       log_mutex()
       {
@@ -33,14 +43,24 @@ namespace elle
     Logger&
     logger()
     {
+      if (auto res = _current().load(std::memory_order_acquire))
+        return *res;
       std::unique_lock<std::mutex> ulock{log_mutex()};
 
       if (!_logger())
       {
         auto const syslog = elle::os::getenv("ELLE_LOG_SYSLOG", false);
+        auto const binary = elle::os::getenv("ELLE_LOG_BINARY", "");
         if (syslog)
           _logger() = std::make_unique<elle::log::SysLogger>(
             elle::sprintf("%s[%s]", syslog, elle::system::getpid()));
+        else if (!binary.empty())
+        {
+          static std::ofstream out{
+            binary, std::fstream::trunc | std::fstream::binary
+              | std::fstream::out};
+          _logger() = std::make_unique<elle::log::BinaryLogger>(out);
+        }
         else
         {
           auto path = elle::os::getenv("ELLE_LOG_FILE", "");
@@ -57,6 +77,18 @@ namespace elle
             _logger() = std::make_unique<elle::log::TextLogger>(out);
           }
         }
+        if (elle::os::getenv("ELLE_LOG_ASYNC", false))
+          _logger() = std::make_unique<elle::log::AsyncLogger>(
+            std::move(_logger()),
+            "",
+            elle::os::getenv(
+              "ELLE_LOG_ASYNC_CAPACITY",
+              static_cast<unsigned>(AsyncLogger::default_capacity)),
+            elle::os::getenv("ELLE_LOG_ASYNC_DROP", false)
+              ? AsyncLogger::Overflow::drop
+              : AsyncLogger::Overflow::block);
+        _current().store(_logger().get(), std::memory_order_release);
+        detail::invalidate();
       }
       return *_logger();
     }
@@ -69,11 +101,54 @@ namespace elle
         logger->_indentation = _logger()->_indentation->clone();
       auto prev = std::move(_logger());
       _logger() = std::move(logger);
+      _current().store(_logger().get(), std::memory_order_release);
+      detail::invalidate();
       return prev;
     }
 
+    void
+    flush()
+    {
+      if (auto l = _current().load(std::memory_order_acquire))
+        l->flush();
+    }
+
     namespace detail
     {
+      // Start at one so that zero-initialized sites are stale.
+      std::atomic<std::uint64_t> generation{1};
+
+      void
+      invalidate()
+      {
+        generation.fetch_add(1, std::memory_order_acq_rel);
+      }
+
+      bool
+      Site::_refresh(elle::log::Logger::Level level,
+                     elle::log::Logger::Type,
+                     char const* component)
+      {
+        // Read the generation first: should it move in between, the cache is
+        // merely refreshed once more.
+        auto const generation =
+          detail::generation.load(std::memory_order_acquire);
+        auto& l = logger();
+        auto const name = std::string(component);
+        // Once enabled, a site stays so: its scopes keep indenting and
+        // stacking their component for nested statements, and Send filters
+        // its messages against the current levels.
+        auto const enabled =
+          this->_cache.load(std::memory_order_relaxed) & 1;
+        auto const res = enabled || l.component_is_active(name, level);
+        // Contextual sites are stored at generation zero, always stale, which
+        // merely remembers whether they were enabled.
+        this->_cache.store(
+          (l.component_is_contextual(name) ? 0 : generation << 1) |
+          (res ? 1 : 0),
+          std::memory_order_relaxed);
+        return res;
+      }
 
       bool
       Send::active(elle::log::Logger::Level level,
@@ -93,6 +168,7 @@ namespace elle
                   char const* function,
                   const std::string& msg)
       {
+        // Sites stay enabled once active, check the current levels.
         logger().message(level, type, component, msg, file, line, function);
         if (indent)
           this->_indent(component);
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 #include <elle/compiler.hh>
 #include <elle/log/Logger.hh>
 #include <elle/memory.hh>
@@ -14,6 +17,10 @@ namespace elle
     ELLE_API
     std::unique_ptr<Logger>
     logger(std::unique_ptr<Logger> l);
+    /// Flush the current logger, if any. Meant to be called before dying.
+    ELLE_API
+    void
+    flush();
 
     /// Here the simplest type possible is used (.rodata-located) so
     /// as to make sure that its initialization will always take place
@@ -21,9 +28,60 @@ namespace elle
     /// logging.
     namespace detail
     {
+      /// Bumped whenever the logger or its levels change, which invalidates
+      /// every Site cache.
+      ELLE_API
+      extern std::atomic<std::uint64_t> generation;
+
+      /// Invalidate all Site caches.
+      ELLE_API
+      void
+      invalidate();
+
+      /// Per call site cache of whether it is enabled.
+      ///
+      /// Constant-initialized, so it requires neither a guard nor a lock. As
+      /// long as the generation did not move, answers from a single atomic
+      /// load. Components whose level depend on the component stack are
+      /// never cached. A site stays enabled once it was active, so that its
+      /// scopes keep indenting and stacking their component even if levels
+      /// are lowered afterwards.
+      class ELLE_API Site
+      {
+      public:
+        constexpr
+        Site()
+          : _cache(0)
+        {}
+
+        bool
+        active(elle::log::Logger::Level level,
+               elle::log::Logger::Type type,
+               char const* component)
+        {
+          auto const cache = this->_cache.load(std::memory_order_relaxed);
+          if (cache >> 1 == generation.load(std::memory_order_acquire))
+            return cache & 1;
+          else
+            return this->_refresh(level, type, component);
+        }
+
+      private:
+        bool
+        _refresh(elle::log::Logger::Level level,
+                 elle::log::Logger::Type type,
+                 char const* component);
+        /// Generation the activity was computed at, shifted left by one, and
+        /// the activity itself in the lowest bit. 64 bits so the shift never
+        /// drops a bit of any generation reachable in practice.
+        std::atomic<std::uint64_t> _cache;
+      };
+
       struct ELLE_API Send
       {
       public:
+        /// Log a message if its component is active, and indent if
+        /// requested either way.
         template <typename... Args>
         Send(elle::log::Logger::Level level,
              elle::log::Logger::Type type,
@@ -55,7 +113,7 @@ namespace elle
                            elle::log::Logger::Type type,
                            std::string const& component);
 
-      private:
+      protected:
         void _send(elle::log::Logger::Level level,
                    elle::log::Logger::Type type,
                    bool indent,
@@ -64,6 +122,7 @@ namespace elle
                    unsigned int line,
                    char const* function,
                    const std::string& msg);
+      private:
         unsigned int* _indentation = nullptr;
       };
     }
@@ -43,15 +43,16 @@ namespace elle
         catch (...)
         {
           static boost::format const error("%s:%s: invalid log: %s");
-          this->_send(Logger::Level::log,
-                      Logger::Type::error,
-                      false,
-                      "elle.log",
-                      __FILE__,
-                      __LINE__,
-                      ELLE_COMPILER_PRETTY_FUNCTION,
-                      str(boost::format(error) % file % line % fmt)
-            );
+          if (Send::active(Logger::Level::log, Logger::Type::error, "elle.log"))
+            this->_send(Logger::Level::log,
+                        Logger::Type::error,
+                        false,
+                        "elle.log",
+                        __FILE__,
+                        __LINE__,
+                        ELLE_COMPILER_PRETTY_FUNCTION,
+                        str(boost::format(error) % file % line % fmt)
+              );
           if (debug)
             throw;
         }
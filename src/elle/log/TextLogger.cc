@@ -166,17 +166,24 @@ namespace elle
         msg = elle::sprintf("%s: %s", time, msg);
 
       auto color_code = get_color_code(level, type);
-      this->_output << color_code << msg << std::endl;
+      this->_output << color_code << msg << '\n';
 
       if (lines.size() > 1)
       {
         ELLE_ASSERT_GTE(msg.size(), lines[0].size());
         auto indent = std::string(msg.size() - lines[0].size(), ' ');
         for (auto i = 1u; i < lines.size(); i++)
-          this->_output << indent << lines[i] << std::endl;
+          this->_output << indent << lines[i] << '\n';
       }
       if (!color_code.empty())
         this->_output << "[0m";
+      if (!this->buffered())
+        this->_output.flush();
+    }
+
+    void
+    TextLogger::_flush()
+    {
       this->_output.flush();
     }
   }
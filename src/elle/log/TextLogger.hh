@@ -33,6 +33,8 @@ namespace elle
                std::string const& file,
                unsigned int line,
                std::string const& function) override;
+      void
+      _flush() override;
     private:
       ELLE_ATTRIBUTE_R(std::ostream&, output);
       ELLE_ATTRIBUTE_RW(bool, display_type);
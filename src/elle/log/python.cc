@@ -51,22 +51,20 @@ public:
        std::string const& file,
        unsigned int line,
        std::string const& function,
-       std::string const& message):
-    elle::log::detail::Send(
-      level,
-      type,
-      false,
-      component,
-      file.c_str(),
-      line,
-      function.c_str(),
-      boost::algorithm::replace_all_copy(message, "%", "%%").c_str())
-  {}
+       std::string const& message)
+    : _enabled(elle::log::detail::Send::active(level, type, component))
+  {
+    // Spare formatting and indentation when inactive.
+    if (this->_enabled)
+      this->_send(level, type, false, component,
+                  file.c_str(), line, function.c_str(), message);
+  }
 
   void
   enter()
   {
-    this->_indent();
+    if (this->_enabled)
+      this->_indent();
   }
 
   void
@@ -76,6 +74,9 @@ public:
   {
     this->_unindent();
   }
+
+private:
+  bool _enabled;
 };
 
 BOOST_PYTHON_MODULE(_log)
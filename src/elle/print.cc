@@ -1,4 +1,7 @@
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
 
 // #pragma GCC diagnostic push
 // #pragma GCC diagnostic ignored "-Wdeprecated"
@@ -403,19 +406,149 @@ namespace elle
       }
     }
 
+    /*-------.
+    | Caches |
+    `-------*/
+
+    using AST = std::shared_ptr<Expression const>;
+
+    /// Beyond this many entries, formats are not cached anymore: they are
+    /// probably built dynamically.
+    static constexpr auto cache_size = 4096u;
+
+    /// The parsed @a fmt, shared by all system threads.
+    static
+    AST
+    parsed(std::string const& fmt)
+    {
+      static std::mutex mutex;
+      static auto cache = std::unordered_map<std::string, AST>{};
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto const it = cache.find(fmt);
+        if (it != cache.end())
+          return it->second;
+      }
+      // Parse outside the lock, the worst case being two threads parsing the
+      // same format concurrently.
+      auto ast = AST(parse(fmt));
+      std::lock_guard<std::mutex> lock(mutex);
+      if (cache.size() < cache_size)
+        cache.emplace(fmt, ast);
+      return ast;
+    }
+
+    /// The parsed @a fmt, looked up by address in a per system thread cache
+    /// first. Contents are checked too, in case the address was reused.
+    static
+    AST
+    parsed(char const* fmt)
+    {
+      static thread_local auto cache =
+        std::unordered_map<char const*, std::pair<std::string, AST>>{};
+      auto it = cache.find(fmt);
+      if (it != cache.end() && it->second.first == fmt)
+        return it->second.second;
+      auto ast = parsed(std::string(fmt));
+      if (it != cache.end())
+        it->second = std::make_pair(fmt, ast);
+      else if (cache.size() < cache_size)
+        cache.emplace(fmt, std::make_pair(fmt, ast));
+      return ast;
+    }
+
+    template <typename Fmt>
+    static
     void
     print(std::ostream& s,
-          std::string const& fmt,
+          Fmt const& fmt,
           std::vector<Argument> const& args,
           NamedArguments const& named)
     {
-      auto const ast = _details::parse(fmt);
+      // Hold the format: printing arguments may format too, and update the
+      // caches.
+      auto const ast = parsed(fmt);
       int count = 0;
       bool full_positional = true;
       _details::print(s, *ast, args, count, true, named, full_positional);
       if (full_positional && count < signed(args.size()))
         elle::err("too many arguments for format: %s", fmt);
     }
+
+    void
+    print(std::ostream& s,
+          std::string const& fmt,
+          std::vector<Argument> const& args,
+          NamedArguments const& named)
+    {
+      print<std::string>(s, fmt, args, named);
+    }
+
+    void
+    print(std::ostream& s,
+          char const* fmt,
+          std::vector<Argument> const& args,
+          NamedArguments const& named)
+    {
+      print<char const*>(s, fmt, args, named);
+    }
+
+    /*--------.
+    | Buffers |
+    `--------*/
+
+    /// Print to a per system thread stream, reused across calls to avoid
+    /// allocating a stream and its buffer every time. Printing an argument
+    /// may format too, hence one stream per nesting level.
+    template <typename Fmt>
+    static
+    std::string
+    format(Fmt const& fmt,
+           std::vector<Argument> const& args,
+           NamedArguments const& named)
+    {
+      static thread_local auto streams =
+        std::vector<std::unique_ptr<std::ostringstream>>{};
+      static thread_local auto depth = 0u;
+      if (depth == streams.size())
+        streams.emplace_back(std::make_unique<std::ostringstream>());
+      auto& s = *streams[depth];
+      // Not elle::SafeFinally, which logs, thus formats.
+      struct Pop
+      {
+        ~Pop()
+        {
+          --depth;
+        }
+      } pop;
+      ++depth;
+      // Restore a pristine stream, keeping the buffer.
+      s.str(std::string());
+      s.clear();
+      s.flags(std::ios_base::dec | std::ios_base::skipws);
+      s.precision(6);
+      s.width(0);
+      s.fill(' ');
+      repr(s, false);
+      print(s, fmt, args, named);
+      return s.str();
+    }
+
+    std::string
+    format(std::string const& fmt,
+           std::vector<Argument> const& args,
+           NamedArguments const& named)
+    {
+      return format<std::string>(fmt, args, named);
+    }
+
+    std::string
+    format(char const* fmt,
+           std::vector<Argument> const& args,
+           NamedArguments const& named)
+    {
+      return format<char const*>(fmt, args, named);
+    }
   }
 
 
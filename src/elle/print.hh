@@ -14,6 +14,13 @@ namespace elle
   void
   print(std::ostream& o, std::string const& fmt, Args&& ... args);
 
+  /// Print a formatted string literal to a given stream.
+  ///
+  /// Same as above, with the parsed format cached by address.
+  template <typename ... Args>
+  void
+  print(std::ostream& o, char const* fmt, Args&& ... args);
+
   /// Return a formatted string.
   ///
   /// @param fmt The un-formatted string specifying how to format and interpret
@@ -24,6 +31,13 @@ namespace elle
   std::string
   print(std::string const& fmt, Args&& ... args);
 
+  /// Return a formatted string literal.
+  ///
+  /// Same as above, with the parsed format cached by address.
+  template <typename ... Args>
+  std::string
+  print(char const* fmt, Args&& ... args);
+
   /// Whether a stream is set for debugging output.
   ///
   /// Armed with `%r` in print's format.
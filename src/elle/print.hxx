@@ -224,12 +224,38 @@ namespace elle
       }
     };
 
+    /// Print @a args to @a s according to @a fmt.
+    ///
+    /// Formats are parsed once per process and cached.
     void
     print(std::ostream& s,
           std::string const& fmt,
           std::vector<Argument> const& args,
           NamedArguments const& named);
 
+    /// Print @a args to @a s according to @a fmt.
+    ///
+    /// @a fmt is expected to be a string literal: besides the process-wide
+    /// cache, its parsed form is cached per system thread by address, saving
+    /// a lookup by contents.
+    void
+    print(std::ostream& s,
+          char const* fmt,
+          std::vector<Argument> const& args,
+          NamedArguments const& named);
+
+    /// Format @a args according to @a fmt in a reusable buffer.
+    std::string
+    format(std::string const& fmt,
+           std::vector<Argument> const& args,
+           NamedArguments const& named);
+
+    /// Format @a args according to @a fmt in a reusable buffer.
+    std::string
+    format(char const* fmt,
+           std::vector<Argument> const& args,
+           NamedArguments const& named);
+
     template <typename ... Args>
     std::vector <Argument>
     erasure(Args const& ... args)
@@ -252,13 +278,25 @@ namespace elle
     _details::print(o, fmt, _details::erasure(args...), {});
   }
 
+  template <typename ... Args>
+  void
+  print(std::ostream& o, char const* fmt, Args&& ... args)
+  {
+    _details::print(o, fmt, _details::erasure(args...), {});
+  }
+
   template <typename ... Args>
   std::string
   print(std::string const& fmt, Args&& ... args)
   {
-    std::stringstream output;
-    print(output, fmt, std::forward<Args>(args)...);
-    return output.str();
+    return _details::format(fmt, _details::erasure(args...), {});
+  }
+
+  template <typename ... Args>
+  std::string
+  print(char const* fmt, Args&& ... args)
+  {
+    return _details::format(fmt, _details::erasure(args...), {});
   }
 
   /*------.
@@ -279,8 +317,23 @@ namespace elle
   print(std::string const& fmt,
         _details::NamedArguments const& args)
   {
-    std::stringstream output;
-    print(output, fmt, args);
-    return output.str();
+    return _details::format(fmt, {}, args);
+  }
+
+  inline
+  void
+  print(std::ostream& o,
+        char const* fmt,
+        _details::NamedArguments const& args)
+  {
+    _details::print(o, fmt, {}, args);
+  }
+
+  inline
+  std::string
+  print(char const* fmt,
+        _details::NamedArguments const& args)
+  {
+    return _details::format(fmt, {}, args);
   }
 }
@@ -0,0 +1,136 @@
+#include <elle/protocol/CRC32C.hh>
+
+#include <array>
+#include <cstring>
+
+#if defined __x86_64__ && (defined __GNUC__ || defined __clang__)
+# define ELLE_PROTOCOL_CRC32C_SSE42
+# include <nmmintrin.h>
+#endif
+
+namespace elle
+{
+  namespace protocol
+  {
+    namespace
+    {
+      /// Reversed Castagnoli polynomial.
+      constexpr uint32_t polynomial = 0x82f63b78;
+
+      using Table = std::array<std::array<uint32_t, 256>, 8>;
+
+      /// Slicing-by-8 lookup tables.
+      Table const&
+      table()
+      {
+        static auto const res = []
+          {
+            auto res = Table{};
+            for (auto i = 0u; i < 256; ++i)
+            {
+              auto crc = i;
+              for (int j = 0; j < 8; ++j)
+                crc = crc & 1 ? (crc >> 1) ^ polynomial : crc >> 1;
+              res[0][i] = crc;
+            }
+            for (auto i = 0u; i < 256; ++i)
+              for (auto t = 1u; t < 8; ++t)
+                res[t][i] =
+                  (res[t - 1][i] >> 8) ^ res[0][res[t - 1][i] & 0xff];
+            return res;
+          }();
+        return res;
+      }
+
+      uint32_t
+      software(uint32_t crc, uint8_t const* data, std::size_t size)
+      {
+        auto const& t = table();
+        for (; size >= 8; size -= 8, data += 8)
+        {
+          uint32_t low;
+          uint32_t high;
+          std::memcpy(&low, data, 4);
+          std::memcpy(&high, data + 4, 4);
+#if defined __BYTE_ORDER__ && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+          low = __builtin_bswap32(low);
+          high = __builtin_bswap32(high);
+#endif
+          low ^= crc;
+          crc =
+            t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff] ^
+            t[5][(low >> 16) & 0xff] ^ t[4][low >> 24] ^
+            t[3][high & 0xff] ^ t[2][(high >> 8) & 0xff] ^
+            t[1][(high >> 16) & 0xff] ^ t[0][high >> 24];
+        }
+        for (; size; --size, ++data)
+          crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xff];
+        return crc;
+      }
+
+#ifdef ELLE_PROTOCOL_CRC32C_SSE42
+      __attribute__((target("sse4.2")))
+      uint32_t
+      sse42(uint32_t crc, uint8_t const* data, std::size_t size)
+      {
+        uint64_t crc64 = crc;
+        for (; size >= 8; size -= 8, data += 8)
+        {
+          uint64_t word;
+          std::memcpy(&word, data, 8);
+          crc64 = _mm_crc32_u64(crc64, word);
+        }
+        crc = static_cast<uint32_t>(crc64);
+        for (; size; --size, ++data)
+          crc = _mm_crc32_u8(crc, *data);
+        return crc;
+      }
+#endif
+
+      using Implementation = uint32_t (*)(uint32_t, uint8_t const*, std::size_t);
+
+      Implementation
+      implementation()
+      {
+#ifdef ELLE_PROTOCOL_CRC32C_SSE42
+        static auto const res =
+          __builtin_cpu_supports("sse4.2") ? &sse42 : &software;
+        return res;
+#else
+        return &software;
+#endif
+      }
+    }
+
+    CRC32C::CRC32C()
+      : _state(0xffffffff)
+    {}
+
+    void
+    CRC32C::update(elle::ConstWeakBuffer data)
+    {
+      this->_state =
+        implementation()(this->_state, data.contents(), data.size());
+    }
+
+    uint32_t
+    CRC32C::value() const
+    {
+      return ~this->_state;
+    }
+
+    bool
+    CRC32C::hardware()
+    {
+      return implementation() != &software;
+    }
+
+    uint32_t
+    crc32c(elle::ConstWeakBuffer data)
+    {
+      auto res = CRC32C{};
+      res.update(data);
+      return res.value();
+    }
+  }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+#include <elle/Buffer.hh>
+#include <elle/attribute.hh>
+#include <elle/compiler.hh>
+
+namespace elle
+{
+  namespace protocol
+  {
+    /// Incremental CRC-32C (Castagnoli) checksum.
+    ///
+    /// A cheap integrity check for data going over the wire, not a
+    /// cryptographic digest. Uses the SSE4.2 crc32 instruction when the CPU
+    /// supports it.
+    ///
+    /// @code{.cc}
+    ///
+    /// auto crc = elle::protocol::CRC32C{};
+    /// crc.update(elle::ConstWeakBuffer("1234"));
+    /// crc.update(elle::ConstWeakBuffer("56789"));
+    /// assert(crc.value() == 0xe3069283);
+    ///
+    /// @endcode
+    class ELLE_API CRC32C
+    {
+    public:
+      /// Start a new checksum.
+      CRC32C();
+      /// Account for more data.
+      void
+      update(elle::ConstWeakBuffer data);
+      /// The checksum of all the data so far.
+      uint32_t
+      value() const;
+      /// Whether the hardware implementation is used.
+      static
+      bool
+      hardware();
+    private:
+      ELLE_ATTRIBUTE(uint32_t, state);
+    };
+
+    /// The CRC-32C of a buffer.
+    ELLE_API
+    uint32_t
+    crc32c(elle::ConstWeakBuffer data);
+  }
+}
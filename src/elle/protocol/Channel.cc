@@ -3,6 +3,7 @@
 #include <elle/algorithm.hh>
 #include <elle/log.hh>
 #include <elle/protocol/ChanneledStream.hh>
+#include <elle/reactor/scheduler.hh>
 
 ELLE_LOG_COMPONENT("elle.protocol.Channel");
 
@@ -18,6 +19,9 @@ namespace elle
       : Super(backend.scheduler())
       , _backend(backend)
       , _id(id)
+      , _credit(ChanneledStream::window)
+      , _consumed(0)
+      , _unread(0)
     {
       ELLE_DEBUG_SCOPE("%s: open %s", this->_backend, *this);
       ELLE_ASSERT(!elle::contains(this->_backend._channels, this->_id));
@@ -39,6 +43,10 @@ namespace elle
       , _id(source._id)
       , _packets(std::move(source._packets))
       , _available(std::move(source._available))
+      , _credit(source._credit)
+      , _credited(std::move(source._credited))
+      , _consumed(source._consumed)
+      , _unread(source._unread)
     {
       source._id = 0;
       ELLE_ASSERT(elle::contains(this->_backend._channels, this->_id));
@@ -63,6 +71,8 @@ namespace elle
                      this->_available.waiters().size());
         ELLE_ASSERT(elle::contains(this->_backend._channels, this->_id));
         this->_backend._channels.erase(this->_id);
+        // Whatever we will never read must not hold the peer back.
+        this->_backend._grant(this->_id, this->_consumed + this->_unread);
       }
     }
 
@@ -94,7 +104,10 @@ namespace elle
     elle::Buffer
     Channel::_read()
     {
-      return this->_packets.get();
+      auto packet = this->_packets.get();
+      this->_unread -= packet.size();
+      this->_backend._consumed(*this, packet.size());
+      return packet;
     }
 
     /*--------.
@@ -104,6 +117,23 @@ namespace elle
     void
     Channel::_write(elle::Buffer const& packet)
     {
+      if (this->_backend._flow_control())
+      {
+        // Also report a failure to grant credit, which the peer would be
+        // stuck on.
+        if (auto e = this->_backend._exception)
+          std::rethrow_exception(e);
+        while (this->_credit <= 0)
+        {
+          ELLE_DEBUG("%s: wait for credit", this);
+          elle::reactor::wait(this->_credited);
+          if (auto e = this->_backend._exception)
+            std::rethrow_exception(e);
+        }
+        // A packet larger than the remaining credit still goes through, so
+        // any size can be sent; the following ones wait.
+        this->_credit -= packet.size();
+      }
       this->_backend._write(packet, this->_id);
     }
   }
@@ -106,6 +106,14 @@ namespace elle
       ELLE_ATTRIBUTE_R(Id, id);
       ELLE_ATTRIBUTE(reactor::Channel<elle::Buffer>, packets);
       ELLE_ATTRIBUTE(elle::reactor::Signal, available);
+      /// Bytes we may still send before the peer grants more.
+      ELLE_ATTRIBUTE(int64_t, credit);
+      /// Signaled when the peer grants credit, or the stream fails.
+      ELLE_ATTRIBUTE(elle::reactor::Signal, credited);
+      /// Bytes read but not granted back to the peer yet.
+      ELLE_ATTRIBUTE(elle::Buffer::Size, consumed);
+      /// Bytes received but not read yet.
+      ELLE_ATTRIBUTE(elle::Buffer::Size, unread);
     };
   }
 }
@@ -17,6 +17,20 @@ namespace elle
 {
   namespace protocol
   {
+    namespace
+    {
+      /// What follows the channel id, from version 0.5.0.
+      enum Frame: unsigned char
+      {
+        /// A packet.
+        data = 0,
+        /// A number of bytes the peer may send again on the channel.
+        credit = 1,
+      };
+    }
+
+    elle::Buffer::Size const ChanneledStream::window = 4 << 20;
+
     /*-------------.
     | Construction |
     `-------------*/
@@ -32,6 +46,11 @@ namespace elle
       this->_thread.reset(
         new reactor::Thread(
           elle::sprintf("%s", this), [this] { this->_read_thread(); }));
+      if (this->_flow_control())
+        this->_granter.reset(
+          new reactor::Thread(
+            elle::sprintf("%s granter", this),
+            [this] { this->_grant_thread(); }));
     }
 
     ChanneledStream::ChanneledStream(Stream& backend)
@@ -43,6 +62,12 @@ namespace elle
       try
       {
         this->_thread->terminate_now();
+        if (this->_granter)
+        {
+          this->_granter->terminate_now();
+          // Channels closed from now on have no peer left to grant to.
+          this->_granter.reset();
+        }
       }
       catch (...)
       {
@@ -60,21 +85,46 @@ namespace elle
         while (true)
         {
           auto p = this->_backend.read();
+          // Strip the header in place, without moving the payload.
           int channel_id = this->uint32_get(p, this->version());
-          // FIXME: The size of the packet isn't adjusted. This is cosmetic
-          // though.
+          if (this->_flow_control())
+          {
+            if (p.size() < 1)
+              elle::err("missing frame type on channel %s", channel_id);
+            auto const frame = p[0];
+            p.pop_front(1);
+            if (frame == Frame::credit)
+            {
+              auto const granted = this->uint32_get(p, this->version());
+              if (auto it = elle::find(this->_channels, channel_id))
+              {
+                ELLE_DEBUG("%s granted %s bytes", *it->second, granted);
+                it->second->_credit += granted;
+                it->second->_credited.signal();
+              }
+              continue;
+            }
+            else if (frame != Frame::data)
+              elle::err("invalid frame type on channel %s: %s",
+                        channel_id, int(frame));
+          }
           if (auto it = elle::find(this->_channels, channel_id))
           {
             ELLE_DEBUG("received %f on channel %s", p, *it->second);
+            it->second->_unread += p.size();
             it->second->_packets.put(std::move(p));
           }
           else if (this->_master && channel_id > 0
                    || !this->_master && channel_id < 0)
+          {
             ELLE_TRACE("discard orphaned packet on channel %s", channel_id);
+            this->_grant(channel_id, p.size());
+          }
           else
           {
             auto res = Channel(*this, channel_id);
             ELLE_DEBUG("received %f on new channel %s", p, channel_id);
+            res._unread += p.size();
             res._packets.put(std::move(p));
             this->_channels_new.put(std::move(res));
           }
@@ -83,14 +133,25 @@ namespace elle
       catch (elle::Error const&)
       {
         ELLE_TRACE("%s: read failed: %s", this, elle::exception_string());
-        this->_channels_new.raise(std::current_exception());
-        this->_default._packets.raise(std::current_exception());
-        for (auto& c: this->_channels)
-          c.second->_packets.raise(std::current_exception());
-        this->_exception = std::current_exception();
+        this->_fail(std::current_exception());
       }
     }
 
+    void
+    ChanneledStream::_fail(std::exception_ptr e)
+    {
+      if (this->_exception)
+        return;
+      this->_channels_new.raise(e);
+      this->_default._packets.raise(e);
+      for (auto& c: this->_channels)
+        c.second->_packets.raise(e);
+      this->_exception = e;
+      // Wake writers waiting for credit, they will find the exception.
+      for (auto& c: this->_channels)
+        c.second->_credited.signal();
+    }
+
     bool
     ChanneledStream::_handshake()
     {
@@ -178,10 +239,75 @@ namespace elle
     {
       ELLE_TRACE_SCOPE("%s: send %f on channel %s", *this, packet, id);
 
-      auto backend_packet = elle::Buffer{};
-      this->uint32_put(backend_packet, id, this->version());
-      backend_packet.append(packet.contents(), packet.size());
-      this->_backend.write(backend_packet);
+      auto header = elle::Buffer{};
+      this->uint32_put(header, id, this->version());
+      if (this->_flow_control())
+      {
+        auto const frame = Frame::data;
+        header.append(&frame, 1);
+      }
+      this->_backend.write(header, packet);
+    }
+
+    void
+    ChanneledStream::_consumed(Channel& channel, elle::Buffer::Size size)
+    {
+      if (!this->_flow_control())
+        return;
+      channel._consumed += size;
+      if (channel._consumed < window / 2)
+        return;
+      this->_grant(channel.id(), channel._consumed);
+      channel._consumed = 0;
+    }
+
+    void
+    ChanneledStream::_grant(int id, elle::Buffer::Size size)
+    {
+      if (!this->_granter || this->_exception || size == 0)
+        return;
+      this->_grants[id] += size;
+      this->_granting.open();
+    }
+
+    void
+    ChanneledStream::_grant_thread()
+    {
+      try
+      {
+        while (true)
+        {
+          reactor::wait(this->_granting);
+          auto grants = std::move(this->_grants);
+          this->_grants.clear();
+          this->_granting.close();
+          for (auto const& grant: grants)
+          {
+            ELLE_DEBUG_SCOPE("%s: grant %s bytes on channel %s",
+                             *this, grant.second, grant.first);
+            auto frame = elle::Buffer{};
+            this->uint32_put(frame, grant.first, this->version());
+            auto const type = Frame::credit;
+            frame.append(&type, 1);
+            this->uint32_put(frame, grant.second, this->version());
+            this->_backend.write(frame);
+          }
+        }
+      }
+      catch (elle::Error const&)
+      {
+        // The peer would wait for this credit forever: report the failure
+        // to the next operation.
+        ELLE_TRACE("%s: unable to grant credit: %s",
+                   *this, elle::exception_string());
+        this->_fail(std::current_exception());
+      }
+    }
+
+    bool
+    ChanneledStream::_flow_control() const
+    {
+      return this->version() >= elle::Version(0, 5, 0);
     }
 
     /*--------.
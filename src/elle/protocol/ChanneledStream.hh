@@ -2,6 +2,8 @@
 
 #include <unordered_map>
 
+#include <elle/reactor/Barrier.hh>
+
 #include <elle/protocol/Channel.hh>
 #include <elle/protocol/Stream.hh>
 #include <elle/protocol/fwd.hh>
@@ -20,6 +22,15 @@ namespace elle
     /// the socket to communicate through the same socket. Multiplexing and
     /// demultiplexing will be transparent for the user.
     ///
+    /// The channel header is sent ahead of the payload without copying it,
+    /// and stripped in place on reception.
+    ///
+    /// From protocol version 0.5.0, every Channel has a receive window of
+    /// `window` bytes: a writer waits once it sent that much more than the
+    /// peer consumed, which bounds the packets queued in a slow Channel. The
+    /// reader grants credit back as packets are read, by half windows.
+    /// Writing on a Channel the peer closed will eventually block.
+    ///
     /// @code{.cc}
     ///
     /// // Consider two peers, connected by an arbitrary socket s.
@@ -47,6 +58,8 @@ namespace elle
       using Self = ChanneledStream;
       using Super = Stream;
       using Channels = std::unordered_map<int, Channel*>;
+      /// The receive window of every Channel, in bytes.
+      static elle::Buffer::Size const window;
 
     /*-------------.
     | Construction |
@@ -105,6 +118,27 @@ namespace elle
     private:
       void
       _write(elle::Buffer const& packet, int id);
+      /// Account for @a size bytes read from @a channel, granting credit back
+      /// to the peer every half window.
+      void
+      _consumed(Channel& channel, elle::Buffer::Size size);
+      /// Grant @a size bytes of credit back to the peer on channel @a id.
+      ///
+      /// Grants are sent by a dedicated thread, so this never blocks.
+      void
+      _grant(int id, elle::Buffer::Size size);
+      void
+      _grant_thread();
+      /// Fail every pending and future operation with @a e.
+      void
+      _fail(std::exception_ptr e);
+      /// Credit to grant, by channel id.
+      ELLE_ATTRIBUTE((std::unordered_map<int, elle::Buffer::Size>), grants);
+      ELLE_ATTRIBUTE(reactor::Barrier, granting);
+      ELLE_ATTRIBUTE(reactor::Thread::unique_ptr, granter);
+      /// Whether Channels are flow-controlled, depending on the version.
+      bool
+      _flow_control() const;
 
     /*----------.
     | Printable |
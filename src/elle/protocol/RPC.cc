@@ -1,14 +1,441 @@
+#include <unordered_map>
+#include <unordered_set>
+
+#include <elle/finally.hh>
+#include <elle/log.hh>
+
+#include <elle/reactor/Scope.hh>
 #include <elle/reactor/exception.hh>
+#include <elle/reactor/network/Error.hh>
+#include <elle/reactor/scheduler.hh>
+#include <elle/reactor/semaphore.hh>
 
+#include <elle/protocol/Channel.hh>
+#include <elle/protocol/ChanneledStream.hh>
 #include <elle/protocol/RPC.hh>
+#include <elle/protocol/exceptions.hh>
+
+ELLE_LOG_COMPONENT("elle.protocol.RPC");
 
 namespace elle
 {
   namespace protocol
   {
+    namespace
+    {
+      void
+      put(elle::Buffer& buffer, uint32_t i)
+      {
+        unsigned char const bytes[] = {
+          static_cast<unsigned char>(i),
+          static_cast<unsigned char>(i >> 8),
+          static_cast<unsigned char>(i >> 16),
+          static_cast<unsigned char>(i >> 24),
+        };
+        buffer.append(bytes, sizeof bytes);
+      }
+
+      uint32_t
+      get(elle::Buffer const& buffer, elle::Buffer::Size& offset)
+      {
+        if (buffer.size() - offset < 4)
+          elle::err<Error>("truncated RPC batch");
+        auto const bytes = buffer.contents() + offset;
+        offset += 4;
+        return
+          uint32_t(bytes[0]) |
+          uint32_t(bytes[1]) << 8 |
+          uint32_t(bytes[2]) << 16 |
+          uint32_t(bytes[3]) << 24;
+      }
+
+      /// Messages tagged with a request id, over one channel.
+      ///
+      /// Messages written during the same scheduler round are sent together
+      /// as one packet, made of (id, size, message) triplets.
+      class Batcher
+      {
+      public:
+        using Message = std::pair<uint32_t, elle::Buffer>;
+        using OnError = std::function<void (std::exception_ptr)>;
+
+        Batcher(Channel channel, OnError on_error = {})
+          : _channel(std::move(channel))
+          , _batch()
+          , _queued("RPC batch queued")
+          , _on_error(std::move(on_error))
+          , _writer(new reactor::Thread(
+                      "RPC batch writer", [this] { this->_write_thread(); }))
+        {}
+
+        ~Batcher()
+        {
+          this->_writer->terminate_now();
+        }
+
+        /// Queue @a message, to be sent with the others of this round.
+        void
+        write(uint32_t id, elle::Buffer const& message)
+        {
+          put(this->_batch, id);
+          put(this->_batch, message.size());
+          this->_batch.append(message.contents(), message.size());
+          this->_queued.open();
+        }
+
+        /// Send the queued messages now.
+        void
+        flush()
+        {
+          if (this->_batch.empty())
+            return;
+          auto batch = std::move(this->_batch);
+          this->_batch = elle::Buffer();
+          this->_queued.close();
+          ELLE_DEBUG("send batch of %s bytes", batch.size());
+          this->_channel.write(batch);
+        }
+
+        /// Read the messages of the next batch.
+        std::vector<Message>
+        read()
+        {
+          auto const batch = this->_channel.read();
+          ELLE_DEBUG("received batch of %s bytes", batch.size());
+          auto res = std::vector<Message>{};
+          auto offset = elle::Buffer::Size{0};
+          while (offset < batch.size())
+          {
+            auto const id = get(batch, offset);
+            auto const size = get(batch, offset);
+            if (batch.size() - offset < size)
+              elle::err<Error>("truncated RPC batch");
+            res.emplace_back(id, elle::Buffer(batch.contents() + offset, size));
+            offset += size;
+          }
+          return res;
+        }
+
+        /// Answer a packet that is not a batch, as sent by a synchronous
+        /// call, with a bare @a reply.
+        void
+        reject(elle::Buffer const& reply)
+        {
+          this->_channel.write(reply);
+        }
+
+      private:
+        void
+        _write_thread()
+        {
+          try
+          {
+            while (true)
+            {
+              reactor::wait(this->_queued);
+              // Let the other messages of this round join the batch.
+              reactor::yield();
+              this->flush();
+            }
+          }
+          catch (elle::Error const&)
+          {
+            ELLE_TRACE("unable to send RPC batch: %s",
+                       elle::exception_string());
+            if (this->_on_error)
+              this->_on_error(std::current_exception());
+          }
+        }
+
+        ELLE_ATTRIBUTE(Channel, channel);
+        ELLE_ATTRIBUTE(elle::Buffer, batch);
+        ELLE_ATTRIBUTE(reactor::Barrier, queued);
+        ELLE_ATTRIBUTE(OnError, on_error);
+        ELLE_ATTRIBUTE(reactor::Thread::unique_ptr, writer);
+      };
+
+      /// A pipeline being served: its batcher and the calls in flight.
+      struct Served
+      {
+        Served(Channel channel, int concurrency)
+          : batcher(std::move(channel))
+          , calls()
+          , slots(concurrency)
+        {}
+
+        Batcher batcher;
+        /// Request ids of the calls still to be answered.
+        std::unordered_set<uint32_t> calls;
+        /// Bounds the calls running at once.
+        reactor::Semaphore slots;
+      };
+    }
+
+    /*------------.
+    | PendingCall |
+    `------------*/
+
+    PendingCall::PendingCall()
+      : _arrived("RPC reply")
+      , _arrived_at()
+      , _reply()
+      , _error()
+    {}
+
+    elle::Buffer const&
+    PendingCall::reply()
+    {
+      reactor::wait(this->_arrived);
+      if (this->_error)
+        std::rethrow_exception(this->_error);
+      return this->_reply;
+    }
+
+    bool
+    PendingCall::done() const
+    {
+      return this->_arrived.opened();
+    }
+
+    /*---------.
+    | Pipeline |
+    `---------*/
+
+    /// The client side of pipelined calls: one channel, and the calls
+    /// awaiting their reply by request id.
+    class BaseRPC::Pipeline
+    {
+    public:
+      Pipeline(ChanneledStream& channels)
+        : _batcher(Channel(channels),
+                   [this] (std::exception_ptr e) { this->_fail(e); })
+        , _calls()
+        , _request_next(0)
+        , _error()
+        , _reader(new reactor::Thread(
+                    "RPC pipeline reader", [this] { this->_read_thread(); }))
+      {}
+
+      ~Pipeline()
+      {
+        this->_reader->terminate_now();
+        this->_fail(std::make_exception_ptr(
+                      RPCError("RPC pipeline destroyed")));
+      }
+
+      std::shared_ptr<PendingCall>
+      call(elle::Buffer const& question)
+      {
+        auto res = std::make_shared<PendingCall>();
+        if (this->_error)
+        {
+          res->_error = this->_error;
+          res->_arrived_at = std::chrono::steady_clock::now();
+          res->_arrived.open();
+          return res;
+        }
+        auto const id = this->_request_next++;
+        ELLE_DEBUG("send request %s", id);
+        this->_calls.emplace(id, res);
+        this->_batcher.write(id, question);
+        return res;
+      }
+
+    private:
+      void
+      _read_thread()
+      {
+        try
+        {
+          while (true)
+            for (auto& reply: this->_batcher.read())
+            {
+              auto it = this->_calls.find(reply.first);
+              if (it == this->_calls.end())
+              {
+                ELLE_TRACE("discard reply to unknown request %s",
+                           reply.first);
+                continue;
+              }
+              ELLE_DEBUG("received reply to request %s", reply.first);
+              it->second->_reply = std::move(reply.second);
+              it->second->_arrived_at = std::chrono::steady_clock::now();
+              it->second->_arrived.open();
+              this->_calls.erase(it);
+            }
+        }
+        catch (elle::Error const&)
+        {
+          ELLE_TRACE("RPC pipeline broken: %s", elle::exception_string());
+          this->_fail(std::current_exception());
+        }
+      }
+
+      /// Fail every pending call, and the next ones, with @a e.
+      void
+      _fail(std::exception_ptr e)
+      {
+        if (!this->_error)
+          this->_error = e;
+        for (auto& call: this->_calls)
+        {
+          call.second->_error = this->_error;
+          call.second->_arrived_at = std::chrono::steady_clock::now();
+          call.second->_arrived.open();
+        }
+        this->_calls.clear();
+      }
+
+      ELLE_ATTRIBUTE(Batcher, batcher);
+      ELLE_ATTRIBUTE((std::unordered_map<uint32_t,
+                                         std::shared_ptr<PendingCall>>),
+                     calls);
+      ELLE_ATTRIBUTE(uint32_t, request_next);
+      ELLE_ATTRIBUTE(std::exception_ptr, error);
+      ELLE_ATTRIBUTE(reactor::Thread::unique_ptr, reader);
+    };
+
+    /*--------.
+    | BaseRPC |
+    `--------*/
+
     BaseRPC::BaseRPC(ChanneledStream& channels)
-      : _channels(channels)
+      : _pipeline_concurrency(64)
+      , _channels(channels)
       , _id(0)
+      , _pipeline()
     {}
+
+    BaseRPC::~BaseRPC()
+    {}
+
+    std::shared_ptr<PendingCall>
+    BaseRPC::_call_pipelined(elle::Buffer const& question)
+    {
+      if (!this->_pipeline)
+        this->_pipeline.reset(new Pipeline(this->_channels));
+      return this->_pipeline->call(question);
+    }
+
+    void
+    BaseRPC::_run_pipelined(Answer const& answer, Failure const& failure)
+    {
+      auto served = std::unordered_set<std::shared_ptr<Served>>{};
+      auto stopping = reactor::Barrier("RPC pipelines stopping");
+      auto const stopped = [&]
+        {
+          return failure(
+            std::make_exception_ptr(RPCError("RPC server stopped")));
+        };
+      elle::With<reactor::Scope>("RPC pipelines") <<
+        [&] (reactor::Scope& scope)
+        {
+          scope.run_background(
+            "RPC pipelines acceptor",
+            [&]
+            {
+              while (true)
+              {
+                auto pipeline = std::make_shared<Served>(
+                  this->_channels.accept(), this->_pipeline_concurrency);
+                ELLE_TRACE("%s: serve new pipeline", this);
+                served.insert(pipeline);
+                scope.run_background(
+                  "RPC pipeline",
+                  [&, pipeline]
+                  {
+                    elle::SafeFinally forget([&] { served.erase(pipeline); });
+                    try
+                    {
+                      elle::With<reactor::Scope>() <<
+                        [&] (reactor::Scope& calls)
+                        {
+                          while (true)
+                            for (auto& question: pipeline->batcher.read())
+                            {
+                              auto const id = question.first;
+                              if (stopping.opened())
+                              {
+                                pipeline->batcher.write(id, stopped());
+                                continue;
+                              }
+                              while (!pipeline->slots.acquire())
+                                reactor::wait(pipeline->slots);
+                              pipeline->calls.insert(id);
+                              calls.run_background(
+                                elle::sprintf("RPC %s", id),
+                                [&, pipeline, id,
+                                 message = std::move(question.second)]
+                                {
+                                  elle::SafeFinally release(
+                                    [&] { pipeline->slots.release(); });
+                                  bool stop = false;
+                                  auto reply = answer(message, stop);
+                                  // Unless already failed by a stop request.
+                                  if (pipeline->calls.erase(id))
+                                    pipeline->batcher.write(id, reply);
+                                  if (stop)
+                                  {
+                                    ELLE_TRACE("%s: stop requested", this);
+                                    stopping.open();
+                                  }
+                                });
+                            }
+                        };
+                    }
+                    catch (reactor::Terminate const&)
+                    {
+                      throw;
+                    }
+                    catch (reactor::network::Error const&)
+                    {
+                      ELLE_TRACE("%s: pipeline closed: %s",
+                                 this, elle::exception_string());
+                    }
+                    catch (elle::Exception const&)
+                    {
+                      auto const error = elle::exception_string();
+                      ELLE_WARN("%s: drop pipeline: %s", this, error);
+                      // Fail a synchronous caller rather than leave it
+                      // waiting forever for a reply.
+                      try
+                      {
+                        pipeline->batcher.reject(
+                          failure(std::make_exception_ptr(RPCError(
+                            elle::sprintf("malformed RPC batch, pipelined "
+                                          "servers cannot answer synchronous "
+                                          "calls: %s", error)))));
+                      }
+                      catch (elle::Error const&)
+                      {
+                        ELLE_TRACE("%s: unable to reject pipeline: %s",
+                                   this, elle::exception_string());
+                      }
+                    }
+                  });
+              }
+            });
+          reactor::wait(stopping);
+          ELLE_TRACE_SCOPE("%s: stop serving pipelines", this);
+          // Copy, since pipelines may be forgotten while flushing.
+          for (auto const& pipeline: std::vector<std::shared_ptr<Served>>(
+                 served.begin(), served.end()))
+          {
+            for (auto id: pipeline->calls)
+              pipeline->batcher.write(id, stopped());
+            pipeline->calls.clear();
+            try
+            {
+              pipeline->batcher.flush();
+            }
+            catch (elle::Error const&)
+            {
+              ELLE_TRACE("%s: unable to fail pending calls: %s",
+                         this, elle::exception_string());
+            }
+          }
+        };
+      throw LastMessageException("stop requested");
+    }
   }
 }
@@ -1,13 +1,16 @@
 #pragma once
 
+#include <chrono>
 #include <ostream>
 #include <memory>
 #include <unordered_map>
 
 #include <boost/noncopyable.hpp>
 
+#include <elle/Buffer.hh>
 #include <elle/Printable.hh>
 
+#include <elle/reactor/Barrier.hh>
 #include <elle/reactor/Thread.hh>
 
 #include <elle/protocol/fwd.hh>
@@ -81,10 +84,36 @@ namespace elle
       ELLE_ATTRIBUTE(Function, function);
     };
 
+    /// The reply to a pipelined call, once it arrives.
+    class PendingCall
+      : public boost::noncopyable
+    {
+    public:
+      PendingCall();
+      /// Wait for the reply and return it.
+      ///
+      /// @throw The error that broke the connection, if any.
+      elle::Buffer const&
+      reply();
+      /// Whether the reply arrived, or the connection broke.
+      bool
+      done() const;
+
+    private:
+      friend class BaseRPC;
+      ELLE_ATTRIBUTE(reactor::Barrier, arrived);
+      /// When the reply arrived, or the connection broke.
+      ELLE_ATTRIBUTE_R(std::chrono::steady_clock::time_point, arrived_at);
+      ELLE_ATTRIBUTE(elle::Buffer, reply);
+      ELLE_ATTRIBUTE(std::exception_ptr, error);
+    };
+
     class BaseRPC
     {
     public:
       BaseRPC(ChanneledStream& channels);
+      virtual
+      ~BaseRPC();
       /// Run forever until one of the following:
       /// - Connection gets closed
       /// - Thread gets terminated
@@ -97,6 +126,10 @@ namespace elle
       virtual
       void
       run(ExceptionHandler handler = {}) = 0;
+      /// Maximum number of pipelined calls served at once on a pipeline.
+      ///
+      /// Questions beyond it are read once a running call finishes.
+      ELLE_ATTRIBUTE_RW(int, pipeline_concurrency);
 
     protected:
       template <typename ISerializer,
@@ -105,8 +138,33 @@ namespace elle
                 typename ... Args>
       friend class Procedure;
 
+      /// Send @a question on the pipeline, opened on first use, and return
+      /// its pending reply.
+      ///
+      /// Questions sent during the same scheduler round share one packet.
+      std::shared_ptr<PendingCall>
+      _call_pipelined(elle::Buffer const& question);
+      /// Compute the answer to a question, setting its second argument to
+      /// stop serving.
+      using Answer = std::function<elle::Buffer (elle::Buffer const&, bool&)>;
+      /// Build the error reply to a question that will not be answered.
+      using Failure = std::function<elle::Buffer (std::exception_ptr)>;
+      /// Serve every accepted channel as a pipeline, answering each question
+      /// in its own thread with @a answer, until the connection is closed.
+      ///
+      /// A pipeline sending malformed batches is dropped, after a bare
+      /// @a failure reply so a synchronous caller fails instead of hanging.
+      /// Once an answer asks to stop, the calls still running are answered
+      /// with @a failure.
+      ///
+      /// @throw LastMessageException once an answer asks to stop.
+      void
+      _run_pipelined(Answer const& answer, Failure const& failure);
+
       ELLE_ATTRIBUTE(ChanneledStream&, channels, protected);
       ELLE_ATTRIBUTE(uint32_t, id, protected);
+      class Pipeline;
+      ELLE_ATTRIBUTE(std::unique_ptr<Pipeline>, pipeline);
     };
 
     template <typename ISerializer, typename OSerializer>
@@ -123,10 +181,20 @@ namespace elle
         using ReturnType = R;
         using Owner = RPC<ISerializer, OSerializer>;
 
+        class Future;
+
       public:
         RemoteProcedure(std::string const& name,
                         RPC<ISerializer, OSerializer>& owner);
         R operator() (Args ...);
+        /// Call the procedure without waiting for the reply.
+        ///
+        /// Such calls share a single channel and are told apart by a request
+        /// id, so any number of them can be in flight and complete in any
+        /// order. Calls issued during the same scheduler round are sent as
+        /// one packet. The peer must serve them with pipelined_run.
+        Future
+        async(Args ...);
         void operator = (std::function<R (Args...)> const& implem);
         template <typename I, typename O>
         friend class RPC;
@@ -134,6 +202,10 @@ namespace elle
                         RPC<ISerializer, OSerializer>& owner,
                         uint32_t id);
       private:
+        elle::Buffer
+        _question(Args ...) const;
+        R
+        _result(elle::Buffer const& response) const;
         ELLE_ATTRIBUTE(uint32_t, id);
         ELLE_ATTRIBUTE(std::string, name);
         ELLE_ATTRIBUTE(Owner&, owner);
@@ -160,7 +232,27 @@ namespace elle
       void
       parallel_run();
 
+      /// Serve pipelined calls, as issued by RemoteProcedure::async, until
+      /// the connection is closed or the handler throws a
+      /// LastMessageException.
+      ///
+      /// Each call runs in its own thread and its answer is sent as soon as
+      /// it is ready, together with the other answers of the same scheduler
+      /// round.
+      ///
+      /// Synchronous calls, as issued by RemoteProcedure::operator(), cannot
+      /// be served: they are answered with an RPCError, unless they happen
+      /// to parse as a well-formed batch.
+      void
+      pipelined_run(ExceptionHandler handler = {});
+
     protected:
+      /// Run the procedure requested by @a question and return the answer.
+      elle::Buffer
+      _answer(elle::Buffer const& question,
+              ExceptionHandler& handler,
+              bool& stop);
+
       using LocalProcedure = BaseProcedure<ISerializer, OSerializer>;
       using NamedProcedure = std::pair<std::string,
                         std::unique_ptr<LocalProcedure>>;
@@ -176,6 +268,32 @@ namespace elle
       void
       print(std::ostream& stream) const override;
     };
+
+    /// The result of a pipelined call, once the reply arrives.
+    template <typename ISerializer, typename OSerializer>
+    template <typename R, typename ... Args>
+    class RPC<ISerializer, OSerializer>::RemoteProcedure<R, Args...>::Future
+    {
+    public:
+      /// Wait for the reply and return the result.
+      ///
+      /// @throw RPCError if the remote procedure failed.
+      R
+      value();
+      /// Whether the reply arrived.
+      bool
+      done() const;
+      /// When the reply arrived.
+      std::chrono::steady_clock::time_point
+      arrived_at() const;
+
+    private:
+      friend class RemoteProcedure;
+      Future(RemoteProcedure const& procedure,
+             std::shared_ptr<PendingCall> call);
+      ELLE_ATTRIBUTE(RemoteProcedure, procedure);
+      ELLE_ATTRIBUTE(std::shared_ptr<PendingCall>, call);
+    };
   }
 }
 
@@ -146,9 +146,10 @@ namespace elle
       auto proc = this->_owner._procedures.find(this->_id);
       assert(proc != this->_owner._procedures.end());
       assert(proc->second.second == nullptr);
-      proc->second.second =
-        std::make_unique<Procedure<IS, OS, R, Args...>>(
-          this->_name, this->_owner, this->_id, f);
+      // Not make_unique: the constructor is private.
+      proc->second.second.reset(
+        new Procedure<IS, OS, R, Args...>(
+          this->_name, this->_owner, this->_id, f));
     }
 
 
@@ -166,55 +167,135 @@ namespace elle
                        this->_owner, this->_name);
 
       Channel channel(this->_owner._channels);
+      channel.write(this->_question(args...));
+      return this->_result(channel.read());
+    }
+
+    template <typename IS,
+              typename OS>
+    template <typename R,
+              typename ... Args>
+    typename RPC<IS, OS>::template RemoteProcedure<R, Args...>::Future
+    RPC<IS, OS>::RemoteProcedure<R, Args...>::
+    async(Args ... args)
+    {
+      ELLE_LOG_COMPONENT("elle.protocol.RPC");
+
+      ELLE_TRACE_SCOPE("%s: call remote procedure asynchronously: %s",
+                       this->_owner, this->_name);
+      return Future(
+        *this, this->_owner._call_pipelined(this->_question(args...)));
+    }
+
+    template <typename IS,
+              typename OS>
+    template <typename R,
+              typename ... Args>
+    elle::Buffer
+    RPC<IS, OS>::RemoteProcedure<R, Args...>::
+    _question(Args ... args) const
+    {
+      elle::Buffer question;
       {
-        elle::Buffer question;
-        {
-          elle::IOStream outs(question.ostreambuf());
-          OS output(outs);
-          output << this->_id;
-          put_args<OS, Args...>(output, args...);
-        }
-        channel.write(question);
+        elle::IOStream outs(question.ostreambuf());
+        OS output(outs);
+        output << this->_id;
+        put_args<OS, Args...>(output, args...);
       }
+      return question;
+    }
+
+    template <typename IS,
+              typename OS>
+    template <typename R,
+              typename ... Args>
+    R
+    RPC<IS, OS>::RemoteProcedure<R, Args...>::
+    _result(elle::Buffer const& response) const
+    {
+      ELLE_LOG_COMPONENT("elle.protocol.RPC");
+
+      elle::IOStream ins(response.istreambuf());
+      IS input(ins);
+      bool res;
+      input >> res;
+      if (res)
+        return GetRes<IS, R>::get_res(input);
+      else
       {
-        elle::Buffer response(channel.read());
-        elle::IOStream ins(response.istreambuf());
-        IS input(ins);
-        bool res;
-        input >> res;
-        if (res)
-          return GetRes<IS, R>::get_res(input);
-        else
+        std::string error;
+        input >> error;
+        ELLE_TRACE_SCOPE("%s: remote procedure call failed: %s",
+                         this->_owner, error);
+        uint16_t bt_size;
+        input >> bt_size;
+        std::vector<elle::StackFrame> frames;
+        for (int i = 0; i < bt_size; ++i)
         {
-          std::string error;
-          input >> error;
-          ELLE_TRACE_SCOPE("%s: remote procedure call failed: %s",
-                           this->_owner, error);
-          uint16_t bt_size;
-          input >> bt_size;
-          std::vector<elle::StackFrame> frames;
-          for (int i = 0; i < bt_size; ++i)
-          {
-            elle::StackFrame frame;
-            input >> frame.symbol;
-            input >> frame.symbol_mangled;
-            input >> frame.symbol_demangled;
-            input >> frame.address;
-            input >> frame.offset;
-            frames.push_back(frame);
-          }
-          elle::Backtrace bt(frames);
-          // FIXME: only protocol error should throw this, not remote
-          // exceptions.
-          RPCError e
-            (elle::sprintf("remote procedure '%s' failed with '%s'", this->_name, error));
-          elle::Exception inner_exception(bt, error);
-          e.inner_exception(std::make_exception_ptr(inner_exception));
-          throw e;
+          elle::StackFrame frame;
+          input >> frame.symbol;
+          input >> frame.symbol_mangled;
+          input >> frame.symbol_demangled;
+          input >> frame.address;
+          input >> frame.offset;
+          frames.push_back(frame);
         }
+        elle::Backtrace bt(frames);
+        // FIXME: only protocol error should throw this, not remote
+        // exceptions.
+        RPCError e
+          (elle::sprintf("remote procedure '%s' failed with '%s'", this->_name, error));
+        elle::Exception inner_exception(bt, error);
+        e.inner_exception(std::make_exception_ptr(inner_exception));
+        throw e;
       }
     }
 
+    /*-------.
+    | Future |
+    `-------*/
+
+    template <typename IS,
+              typename OS>
+    template <typename R,
+              typename ... Args>
+    RPC<IS, OS>::RemoteProcedure<R, Args...>::Future::Future(
+      RemoteProcedure const& procedure,
+      std::shared_ptr<PendingCall> call)
+      : _procedure(procedure)
+      , _call(std::move(call))
+    {}
+
+    template <typename IS,
+              typename OS>
+    template <typename R,
+              typename ... Args>
+    R
+    RPC<IS, OS>::RemoteProcedure<R, Args...>::Future::value()
+    {
+      return this->_procedure._result(this->_call->reply());
+    }
+
+    template <typename IS,
+              typename OS>
+    template <typename R,
+              typename ... Args>
+    bool
+    RPC<IS, OS>::RemoteProcedure<R, Args...>::Future::done() const
+    {
+      return this->_call->done();
+    }
+
+    template <typename IS,
+              typename OS>
+    template <typename R,
+              typename ... Args>
+    std::chrono::steady_clock::time_point
+    RPC<IS, OS>::RemoteProcedure<R, Args...>::Future::arrived_at() const
+    {
+      return this->_call->arrived_at();
+    }
+
     /*------------------.
     | Procedure helpers |
     `------------------*/
@@ -402,13 +483,65 @@ namespace elle
 
     template <typename IS,
               typename OS>
-    void
-    RPC<IS, OS>::run(ExceptionHandler handler)
+    elle::Buffer
+    RPC<IS, OS>::_answer(elle::Buffer const& question,
+                         ExceptionHandler& handler,
+                         bool& stop)
     {
       ELLE_LOG_COMPONENT("elle.protocol.RPC");
 
       using elle::sprintf;
       using elle::Exception;
+      elle::IOStream ins(question.istreambuf());
+      IS input(ins);
+      uint32_t id;
+      input >> id;
+      ELLE_TRACE_SCOPE("%s: Processing request for %s...", *this, id);
+      auto proc = this->_procedures.find(id);
+
+      elle::Buffer answer;
+      {
+        elle::IOStream outs(answer.ostreambuf());
+        OS output(outs);
+        try
+        {
+          if (proc == this->_procedures.end())
+            throw Exception(sprintf("call to unknown procedure: %s", id));
+          else if (proc->second.second == nullptr)
+          {
+            throw Exception(sprintf("remote call to non-local procedure: %s",
+                                    proc->second.first));
+          }
+          else
+          {
+            auto const &name = proc->second.first;
+
+            ELLE_TRACE("%s: remote procedure called: %s", *this, name)
+              proc->second.second->_call(input, output);
+            ELLE_TRACE("%s: procedure %s succeeded", *this, name);
+          }
+        }
+        catch (elle::reactor::Terminate const&)
+        {
+          ELLE_TRACE("%s: terminating as requested", *this);
+          throw;
+        }
+        catch (...)
+        { // Pass exception through handler if present, reply with an error
+          stop = handle_exception(handler, output, std::current_exception());
+        }
+        outs.flush();
+      }
+      return answer;
+    }
+
+    template <typename IS,
+              typename OS>
+    void
+    RPC<IS, OS>::run(ExceptionHandler handler)
+    {
+      ELLE_LOG_COMPONENT("elle.protocol.RPC");
+
       bool stop_request = false;
       try
       {
@@ -417,45 +550,7 @@ namespace elle
           ELLE_TRACE_SCOPE("%s: Accepting new request...", *this);
           Channel c(this->_channels.accept());
           elle::Buffer question(c.read());
-          elle::IOStream ins(question.istreambuf());
-          IS input(ins);
-          uint32_t id;
-          input >> id;
-          ELLE_TRACE_SCOPE("%s: Processing request for %s...", *this, id);
-          auto proc = this->_procedures.find(id);
-
-          elle::Buffer answer;
-          elle::IOStream outs(answer.ostreambuf());
-          OS output(outs);
-          try
-          {
-            if (proc == this->_procedures.end())
-              throw Exception(sprintf("call to unknown procedure: %s", id));
-            else if (proc->second.second == nullptr)
-            {
-              throw Exception(sprintf("remote call to non-local procedure: %s",
-                                      proc->second.first));
-            }
-            else
-            {
-              auto const &name = proc->second.first;
-
-              ELLE_TRACE("%s: remote procedure called: %s", *this, name)
-                proc->second.second->_call(input, output);
-              ELLE_TRACE("%s: procedure %s succeeded", *this, name);
-            }
-          }
-          catch (elle::reactor::Terminate const&)
-          {
-            ELLE_TRACE("%s: terminating as requested", *this);
-            throw;
-          }
-          catch (...)
-          { // Pass exception through handler if present, reply with an error
-            stop_request = handle_exception(handler, output, std::current_exception());
-          }
-          outs.flush();
-          c.write(answer);
+          c.write(this->_answer(question, handler, stop_request));
         }
       }
       catch (elle::reactor::network::ConnectionClosed const& e)
@@ -582,6 +677,43 @@ namespace elle
       }
     }
 
+    template <typename IS,
+              typename OS>
+    void
+    RPC<IS, OS>::pipelined_run(ExceptionHandler handler)
+    {
+      ELLE_LOG_COMPONENT("elle.protocol.RPC");
+
+      try
+      {
+        this->_run_pipelined(
+          [&] (elle::Buffer const& question, bool& stop)
+          {
+            return this->_answer(question, handler, stop);
+          },
+          [] (std::exception_ptr e)
+          {
+            elle::Buffer answer;
+            {
+              elle::IOStream outs(answer.ostreambuf());
+              OS output(outs);
+              auto none = ExceptionHandler{};
+              handle_exception(none, output, e);
+            }
+            return answer;
+          });
+      }
+      catch (elle::reactor::network::ConnectionClosed const& e)
+      {
+        ELLE_TRACE("%s: end of RPCs: connection closed", *this);
+        return;
+      }
+      catch (LastMessageException const&)
+      {
+        ELLE_TRACE("%s: end of RPCs: normal exit", *this);
+      }
+    }
+
     template <typename IS,
               typename OS>
     void
@@ -4,9 +4,14 @@
 # include <arpa/inet.h>
 #endif
 
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+
 #include <elle/Buffer.hh>
 #include <elle/log.hh>
 
+#include <elle/cryptography/Hasher.hh>
 #include <elle/cryptography/hash.hh>
 
 #include <elle/serialization/binary.hh>
@@ -15,9 +20,11 @@
 #include <elle/reactor/scheduler.hh>
 #include <elle/reactor/exception.hh>
 #include <elle/reactor/Barrier.hh>
+#include <elle/reactor/signal.hh>
 #include <elle/reactor/network/socket.hh>
 #include <elle/reactor/network/utp-socket.hh>
 
+#include <elle/protocol/CRC32C.hh>
 #include <elle/protocol/Serializer.hh>
 #include <elle/protocol/exceptions.hh>
 
@@ -105,6 +112,26 @@ namespace elle
       }
     }
 
+    // Read a CRC-32C trailer.
+    static
+    uint32_t
+    read_crc(std::istream& stream)
+    {
+      auto crc = elle::Buffer(sizeof(uint32_t));
+      read(stream, crc, sizeof(uint32_t));
+      uint32_t res;
+      memcpy(&res, crc.contents(), sizeof(uint32_t));
+      return ntohl(res);
+    }
+
+    static
+    void
+    write_crc(std::ostream& stream, uint32_t crc)
+    {
+      crc = htonl(crc);
+      stream.write(reinterpret_cast<char const*>(&crc), sizeof(crc));
+    }
+
     static
     void
     write(std::ostream& stream,
@@ -122,6 +149,35 @@ namespace elle
         to_send);
     }
 
+    // Write bytes [offset, offset + size) of header + packet.
+    static
+    void
+    write_parts(std::ostream& stream,
+                elle::ConstWeakBuffer const& header,
+                elle::ConstWeakBuffer const& packet,
+                elle::Buffer::Size offset,
+                elle::Buffer::Size size,
+                CRC32C* crc)
+    {
+      for (auto const& part: {header, packet})
+      {
+        if (size == 0)
+          break;
+        if (offset >= part.size())
+        {
+          offset -= part.size();
+          continue;
+        }
+        auto const n = std::min(size, part.size() - offset);
+        auto const chunk = elle::ConstWeakBuffer(part.contents() + offset, n);
+        stream.write(reinterpret_cast<char const*>(chunk.contents()), n);
+        if (crc)
+          crc->update(chunk);
+        offset = 0;
+        size -= n;
+      }
+    }
+
     enum Control: unsigned char
     {
       keep_going = 0,
@@ -129,7 +185,11 @@ namespace elle
       message = 2,
       ping = 3,
       pong = 4,
-      max = pong,
+      /// From 0.6.0: first chunk of a packet, with its slot and total size.
+      packet = 5,
+      /// From 0.6.0: next chunk of the packet in a slot.
+      chunk = 6,
+      max = chunk,
     };
 
     static
@@ -177,6 +237,10 @@ namespace elle
         , _version(version)
         , _lock_write()
         , _lock_read()
+        , _incoming()
+        , _outgoing()
+        , _turn()
+        , _slot_next(0)
       {
         if (bool(this->_ping_period) != bool(this->_ping_delay))
           elle::err("specify either both ping period and timeout or neither");
@@ -211,9 +275,37 @@ namespace elle
       /// Whether the stream is broken by a previous interrupted read.
       ELLE_ATTRIBUTE_R(bool, broken);
 
+      /// Whether packets end with a CRC-32C computed chunk by chunk, rather
+      /// than start with a SHA-1 of the whole packet.
+      bool
+      crc() const
+      {
+        return this->_checksum && this->version() >= elle::Version(0, 4, 0);
+      }
+
+      /// Whether chunks of concurrent packets are interleaved, each tagged
+      /// with the slot of its packet.
+      bool
+      interleaved() const
+      {
+        return this->version() >= elle::Version(0, 6, 0);
+      }
+
       elle::Buffer
       _read()
       {
+        if (this->interleaved())
+          try
+          {
+            return this->_read_interleaved();
+          }
+          catch (...)
+          {
+            ELLE_TRACE("read interrupted, switching to broken state: %s",
+                       elle::exception_string());
+            this->_broken = true;
+            throw;
+          }
         if (this->version() >= elle::Version(0, 3, 0))
           while (!this->read_control())
             ;
@@ -222,7 +314,7 @@ namespace elle
         // return elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
         // {
           elle::Buffer hash;
-          if (this->_checksum)
+          if (this->_checksum && !this->crc())
           {
             ELLE_DEBUG("read checksum")
               if (this->version() >= elle::Version(0, 2, 0))
@@ -240,12 +332,16 @@ namespace elle
               ELLE_DEBUG("packet size: %s", total_size);
               elle::Buffer packet(static_cast<std::size_t>(total_size));
               elle::Buffer::Size offset = 0;
+              auto crc = CRC32C{};
               while (true)
               {
                 uint32_t size =
                   std::min(total_size - offset, this->_chunk_size);
                 ELLE_DEBUG("read chunk of size %s", size);
                 elle::protocol::read(this->_stream, packet, size, offset);
+                if (this->crc())
+                  crc.update(elle::ConstWeakBuffer(
+                               packet.contents() + offset, size));
                 offset += size;
                 ELLE_ASSERT_LTE(offset, total_size);
                 if (offset >= total_size)
@@ -253,6 +349,16 @@ namespace elle
                 if (!this->read_control())
                   throw InterruptionError();
               }
+              if (this->crc())
+              {
+                auto const expected = read_crc(this->_stream);
+                ELLE_DEBUG("read checksum: 0x%x", expected);
+                if (crc.value() != expected)
+                {
+                  ELLE_ERR("wrong packet checksum")
+                    throw ChecksumError();
+                }
+              }
               return packet;
             }
             else
@@ -260,7 +366,7 @@ namespace elle
           }();
           ELLE_DUMP("packet content: %s", packet);
           // Check checksums match.
-          if (this->_checksum)
+          if (this->_checksum && !this->crc())
             enforce_checksums_equal(packet, hash);
           return packet;
         }
@@ -277,12 +383,88 @@ namespace elle
         }
       }
 
+      /// A packet being received, in interleaved mode.
+      struct Incoming
+      {
+        elle::Buffer packet;
+        elle::Buffer::Size offset;
+        CRC32C crc;
+      };
+
+      elle::Buffer
+      _read_interleaved()
+      {
+        while (true)
+        {
+          auto const control = this->next_control();
+          if (control == Control::keep_going)
+            elle::err<protocol::Error>("unexpected control byte: 0x%x",
+                                       static_cast<int>(control));
+          auto const slot =
+            Serializer::Super::uint32_get(this->_stream, this->version());
+          if (control == Control::interrupt)
+          {
+            ELLE_DEBUG("packet %s interrupted", slot);
+            this->_incoming.erase(slot);
+            continue;
+          }
+          auto it = this->_incoming.find(slot);
+          if (control == Control::packet)
+          {
+            if (it != this->_incoming.end())
+              elle::err<protocol::Error>("packet %s started twice", slot);
+            auto const total =
+              Serializer::Super::uint32_get(this->_stream, this->version());
+            ELLE_DEBUG("packet %s size: %s", slot, total);
+            it = this->_incoming.emplace(
+              slot,
+              Incoming{elle::Buffer(static_cast<std::size_t>(total)), 0, {}})
+              .first;
+          }
+          else if (it == this->_incoming.end())
+            elle::err<protocol::Error>("chunk for unknown packet %s", slot);
+          auto& incoming = it->second;
+          auto const size =
+            Serializer::Super::uint32_get(this->_stream, this->version());
+          if (size > incoming.packet.size() - incoming.offset)
+            elle::err<protocol::Error>(
+              "chunk of %s bytes overflows packet %s", size, slot);
+          ELLE_DEBUG("read chunk of size %s for packet %s", size, slot);
+          elle::protocol::read(
+            this->_stream, incoming.packet, size, incoming.offset);
+          if (this->crc())
+            incoming.crc.update(elle::ConstWeakBuffer(
+                                  incoming.packet.contents() + incoming.offset,
+                                  size));
+          incoming.offset += size;
+          if (incoming.offset < incoming.packet.size())
+            continue;
+          if (this->crc())
+          {
+            auto const expected = read_crc(this->_stream);
+            ELLE_DEBUG("read checksum: 0x%x", expected);
+            if (incoming.crc.value() != expected)
+            {
+              ELLE_ERR("wrong packet checksum")
+                throw ChecksumError();
+            }
+          }
+          auto packet = std::move(incoming.packet);
+          this->_incoming.erase(it);
+          ELLE_DUMP("packet content: %s", packet);
+          return packet;
+        }
+      }
+
       void
-      write(elle::Buffer const& packet)
+      write(elle::ConstWeakBuffer const& header,
+            elle::ConstWeakBuffer const& packet)
       {
+        if (this->interleaved())
+          return this->_write_interleaved(header, packet);
         elle::reactor::Lock lock(this->_lock_write);
         elle::IOStreamClear clearer(this->_stream);
-        this->_write(packet);
+        this->_write(header, packet);
       }
 
       void
@@ -317,6 +499,24 @@ namespace elle
 
       bool
       read_control()
+      {
+        auto const control = this->next_control();
+        switch (control)
+        {
+          case Control::keep_going:
+            return true;
+          case Control::interrupt:
+            return false;
+          default:
+            elle::err<protocol::Error>(
+              "unexpected control byte: 0x%x", static_cast<int>(control));
+        }
+      }
+
+      /// Read control bytes, handling pings, pongs and messages, up to the
+      /// next one about packets.
+      Control
+      next_control()
       {
         while (true)
         {
@@ -337,9 +537,10 @@ namespace elle
           switch (static_cast<Control>(control))
           {
             case Control::keep_going:
-              return true;
             case Control::interrupt:
-              return false;
+            case Control::packet:
+            case Control::chunk:
+              return static_cast<Control>(control);
             case Control::message:
               ignore_message(this->_stream, this->version());
               break;
@@ -401,15 +602,127 @@ namespace elle
       ELLE_ATTRIBUTE(std::list<Timer>, ping_timers);
       ELLE_ATTRIBUTE_RX(boost::signals2::signal<void ()>, ping_timeout);
 
+      /// A packet being sent, in interleaved mode.
+      struct Outgoing
+      {
+        uint32_t slot;
+        elle::Buffer::Size offset;
+        bool started;
+        CRC32C crc;
+      };
+
+      /// Send @a header followed by @a packet one chunk at a time, taking
+      /// turns with the other packets being sent.
+      ///
+      /// Writers queue in round-robin order and each sends a single chunk of
+      /// its own packet when at the front, so a small packet waits for at
+      /// most one chunk per concurrent transfer.
+      void
+      _write_interleaved(elle::ConstWeakBuffer const& header,
+                         elle::ConstWeakBuffer const& packet)
+      {
+        auto const total = header.size() + packet.size();
+        auto self = Outgoing{this->_slot_next++, 0, false, {}};
+        ELLE_DEBUG_SCOPE("send packet %s of size %s", self.slot, total);
+        auto leave = [&]
+          {
+            auto it =
+              std::find(this->_outgoing.begin(), this->_outgoing.end(), &self);
+            if (it != this->_outgoing.end())
+              this->_outgoing.erase(it);
+            this->_turn.signal();
+          };
+        this->_outgoing.push_back(&self);
+        try
+        {
+          while (true)
+          {
+            while (this->_outgoing.front() != &self)
+              elle::reactor::wait(this->_turn);
+            {
+              elle::reactor::Lock lock(this->_lock_write);
+              elle::IOStreamClear clearer(this->_stream);
+              elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
+              {
+                auto const size =
+                  std::min(this->_chunk_size, total - self.offset);
+                ELLE_DEBUG("send %s bytes of packet %s at offset %s",
+                           size, self.slot, self.offset);
+                if (self.started)
+                  this->write_control(Control::chunk);
+                else
+                  this->write_control(Control::packet);
+                Serializer::Super::uint32_put(
+                  this->_stream, self.slot, this->version());
+                if (!self.started)
+                  Serializer::Super::uint32_put(
+                    this->_stream, total, this->version());
+                self.started = true;
+                Serializer::Super::uint32_put(
+                  this->_stream, size, this->version());
+                write_parts(this->_stream, header, packet, self.offset, size,
+                            this->crc() ? &self.crc : nullptr);
+                self.offset += size;
+                if (this->crc() && self.offset == total)
+                  write_crc(this->_stream, self.crc.value());
+                this->_stream.flush();
+              };
+              this->write_pings_pongs(true);
+            }
+            this->_outgoing.pop_front();
+            if (self.offset == total)
+              break;
+            this->_outgoing.push_back(&self);
+            this->_turn.signal();
+          }
+          this->_turn.signal();
+        }
+        catch (elle::reactor::Terminate const&)
+        {
+          leave();
+          if (self.started && self.offset < total)
+            elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
+            {
+              ELLE_DEBUG("interrupted after sending %s bytes over %s",
+                         self.offset, total);
+              elle::reactor::Lock lock(this->_lock_write);
+              elle::IOStreamClear clearer(this->_stream);
+              this->write_control(Control::interrupt);
+              Serializer::Super::uint32_put(
+                this->_stream, self.slot, this->version());
+              this->write_pings_pongs(true);
+              this->_stream.flush();
+            };
+          throw;
+        }
+        catch (...)
+        {
+          leave();
+          throw;
+        }
+      }
+
+      /// Write @a header immediately followed by @a packet as one packet,
+      /// without concatenating them.
       void
-      _write(elle::Buffer const& packet)
+      _write(elle::ConstWeakBuffer const& header,
+             elle::ConstWeakBuffer const& packet)
       {
+        auto const total = header.size() + packet.size();
+        auto put = [&] (elle::Buffer::Size offset,
+                        elle::Buffer::Size size,
+                        CRC32C* crc)
+          {
+            write_parts(this->_stream, header, packet, offset, size, crc);
+          };
         if (this->version() >= elle::Version(0, 3, 0))
           this->write_control(Control::keep_going);
-        if (this->_checksum)
+        if (this->_checksum && !this->crc())
         {
           // Compute and send checksum.
-          auto hash = compute_checksum(packet);
+          auto hash = elle::cryptography::Hasher(
+            elle::cryptography::Oneway::sha1)
+            .update(header).update(packet).finalize();
           elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
           {
             ELLE_DEBUG("send checksum: 0x%x", hash)
@@ -419,33 +732,33 @@ namespace elle
         if (this->version() >= elle::Version(0, 2, 0))
         {
           elle::Buffer::Size offset = 0;
+          auto crc = CRC32C{};
           try
           {
             auto send = [&]
               {
-                auto to_send = std::min(this->_chunk_size, packet.size() - offset);
+                auto to_send = std::min(this->_chunk_size, total - offset);
                 ELLE_DEBUG_SCOPE("send %s bytes of data at offset %s",
                                  to_send, offset);
-                elle::protocol::write(
-                  this->_stream,
-                  this->version(), packet, false, offset, to_send);
+                put(offset, to_send, this->crc() ? &crc : nullptr);
                 offset += to_send;
+                if (this->crc() && offset == total)
+                  ELLE_DEBUG("send checksum: 0x%x", crc.value())
+                    write_crc(this->_stream, crc.value());
                 this->_stream.flush();
               };
             {
               elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
               {
                 // Send the size.
-                {
-                  auto size = packet.size();
-                  ELLE_DEBUG("send packet size %s", size)
-                    Serializer::Super::uint32_put(this->_stream, size, this->version());
-                }
+                ELLE_DEBUG("send packet size %s", total)
+                  Serializer::Super::uint32_put(
+                    this->_stream, total, this->version());
                 // Send first chunk
                 send();
               };
             }
-            while (offset < packet.size())
+            while (offset < total)
             {
               elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
               {
@@ -457,10 +770,10 @@ namespace elle
           }
           catch (elle::reactor::Terminate const&)
           {
-            if (offset < packet.size())
+            if (offset < total)
             {
               ELLE_DEBUG("interrupted after sending %s bytes over %s",
-                         offset, packet.size());
+                         offset, total);
               this->write_control(Control::interrupt);
               this->write_pings_pongs(true);
             }
@@ -473,7 +786,11 @@ namespace elle
           elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
           {
             ELLE_DEBUG("send actual data")
-              elle::protocol::write(this->_stream, this->version(), packet);
+            {
+              Serializer::Super::uint32_put(
+                this->_stream, total, this->version());
+              put(0, total, nullptr);
+            }
             this->_stream.flush();
           };
       }
@@ -484,6 +801,13 @@ namespace elle
       ELLE_ATTRIBUTE_R(elle::Version, version);
       ELLE_ATTRIBUTE(elle::reactor::Mutex, lock_write, protected);
       ELLE_ATTRIBUTE(elle::reactor::Mutex, lock_read, protected);
+      /// Packets being received, by slot.
+      ELLE_ATTRIBUTE((std::unordered_map<uint32_t, Incoming>), incoming);
+      /// Packets being sent, the front one's chunk goes next.
+      ELLE_ATTRIBUTE(std::deque<Outgoing*>, outgoing);
+      /// Signaled when the front of outgoing changes.
+      ELLE_ATTRIBUTE(elle::reactor::Signal, turn);
+      ELLE_ATTRIBUTE(uint32_t, slot_next);
     };
 
     /*------.
@@ -527,7 +851,7 @@ namespace elle
       }
       ELLE_TRACE("using version: '%s'", this->version());
       this->_impl.reset(
-        new Impl(stream, this->_chunk_size, checksum, version,
+        new Impl(stream, this->_chunk_size, checksum, this->version(),
                  std::move(ping_period), std::move(ping_timeout)));
       this->_impl->ping_timeout().connect(this->_ping_timeout);
     }
@@ -552,7 +876,14 @@ namespace elle
     void
     Serializer::_write(elle::Buffer const& packet)
     {
-      this->_impl->write(packet);
+      this->_impl->write({}, packet);
+    }
+
+    void
+    Serializer::_write_framed(elle::ConstWeakBuffer const& header,
+                              elle::Buffer const& packet)
+    {
+      this->_impl->write(header, packet);
     }
 
     /*----------.
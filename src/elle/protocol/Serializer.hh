@@ -30,6 +30,15 @@ namespace elle
     /// its version and read the peer version in order to agree what version to
     /// use (actually, the smaller of the versions).
     ///
+    /// Up to version 0.3.0, packets are preceded by their SHA-1. From version
+    /// 0.4.0, they are followed by a CRC-32C computed as chunks are sent and
+    /// received, which is far cheaper.
+    /// From version 0.5.0, a ChanneledStream on top of it flow-controls its
+    /// channels.
+    /// From version 0.6.0, concurrently written packets are sent as
+    /// interleaved chunks, round-robin, so a small packet does not wait for a
+    /// large one to be fully sent.
+    ///
     /// \code{.cc}
     ///
     /// elle::reactor::network::TCPSocket socket("127.0.0.1", 8182);
@@ -63,7 +72,8 @@ namespace elle
       /// @param stream The underlying std::iostream.
       /// @param version The version of the protocol.
       /// @param checksum Whether it should read and write the checksum of
-      ///                 packets sent.
+      ///                 packets sent. Its algorithm depends on the
+      ///                 negotiated version.
       Serializer(std::iostream& stream,
                  elle::Version const& version = elle::Version(0, 1, 0),
                  bool checksum = true,
@@ -91,6 +101,11 @@ namespace elle
       /// @param packet The packet to write.
       void
       _write(elle::Buffer const& packet) override;
+      /// Write @a header and @a packet as a single packet, without
+      /// concatenating them.
+      void
+      _write_framed(elle::ConstWeakBuffer const& header,
+                    elle::Buffer const& packet) override;
 
     /*----------.
     | Printable |
@@ -59,6 +59,26 @@ namespace elle
       this->_write(packet);
     }
 
+    void
+    Stream::write(elle::ConstWeakBuffer const& header,
+                  elle::Buffer const& packet)
+    {
+      ELLE_TRACE_SCOPE("%s: write packet (%s + %s bytes)",
+                       this, header.size(), packet.size());
+      this->_write_framed(header, packet);
+    }
+
+    void
+    Stream::_write_framed(elle::ConstWeakBuffer const& header,
+                          elle::Buffer const& packet)
+    {
+      auto framed = elle::Buffer(header.size() + packet.size());
+      memcpy(framed.mutable_contents(), header.contents(), header.size());
+      memcpy(framed.mutable_contents() + header.size(),
+             packet.contents(), packet.size());
+      this->_write(framed);
+    }
+
     /*------------------.
     | Int serialization |
     `------------------*/
@@ -68,8 +88,7 @@ namespace elle
     {
       if (v >= elle::Version(0, 3, 0))
       {
-        elle::IOStream output(b.ostreambuf());
-        SerializerOut::serialize_number(output, i);
+        SerializerOut::serialize_number(b, i);
       }
       else
       {
@@ -83,9 +102,8 @@ namespace elle
     {
       if (v >= elle::Version(0, 3, 0))
       {
-        elle::IOStream input(b.istreambuf());
         int64_t res;
-        b.pop_front(SerializerIn::serialize_number(input, res));
+        b.pop_front(SerializerIn::serialize_number(b, res));
         return (uint32_t) res;
       }
       else
@@ -63,10 +63,26 @@ namespace elle
       /// @param packet The buffer to write.
       void
       write(elle::Buffer const& packet);
+      /// Write a packet made of @a header followed by @a packet.
+      ///
+      /// Lets a multiplexing layer prefix its own framing without copying the
+      /// payload into a new buffer, when the backend supports it.
+      ///
+      /// @param header The bytes to prepend.
+      /// @param packet The buffer to write.
+      void
+      write(elle::ConstWeakBuffer const& header, elle::Buffer const& packet);
     protected:
       virtual
       void
       _write(elle::Buffer const& packet) = 0;
+      /// Write @a header followed by @a packet.
+      ///
+      /// Defaults to writing their concatenation.
+      virtual
+      void
+      _write_framed(elle::ConstWeakBuffer const& header,
+                    elle::Buffer const& packet);
 
     /*------------------.
     | Int serialization |
@@ -35,6 +35,7 @@ namespace elle
     void
     Barrier::open()
     {
+      auto lock = this->_lock_waiters();
       if (!this->_opened)
       {
         this->_opened = true;
@@ -48,6 +49,7 @@ namespace elle
     void
     Barrier::close()
     {
+      auto lock = this->_lock_waiters();
       if (this->_opened)
       {
         this->_raise(std::exception_ptr());
@@ -60,6 +62,7 @@ namespace elle
     bool
     Barrier::_wait(Thread* thread, Waker const& waker)
     {
+      auto lock = this->_lock_waiters();
       if (this->_opened)
         return false;
       else
@@ -98,6 +101,7 @@ namespace elle
     bool
     Barrier::InvertedBarrier::_wait(Thread* thread, Waker const& waker)
     {
+      auto lock = this->_barrier._lock_waiters();
       if (!this->_barrier._opened)
         return false;
       else
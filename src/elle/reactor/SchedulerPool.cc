@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <thread>
+
+#include <elle/assert.hh>
+#include <elle/log.hh>
+#include <elle/reactor/SchedulerPool.hh>
+#include <elle/reactor/scheduler.hh>
+#include <elle/reactor/Thread.hh>
+
+ELLE_LOG_COMPONENT("elle.reactor.SchedulerPool");
+
+namespace elle
+{
+  namespace reactor
+  {
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    SchedulerPool::SchedulerPool(int size)
+      : _schedulers()
+      , _next(0)
+      , _mutex()
+      , _empty(0)
+      , _done(false)
+    {
+      ELLE_ASSERT_GT(size, 0);
+      for (int i = 0; i < size; ++i)
+      {
+        this->_schedulers.emplace_back(std::make_unique<Scheduler>());
+        this->_schedulers.back()->_pool = this;
+      }
+    }
+
+    SchedulerPool::~SchedulerPool() = default;
+
+    /*-----------.
+    | Schedulers |
+    `-----------*/
+
+    Scheduler&
+    SchedulerPool::scheduler(int i)
+    {
+      return *this->_schedulers.at(i);
+    }
+
+    int
+    SchedulerPool::size() const
+    {
+      return this->_schedulers.size();
+    }
+
+    Scheduler&
+    SchedulerPool::next()
+    {
+      return *this->_schedulers[this->_next++ % this->_schedulers.size()];
+    }
+
+    /*----.
+    | Run |
+    `----*/
+
+    void
+    SchedulerPool::run()
+    {
+      ELLE_TRACE_SCOPE("%s: run %s schedulers", this, this->size());
+      auto eptr = std::exception_ptr{};
+      std::mutex eptr_mutex;
+      auto run = [&] (Scheduler& s)
+        {
+          try
+          {
+            s.run();
+          }
+          catch (...)
+          {
+            ELLE_TRACE("%s: %s failed: %s", this, s, elle::exception_string());
+            std::unique_lock<std::mutex> lock(eptr_mutex);
+            if (!eptr)
+              eptr = std::current_exception();
+          }
+        };
+      auto threads = std::vector<std::thread>{};
+      for (auto i = 1u; i < this->_schedulers.size(); ++i)
+        threads.emplace_back(
+          [&, i]
+          {
+            run(*this->_schedulers[i]);
+          });
+      run(*this->_schedulers[0]);
+      for (auto& t: threads)
+        t.join();
+      ELLE_TRACE("%s: done", this);
+      if (eptr)
+        std::rethrow_exception(eptr);
+    }
+
+    void
+    SchedulerPool::terminate_later()
+    {
+      // Scheduler::terminate_later is not thread safe, run it from each
+      // Scheduler.
+      for (auto& s: this->_schedulers)
+        s->io_service().post([s = s.get()] { s->terminate_later(); });
+    }
+
+    /*----------.
+    | Balancing |
+    `----------*/
+
+    void
+    SchedulerPool::_busy(Scheduler& scheduler, Thread& thread)
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      this->_busy_locked(scheduler);
+      scheduler._inbox_push(thread, thread);
+    }
+
+    void
+    SchedulerPool::_busy_locked(Scheduler& scheduler)
+    {
+      if (scheduler._pool_empty)
+      {
+        ELLE_ASSERT(!this->_done);
+        scheduler._pool_empty = false;
+        --this->_empty;
+      }
+    }
+
+    bool
+    SchedulerPool::_idle(Scheduler& scheduler)
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      // The caller checked without the lock: a Thread may have been pushed
+      // since, and it must not be marked empty with pending work.
+      if (!scheduler._running.empty() || scheduler._inbox.load())
+        return false;
+      if (!scheduler._pool_empty)
+      {
+        scheduler._pool_empty = true;
+        if (++this->_empty == this->size())
+        {
+          ELLE_TRACE("%s: no threads left in any scheduler", this);
+          this->_done = true;
+          for (auto& s: this->_schedulers)
+            s->io_service().post([]{});
+        }
+      }
+      return this->_done;
+    }
+
+    void
+    SchedulerPool::_notify(Scheduler& scheduler)
+    {
+      for (auto& s: this->_schedulers)
+        if (s.get() != &scheduler && s->_blocked)
+        {
+          s->io_service().post([]{});
+          return;
+        }
+    }
+
+    std::size_t
+    SchedulerPool::_steal(Scheduler& thief)
+    {
+      auto const size = this->_schedulers.size();
+      auto const self = std::find_if(
+        this->_schedulers.begin(), this->_schedulers.end(),
+        [&] (auto const& s) { return s.get() == &thief; });
+      ELLE_ASSERT(self != this->_schedulers.end());
+      // Victims' inboxes are emptied while we sort them out, hold the lock so
+      // they are not deemed idle meanwhile.
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      // Once done, Schedulers are only woken up to notice it.
+      if (this->_done)
+        return 0;
+      // Mark the thief busy first: the victim may run out of threads as soon
+      // as they are taken.
+      this->_busy_locked(thief);
+      auto stolen = std::vector<Thread*>{};
+      auto const start = self - this->_schedulers.begin();
+      for (auto i = 1u; i < size && stolen.empty(); ++i)
+      {
+        auto& victim = *this->_schedulers[(start + i) % size];
+        // Take the whole inbox of the victim, newest first, and give back what
+        // we do not keep.
+        auto pending = std::vector<Thread*>{};
+        for (auto t = victim._inbox.exchange(nullptr); t; t = t->_inbox_next)
+          pending.emplace_back(t);
+        if (pending.empty())
+          continue;
+        // Leave the victim half its pending threads, taking the most recent.
+        auto n = (pending.size() + 1) / 2;
+        auto kept = std::vector<Thread*>{};
+        for (auto t: pending)
+          if (n > 0 && t->dispose() && t->migratable())
+          {
+            stolen.emplace_back(t);
+            --n;
+          }
+          else
+            kept.emplace_back(t);
+        if (!kept.empty())
+        {
+          for (auto it = kept.begin(); it + 1 != kept.end(); ++it)
+            (*it)->_inbox_next = *(it + 1);
+          victim._inbox_push(*kept.front(), *kept.back());
+        }
+        if (!stolen.empty())
+          ELLE_DEBUG("%s: %s steals %s threads from %s",
+                     this, thief, stolen.size(), victim);
+      }
+      lock.unlock();
+      for (auto it = stolen.rbegin(); it != stolen.rend(); ++it)
+      {
+        (*it)->_inbox_next = nullptr;
+        (*it)->_migrate(thief);
+        thief._running.push_back(**it);
+        std::unique_lock<std::mutex> lock(thief._pool_threads_mutex);
+        thief._pool_threads.insert(*it);
+      }
+      return stolen.size();
+    }
+
+    /*----------.
+    | Printable |
+    `----------*/
+
+    void
+    SchedulerPool::print(std::ostream& s) const
+    {
+      s << "SchedulerPool " << this;
+    }
+  }
+}
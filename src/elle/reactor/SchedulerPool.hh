@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <elle/Printable.hh>
+#include <elle/attribute.hh>
+#include <elle/reactor/fwd.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    /// A set of Schedulers, each running on its own system thread with its own
+    /// io_service, that share the coroutines load.
+    ///
+    /// Threads are created on any Scheduler of the pool as usual. A Scheduler
+    /// with no ready Thread steals Threads that were not started yet from the
+    /// other Schedulers of the pool. Only detached (disposed by the Scheduler)
+    /// and `migratable` Threads are stolen: once started, a Thread stays on the
+    /// Scheduler it started on, since its asio operations and timers are bound
+    /// to that Scheduler's io_service.
+    ///
+    /// Barrier, Mutex and Signal can be shared by Threads of different
+    /// Schedulers of the pool: waking a Thread of another Scheduler is
+    /// forwarded to that Scheduler. Other Waitables remain single-scheduler.
+    ///
+    /// @code{.cc}
+    ///
+    /// auto pool = reactor::SchedulerPool{4};
+    /// auto main = reactor::Thread{
+    ///   pool.scheduler(0), "main",
+    ///   []
+    ///   {
+    ///     for (int i = 0; i < 1000; ++i)
+    ///       new reactor::Thread("job", [] { crunch(); }, reactor::dispose = true);
+    ///   }};
+    /// // Return when all Threads of all Schedulers are done.
+    /// pool.run();
+    /// @endcode
+    class SchedulerPool
+      : public elle::Printable
+    {
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// Create a pool of @a size Schedulers.
+      ///
+      /// @param size The number of Schedulers, thus of system threads.
+      SchedulerPool(int size);
+      ~SchedulerPool();
+
+    /*-----------.
+    | Schedulers |
+    `-----------*/
+    public:
+      /// The @a i-th Scheduler of the pool.
+      Scheduler&
+      scheduler(int i);
+      /// The number of Schedulers in the pool.
+      int
+      size() const;
+      /// A Scheduler of the pool, in a round-robin fashion, to spread Threads
+      /// created from outside the pool.
+      Scheduler&
+      next();
+    private:
+      ELLE_ATTRIBUTE(std::vector<std::unique_ptr<Scheduler>>, schedulers);
+      ELLE_ATTRIBUTE(std::atomic<unsigned>, next);
+
+    /*----.
+    | Run |
+    `----*/
+    public:
+      /// Run all Schedulers, the first one in the calling thread, until all
+      /// Threads of the pool are done.
+      ///
+      /// If any Scheduler fails, all Schedulers are terminated and the first
+      /// error is rethrown.
+      void
+      run();
+      /// Terminate all Schedulers of the pool.
+      void
+      terminate_later();
+
+    /*----------.
+    | Balancing |
+    `----------*/
+    private:
+      friend class Scheduler;
+      /// Note @a scheduler has Threads and hand it @a thread.
+      void
+      _busy(Scheduler& scheduler, Thread& thread);
+      /// Note @a scheduler has Threads, with the mutex held.
+      void
+      _busy_locked(Scheduler& scheduler);
+      /// Note @a scheduler has no Thread left.
+      ///
+      /// @returns Whether all Schedulers are out of Threads, and thus done.
+      bool
+      _idle(Scheduler& scheduler);
+      /// Wake an idle Scheduler so it steals work from @a scheduler.
+      void
+      _notify(Scheduler& scheduler);
+      /// Move pending Threads of other Schedulers to @a thief.
+      ///
+      /// @returns The number of Threads stolen.
+      std::size_t
+      _steal(Scheduler& thief);
+      ELLE_ATTRIBUTE(std::mutex, mutex);
+      ELLE_ATTRIBUTE(int, empty);
+      ELLE_ATTRIBUTE(bool, done);
+
+    /*----------.
+    | Printable |
+    `----------*/
+    public:
+      void
+      print(std::ostream& s) const override;
+    };
+  }
+}
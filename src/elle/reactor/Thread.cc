@@ -26,30 +26,48 @@ namespace elle
                    std::string const& name,
                    Action action,
                    bool dispose)
-      : _dispose(dispose)
-      , _managed(false)
+      : Thread(scheduler, name, std::move(action),
+               Options{dispose, false, true})
+    {}
+
+    Thread::Thread(std::string const& name,
+                   Action action,
+                   bool dispose)
+      : Thread(reactor::scheduler(), name, std::move(action), dispose)
+    {}
+
+    Thread::Thread(std::string const& name,
+                   Action action,
+                   Options options)
+      : Thread(reactor::scheduler(), name, std::move(action), options)
+    {}
+
+    Thread::Thread(Scheduler& scheduler,
+                   std::string const& name,
+                   Action action,
+                   Options options)
+      : _dispose(options.dispose)
+      , _managed(options.managed)
+      , _migratable(options.migratable)
       , _state(State::running)
       , _injection()
       , _exception()
       , _waited()
       , _timeout(false)
-      , _timeout_timer(scheduler.io_service())
+      , _timeout_timer(std::make_unique<boost::asio::deadline_timer>(
+                         scheduler.io_service()))
+      , _scheduler_hook()
+      , _inbox_next(nullptr)
       , _thread(scheduler._manager->make_thread(
                   name,
                   [this, a=std::move(action)] { this->_action_wrapper(a); }))
-      , _scheduler(scheduler)
+      , _scheduler(&scheduler)
       , _terminating(false)
       , _interruptible(true)
     {
-      _scheduler._thread_register(*this);
+      this->_scheduler->_thread_register(*this);
     }
 
-    Thread::Thread(std::string const& name,
-                   Action action,
-                   bool dispose)
-      : Thread(reactor::scheduler(), name, std::move(action), dispose)
-    {}
-
     ThreadPtr
     Thread::make_tracked(const std::string& name,
                          Action action)
@@ -78,6 +96,12 @@ namespace elle
                      this, this->state());
         this->terminate_now(false);
       }
+      if (this->_scheduler->pool())
+      {
+        std::unique_lock<std::mutex> lock(
+          this->_scheduler->_pool_threads_mutex);
+        this->_scheduler->_pool_threads.erase(this);
+      }
       this->_destructed();
     }
 
@@ -204,7 +228,7 @@ namespace elle
         ELLE_TRACE("%s: step: re-raise exception: %s",
                    *this, elle::exception_string(this->_exception_thrown));
         // Do not reraise in the context of this thread
-        this->_scheduler._current = nullptr;
+        this->_scheduler->_current = nullptr;
         std::rethrow_exception(this->_exception_thrown);
       }
     }
@@ -287,7 +311,7 @@ namespace elle
     void
     Thread::sleep(Duration d)
     {
-      Sleep sleep(_scheduler, d);
+      Sleep sleep(*this->_scheduler, d);
       sleep.run();
     }
 
@@ -341,10 +365,10 @@ namespace elle
       {
         if (timeout)
         {
-          this->_timeout_timer.expires_from_now(*timeout);
+          this->_timeout_timer->expires_from_now(*timeout);
           this->_timeout = false;
           auto repr = elle::sprintf("%s", waitables);
-          this->_timeout_timer.async_wait(
+          this->_timeout_timer->async_wait(
             [this, repr]
             (boost::system::error_code const& e)
             {
@@ -354,7 +378,7 @@ namespace elle
             {
               ELLE_DUMP("%s: cancel timeout", *this);
               if (!this->_timeout)
-                this->_timeout_timer.cancel();
+                this->_timeout_timer->cancel();
             };
           return elle::With<elle::Finally>(cancel_timeout) << [&]
           {
@@ -374,12 +398,12 @@ namespace elle
 
     void Thread::terminate()
     {
-      _scheduler._terminate(this);
+      this->_scheduler->_terminate(this);
     }
 
     void Thread::terminate_now(bool suicide)
     {
-      _scheduler._terminate_now(this, suicide);
+      this->_scheduler->_terminate_now(this, suicide);
     }
 
     bool
@@ -444,8 +468,8 @@ namespace elle
       for (Waitable* waitable: _waited)
         waitable->_unwait(this);
       this->_waited.clear();
-      this->_timeout_timer.cancel();
-      this->_scheduler._unfreeze(*this, reason);
+      this->_timeout_timer->cancel();
+      this->_scheduler->_unfreeze(*this, reason);
       this->_state = State::running;
     }
 
@@ -453,7 +477,7 @@ namespace elle
     Thread::_freeze()
     {
       ELLE_TRACE_SCOPE("%s: freeze", *this);
-      _scheduler._freeze(*this);
+      this->_scheduler->_freeze(*this);
       _state = State::frozen;
       yield();
     }
@@ -461,19 +485,41 @@ namespace elle
     void
     Thread::_wake(Waitable* waitable)
     {
-      ELLE_TRACE("%s: wait ended for %s", *this, *waitable)
+      auto const current = Scheduler::scheduler();
+      if (this->_scheduler->pool() && current && current != this->_scheduler)
+      {
+        // Signaled from another scheduler of a pool: our state may only be
+        // touched from our own scheduler. The Waitable may be gone by the
+        // time the wake is run, only forward what we need of it.
+        ELLE_TRACE("%s: wait ended for %s from %s",
+                   *this, *waitable, *current);
+        this->_scheduler->_wake_remote(
+          *this, waitable, waitable->_exception,
+          elle::sprintf("%s", *waitable));
+      }
+      else
+        this->_wake(waitable, waitable->_exception,
+                    elle::sprintf("%s", *waitable));
+    }
+
+    void
+    Thread::_wake(Waitable* waitable,
+                  std::exception_ptr const& exception,
+                  std::string const& description)
+    {
+      ELLE_TRACE("%s: wait ended for %s", *this, description)
       {
-        if (waitable->_exception && !this->_exception)
+        if (exception && !this->_exception)
         {
           ELLE_TRACE("%s: forward exception", *this);
-          this->_exception = waitable->_exception;
+          this->_exception = exception;
         }
         this->_waited.erase(waitable);
         if (this->_waited.empty())
         {
           ELLE_TRACE("%s: nothing to wait on, waking up", *this);
-          this->_scheduler._unfreeze(
-            *this, elle::sprintf("wait for %s ended", *waitable));
+          this->_scheduler->_unfreeze(
+            *this, elle::sprintf("wait for %s ended", description));
           this->_state = State::running;
         }
         else
@@ -489,7 +535,23 @@ namespace elle
     Scheduler&
     Thread::scheduler()
     {
-      return _scheduler;
+      return *this->_scheduler;
+    }
+
+    void
+    Thread::_migrate(Scheduler& scheduler)
+    {
+      ELLE_ASSERT(this->_migratable);
+      ELLE_ASSERT_EQ(this->_thread->status(), backend::Thread::Status::starting);
+      ELLE_TRACE("%s: migrate from %s to %s",
+                 *this, *this->_scheduler, scheduler);
+      // The coroutine never ran: rebuild it, and its timer, on the new
+      // scheduler's backend and io_service.
+      this->_timeout_timer =
+        std::make_unique<boost::asio::deadline_timer>(scheduler.io_service());
+      this->_thread = scheduler._manager->make_thread(
+        this->_thread->name(), this->_thread->action());
+      this->_scheduler = &scheduler;
     }
 
     void
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <boost/intrusive/list_hook.hpp>
 #include <boost/signals2.hpp>
 #include <boost/system/error_code.hpp>
 
@@ -22,6 +23,7 @@ namespace elle
 
     ELLE_DAS_SYMBOL(dispose);
     ELLE_DAS_SYMBOL(managed);
+    ELLE_DAS_SYMBOL(migratable);
 
     /// Thread represent a coroutine in a Scheduler environment.
     ///
@@ -124,7 +126,8 @@ namespace elle
       /// @param scheduler The Scheduler in charge of the Thread.
       /// @param name A descriptive name of Thread to be spawn.
       /// @param action The action to execute.
-      /// @param args The named arguments `dispose` and `managed`.
+      /// @param args The named arguments `dispose`, `managed` and
+      ///             `migratable`.
       template <typename ... Args>
       Thread(std::string const& name,
              Action action,
@@ -157,6 +160,21 @@ namespace elle
                    Action action);
       virtual
       ~Thread();
+    private:
+      /// Options applied before the Thread is registered to its Scheduler.
+      struct Options
+      {
+        bool dispose;
+        bool managed;
+        bool migratable;
+      };
+      Thread(Scheduler& scheduler,
+             std::string const& name,
+             Action action,
+             Options options);
+      Thread(std::string const& name,
+             Action action,
+             Options options);
     protected:
       /// Called by the scheduler when it doesn't reference this anymore.
       virtual
@@ -166,6 +184,9 @@ namespace elle
       ELLE_ATTRIBUTE(ThreadPtr, self);
       ELLE_ATTRIBUTE_RW(bool, dispose);
       ELLE_ATTRIBUTE_RW(bool, managed);
+      /// Whether a SchedulerPool may move the Thread to another Scheduler
+      /// before it starts. Set it through the `migratable` named argument.
+      ELLE_ATTRIBUTE_R(bool, migratable);
 
     /*----------.
     | Backtrace |
@@ -309,9 +330,14 @@ namespace elle
       _freeze();
       void
       _wake(Waitable* waitable);
+      void
+      _wake(Waitable* waitable,
+            std::exception_ptr const& exception,
+            std::string const& description);
       ELLE_ATTRIBUTE_R(std::set<Waitable*>, waited);
       ELLE_ATTRIBUTE(bool, timeout);
-      ELLE_ATTRIBUTE(boost::asio::deadline_timer, timeout_timer);
+      ELLE_ATTRIBUTE(std::unique_ptr<boost::asio::deadline_timer>,
+                     timeout_timer);
 
     /*------.
     | Hooks |
@@ -365,8 +391,18 @@ namespace elle
       Scheduler& scheduler();
     private:
       friend class Scheduler;
+      friend class SchedulerPool;
+      using SchedulerHook = boost::intrusive::list_member_hook<
+        boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
+      /// Link in the running or frozen list of the Scheduler.
+      SchedulerHook _scheduler_hook;
+      /// Next Thread in the inbox of the Scheduler.
+      Thread* _inbox_next;
       ELLE_ATTRIBUTE(std::unique_ptr<backend::Thread>, thread);
-      ELLE_ATTRIBUTE(Scheduler&, scheduler);
+      /// Move the Thread, which must not have started yet, to @a scheduler.
+      void
+      _migrate(Scheduler& scheduler);
+      ELLE_ATTRIBUTE(Scheduler*, scheduler);
       ELLE_ATTRIBUTE_R(bool, terminating);
       /// If set to false, do not rethrow Terminate exception.
       ELLE_ATTRIBUTE_Rw(bool, interruptible);
@@ -12,16 +12,16 @@ namespace elle
     Thread::Thread(std::string const& name,
                    Action action,
                    Args&& ... args)
-      : Thread(name, std::move(action))
-    {
-      elle::das::named::prototype(reactor::dispose = false,
-                                  reactor::managed = false)
-        .call([&] (bool dispose, bool managed)
+      : Thread(
+        name, std::move(action),
+        elle::das::named::prototype(reactor::dispose = false,
+                                    reactor::managed = false,
+                                    reactor::migratable = true)
+        .call([] (bool dispose, bool managed, bool migratable)
               {
-                this->_dispose = dispose;
-                this->_managed = managed;
-              }, std::forward<Args>(args)...);
-    }
+                return Options{dispose, managed, migratable};
+              }, std::forward<Args>(args)...))
+    {}
 
     template <typename R>
     static
@@ -29,6 +29,7 @@ namespace elle
     Waitable::Waitable(Waitable&& source)
       : _name(source._name)
       , _waiters(std::move(source._waiters))
+      , _waiters_mutex()
       , _exception(source._exception)
     {}
 
@@ -52,6 +53,16 @@ namespace elle
       }
     }
 
+    std::unique_lock<std::recursive_mutex>
+    Waitable::_lock_waiters()
+    {
+      auto const sched = Scheduler::scheduler();
+      if (sched && sched->pool())
+        return std::unique_lock<std::recursive_mutex>(this->_waiters_mutex);
+      else
+        return std::unique_lock<std::recursive_mutex>();
+    }
+
     /*--------.
     | Waiting |
     `--------*/
@@ -69,6 +80,7 @@ namespace elle
     int
     Waitable::_signal()
     {
+      auto lock = this->_lock_waiters();
       if (_waiters.empty())
       {
         _exception = std::exception_ptr{}; // An empty one.
@@ -90,6 +102,7 @@ namespace elle
     Thread*
     Waitable::_signal_one()
     {
+      auto lock = this->_lock_waiters();
       if (this->_waiters.empty())
       {
         this->_exception = std::exception_ptr{}; // An empty one.
@@ -104,6 +117,7 @@ namespace elle
     void
     Waitable::_signal_one(Thread* t)
     {
+      auto lock = this->_lock_waiters();
       auto thread = this->_waiters.get<1>().find(t);
       if (thread != this->_waiters.get<1>().end())
         return _signal_one(*thread);
@@ -112,6 +126,7 @@ namespace elle
     void
     Waitable::_signal_one(Handler const& thread)
     {
+      auto lock = this->_lock_waiters();
       if (thread.second)
         thread.second(thread.first);
       else
@@ -126,6 +141,7 @@ namespace elle
     Waitable::_wait(Thread* t, Waker const& waker)
     {
       ELLE_TRACE("%s: wait %s", t, this);
+      auto lock = this->_lock_waiters();
       ELLE_ASSERT_EQ(this->_waiters.get<1>().find(t),
                      this->_waiters.get<1>().end());
       this->_waiters.emplace_back(t, waker);
@@ -136,9 +152,13 @@ namespace elle
     Waitable::_unwait(Thread* t)
     {
       ELLE_TRACE("%s: unwait %s", t, this);
-      ELLE_ASSERT_NEQ(this->_waiters.get<1>().find(t),
-                      this->_waiters.get<1>().end());
-      this->_waiters.get<1>().erase(t);
+      auto lock = this->_lock_waiters();
+      auto it = this->_waiters.get<1>().find(t);
+      // In a pool, a thread of another scheduler may already have signaled
+      // us, the wake being still in flight to the waiter's scheduler.
+      ELLE_ASSERT(it != this->_waiters.get<1>().end() || t->scheduler().pool());
+      if (it != this->_waiters.get<1>().end())
+        this->_waiters.get<1>().erase(it);
     }
 
     void
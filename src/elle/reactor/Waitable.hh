@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <set>
 
 #include <boost/function.hpp>
@@ -100,6 +101,15 @@ namespace elle
     public:
       ELLE_ATTRIBUTE_R(std::string, name);
       ELLE_ATTRIBUTE_R(Waiters, waiters);
+    protected:
+      /// Guards the waiters and the subclasses state against threads of
+      /// other schedulers of a SchedulerPool. Recursive since wakers and
+      /// subclasses re-enter the Waitable.
+      std::recursive_mutex _waiters_mutex;
+      /// Lock _waiters_mutex if the current Scheduler belongs to a pool,
+      /// leave it alone otherwise.
+      std::unique_lock<std::recursive_mutex>
+      _lock_waiters();
 
     /*--------.
     | Waiting |
@@ -0,0 +1,259 @@
+#include <elle/reactor/backend/StackPool.hh>
+
+#include <new>
+
+#ifdef INFINIT_WINDOWS
+# include <windows.h>
+#else
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+#include <elle/assert.hh>
+#include <elle/log.hh>
+
+ELLE_LOG_COMPONENT("elle.reactor.backend.StackPool");
+
+namespace elle
+{
+  namespace reactor
+  {
+    namespace backend
+    {
+      namespace
+      {
+        std::size_t
+        page_size()
+        {
+#ifdef INFINIT_WINDOWS
+          auto info = SYSTEM_INFO{};
+          GetSystemInfo(&info);
+          return info.dwPageSize;
+#else
+          return ::sysconf(_SC_PAGESIZE);
+#endif
+        }
+
+        std::size_t
+        round_up(std::size_t size, std::size_t page)
+        {
+          return (size + page - 1) / page * page;
+        }
+      }
+
+      /*-------------.
+      | Construction |
+      `-------------*/
+
+      std::size_t const StackPool::default_stack_size = 4 * 128 * 1024;
+      std::size_t const StackPool::default_max_free = 64;
+      std::size_t const StackPool::slab_stacks = 64;
+
+      StackPool::StackPool(std::size_t stack_size,
+                           std::size_t max_free,
+                           bool guard)
+        : _stack_size()
+        , _max_free(max_free)
+        , _guard(guard)
+        , _page_size(page_size())
+      {
+        this->_stack_size = round_up(stack_size, this->_page_size);
+        this->_free.reserve(this->_max_free);
+        ELLE_DEBUG("%s: create with stack size %s, keeping up to %s stacks%s",
+                   this, this->_stack_size, this->_max_free,
+                   this->_guard ? ", guarded" : "");
+      }
+
+      StackPool::~StackPool()
+      {
+        ELLE_DEBUG("%s: destroy: %s hits, %s misses, %s stacks at peak",
+                   this, this->_statistics.hits, this->_statistics.misses,
+                   this->_statistics.peak);
+        ELLE_ASSERT_EQ(this->_statistics.used, 0u);
+        if (this->_guard)
+          for (auto const& stack: this->_free)
+            this->_unmap_guarded(stack);
+        for (auto const& slab: this->_slabs)
+        {
+#ifdef INFINIT_WINDOWS
+          ::VirtualFree(slab.base, 0, MEM_RELEASE);
+#else
+          ::munmap(slab.base, slab.size);
+#endif
+        }
+      }
+
+      /*-----------.
+      | Allocation |
+      `-----------*/
+
+      StackPool::Stack
+      StackPool::allocate()
+      {
+        {
+          auto lock = std::unique_lock<std::mutex>(this->_mutex);
+          auto& stats = this->_statistics;
+          stats.peak = std::max(stats.peak, ++stats.used);
+          if (!this->_free.empty())
+          {
+            ++stats.hits;
+            auto res = this->_free.back();
+            this->_free.pop_back();
+            return res;
+          }
+          ++stats.misses;
+          if (!this->_spare.empty())
+          {
+            auto res = this->_spare.back();
+            this->_spare.pop_back();
+            return res;
+          }
+        }
+        try
+        {
+          return this->_guard ? this->_map_guarded() : this->_map_slab();
+        }
+        catch (...)
+        {
+          auto lock = std::unique_lock<std::mutex>(this->_mutex);
+          --this->_statistics.used;
+          throw;
+        }
+      }
+
+      void
+      StackPool::deallocate(Stack stack)
+      {
+        ELLE_ASSERT(stack.base);
+        ELLE_ASSERT_EQ(stack.size, this->_stack_size);
+        {
+          auto lock = std::unique_lock<std::mutex>(this->_mutex);
+          --this->_statistics.used;
+          if (this->_free.size() < this->_max_free)
+          {
+            this->_free.push_back(stack);
+            return;
+          }
+          if (this->_guard)
+            --this->_statistics.mappings;
+        }
+        if (this->_guard)
+          this->_unmap_guarded(stack);
+        else
+        {
+          this->_decommit(stack);
+          auto lock = std::unique_lock<std::mutex>(this->_mutex);
+          this->_spare.push_back(stack);
+        }
+      }
+
+      StackPool::Statistics
+      StackPool::statistics() const
+      {
+        auto lock = std::unique_lock<std::mutex>(this->_mutex);
+        return this->_statistics;
+      }
+
+      StackPool::Stack
+      StackPool::_map_slab()
+      {
+        auto const total = this->_stack_size * slab_stacks;
+#ifdef INFINIT_WINDOWS
+        auto const region = static_cast<char*>(
+          ::VirtualAlloc(nullptr, total, MEM_RESERVE | MEM_COMMIT,
+                         PAGE_READWRITE));
+        if (!region)
+          throw std::bad_alloc();
+#else
+        auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+# ifdef MAP_NORESERVE
+        flags |= MAP_NORESERVE;
+# endif
+# ifdef MAP_STACK
+        flags |= MAP_STACK;
+# endif
+        auto const mapping =
+          ::mmap(nullptr, total, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (mapping == MAP_FAILED)
+          throw std::bad_alloc();
+        auto const region = static_cast<char*>(mapping);
+#endif
+        ELLE_DEBUG("%s: map slab of %s stacks at %x", this, slab_stacks, region);
+        auto lock = std::unique_lock<std::mutex>(this->_mutex);
+        this->_slabs.push_back(Stack{region, total});
+        ++this->_statistics.mappings;
+        // Hand out the lowest stack first.
+        for (auto i = slab_stacks - 1; i > 0; --i)
+          this->_spare.push_back(
+            Stack{region + i * this->_stack_size, this->_stack_size});
+        return Stack{region, this->_stack_size};
+      }
+
+      StackPool::Stack
+      StackPool::_map_guarded()
+      {
+        auto const total = this->_stack_size + this->_page_size;
+#ifdef INFINIT_WINDOWS
+        auto const region = static_cast<char*>(
+          ::VirtualAlloc(nullptr, total, MEM_RESERVE | MEM_COMMIT,
+                         PAGE_READWRITE));
+        if (!region)
+          throw std::bad_alloc();
+        auto old = DWORD{};
+        if (!::VirtualProtect(region, this->_page_size, PAGE_NOACCESS, &old))
+        {
+          ::VirtualFree(region, 0, MEM_RELEASE);
+          throw std::bad_alloc();
+        }
+#else
+        auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+# ifdef MAP_NORESERVE
+        flags |= MAP_NORESERVE;
+# endif
+# ifdef MAP_STACK
+        flags |= MAP_STACK;
+# endif
+        auto const mapping =
+          ::mmap(nullptr, total, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (mapping == MAP_FAILED)
+          throw std::bad_alloc();
+        auto const region = static_cast<char*>(mapping);
+        if (::mprotect(region, this->_page_size, PROT_NONE))
+        {
+          ::munmap(region, total);
+          throw std::bad_alloc();
+        }
+#endif
+        ELLE_DUMP("%s: map stack at %x", this, region);
+        {
+          auto lock = std::unique_lock<std::mutex>(this->_mutex);
+          ++this->_statistics.mappings;
+        }
+        return Stack{region + this->_page_size, this->_stack_size};
+      }
+
+      void
+      StackPool::_unmap_guarded(Stack stack)
+      {
+        auto const region = static_cast<char*>(stack.base) - this->_page_size;
+        ELLE_DUMP("%s: unmap stack at %x", this, region);
+#ifdef INFINIT_WINDOWS
+        ::VirtualFree(region, 0, MEM_RELEASE);
+#else
+        ::munmap(region, stack.size + this->_page_size);
+#endif
+      }
+
+      void
+      StackPool::_decommit(Stack stack)
+      {
+        ELLE_DUMP("%s: decommit stack at %x", this, stack.base);
+#ifdef INFINIT_WINDOWS
+        ::VirtualAlloc(stack.base, stack.size, MEM_RESET, PAGE_READWRITE);
+#else
+        ::madvise(stack.base, stack.size, MADV_DONTNEED);
+#endif
+      }
+    }
+  }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <elle/attribute.hh>
+#include <elle/compiler.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    namespace backend
+    {
+      /// Pool of coroutine stacks of a given size class.
+      ///
+      /// Stacks are carved out of large slabs mapped straight from the system,
+      /// so that hundreds of thousands of coroutines stay well within the
+      /// process' mapping limit (vm.max_map_count on Linux). Pages are only
+      /// committed when first touched. Released stacks are kept on a bounded
+      /// free list and handed back to the next allocation, sparing the page
+      /// faults. Beyond that bound, their pages are given back to the system
+      /// but their addresses stay in the pool.
+      ///
+      /// Optionally, every stack is mapped on its own above a non-accessible
+      /// guard page: overflowing a stack faults instead of silently corrupting
+      /// its neighbor, at the cost of two mappings per stack.
+      class ELLE_API StackPool
+      {
+      /*------.
+      | Types |
+      `------*/
+      public:
+        using Self = StackPool;
+        /// A usable stack, guard page excluded.
+        struct Stack
+        {
+          /// Lowest usable address.
+          void* base;
+          /// Usable size.
+          std::size_t size;
+          /// Highest address, where the stack starts as it grows down.
+          void*
+          top() const
+          {
+            return static_cast<char*>(this->base) + this->size;
+          }
+        };
+        /// Usage counters.
+        struct Statistics
+        {
+          /// Allocations served from the free list.
+          std::size_t hits = 0;
+          /// Allocations not served from the free list.
+          std::size_t misses = 0;
+          /// System mappings currently held, slabs or guarded stacks.
+          std::size_t mappings = 0;
+          /// Stacks currently handed out.
+          std::size_t used = 0;
+          /// Highest number of stacks handed out at once.
+          std::size_t peak = 0;
+        };
+
+      /*-------------.
+      | Construction |
+      `-------------*/
+      public:
+        /// Create a pool.
+        ///
+        /// @param stack_size Usable size of every stack, rounded up to the
+        ///                   page size.
+        /// @param max_free   How many released stacks to keep for reuse.
+        /// @param guard      Whether to map every stack on its own, above a
+        ///                   guard page.
+        StackPool(std::size_t stack_size = default_stack_size,
+                  std::size_t max_free = default_max_free,
+                  bool guard = false);
+        /// Unmap all pooled stacks.
+        ~StackPool();
+        StackPool(StackPool const&) = delete;
+        StackPool&
+        operator =(StackPool const&) = delete;
+        /// Default usable stack size: 512 kiB.
+        static std::size_t const default_stack_size;
+        /// Default free list bound.
+        static std::size_t const default_max_free;
+        /// Number of stacks carved out of every slab.
+        static std::size_t const slab_stacks;
+
+      /*-----------.
+      | Allocation |
+      `-----------*/
+      public:
+        /// A stack, recycled if possible.
+        Stack
+        allocate();
+        /// Give back a stack obtained from allocate().
+        void
+        deallocate(Stack stack);
+        /// A snapshot of the usage counters.
+        Statistics
+        statistics() const;
+        /// Usable size of every stack.
+        ELLE_ATTRIBUTE_R(std::size_t, stack_size);
+        /// How many released stacks are kept for reuse.
+        ELLE_ATTRIBUTE_R(std::size_t, max_free);
+        /// Whether every stack has its own mapping and guard page.
+        ELLE_ATTRIBUTE_R(bool, guard);
+      private:
+        /// Map a fresh slab, return its first stack and keep the others spare.
+        Stack
+        _map_slab();
+        /// Map a fresh stack and its guard page.
+        Stack
+        _map_guarded();
+        /// Unmap a stack and its guard page.
+        void
+        _unmap_guarded(Stack stack);
+        /// Give the pages of a slab stack back to the system.
+        void
+        _decommit(Stack stack);
+        ELLE_ATTRIBUTE(std::size_t, page_size);
+        /// Released stacks whose pages are still committed.
+        ELLE_ATTRIBUTE(std::vector<Stack>, free);
+        /// Slab stacks whose pages were given back, or never touched.
+        ELLE_ATTRIBUTE(std::vector<Stack>, spare);
+        /// Slabs, unmapped with the pool.
+        ELLE_ATTRIBUTE(std::vector<Stack>, slabs);
+        ELLE_ATTRIBUTE(Statistics, statistics);
+        ELLE_ATTRIBUTE(std::mutex, mutex, mutable);
+      };
+    }
+  }
+}
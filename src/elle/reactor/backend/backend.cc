@@ -10,6 +10,8 @@
 # define THROW_SPEC throw()
 #endif
 
+#include <elle/os/environ.hh>
+
 namespace elle
 {
   namespace reactor
@@ -20,6 +22,12 @@ namespace elle
       | Backend |
       `--------*/
 
+      Backend::Backend(std::size_t stack_size)
+        : _stacks(std::make_shared<StackPool>(
+                    stack_size, StackPool::default_max_free,
+                    elle::os::inenv("ELLE_REACTOR_STACK_GUARD")))
+      {}
+
       Backend::~Backend()
       = default;
 
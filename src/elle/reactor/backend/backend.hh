@@ -5,6 +5,7 @@
 #include <string>
 
 #include <elle/attribute.hh>
+#include <elle/reactor/backend/StackPool.hh>
 #include <elle/reactor/backend/fwd.hh>
 
 namespace elle
@@ -30,6 +31,15 @@ namespace elle
         virtual
         ~Backend();
 
+      /*-------------.
+      | Construction |
+      `-------------*/
+      protected:
+        /// Create a backend whose coroutines have stacks of stack_size.
+        ///
+        /// Stacks have guard pages if ELLE_REACTOR_STACK_GUARD is set.
+        Backend(std::size_t stack_size = StackPool::default_stack_size);
+
       /*--------.
       | Threads |
       `--------*/
@@ -43,6 +53,10 @@ namespace elle
         virtual
         Thread*
         current() const = 0;
+        /// Stacks of the coroutines of this backend.
+        ///
+        /// Threads share ownership so they can safely outlive their backend.
+        ELLE_ATTRIBUTE_R(std::shared_ptr<StackPool>, stacks);
       };
 
       class Thread
@@ -32,73 +32,12 @@ namespace elle
     {
       namespace boost
       {
-        /*----------------.
-        | Stack Allocator |
-        `----------------*/
-        template <std::size_t Max, std::size_t Default, std::size_t Min>
-        class TemplatedStackAllocator
-        {
-        public:
-          static
-          std::size_t
-          maximum_stack_size()
-          {
-            return Max;
-          }
-
-          static
-          std::size_t
-          default_stack_size()
-          {
-            return Default;
-          }
-
-          static
-          std::size_t
-          minimum_stack_size()
-          {
-            return Min;
-          }
-
-          void*
-          allocate(std::size_t size) const
-          {
-            ELLE_ASSERT(minimum_stack_size() <= size);
-            ELLE_ASSERT(maximum_stack_size() >= size);
-
-            if (auto limit = std::malloc(size))
-              return static_cast<char*>(limit) + size;
-            else
-              throw std::bad_alloc();
-          }
-
-          void
-          deallocate(void* vp, std::size_t size) const
-          {
-            ELLE_ASSERT(vp);
-            ELLE_ASSERT(minimum_stack_size() <= size);
-            ELLE_ASSERT(maximum_stack_size() >= size);
-
-            void* limit = static_cast<char*>(vp) - size;
-            std::free(limit);
-          }
-        };
-
         /*-------.
         | Thread |
         `-------*/
-        /// Default allocator type.
-        using StackAllocator = TemplatedStackAllocator<
-          8 * 1024 * 1024,  // Max: 8 MiB
-          4 * 128 * 1024,   // Default: 128 kiB
-          8 * 1024          // Min: 8 kiB
-          >;
         /// Type of context pointer used.
         using Context = ::boost::context::fcontext_t;
 
-        /// Allocator.
-        static StackAllocator stack_allocator;
-
         /// Invoke thread_ptr->_run().
         static
         void
@@ -125,7 +64,10 @@ namespace elle
                  Action action)
             : Super(name, std::move(action))
             , _backend(backend)
-            , _stack_pointer(stack_allocator.allocate(this->_stack_size))
+            , _stacks(backend.stacks())
+            , _stack(this->_stacks->allocate())
+            , _stack_pointer(this->_stack.top())
+            , _stack_size(this->_stack.size)
             , _context(make_fcontext(this->_stack_pointer,
                                      this->_stack_size, wrapped_run))
             , _root(false)
@@ -150,8 +92,7 @@ namespace elle
             if (this->_context)
             {
               this->_context = nullptr;
-              stack_allocator.deallocate(this->_stack_pointer,
-                                         this->_stack_size);
+              this->_stacks->deallocate(this->_stack);
             }
 #ifdef VALGRIND
             VALGRIND_STACK_DEREGISTER(this->_valgrind_stack);
@@ -170,7 +111,7 @@ namespace elle
           /// The bottom of the stack.
           void* _base_pointer() const
           {
-            return static_cast<char*>(this->_stack_pointer) - this->_stack_size;
+            return this->_stack.base;
           }
 
           /// Pass the execution from @from to @to.
@@ -312,10 +253,14 @@ namespace elle
 
           /// Owning backend.
           Backend& _backend;
-          /// Context stack size.
-          std::size_t const _stack_size = StackAllocator::default_stack_size();
+          /// Pool our stack comes from.
+          std::shared_ptr<StackPool> _stacks;
+          /// Context stack, above its guard page.
+          StackPool::Stack _stack;
           /// Context stack pointer.
           void* _stack_pointer;
+          /// Context stack size.
+          std::size_t const _stack_size;
           /// Underlying IO context.
           Context _context;
           /// The thread that stepped us.
@@ -341,8 +286,9 @@ namespace elle
         | Backend |
         `--------*/
 
-        Backend::Backend()
-          : _self(new Thread(*this))
+        Backend::Backend(std::size_t stack_size)
+          : Super(stack_size)
+          , _self(new Thread(*this))
           , _current(this->_self.get())
         {}
 
@@ -43,6 +43,8 @@ namespace elle
             : Super(name, std::move(action))
             , _backend(backend)
             , _coro(Coro_new())
+            , _stacks(backend.stacks())
+            , _stack{nullptr, 0}
             , _root(false)
           {}
 
@@ -57,6 +59,8 @@ namespace elle
               Coro_free(_coro);
               _coro = nullptr;
             }
+            if (this->_stack.base)
+              this->_stacks->deallocate(this->_stack);
           }
 
         private:
@@ -90,6 +94,11 @@ namespace elle
             {
               this->status(Status::running);
               ELLE_ASSERT(_coro);
+#ifndef USE_FIBERS
+              // Fibers manage their own stack.
+              this->_stack = this->_stacks->allocate();
+              Coro_setStack_(_coro, this->_stack.base, this->_stack.size);
+#endif
               ELLE_TRACE("%s: start %s", *current , *this);
               Coro_startCoro_(_caller->_coro, _coro, this, &starter);
               ELLE_TRACE("%s: back from %s", *current, *this);
@@ -184,6 +193,10 @@ namespace elle
           Backend& _backend;
           /// Underlying IO coroutine.
           struct Coro* _coro;
+          /// Pool our stack comes from.
+          std::shared_ptr<StackPool> _stacks;
+          /// Coroutine stack, taken from the pool when we first start.
+          StackPool::Stack _stack;
           /// The thread that stepped us.
           Thread* _caller = nullptr;
           /// Let libcoroutine callback invoke our _run.
@@ -203,8 +216,9 @@ namespace elle
         | Backend |
         `--------*/
 
-        Backend::Backend()
-          : _self(new Thread(*this))
+        Backend::Backend(std::size_t stack_size)
+          : Super(stack_size)
+          , _self(new Thread(*this))
           , _current(_self.get())
         {}
 
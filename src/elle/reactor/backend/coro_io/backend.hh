@@ -28,7 +28,7 @@ namespace elle
         | Construction |
         `-------------*/
         public:
-          Backend();
+          Backend(std::size_t stack_size = StackPool::default_stack_size);
           ~Backend();
 
         /*--------.
@@ -83,13 +83,15 @@ Coro *Coro_new(void)
 #else
 	self->stack = nullptr;
 #endif
+	self->ownsStack = 1;
 	return self;
 }
 
 #ifndef USE_FIBERS
 void Coro_allocStackIfNeeded(Coro *self)
 {
-	if (self->stack && self->requestedStackSize < self->allocatedStackSize)
+	if (self->stack && self->ownsStack &&
+	    self->requestedStackSize < self->allocatedStackSize)
 	{
 		io_free(self->stack);
 		self->stack = nullptr;
@@ -119,7 +121,8 @@ void Coro_free(Coro *self)
 	if (self->stack)
 	{
                 STACK_DEREGISTER(self);
-		io_free(self->stack);
+		if (self->ownsStack)
+			io_free(self->stack);
 	}
 #endif
 
@@ -147,6 +150,26 @@ void Coro_setStackSize_(Coro *self, size_t sizeInBytes)
 	//printf("Coro_%p io_reallocating stack size %i\n", (void *)self, sizeInBytes);
 }
 
+void Coro_setStack_(Coro *self, void *stack, size_t sizeInBytes)
+{
+#ifndef USE_FIBERS
+	if (self->stack)
+	{
+		STACK_DEREGISTER(self);
+		if (self->ownsStack)
+			io_free(self->stack);
+	}
+	self->stack = stack;
+	self->requestedStackSize = sizeInBytes;
+	self->allocatedStackSize = sizeInBytes;
+	self->ownsStack = 0;
+	STACK_REGISTER(self);
+#else
+	(void)stack;
+	self->requestedStackSize = sizeInBytes;
+#endif
+}
+
 #if __GNUC__ == 4
 uint8_t *Coro_CurrentStackPointer(void) __attribute__ ((noinline));
 #endif
@@ -80,6 +80,7 @@ struct Coro
 	size_t requestedStackSize;
 	size_t allocatedStackSize;
 	void *stack;
+	unsigned char ownsStack;
 
 #ifdef USE_VALGRIND
 	unsigned int valgrindStackId;
@@ -109,6 +110,8 @@ CORO_API uint8_t *Coro_CurrentStackPointer(void)
 #endif
   ;
 CORO_API void Coro_setStackSize_(Coro *self, size_t sizeInBytes);
+// Use a caller-owned stack, which Coro_free will not release.
+CORO_API void Coro_setStack_(Coro *self, void *stack, size_t sizeInBytes);
 CORO_API size_t Coro_bytesLeftOnStack(Coro *self);
 CORO_API int Coro_stackSpaceAlmostGone(Coro *self);
 
@@ -5,6 +5,8 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
+
 #include <elle/assert.hh>
 #include <elle/log.hh>
 #include <elle/reactor/filesystem.hh>
@@ -44,17 +46,279 @@ namespace elle
           return Waitable::_wait(thread, waker);
       }
 
+      /*----------.
+      | PathCache |
+      `----------*/
+
+      namespace
+      {
+        /// Approximate memory used by an entry, including its slot in its
+        /// parent's children.
+        std::size_t
+        cost(std::string const& name)
+        {
+          return 2 * name.size() + 160;
+        }
+
+        template <typename F>
+        void
+        components(std::string const& path, F const& f)
+        {
+          auto begin = path.begin();
+          while (begin != path.end())
+          {
+            auto end = std::find(begin, path.end(), '/');
+            if (end != begin)
+              if (!f(std::string(begin, end)))
+                return;
+            begin = end == path.end() ? end : end + 1;
+          }
+        }
+      }
+
+      PathCache::Node::Node(Node* parent, std::string name)
+        : parent(parent)
+        , name(std::move(name))
+        , children()
+        , content()
+        , missing()
+        , lru()
+      {}
+
+      PathCache::PathCache(std::size_t size, Duration negative_ttl)
+        : _negative_ttl(negative_ttl)
+        , _statistics{0, 0, 0, 0, 0, 0, 0}
+        , _size(size)
+        , _root(std::make_unique<Node>(nullptr, ""))
+        , _lru()
+      {}
+
+      PathCache::~PathCache()
+      {
+        this->clear();
+      }
+
+      std::shared_ptr<Path>
+      PathCache::get(std::string const& path)
+      {
+        auto chain = std::vector<Node*>{};
+        auto const node = this->_find(path, false, &chain);
+        // Walk down from the root, a missing parent hides its children.
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+          if (auto const& missing = (*it)->missing)
+          {
+            if (Clock::now() < *missing)
+            {
+              ++this->_statistics.negative_hits;
+              this->_touch(chain);
+              throw Error(ENOENT, "No such file or directory");
+            }
+            ++this->_statistics.expirations;
+            (*it)->missing.reset();
+            if (*it != this->_root.get() && (*it)->children.empty() &&
+                !(*it)->content)
+            {
+              this->_prune(*it);
+              ++this->_statistics.misses;
+              return nullptr;
+            }
+          }
+        if (node && node->content)
+        {
+          ++this->_statistics.hits;
+          this->_touch(chain);
+          return node->content;
+        }
+        ++this->_statistics.misses;
+        return nullptr;
+      }
+
+      void
+      PathCache::set(std::string const& path, std::shared_ptr<Path> content)
+      {
+        auto chain = std::vector<Node*>{};
+        auto const node = this->_find(path, true, &chain);
+        for (auto n: chain)
+          n->missing.reset();
+        node->content = std::move(content);
+        this->_touch(chain);
+        this->_evict();
+      }
+
+      std::shared_ptr<Path>
+      PathCache::extract(std::string const& path)
+      {
+        auto const node = this->_find(path, false);
+        if (!node)
+          return nullptr;
+        auto res = std::move(node->content);
+        node->content.reset();
+        node->missing.reset();
+        this->_prune(node);
+        return res;
+      }
+
+      void
+      PathCache::missing(std::string const& path)
+      {
+        auto chain = std::vector<Node*>{};
+        auto const node = this->_find(path, true, &chain);
+        if (node == this->_root.get())
+          return;
+        this->_drop_children(node);
+        node->content.reset();
+        node->missing = Clock::now() + std::chrono::microseconds(
+          this->_negative_ttl.total_microseconds());
+        this->_touch(chain);
+        this->_evict();
+      }
+
+      void
+      PathCache::forget_missing(std::string const& path)
+      {
+        auto chain = std::vector<Node*>{};
+        this->_find(path, false, &chain);
+        for (auto n: chain)
+          n->missing.reset();
+        if (!chain.empty())
+          this->_prune(chain.front());
+      }
+
+      void
+      PathCache::clear()
+      {
+        this->_drop_children(this->_root.get());
+        this->_root->content.reset();
+      }
+
+      std::size_t
+      PathCache::size() const
+      {
+        return this->_size;
+      }
+
+      void
+      PathCache::size(std::size_t size)
+      {
+        this->_size = size;
+        this->_evict();
+      }
+
+      PathCache::Node*
+      PathCache::_find(std::string const& path,
+                       bool create,
+                       std::vector<Node*>* chain)
+      {
+        auto node = this->_root.get();
+        if (chain)
+          chain->push_back(node);
+        components(
+          path,
+          [&] (std::string name)
+          {
+            auto it = node->children.find(name);
+            if (it == node->children.end())
+            {
+              if (!create)
+              {
+                node = nullptr;
+                return false;
+              }
+              auto const size = cost(name);
+              auto child = std::make_unique<Node>(node, name);
+              it = node->children.emplace(std::move(name),
+                                          std::move(child)).first;
+              ++this->_statistics.entries;
+              this->_statistics.bytes += size;
+              this->_lru.push_front(*it->second);
+            }
+            node = it->second.get();
+            if (chain)
+              chain->push_back(node);
+            return true;
+          });
+        if (chain)
+          std::reverse(chain->begin(), chain->end());
+        return node;
+      }
+
+      void
+      PathCache::_touch(std::vector<Node*> const& chain)
+      {
+        for (auto n: chain)
+          if (n != this->_root.get())
+          {
+            this->_lru.erase(this->_lru.iterator_to(*n));
+            this->_lru.push_front(*n);
+          }
+      }
+
+      void
+      PathCache::_drop_children(Node* node)
+      {
+        for (auto& child: node->children)
+        {
+          this->_drop_children(child.second.get());
+          this->_lru.erase(this->_lru.iterator_to(*child.second));
+          --this->_statistics.entries;
+          this->_statistics.bytes -= cost(child.first);
+        }
+        node->children.clear();
+      }
+
+      void
+      PathCache::_drop(Node* node)
+      {
+        ELLE_ASSERT_NEQ(node, this->_root.get());
+        this->_drop_children(node);
+        this->_lru.erase(this->_lru.iterator_to(*node));
+        --this->_statistics.entries;
+        this->_statistics.bytes -= cost(node->name);
+        auto& siblings = node->parent->children;
+        // Destroys node.
+        siblings.erase(siblings.find(node->name));
+      }
+
+      void
+      PathCache::_prune(Node* node)
+      {
+        while (node != this->_root.get() &&
+               !node->content && !node->missing && node->children.empty())
+        {
+          auto const parent = node->parent;
+          this->_drop(node);
+          node = parent;
+        }
+      }
+
+      void
+      PathCache::_evict()
+      {
+        while (this->_statistics.bytes > this->_size && !this->_lru.empty())
+        {
+          auto& victim = this->_lru.back();
+          ELLE_DUMP("%s: evict %s", this, victim.name);
+          ++this->_statistics.evictions;
+          auto const parent = victim.parent;
+          // Ancestors are more recent: this is a leaf.
+          this->_drop(&victim);
+          this->_prune(parent);
+        }
+      }
+
+      /*-----------.
+      | FileSystem |
+      `-----------*/
+
       std::shared_ptr<Path>
       FileSystem::fetch_recurse(std::string path)
       {
         normalize(path);
         ELLE_DEBUG_SCOPE("%s: fetch_recurse \"%s\"", *this, path);
-        ELLE_DUMP("from %s", _cache);
-        auto it = _cache.find(path);
-        if (it != _cache.end())
+        if (auto res = this->_cache.get(path))
         {
-          ELLE_DEBUG("%s: hit on '%s': %s", *this, path, it->second.get());
-          return it->second;
+          ELLE_DEBUG("%s: hit on '%s': %s", *this, path, res.get());
+          return res;
         }
         else
         {
@@ -64,14 +328,24 @@ namespace elle
             ELLE_DEBUG("%s: root fetch", *this);
             auto p = _operations->path("/");
             if (p->allow_cache())
-              _cache[path] = p;
+              this->_cache.set(path, p);
             return p;
           }
           auto bpath = bfs::path(path);
           auto parent = this->fetch_recurse(bpath.parent_path().string());
-          auto p = parent->child(bpath.filename().string());
+          auto p = std::shared_ptr<Path>{};
+          try
+          {
+            p = parent->child(bpath.filename().string());
+          }
+          catch (Error const& e)
+          {
+            if (e.error_code() == ENOENT)
+              this->_cache.missing(path);
+            throw;
+          }
           if (p->allow_cache())
-            _cache[path] = p;
+            this->_cache.set(path, p);
           return p;
         }
       }
@@ -88,18 +362,23 @@ namespace elle
           auto res = this->fetch_recurse(spath);
           return res->unwrap();
         }
+        else if (auto res = this->_cache.get(spath))
+          return res;
         else
         {
-          auto it = this->_cache.find(spath);
-          if (it == this->_cache.end())
+          try
+          {
+            res = this->_operations->path(spath);
+          }
+          catch (Error const& e)
           {
-            auto res = this->_operations->path(spath);
-            if (res->allow_cache())
-              this->_cache[spath] = res;
-            return res;
+            if (e.error_code() == ENOENT)
+              this->_cache.missing(spath);
+            throw;
           }
-          else
-            return it->second;
+          if (res->allow_cache())
+            this->_cache.set(spath, res);
+          return res;
         }
       }
 
@@ -108,11 +387,9 @@ namespace elle
       {
         std::string path(path_);
         normalize(path);
-        auto it = this->_cache.find(path);
-        if (it == this->_cache.end())
+        auto res = this->_cache.extract(path);
+        if (!res)
           return {};
-        auto res = it->second;
-        this->_cache.erase(path);
         return res->unwrap();
       }
 
@@ -123,8 +400,7 @@ namespace elle
         std::string path(path_);
         normalize(path);
         std::shared_ptr<Path> res = extract(path);
-        this->_cache[path] =
-          this->_operations->wrap(path, new_content);
+        this->_cache.set(path, this->_operations->wrap(path, new_content));
         return res;
       }
 
@@ -133,11 +409,30 @@ namespace elle
       {
         std::string path(path_);
         normalize(path);
-        auto it = this->_cache.find(path);
-        if (it == this->_cache.end())
+        try
+        {
+          return this->_cache.get(path);
+        }
+        catch (Error const&)
+        {
           return nullptr;
-        else
-          return it->second;
+        }
+      }
+
+      void
+      FileSystem::missing(std::string const& path_)
+      {
+        std::string path(path_);
+        normalize(path);
+        this->_cache.missing(path);
+      }
+
+      void
+      FileSystem::forget_missing(std::string const& path_)
+      {
+        std::string path(path_);
+        normalize(path);
+        this->_cache.forget_missing(path);
       }
 
       std::unique_ptr<Handle>
@@ -4,12 +4,16 @@
 
 #include <sys/types.h>
 
+#include <chrono>
 #include <string>
 #include <unordered_map>
 
 #include <boost/filesystem.hpp>
+#include <boost/intrusive/list.hpp>
+#include <boost/optional.hpp>
 
 #include <elle/Buffer.hh>
+#include <elle/Duration.hh>
 #include <elle/Exception.hh>
 #include <elle/filesystem.hh>
 #include <elle/reactor/Waitable.hh>
@@ -217,6 +221,118 @@ namespace elle
         ELLE_ATTRIBUTE_R(FileSystem*, filesystem, protected);
       };
 
+      /// Bounded cache of resolved Paths, with negative entries.
+      ///
+      /// Entries form a tree of path components. Looking an entry up marks
+      /// it and its ancestors as recently used, so ancestors are always more
+      /// recent than their descendants and least recently used entries,
+      /// evicted first, are leaves. The memory used by entries is accounted
+      /// approximately, excluding the Paths themselves.
+      ///
+      /// A missing entry makes lookups of its path, and of any path below,
+      /// fail with ENOENT until it expires.
+      class PathCache
+      {
+      public:
+        PathCache(std::size_t size = 64 * 1024 * 1024,
+                  Duration negative_ttl = boost::posix_time::seconds(1));
+        ~PathCache();
+        PathCache(PathCache const&) = delete;
+
+      public:
+        /// The cached Path, or null.
+        ///
+        /// \throw Error ENOENT if the path, or one of its parents, is known
+        ///        to be missing.
+        std::shared_ptr<Path>
+        get(std::string const& path);
+        /// Cache \a content for \a path. Parents are not missing anymore.
+        void
+        set(std::string const& path, std::shared_ptr<Path> content);
+        /// Remove and return the Path cached for \a path, if any. Entries
+        /// below it are kept.
+        std::shared_ptr<Path>
+        extract(std::string const& path);
+        /// Record that \a path is missing, dropping entries below it.
+        void
+        missing(std::string const& path);
+        /// Forget that \a path or its parents are missing.
+        void
+        forget_missing(std::string const& path);
+        /// Drop every entry.
+        void
+        clear();
+
+        /// Maximum memory used by entries, in bytes.
+        std::size_t
+        size() const;
+        void
+        size(std::size_t size);
+        /// How long missing entries last.
+        ELLE_ATTRIBUTE_RW(Duration, negative_ttl);
+
+        struct Statistics
+        {
+          /// Lookups answered with a Path.
+          int64_t hits;
+          /// Lookups answered with ENOENT.
+          int64_t negative_hits;
+          /// Lookups answered with nothing.
+          int64_t misses;
+          /// Entries dropped to make room.
+          int64_t evictions;
+          /// Missing entries that expired.
+          int64_t expirations;
+          /// Current number of entries.
+          std::size_t entries;
+          /// Memory used by entries, in bytes.
+          std::size_t bytes;
+        };
+        ELLE_ATTRIBUTE_R(Statistics, statistics);
+
+      private:
+        using Clock = std::chrono::steady_clock;
+        struct Node;
+        using Hook = boost::intrusive::list_member_hook<>;
+        struct Node
+        {
+          Node(Node* parent, std::string name);
+          Node* parent;
+          std::string name;
+          std::unordered_map<std::string, std::unique_ptr<Node>> children;
+          std::shared_ptr<Path> content;
+          /// When the path stops being missing, if it is.
+          boost::optional<Clock::time_point> missing;
+          Hook lru;
+        };
+        using LRU = boost::intrusive::list<
+          Node,
+          boost::intrusive::member_hook<Node, Hook, &Node::lru>>;
+        /// The node for \a path, created along with its parents if \a create
+        /// is set. Visited nodes are stored in \a chain, deepest first.
+        Node*
+        _find(std::string const& path,
+              bool create,
+              std::vector<Node*>* chain = nullptr);
+        /// Mark nodes as recently used, deepest first.
+        void
+        _touch(std::vector<Node*> const& chain);
+        /// Remove \a node and its descendants.
+        void
+        _drop(Node* node);
+        /// Remove the descendants of \a node.
+        void
+        _drop_children(Node* node);
+        /// Remove \a node and its parents while they hold nothing.
+        void
+        _prune(Node* node);
+        void
+        _evict();
+        ELLE_ATTRIBUTE(std::size_t, size);
+        ELLE_ATTRIBUTE(std::unique_ptr<Node>, root);
+        ELLE_ATTRIBUTE(LRU, lru);
+      };
+
       class FileSystemImpl;
       class FileSystem
         : public reactor::Waitable
@@ -261,6 +377,17 @@ namespace elle
         std::shared_ptr<Path>
         get(std::string const& path);
 
+        /// Record that \a path is missing, sparing further lookups of it the
+        /// backend until the cache negative_ttl expires.
+        void
+        missing(std::string const& path);
+
+        /// Forget that \a path is missing, e.g. before creating it.
+        void
+        forget_missing(std::string const& path);
+
+        ELLE_ATTRIBUTE_X(PathCache, cache);
+
       /*---------.
       | Waitable |
       `---------*/
@@ -280,7 +407,6 @@ namespace elle
         ELLE_ATTRIBUTE_R(std::vector<std::string>, mount_options);
         ELLE_ATTRIBUTE_RW(bool, full_tree);
         std::string _where;
-        std::unordered_map<std::string, std::shared_ptr<Path>> _cache;
       };
 
 
@@ -52,15 +52,18 @@ namespace elle
         BENCH("getattr");
         ELLE_ASSERT(path);
         ELLE_TRACE_SCOPE("fusop_getattr %s", path);
+        auto* fs = (FileSystem*)fuse_get_context()->private_data;
         try
         {
-          auto* fs = (FileSystem*)fuse_get_context()->private_data;
           PathPtr p = fs->path(path);
           p->stat(stbuf);
         }
         catch (Error const& e)
         {
           ELLE_TRACE("filesystem error statting %s: %s", path, e.what());
+          // Lookups of missing files are frequent, spare the backend.
+          if (e.error_code() == ENOENT)
+            fs->missing(path);
           return -e.error_code();
         }
         return 0;
@@ -128,6 +131,7 @@ namespace elle
         try
         {
           auto* fs = (FileSystem*)fuse_get_context()->private_data;
+          fs->forget_missing(path);
           PathPtr p = fs->path(path);
           auto handle = p->create(fi->flags, mode);
           fi->fh = (decltype(fi->fh)) handle.release();
@@ -171,6 +175,7 @@ namespace elle
         try
         {
           auto* fs = (FileSystem*)fuse_get_context()->private_data;
+          fs->forget_missing(path);
           PathPtr p = fs->path(path);
           p->mkdir(mode);
         }
@@ -216,6 +221,7 @@ namespace elle
           auto* fs = (FileSystem*)fuse_get_context()->private_data;
           PathPtr p = fs->path(path);
           p->rename(to);
+          fs->forget_missing(to);
         }
         catch (Error const& e)
         {
@@ -370,6 +376,7 @@ namespace elle
         try
         {
           auto* fs = (FileSystem*)fuse_get_context()->private_data;
+          fs->forget_missing(where);
           PathPtr p = fs->path(where);
           p->symlink(target);
         }
@@ -394,6 +401,7 @@ namespace elle
           auto* fs = (FileSystem*)fuse_get_context()->private_data;
           PathPtr p = fs->path(path);
           p->link(to);
+          fs->forget_missing(to);
         }
         catch (Error const& e)
         {
@@ -741,8 +749,16 @@ namespace elle
         }
         else if (!elle::os::getenv("INFINIT_FUSE_THREAD", "").empty())
         {
-          ELLE_TRACE("Thread mode");
-          _impl->loop_mt();
+          // Any non numeric value keeps the historical single reader.
+          int nr = 1;
+          try
+          {
+            nr = std::max(elle::os::getenv("INFINIT_FUSE_THREAD", 1), 1);
+          }
+          catch (std::invalid_argument const&)
+          {}
+          ELLE_TRACE("Thread mode with %s readers", nr);
+          _impl->loop_mt(nr);
         }
         else
         {
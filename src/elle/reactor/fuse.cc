@@ -30,8 +30,58 @@ namespace elle
 {
   namespace reactor
   {
+    /// A request received by a reader thread.
+    ///
+    /// Buffers are recycled from the workers back to the readers, so that
+    /// once warm no allocation nor copy happens between the kernel and the
+    /// operation handler.
+    struct FuseContext::Request
+    {
+      Request(std::size_t capacity)
+        : data(new char[capacity])
+        , size(0)
+        , channel(nullptr)
+        , next(nullptr)
+      {}
+
+      std::unique_ptr<char[]> data;
+      std::size_t size;
+      fuse_chan* channel;
+      Request* next;
+    };
+
+    /// Push on a lock-free stack, return whether it was empty.
+    template <typename T>
+    static
+    bool
+    _push(std::atomic<T*>& stack, T* e)
+    {
+      e->next = stack.load(std::memory_order_relaxed);
+      while (!stack.compare_exchange_weak(
+               e->next, e,
+               std::memory_order_release, std::memory_order_relaxed))
+        ;
+      return !e->next;
+    }
+
+    template <typename T>
+    static
+    void
+    _delete(T* list)
+    {
+      while (list)
+      {
+        auto next = list->next;
+        delete list;
+        list = next;
+      }
+    }
+
     FuseContext::FuseContext()
       : _mt_barrier(elle::sprintf("%s barrier", this))
+      , _requests(nullptr)
+      , _free(nullptr)
+      , _readers_running(0)
     {}
 
     void
@@ -39,18 +89,7 @@ namespace elle
     {
       // Macos can't run async ops on fuse socket, so thread it
 #ifdef INFINIT_MACOSX
-      this->_loop.reset(new Thread(
-        "holder",
-        [&]
-        {
-          reactor::sleep();
-        }));
-      auto& sched = scheduler();
-      this->_loop_thread.reset(new std::thread(
-        [&]
-        {
-          this->_loop_one_thread(sched);
-        }));
+      this->loop_mt();
 #else
       this->_loop.reset(new Thread("fuse loop",
         [&]
@@ -60,45 +99,6 @@ namespace elle
 #endif
     }
 
-    void
-    FuseContext::_loop_one_thread(reactor::Scheduler& sched)
-    {
-      fuse_session* s = fuse_get_session(this->_fuse);
-      fuse_chan* ch = fuse_session_next_chan(s, nullptr);
-      size_t buffer_size = fuse_chan_bufsize(ch);
-      void* buffer_data = malloc(buffer_size);
-      while (!fuse_exited(this->_fuse))
-      {
-        ELLE_DUMP("Processing command");
-        int res = -EINTR;
-        while(res == -EINTR)
-          res = fuse_chan_recv(&ch, (char*)buffer_data, buffer_size);
-        if (res == -EAGAIN)
-          continue;
-        if (res <= 0)
-        {
-          if (res < 0)
-            ELLE_LOG("%s: %s", res, strerror(-res));
-          break;
-        }
-        try
-        {
-          sched.mt_run<void>(
-            "fuse worker",
-            [&]
-            {
-              fuse_session_process(s, (const char*)buffer_data, res, ch);
-            });
-        }
-        catch (std::exception const& e)
-        {
-          ELLE_WARN("Exception escaped fuse_process: %s", e.what());
-        }
-      }
-      if (this->on_loop_exited())
-        sched.run_later("exit notifier", this->on_loop_exited());
-    }
-
     void
     FuseContext::_loop_single()
     {
@@ -156,23 +156,15 @@ namespace elle
     }
 
     void
-    FuseContext::loop_mt()
+    FuseContext::loop_mt(int readers)
     {
       Scheduler& sched = scheduler();
-#ifdef INFINIT_MACOSX
-      this->_loop_thread.reset(new std::thread(
-        [&]
-        {
-          this->_loop_mt(sched);
-        }));
-#else
       this->_loop.reset(new Thread(
         "fuse loop",
-        [&]
+        [this, readers, &sched]
         {
-          this->_loop_mt(sched);
+          this->_loop_mt(readers, sched);
         }));
-#endif
     }
 
     void
@@ -278,77 +270,107 @@ namespace elle
 
 
     void
-    FuseContext::_loop_mt(Scheduler& sched)
+    FuseContext::_loop_mt(int readers, Scheduler& sched)
     {
+      ELLE_TRACE("entering dispatch loop with %s readers", readers);
       fuse_session* s = fuse_get_session(this->_fuse);
-      fuse_chan* ch = fuse_session_next_chan(s, nullptr);
-      size_t buffer_size = fuse_chan_bufsize(ch);
-#ifndef INFINIT_MACOSX
-      int fd = fuse_chan_fd(ch);
-      ELLE_TRACE("Got fuse fd %s", fd);
-      boost::asio::posix::stream_descriptor socket(scheduler().io_service());
-      socket.assign(fd);
-#endif
       auto lock = this->_mt_barrier.lock();
-      void* buffer_data = malloc(buffer_size);
+      this->_readers_running = readers;
+      for (int i = 0; i < readers; ++i)
+        this->_readers.emplace_back([this, &sched] { this->_read(sched); });
       while (!fuse_exited(this->_fuse))
       {
-#ifndef INFINIT_MACOSX
         this->_socket_barrier.close();
-        socket.async_read_some(boost::asio::null_buffers(),
-          [&](boost::system::error_code const& erc, std::size_t)
-          {
-            if (erc)
-              return;
-            this->_socket_barrier.open();
-          });
-        ELLE_DUMP("waiting for socket");
-        wait(this->_socket_barrier);
-#endif
-        if (fuse_exited(this->_fuse))
-          break;
-        ELLE_DUMP("Processing command");
-        int res = -EINTR;
-        while(res == -EINTR)
-          res = fuse_chan_recv(&ch, (char*)buffer_data, buffer_size);
-        if (res == -EAGAIN)
+        auto batch = this->_requests.exchange(nullptr, std::memory_order_acquire);
+        if (!batch)
+        {
+          if (!this->_readers_running)
+            break;
+          ELLE_DUMP("waiting for requests");
+          wait(this->_socket_barrier);
           continue;
-        if (res <= 0)
+        }
+        // Readers stack requests up, restore their arrival order.
+        Request* pending = nullptr;
+        while (batch)
+        {
+          auto next = batch->next;
+          batch->next = pending;
+          pending = batch;
+          batch = next;
+        }
+        while (pending)
         {
+          auto request = pending;
+          pending = pending->next;
+          ELLE_DUMP("processing %s bytes request", request->size);
+          new Thread(
+            sched,
+            "fuse worker",
+            [this, s, request, lock]
+            {
+              elle::SafeFinally release([&] { this->_release(request); });
+              fuse_session_process(
+                s, request->data.get(), request->size, request->channel);
+            }, true);
+        }
+      }
+      ELLE_DEBUG("fuse loop returning");
+      if (this->on_loop_exited())
+        new reactor::Thread("exit notifier", this->on_loop_exited(), true);
+    }
+
+    void
+    FuseContext::_read(Scheduler& sched)
+    {
+      fuse_session* s = fuse_get_session(this->_fuse);
+      fuse_chan* ch = fuse_session_next_chan(s, nullptr);
+      size_t buffer_size = fuse_chan_bufsize(ch);
+      // Buffers reclaimed from the workers, private to this reader. Taking the
+      // whole shared list at once keeps it free of ABA issues.
+      Request* spare = nullptr;
+      elle::SafeFinally cleanup([&] { _delete(spare); });
+      auto wake = [this, &sched]
+        {
+          sched.io_service().post([this] { this->_socket_barrier.open(); });
+        };
+      while (!fuse_exited(this->_fuse))
+      {
+        if (!spare)
+          spare = this->_free.exchange(nullptr, std::memory_order_acquire);
+        auto request = spare;
+        if (request)
+          spare = request->next;
+        else
+          request = new Request(buffer_size);
+        auto channel = ch;
+        int res = -EINTR;
+        while (res == -EINTR)
+          res = fuse_chan_recv(&channel, request->data.get(), buffer_size);
+        if (res <= 0 || fuse_exited(this->_fuse))
+        {
+          request->next = spare;
+          spare = request;
+          if (res == -EAGAIN)
+            continue;
           if (res < 0)
             ELLE_LOG("%s: %s", res, strerror(-res));
           break;
         }
-        void* b2 = malloc(res);
-        memcpy(b2, buffer_data, res);
-#ifdef INFINIT_MACOSX
-        std::unique_lock<std::mutex> mutex_lock(this->_mutex);
-#endif
-        this->_workers.push_back(new Thread(
-          sched,
-          "fuse worker",
-          [s, b2, res, ch, this]
-          {
-            auto lock = this->_mt_barrier.lock();
-            fuse_session_process(s, (const char*)b2, res, ch);
-            free(b2);
-#ifdef INFINIT_MACOSX
-            std::unique_lock<std::mutex> mutex_lock(this->_mutex);
-#endif
-            auto it = std::find(this->_workers.begin(),
-                                this->_workers.end(),
-                                scheduler().current());
-            ELLE_ASSERT(it != this->_workers.end());
-            std::swap(*it, this->_workers.back());
-            this->_workers.pop_back();
-          }, true));
+        request->size = res;
+        request->channel = channel;
+        // Only the first request of a batch needs to wake the dispatcher.
+        if (_push(this->_requests, request))
+          wake();
       }
-      if (this->on_loop_exited())
-#ifdef INFINIT_MACOSX
-        sched.mt_run<void>("exit notifier", this->on_loop_exited());
-#else
-        new reactor::Thread("exit notifier", this->on_loop_exited(), true);
-#endif
+      if (--this->_readers_running == 0 && !fuse_exited(this->_fuse))
+        wake();
+    }
+
+    void
+    FuseContext::_release(Request* request)
+    {
+      _push(this->_free, request);
     }
 
     void
@@ -383,6 +405,30 @@ namespace elle
     {
       ELLE_DEBUG("caught signal: %d", sig);
     }
+
+    static
+    void
+    _interrupt(std::thread& thread)
+    {
+      // Use a signal to stop the read syscall in fuse_chan_recv. We also need
+      // to ensure that the syscall is not automatically restarted (default on
+      // OS X, see `man signal`).
+      struct sigaction action;
+      sigaction(SIGUSR1, nullptr, &action);
+      action.sa_handler = &_signal_handler;
+      action.sa_flags &= ~SA_RESTART;
+      sigaction(SIGUSR1, &action, nullptr);
+      int res = 0;
+      sigset_t mask_set;
+      sigemptyset(&mask_set);
+      sigaddset(&mask_set, SIGUSR1);
+      res = pthread_sigmask(SIG_BLOCK, &mask_set, nullptr);
+      if (res != 0)
+        ELLE_WARN("failed to mask SIGUSR1 on main thread, error: %d", res);
+      res = pthread_kill(thread.native_handle(), SIGUSR1);
+      if (res != 0)
+        ELLE_WARN("failed to send signal to loop_thread, error: %d", res);
+    }
 #endif
 
     void
@@ -414,27 +460,18 @@ namespace elle
       if (this->_loop_thread)
       {
 #ifdef INFINIT_MACOSX
-        // Use a signal to stop the read syscall in fuse_chan_recv. We also need
-        // to ensure that the syscall is not automatically restarted (default on
-        // OS X, see `man signal`).
-        struct sigaction action;
-        sigaction(SIGUSR1, nullptr, &action);
-        action.sa_handler = &_signal_handler;
-        action.sa_flags &= ~SA_RESTART;
-        sigaction(SIGUSR1, &action, nullptr);
-        int res = 0;
-        sigset_t mask_set;
-        sigemptyset(&mask_set);
-        sigaddset(&mask_set, SIGUSR1);
-        res = pthread_sigmask(SIG_BLOCK, &mask_set, nullptr);
-        if (res != 0)
-          ELLE_WARN("failed to mask SIGUSR1 on main thread, error: %d", res);
-        res = pthread_kill(this->_loop_thread->native_handle(), SIGUSR1);
-        if (res != 0)
-          ELLE_WARN("failed to send signal to loop_thread, error: %d", res);
+        _interrupt(*this->_loop_thread);
 #endif
         this->_loop_thread->join();
       }
+#ifdef INFINIT_MACOSX
+      for (auto& reader: this->_readers)
+      {
+        _interrupt(reader);
+        reader.join();
+      }
+      this->_readers.clear();
+#endif
       ELLE_TRACE("done");
       if (!this->_fuse)
         return;
@@ -444,10 +481,16 @@ namespace elle
       fuse_chan* ch = ::fuse_session_next_chan(s, NULL);
       ELLE_TRACE("chan %s", (void*)(ch));
       ::fuse_unmount(this->_mountpoint.c_str(), ch);
+      // Unmounting aborts the connection, failing the readers' pending reads.
+      for (auto& reader: this->_readers)
+        reader.join();
+      this->_readers.clear();
 #endif
       ELLE_TRACE("unmounted");
       ::fuse_destroy(this->_fuse);
       this->_fuse = nullptr;
+      _delete(this->_requests.exchange(nullptr));
+      _delete(this->_free.exchange(nullptr));
       ELLE_TRACE("destroyed");
 #ifdef INFINIT_MACOSX
       this->_loop->terminate_now();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <thread>
@@ -32,8 +33,10 @@ namespace elle
     public:
       void
       loop();
+      /// Read requests on \a readers system threads and process each of
+      /// them in its own reactor thread.
       void
-      loop_mt();
+      loop_mt(int readers = 1);
       void
       loop_pool(int threads);
       /// unmount and free ressources. Force-kill after "grace_time".
@@ -46,9 +49,9 @@ namespace elle
       void
       _loop_single();
       void
-      _loop_one_thread(Scheduler&);
+      _loop_mt(int readers, Scheduler&);
       void
-      _loop_mt(Scheduler&);
+      _read(Scheduler&);
       void
       _loop_pool(int threads, Scheduler&);
 
@@ -65,6 +68,17 @@ namespace elle
       std::unique_ptr<std::thread> _loop_thread;
       std::vector<reactor::Thread*> _workers;
       std::mutex _mutex;
+      /// A received request, living in a reusable buffer.
+      struct Request;
+      /// Release a processed request buffer for the readers to reuse.
+      void
+      _release(Request* request);
+      /// Requests pushed by the readers, in LIFO order.
+      std::atomic<Request*> _requests;
+      /// Buffers released by the workers.
+      std::atomic<Request*> _free;
+      std::atomic<int> _readers_running;
+      std::vector<std::thread> _readers;
     };
   }
 }
@@ -16,6 +16,7 @@ namespace elle
     class Mutex;
     class Operation;
     class Scheduler;
+    class SchedulerPool;
     class Semaphore;
     class Signal;
     class Sleep;
@@ -29,12 +29,23 @@ namespace elle
         Impl():
           _curl(boost::asio::use_service<Service>(
                   Scheduler::scheduler()->io_service())),
-          _share(curl_share_init(), &curl_share_cleanup)
+          _share(curl_share_init(), &curl_share_cleanup),
+          _statistics(std::make_shared<Statistics>())
         {
           if (!this->_share)
             throw std::bad_alloc();
+          // Requests all run on the Scheduler's thread, no need for locking
+          // callbacks.
           curl_share_setopt(this->_share.get(),
                             CURLSHOPT_SHARE, CURL_LOCK_DATA_COOKIE);
+          curl_share_setopt(this->_share.get(),
+                            CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+          curl_share_setopt(this->_share.get(),
+                            CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900
+          curl_share_setopt(this->_share.get(),
+                            CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
         }
 
         ~Impl()
@@ -44,9 +55,12 @@ namespace elle
         friend class Client;
         Service& _curl;
         ELLE_ATTRIBUTE(elle::generic_unique_ptr<CURLSH>, share);
+        /// Shared with the requests, which may outlive the client.
+        ELLE_ATTRIBUTE(std::shared_ptr<Statistics>, statistics);
       };
 
       Client::Client(std::string  user_agent):
+        _http2(true),
         _impl(new Impl),
         _user_agent(std::move(user_agent))
       {}
@@ -68,24 +82,48 @@ namespace elle
       Client::_register(Request const& request)
       {
         ELLE_TRACE_SCOPE("%s: register %s", *this, request);
+        auto setopt = [&] (char const* what, CURLoption option, auto value)
+          {
+            auto res = curl_easy_setopt(request._impl->_handle, option, value);
+            if (res != CURLE_OK)
+              throw RequestError(request.url(),
+                                 elle::sprintf("unable to set %s: %s",
+                                               what, curl_easy_strerror(res)));
+          };
+        setopt("shared context", CURLOPT_SHARE, this->_impl->_share.get());
+        setopt("user agent", CURLOPT_USERAGENT, this->_user_agent.c_str());
+#if LIBCURL_VERSION_NUM >= 0x072f00
+        if (this->_http2 &&
+            request._impl->_conf.version() == Version::v11)
         {
-          auto res = curl_easy_setopt(request._impl->_handle,
-                                      CURLOPT_SHARE, this->_impl->_share.get());
-          if (res != CURLE_OK)
-            throw RequestError(request.url(),
-                               elle::sprintf("unable to set cookie jar: %s",
-                                             curl_easy_strerror(res)));
+          // Fall back to HTTP/1.1 on clear text connections and servers
+          // without HTTP/2.
+          setopt("HTTP version", CURLOPT_HTTP_VERSION,
+                 long(CURL_HTTP_VERSION_2TLS));
+          // Rather than opening a new connection, wait for one being
+          // established to tell whether it can be multiplexed.
+          setopt("pipewait", CURLOPT_PIPEWAIT, 1L);
         }
+#endif
+        request._impl->_statistics = this->_impl->_statistics;
+      }
 
-        {
-          auto res = curl_easy_setopt(request._impl->_handle,
-                                      CURLOPT_USERAGENT,
-                                      this->_user_agent.c_str());
-          if (res != CURLE_OK)
-            throw RequestError(request.url(),
-                               elle::sprintf("unable to set user agent: %s",
-                                             curl_easy_strerror(res)));
-        }
+      /*------------.
+      | Connections |
+      `------------*/
+
+      void
+      Client::max_host_connections(int count)
+      {
+        ELLE_TRACE("%s: limit connections per host to %s", *this, count);
+        curl_multi_setopt(this->_impl->_curl._curl,
+                          CURLMOPT_MAX_HOST_CONNECTIONS, long(count));
+      }
+
+      Client::Statistics
+      Client::statistics() const
+      {
+        return *this->_impl->_statistics;
       }
 
       /*--------.
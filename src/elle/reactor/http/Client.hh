@@ -1,7 +1,9 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
+#include <elle/reactor/duration.hh>
 #include <elle/reactor/http/Request.hh>
 
 namespace elle
@@ -12,10 +14,31 @@ namespace elle
     {
       /// HTTP client to run multiple requests in the same context.
       ///
-      /// For now the context just includes the cookie jar.
+      /// The context includes the cookie jar, and a pool of connections along
+      /// with the DNS cache and TLS sessions, so consecutive requests to a
+      /// host skip resolution and handshakes. HTTP/2 is negotiated on TLS
+      /// connections, so concurrent requests to a host can be multiplexed on
+      /// a single connection.
       class Client
       {
       public:
+        /// Transfer statistics of the requests run by a Client.
+        struct Statistics
+        {
+          /// Completed requests.
+          int requests;
+          /// Connections opened.
+          int connections;
+          /// Requests run on an already open connection.
+          int reused;
+          /// Time spent resolving host names.
+          Duration resolution;
+          /// Time spent establishing TCP connections.
+          Duration connection;
+          /// Time spent in TLS handshakes.
+          Duration handshake;
+        };
+
         /// Create a Client.
         Client(std::string  user_agent = "Elle");
         /// Dispose of a Client.
@@ -47,6 +70,25 @@ namespace elle
         Request::Configuration::Cookies
         cookies() const;
 
+      /*------------.
+      | Connections |
+      `------------*/
+      public:
+        /// Limit the number of connections to a single host, 0 meaning no
+        /// limit. Requests beyond wait for a connection to be available, or
+        /// are multiplexed with HTTP/2.
+        ///
+        /// Since transfers are driven by the Scheduler's HTTP service, this
+        /// limit applies to all the Clients of the current Scheduler.
+        void
+        max_host_connections(int count);
+        /// Transfer statistics so far.
+        Statistics
+        statistics() const;
+        /// Whether to negotiate HTTP/2 on TLS connections, true by default.
+        /// Only affects requests registered afterwards.
+        ELLE_ATTRIBUTE_RW(bool, http2);
+
       private:
         /// Register a Request to use this client's context.
         void
@@ -115,6 +115,7 @@ namespace elle
         , _output(0)
         , _output_available(false)
         , _output_offset(0)
+        , _statistics()
         , _curl(boost::asio::use_service<Service>(
                   reactor::scheduler().io_service()))
         , _url(url)
@@ -138,9 +139,20 @@ namespace elle
         memset(&this->_error[0], 0, CURL_ERROR_SIZE);
         setopt(this->_handle, CURLOPT_ERRORBUFFER, this->_error);
         // Set version.
-        auto version = this->_conf.version() == Version::v11
-          ? CURL_HTTP_VERSION_1_1 : CURL_HTTP_VERSION_1_0;
-        setopt(this->_handle, CURLOPT_HTTP_VERSION, version);
+        auto version = [&]
+          {
+            switch (this->_conf.version())
+            {
+              case Version::v10:
+                return CURL_HTTP_VERSION_1_0;
+              case Version::v11:
+                return CURL_HTTP_VERSION_1_1;
+              case Version::v20:
+                return CURL_HTTP_VERSION_2_0;
+            }
+            elle::unreachable();
+          }();
+        setopt(this->_handle, CURLOPT_HTTP_VERSION, long(version));
         // Set IPv4 only.
         setopt(this->_handle, CURLOPT_IPRESOLVE, CURL_IPRESOLVE_V4);
         // Set proxy.
@@ -506,6 +518,47 @@ namespace elle
         this->_input_done = true;
       }
 
+      /*-----------.
+      | Statistics |
+      `-----------*/
+
+      void
+      Request::Impl::statistics_update()
+      {
+        auto& statistics = *this->_statistics;
+        auto time = [&] (CURLINFO info)
+          {
+            auto res = 0.;
+            curl_easy_getinfo(this->_handle, info, &res);
+            return res;
+          };
+        auto duration = [] (double seconds)
+          {
+            return boost::posix_time::microseconds(
+              static_cast<long>(seconds * 1000000));
+          };
+        ++statistics.requests;
+        auto connections = 0l;
+        curl_easy_getinfo(this->_handle, CURLINFO_NUM_CONNECTS, &connections);
+        if (!connections)
+        {
+          ++statistics.reused;
+          return;
+        }
+        statistics.connections += connections;
+        // Times are cumulative since the start of the transfer.
+        auto const resolved = time(CURLINFO_NAMELOOKUP_TIME);
+        auto const connected = time(CURLINFO_CONNECT_TIME);
+        auto const handshaken = time(CURLINFO_APPCONNECT_TIME);
+        statistics.resolution += duration(resolved);
+        statistics.connection += duration(connected - resolved);
+        // Zero for clear text connections.
+        if (handshaken > 0)
+          statistics.handshake += duration(handshaken - connected);
+        ELLE_DEBUG("%s: connected in %ss, handshake done after %ss",
+                   *this, connected, handshaken);
+      }
+
       /*------.
       | Input |
       `------*/
@@ -774,6 +827,8 @@ namespace elle
           ELLE_WARN("%s: done with error: %s", *this, message);
           set_exception();
         }
+        if (this->_impl->_statistics)
+          this->_impl->statistics_update();
         this->_impl->_debug2 = 2;
         this->_signal();
         // Waitables consume their exception once signaled, restore it.
@@ -6,6 +6,7 @@
 #include <elle/Buffer.hh>
 #include <elle/memory.hh>
 #include <elle/reactor/Barrier.hh>
+#include <elle/reactor/http/Client.hh>
 #include <elle/reactor/http/Request.hh>
 #include <elle/reactor/http/fwd.hh>
 #include <elle/reactor/signal.hh>
@@ -131,6 +132,15 @@ namespace elle
       public:
         ELLE_ATTRIBUTE_R(Progress, progress);
 
+      /*-----------.
+      | Statistics |
+      `-----------*/
+      private:
+        /// Account for the transfer in the statistics of the Client, if any.
+        void
+        statistics_update();
+        std::shared_ptr<Client::Statistics> _statistics;
+
       private:
         friend class Client;
         friend class Request;
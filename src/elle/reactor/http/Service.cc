@@ -77,8 +77,11 @@ namespace elle
                           &socket_callback);
         curl_multi_setopt(this->_curl,
                           CURLMOPT_TIMERFUNCTION, &Service::timeout_callback);
-        // Pipelining causes issues with S3, requests end up being stuck.
-        // curl_multi_setopt(this->_curl, CURLMOPT_PIPELINING, 1L);
+        // HTTP/1.1 pipelining causes issues with S3, requests end up being
+        // stuck. Only multiplex over HTTP/2 connections.
+#ifdef CURLPIPE_MULTIPLEX
+        curl_multi_setopt(this->_curl, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
       }
 
       Service::~Service()
@@ -15,6 +15,7 @@ namespace elle
     bool
     Mutex::release()
     {
+      auto lock = this->_lock_waiters();
       ELLE_ASSERT(this->_locked);
       this->_locked = false;
       this->_signal();
@@ -24,6 +25,7 @@ namespace elle
     bool
     Mutex::acquire()
     {
+      auto lock = this->_lock_waiters();
       if (this->_locked)
         return false;
       this->_locked = true;
@@ -33,6 +35,7 @@ namespace elle
     bool
     Mutex::_wait(Thread* thread, Waker const& waker)
     {
+      auto lock = this->_lock_waiters();
       if (this->_locked)
       {
         this->Waitable::_wait(thread, waker);
@@ -1,25 +1,118 @@
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <elle/finally.hh>
 #include <elle/os/environ.hh>
+#include <elle/reactor/Channel.hh>
 #include <elle/reactor/network/Error.hh>
 #include <elle/reactor/network/http-server.hh>
+#include <elle/reactor/signal.hh>
 
 ELLE_LOG_COMPONENT("elle.reactor.network.http");
 
 namespace
 {
-  // FIXME: most callers do not need fresh strings, string_views would
-  // suffice.  Or even simply some range such as with Boost Tokenizer.
-  template <typename String>
-  std::vector<std::string>
-  split(String const& str, std::string const& sep)
+  /// Bodies up to this size are copied after the response head, to be sent
+  /// with a single write. Larger ones are written from where they are.
+  auto const copy_threshold = elle::Buffer::Size{16 * 1024};
+  /// Maximum size of a request header block.
+  auto const max_head_size = elle::Buffer::Size{64 * 1024};
+  /// How much to read from the socket at once.
+  auto const read_size = elle::Buffer::Size{16 * 1024};
+
+  elle::ConstWeakBuffer
+  trim(elle::ConstWeakBuffer b)
+  {
+    auto begin = reinterpret_cast<char const*>(b.contents());
+    auto end = begin + b.size();
+    while (begin != end && (*begin == ' ' || *begin == '\t'))
+      ++begin;
+    while (end != begin && (end[-1] == ' ' || end[-1] == '\t'))
+      --end;
+    return {begin, static_cast<elle::Buffer::Size>(end - begin)};
+  }
+
+  /// Call \a f on every piece of \a b separated by \a sep.
+  template <typename F>
+  void
+  split(elle::ConstWeakBuffer b, char sep, F const& f)
   {
-    auto res = std::vector<std::string>{};
-    boost::algorithm::split(res, str,
-                            boost::algorithm::is_any_of(sep));
-    return res;
+    auto begin = reinterpret_cast<char const*>(b.contents());
+    auto const end = begin + b.size();
+    while (true)
+    {
+      auto const it = std::find(begin, end, sep);
+      f(elle::ConstWeakBuffer(
+          begin, static_cast<elle::Buffer::Size>(it - begin)));
+      if (it == end)
+        break;
+      begin = it + 1;
+    }
+  }
+
+  /// Split \a b at the first \a sep, if any.
+  std::pair<elle::ConstWeakBuffer, boost::optional<elle::ConstWeakBuffer>>
+  split_once(elle::ConstWeakBuffer b, char sep)
+  {
+    auto const begin = reinterpret_cast<char const*>(b.contents());
+    auto const end = begin + b.size();
+    auto const it = std::find(begin, end, sep);
+    auto const first = elle::ConstWeakBuffer(
+      begin, static_cast<elle::Buffer::Size>(it - begin));
+    if (it == end)
+      return {first, boost::none};
+    else
+      return {first, elle::ConstWeakBuffer(
+          it + 1, static_cast<elle::Buffer::Size>(end - it - 1))};
+  }
+
+  elle::ConstWeakBuffer
+  strip_cr(elle::ConstWeakBuffer b)
+  {
+    if (b.size() && b.contents()[b.size() - 1] == '\r')
+      return b.range(0, b.size() - 1);
+    else
+      return b;
+  }
+
+  bool
+  iequals(elle::ConstWeakBuffer b, char const* s)
+  {
+    auto const size = std::strlen(s);
+    if (b.size() != size)
+      return false;
+    for (auto i = 0u; i < size; ++i)
+      if (std::tolower(b.contents()[i]) != std::tolower(s[i]))
+        return false;
+    return true;
+  }
+
+  /// Send \a head and \a body, concatenated if \a body is small enough.
+  void
+  send(elle::reactor::network::Socket& socket,
+       std::string head,
+       elle::ConstWeakBuffer body,
+       char const* tail = "")
+  {
+    if (body.size() <= copy_threshold)
+    {
+      head.append(reinterpret_cast<char const*>(body.contents()),
+                  body.size());
+      head += tail;
+      socket.write(elle::ConstWeakBuffer(head));
+    }
+    else
+    {
+      socket.write(elle::ConstWeakBuffer(head));
+      socket.write(body);
+      if (*tail)
+        socket.write(elle::ConstWeakBuffer(tail));
+    }
   }
 }
 
@@ -29,10 +122,162 @@ namespace elle
   {
     namespace network
     {
+      /*------.
+      | Input |
+      `------*/
+
+      class HttpServer::Input
+      {
+      public:
+        using Size = elle::Buffer::Size;
+
+        Input(reactor::network::Socket& socket)
+          : _socket(socket)
+          , _buffer()
+          , _start(0)
+        {}
+
+        /// The next header block, terminated by its last header CRLF, or
+        /// nothing if the connection was closed or stayed idle.
+        ///
+        /// The block is only valid until the next read.
+        boost::optional<elle::ConstWeakBuffer>
+        head(DurationOpt timeout)
+        {
+          // Bytes already searched for the end of the block.
+          auto scanned = Size{0};
+          while (true)
+          {
+            // Ignore empty lines before the request line.
+            while (this->_available() >= 2 &&
+                   this->_data()[0] == '\r' && this->_data()[1] == '\n')
+              this->_start += 2;
+            auto const begin = this->_data();
+            auto const end = begin + this->_available();
+            static char const blank[] = "\r\n\r\n";
+            auto const it = std::search(begin + scanned, end, blank, blank + 4);
+            if (it != end)
+            {
+              this->_start += it + 4 - begin;
+              return elle::ConstWeakBuffer(
+                begin, static_cast<Size>(it + 2 - begin));
+            }
+            if (this->_available() > max_head_size)
+              throw Exception("", http::StatusCode::Request_Entity_Too_Large,
+                              "request header block too large");
+            scanned = this->_available() < 3 ? 0 : this->_available() - 3;
+            try
+            {
+              this->_fill(timeout);
+            }
+            catch (reactor::network::ConnectionClosed const&)
+            {
+              if (this->_available() == 0)
+                return boost::none;
+              throw;
+            }
+            catch (reactor::network::TimeOut const&)
+            {
+              if (this->_available() == 0)
+                return boost::none;
+              throw;
+            }
+          }
+        }
+
+        /// The next line, without its CRLF.
+        std::string
+        line()
+        {
+          auto scanned = Size{0};
+          while (true)
+          {
+            auto const begin = this->_data();
+            auto const end = begin + this->_available();
+            static char const crlf[] = "\r\n";
+            auto const it = std::search(begin + scanned, end, crlf, crlf + 2);
+            if (it != end)
+            {
+              this->_start += it + 2 - begin;
+              return std::string(begin, it);
+            }
+            if (this->_available() > max_head_size)
+              throw Exception("", http::StatusCode::Bad_Request,
+                              "line too long");
+            scanned = this->_available() < 1 ? 0 : this->_available() - 1;
+            this->_fill();
+          }
+        }
+
+        /// Read exactly \a size bytes into \a output. What is not buffered
+        /// already is read straight into \a output.
+        void
+        read(elle::WeakBuffer output)
+        {
+          auto const buffered = std::min(output.size(), this->_available());
+          std::memcpy(output.mutable_contents(), this->_data(), buffered);
+          this->_start += buffered;
+          if (buffered < output.size())
+            this->_socket.read(elle::WeakBuffer(
+                                 output.mutable_contents() + buffered,
+                                 output.size() - buffered));
+        }
+
+      private:
+        char const*
+        _data() const
+        {
+          return reinterpret_cast<char const*>(
+            this->_buffer.contents() + this->_start);
+        }
+
+        Size
+        _available() const
+        {
+          return this->_buffer.size() - this->_start;
+        }
+
+        void
+        _fill(DurationOpt timeout = {})
+        {
+          // What remains is at most a partial header block: moving it back
+          // is cheap.
+          if (this->_start)
+          {
+            std::memmove(this->_buffer.mutable_contents(),
+                         this->_buffer.contents() + this->_start,
+                         this->_available());
+            this->_buffer.size(this->_available());
+            this->_start = 0;
+          }
+          auto const size = this->_buffer.size();
+          auto read = Size{0};
+          elle::SafeFinally resize([&] { this->_buffer.size(size + read); });
+          this->_buffer.size(size + read_size);
+          read = this->_socket.read_some(
+            elle::WeakBuffer(this->_buffer.mutable_contents() + size,
+                             read_size),
+            timeout);
+        }
+
+        reactor::network::Socket& _socket;
+        elle::Buffer _buffer;
+        Size _start;
+      };
+
+      /*-------------.
+      | Construction |
+      `-------------*/
+
       HttpServer::HttpServer(std::unique_ptr<Server> server)
         : _server(std::move(server))
         , _port(0)
         , _accepter()
+        , _max_connections(1024)
+        , _keep_alive_timeout(boost::posix_time::seconds(30))
+        , _max_body_size(64 * 1024 * 1024)
+        , _handlers(0)
+        , _requests(0)
       {
         if (!this->_server)
         {
@@ -49,6 +294,12 @@ namespace elle
       }
 
       HttpServer::HttpServer(int port)
+        : _accepter()
+        , _max_connections(1024)
+        , _keep_alive_timeout(boost::posix_time::seconds(30))
+        , _max_body_size(64 * 1024 * 1024)
+        , _handlers(0)
+        , _requests(0)
       {
         auto server = std::make_unique<TCPServer>();
         server->listen(port);
@@ -79,35 +330,36 @@ namespace elle
         return elle::sprintf("http://127.0.0.1:%s/%s", this->port(), path);
       }
 
-      HttpServer::CommandLine::CommandLine(elle::Buffer const& buffer)
+      HttpServer::CommandLine::CommandLine(elle::ConstWeakBuffer line)
         : _path()
         , _method()
         , _version()
       {
-         auto const words = split(buffer, " ");
+         auto words = std::vector<elle::ConstWeakBuffer>{};
+         split(line, ' ', [&] (elle::ConstWeakBuffer w) { words.push_back(w); });
          if (words.size() != 3)
            throw HttpServer::Exception(
-             boost::algorithm::join(words, " "),
+             line.string(),
              http::StatusCode::Bad_Request,
              "request command line should have 3 members");
-         auto const path_and_args = split(words[1], "?");
-         this->_path = path_and_args[0];
-         if (path_and_args.size() > 1)
-         {
-           auto const parameters = split(path_and_args[1], "&");
-           ELLE_DEBUG("%s", parameters);
-           for (auto const& param: parameters)
-           {
-             // FIXME: this is wrong, we should split exactly once.
-             auto const key_value = split(param, "=");
-             ELLE_DEBUG("%s", key_value);
-             this->_params[key_value[0]] = key_value[1];
-           }
-         }
+         auto const path_and_args = split_once(words[1], '?');
+         this->_path = path_and_args.first.string();
+         if (path_and_args.second)
+           split(
+             *path_and_args.second, '&',
+             [&] (elle::ConstWeakBuffer param)
+             {
+               auto const key_value = split_once(param, '=');
+               ELLE_DEBUG("%s", param);
+               this->_params[key_value.first.string()] =
+                 key_value.second ? key_value.second->string() : "";
+             });
          try
          {
-           this->_method = reactor::http::method::from_string(words[0]);
-           this->_version = reactor::http::version::from_string(words[2].substr(0, words[2].size() - 2));
+           this->_method = reactor::http::method::from_string(
+             words[0].string());
+           this->_version = reactor::http::version::from_string(
+             words[2].string());
          }
          catch (elle::Exception const& e)
          {
@@ -143,25 +395,35 @@ namespace elle
                       this->path(), this->params(), this->method());
       }
 
+      /*--------.
+      | Serving |
+      `--------*/
+
       void
       HttpServer::_accept()
       {
+        // Connections being served.
+        auto busy = 0;
+        reactor::Signal released;
+        // Handlers waiting for a connection, or about to.
+        auto idle = 0;
+        reactor::Channel<std::unique_ptr<reactor::network::Socket>> accepted;
         elle::With<reactor::Scope>() << [&] (reactor::Scope& scope)
         {
-          while (true)
-          {
-            auto socket = elle::utility::move_on_copy(this->_server->accept());
-            ELLE_DEBUG("accept connection from %s", **socket);
-            auto name = elle::sprintf("request %s", **socket);
-            scope.run_background(
-              name,
-              [this, socket]
+          auto handle = [&]
+            {
+              while (true)
               {
+                auto socket = accepted.get();
+                elle::SafeFinally release([&]
+                  {
+                    --busy;
+                    ++idle;
+                    released.signal();
+                  });
                 try
                 {
-                  std::unique_ptr<reactor::network::Socket> s =
-                    std::move(*socket);
-                  this->_serve(std::move(s));
+                  this->_serve(std::move(socket));
                 }
                 catch (reactor::network::ConnectionClosed const& e)
                 {
@@ -171,124 +433,251 @@ namespace elle
                 {
                   ELLE_TRACE("SocketClosed: %s", e.backtrace());
                 }
+                catch (reactor::network::TimeOut const& e)
+                {
+                  ELLE_TRACE("TimeOut: %s", e.backtrace());
+                }
+                catch (reactor::Terminate const&)
+                {
+                  throw;
+                }
                 catch (...)
                 {
-                  ELLE_ERR("%s: fatal error serving client: %s",
+                  // Only this connection is lost, keep serving the others.
+                  ELLE_ERR("%s: error serving client: %s",
                            this, elle::exception_string());
-                  throw;
                 }
-              });
+              }
+            };
+          while (true)
+          {
+            // Leave further clients in the listen backlog.
+            while (busy >= this->_max_connections)
+              reactor::wait(released);
+            auto socket = this->_server->accept();
+            ELLE_DEBUG("accept connection from %s", *socket);
+            ++busy;
+            if (idle > 0)
+              --idle;
+            else
+              scope.run_background(
+                elle::sprintf("handler %s", this->_handlers++), handle);
+            accepted.put(std::move(socket));
           }
         };
       }
 
       void
       HttpServer::_serve(std::unique_ptr<reactor::network::Socket> socket)
+      {
+        auto input = Input(*socket);
+        try
+        {
+          while (auto head = input.head(this->_keep_alive_timeout))
+            if (!this->_serve(*socket, input, *head))
+              break;
+        }
+        catch (Exception const& e)
+        {
+          ELLE_WARN("%s: http exception: %s", *this, e.what());
+          this->_response(*socket, e.code(), e.what());
+        }
+        ELLE_TRACE("%s: close connection with %s", *this, socket);
+      }
+
+      bool
+      HttpServer::_serve(reactor::network::Socket& socket,
+                         Input& input,
+                         elle::ConstWeakBuffer head)
       {
         auto headers = this->_headers;
         auto cookies = Cookies{};
+        // Whether the request was read entirely, leaving the connection in
+        // a state to serve the next one.
+        auto consumed = false;
+        auto keep_alive = false;
+        elle::SafeFinally forget([&] { this->_persistent.erase(&socket); });
         try
         {
-          CommandLine cmd(socket->read_until("\r\n"));
-          ELLE_LOG_SCOPE("%s: handle request from %s: %s",
-                         *this, socket, cmd);
+          auto const lines = split_once(head, '\n');
+          CommandLine cmd(strip_cr(lines.first));
+          ELLE_TRACE_SCOPE("%s: handle request from %s: %s",
+                           *this, socket, cmd);
+          auto connection = boost::optional<std::string>{};
+          // Drop the final LF, not to get an empty last line.
+          if (lines.second && lines.second->size())
+            split(
+              lines.second->range(0, lines.second->size() - 1), '\n',
+              [&] (elle::ConstWeakBuffer line)
+              {
+                line = strip_cr(line);
+                ELLE_TRACE("%s: get header: %s", *this, line.string());
+                auto const name_value = split_once(line, ':');
+                if (!name_value.second)
+                  throw Exception(cmd.path(),
+                                  reactor::http::StatusCode::Bad_Request,
+                                  elle::sprintf("%s: ill-formed",
+                                                line.string()));
+                auto const name = trim(name_value.first);
+                auto const value = trim(*name_value.second);
+                if (iequals(name, "Expect"))
+                {
+                  if (iequals(value, "100-continue"))
+                    headers["Expect"] = "1";
+                }
+                else if (iequals(name, "Transfer-Encoding"))
+                {
+                  if (iequals(value, "chunked"))
+                    headers["chunked"] = "1";
+                }
+                else if (iequals(name, "Set-Cookie") || iequals(name, "Cookie"))
+                  split(
+                    value, ';',
+                    [&] (elle::ConstWeakBuffer cookie)
+                    {
+                      auto const chunks = split_once(trim(cookie), '=');
+                      if (!chunks.second)
+                        throw Exception(cmd.path(),
+                                        reactor::http::StatusCode::Bad_Request,
+                                        elle::sprintf("%s: ill-formed",
+                                                      line.string()));
+                      cookies[chunks.first.string()] = chunks.second->string();
+                    });
+                else if (iequals(name, "Connection"))
+                {
+                  connection = value.string();
+                  headers["Connection"] = *connection;
+                }
+                else if (iequals(name, "Content-Length"))
+                  headers["Content-Length"] = value.string();
+                else if (iequals(name, "Content-Type"))
+                  headers["Content-Type"] = value.string();
+                else if (value.size())
+                  headers[name.string()] = value.string();
+              });
+          // Keep-alive is the default from HTTP/1.1 on.
+          keep_alive = cmd.version() == http::Version::v10 ?
+            connection && boost::algorithm::iequals(*connection, "keep-alive") :
+            !connection || !boost::algorithm::iequals(*connection, "close");
+          if (keep_alive)
+            this->_persistent.insert(&socket);
+          auto const chunked = headers.find("chunked") != headers.end();
+          auto const length = headers.find("Content-Length");
+          // Without a body, errors leave the connection usable.
+          consumed = !chunked && length == headers.end();
           auto route = this->_routes.find(cmd.path());
-          if (route == this->_routes.end())
+          auto stream_route = this->_stream_routes.find(cmd.path());
+          if (route == this->_routes.end() &&
+              stream_route == this->_stream_routes.end())
           {
             ELLE_TRACE("%s: not found", *this);
             throw Exception(cmd.path(), reactor::http::StatusCode::Not_Found);
           }
-          if (route->second.find(cmd.method()) == route->second.end())
+          auto function = Function{};
+          auto stream_function = StreamFunction{};
+          if (route != this->_routes.end())
+          {
+            auto it = route->second.find(cmd.method());
+            if (it != route->second.end())
+              function = it->second;
+          }
+          if (!function && stream_route != this->_stream_routes.end())
+          {
+            auto it = stream_route->second.find(cmd.method());
+            if (it != stream_route->second.end())
+              stream_function = it->second;
+          }
+          if (!function && !stream_function)
           {
             ELLE_TRACE("%s: method not allowed", *this);
             throw Exception(cmd.path(),
                             reactor::http::StatusCode::Method_Not_Allowed);
           }
-          while (true)
-          {
-            auto buffer = socket->read_until("\r\n");
-            if (buffer == "\r\n")
-              break;
-            buffer.size(buffer.size() - 2);
-            ELLE_TRACE("%s: get header: %s", *this, buffer.string());
-            auto const words = split(buffer, " ");
-            auto expected_length = [&] (unsigned int length) {
-              if (words.size() != length)
-                throw Exception(cmd.path(),
-                                reactor::http::StatusCode::Bad_Request,
-                                elle::sprintf("%s: ill-formed", words));
-              };
-            if (words[0] == "Expect:")
-            {
-              expected_length(2);
-              if (words[1] == "100-continue")
-                headers["Expect"] = "1";
-            }
-            else if (words[0] == "Content-Length:")
-            {
-              expected_length(2);
-              headers["Content-Length"] = words[1];
-            }
-            else if (words[0] == "Content-Type:")
-            {
-              expected_length(2);
-              headers["Content-Type"] = words[1];
-            }
-            else if (words[0] == "Transfer-Encoding:")
-            {
-              expected_length(2);
-              if (words[1] == "chunked")
-                headers["chunked"] = "1";
-            }
-            else if (words[0] == "Set-Cookie:" || words[0] == "Cookie:")
-            {
-              auto const chunks = split(words[1], "=");
-              if (chunks.size() != 2)
-                throw Exception(cmd.path(),
-                                reactor::http::StatusCode::Bad_Request,
-                                elle::sprintf("%s: ill-formed", words));
-              cookies[chunks[0]] = chunks[1];
-            }
-            else if (words[0] == "Connection:")
-            {
-              expected_length(2);
-              headers["Connection"] = words[1];
-            }
-          }
-
           ELLE_TRACE("%s: cookies: %s", *this, cookies);
           ELLE_TRACE("%s: parameters: %s", *this, cmd.params());
-          elle::Buffer content;
           if (cmd.version() == http::Version::v11 &&
-              headers.find("Expect") != headers.end())
+              headers.find("Expect") != headers.end() &&
+              (chunked || length != headers.end()))
           {
             ELLE_TRACE("%s: send Continue header", *this)
             {
               std::string answer(
                 "HTTP/1.1 100 Continue\r\n"
                 "\r\n");
-              socket->write(elle::ConstWeakBuffer(answer));
+              socket.write(elle::ConstWeakBuffer(answer));
             }
           }
-          if (headers.find("chunked") != headers.end())
+          elle::Buffer content;
+          if (chunked)
             ELLE_TRACE("%s: read chunked content", *this)
               while (true)
               {
-                socket->read_until("\r\n"); // Ignore the chunked header.
-                auto buffer = socket->read_until("\r\n");
-                if (buffer == "\r\n")
+                auto const size_line = input.line();
+                auto size = elle::Buffer::Size{0};
+                try
+                {
+                  size = std::stoull(size_line, nullptr, 16);
+                }
+                catch (std::logic_error const&)
+                {
+                  throw Exception(cmd.path(),
+                                  reactor::http::StatusCode::Bad_Request,
+                                  elle::sprintf("invalid chunk size: %s",
+                                                size_line));
+                }
+                if (size == 0)
+                {
+                  // Skip trailers.
+                  while (!input.line().empty())
+                    ;
                   break;
-                ELLE_DEBUG("%s: got content chunk from %s: %s",
-                           *this, socket, buffer.string());
-                content.append(buffer.contents(), buffer.size() - 2);
+                }
+                ELLE_DEBUG("%s: got content chunk of %s bytes from %s",
+                           *this, size, socket);
+                auto const previous = content.size();
+                // Written not to overflow on huge announced sizes.
+                if (size > this->_max_body_size - previous)
+                  throw Exception(
+                    cmd.path(),
+                    reactor::http::StatusCode::Request_Entity_Too_Large,
+                    elle::sprintf("body exceeds %s bytes",
+                                  this->_max_body_size));
+                content.size(previous + size);
+                input.read(elle::WeakBuffer(
+                             content.mutable_contents() + previous, size));
+                if (!input.line().empty())
+                  throw Exception(cmd.path(),
+                                  reactor::http::StatusCode::Bad_Request,
+                                  "chunk is longer than announced");
               }
-          else
+          else if (length != headers.end())
           {
-            auto content_length =
-              boost::lexical_cast<unsigned int>(headers.at("Content-Length"));
-            ELLE_TRACE("%s: read sized content", *this)
-              content = this->read_sized_content(*socket, content_length);
+            auto content_length = elle::Buffer::Size{0};
+            try
+            {
+              content_length =
+                boost::lexical_cast<elle::Buffer::Size>(length->second);
+            }
+            catch (boost::bad_lexical_cast const&)
+            {
+              throw Exception(cmd.path(),
+                              reactor::http::StatusCode::Bad_Request,
+                              elle::sprintf("invalid content length: %s",
+                                            length->second));
+            }
+            if (content_length > this->_max_body_size)
+              throw Exception(
+                cmd.path(),
+                reactor::http::StatusCode::Request_Entity_Too_Large,
+                elle::sprintf("body exceeds %s bytes", this->_max_body_size));
+            ELLE_TRACE("%s: read sized content of size %s",
+                       *this, content_length)
+            {
+              content.size(content_length);
+              input.read(elle::WeakBuffer(content));
+            }
           }
+          consumed = true;
           ELLE_DUMP("%s: content: %s", *this, content);
           // Check JSON is valid. When getting meta_data on S3, we send a JSON
           // mimetype but an empty body, skip this case (and fix it later
@@ -308,27 +697,40 @@ namespace elle
 
             }
           }
-          this->_response(
-            *socket,
-            http::StatusCode::OK,
-            route->second.at(cmd.method())
-              (headers, cookies, cmd.params(), content),
-            cookies);
+          if (function)
+            this->_response(
+              socket,
+              http::StatusCode::OK,
+              function(headers, cookies, cmd.params(), content),
+              cookies);
+          else
+          {
+            auto chunks = stream_function(headers, cookies, cmd.params(),
+                                          content);
+            this->_stream_response(socket, http::StatusCode::OK, chunks,
+                                   cookies);
+          }
         }
         catch (Exception const& e)
         {
           ELLE_WARN("%s: http exception: %s", *this, e.what());
-          this->_response(*socket, e.code(),
-                          this->is_json(headers) ? e.body() : e.what(), cookies);
+          if (!consumed)
+            this->_persistent.erase(&socket);
+          this->_response(socket, e.code(),
+                          this->is_json(headers) ? e.body() : e.what(),
+                          cookies);
         }
         catch (elle::Exception const& e)
         {
           ELLE_WARN("%s: internal error: %s", *this, e.what());
-          this->_response(*socket,
+          if (!consumed)
+            this->_persistent.erase(&socket);
+          this->_response(socket,
                           reactor::http::StatusCode::Internal_Server_Error,
                           e.what(), cookies);
         }
-        ELLE_TRACE("%s: close connection with %s", *this, socket);
+        ++this->_requests;
+        return this->_persistent.find(&socket) != this->_persistent.end();
       }
 
       void
@@ -340,6 +742,15 @@ namespace elle
         this->_routes[route][method] = function;
       }
 
+      void
+      HttpServer::register_stream_route(std::string const& route,
+                                        http::Method method,
+                                        StreamFunction const& function)
+      {
+        ELLE_TRACE("%s: register stream %s on %s", *this, route, method);
+        this->_stream_routes[route][method] = function;
+      }
+
       bool
       HttpServer::is_json(Headers const& headers) const
       {
@@ -354,36 +765,68 @@ namespace elle
                     Cookies const& cookies)
       {
         Headers headers = this->_headers;
+        std::string answer = elle::sprintf(
+          "HTTP/1.1 %s %s\r\n"
+          "Server: Custom HTTP of doom\r\n",
+          (int) code, code);
+        headers["Content-Length"] = std::to_string(content.size());
+        headers["Connection"] =
+          this->_persistent.count(&socket) ? "keep-alive" : "close";
+        for (auto const& value: headers)
+          answer += elle::sprintf("%s: %s\r\n", value.first, value.second);
+        answer += "\r\n";
+        ELLE_TRACE("%s: send response to %s: %s %s",
+                   *this, socket, static_cast<int>(code), code)
         {
-          std::string response;
-          response += content.string();
-          std::string answer = elle::sprintf(
-            "HTTP/1.1 %s %s\r\n"
-            "Server: Custom HTTP of doom\r\n",
-            (int) code, code);
-          headers["Content-Length"] = std::to_string(response.size());
-          headers["Connection"] = "close";
-          for (auto const& value: headers)
-            answer += elle::sprintf("%s: %s\r\n", value.first, value.second);
-          answer += "\r\n" + response;
-          ELLE_TRACE("%s: send response to %s: %s %s",
-                     *this, socket, static_cast<int>(code), code)
-          {
-            ELLE_DUMP("%s", answer);
-            socket.write(elle::ConstWeakBuffer(answer));
-          }
+          ELLE_DUMP("%s%s", answer, content.string());
+          send(socket, std::move(answer), content);
         }
       }
 
-      elle::Buffer
-      HttpServer::read_sized_content(reactor::network::Socket& socket,
-                                     unsigned int length)
+      void
+      HttpServer::_stream_response(reactor::network::Socket& socket,
+                                   http::StatusCode code,
+                                   Chunks& chunks,
+                                   Cookies const& cookies)
       {
-        ELLE_TRACE_SCOPE("%s: read sized content of size %s", *this, length);
-        auto content = elle::Buffer(length);
-        content.size(length);
-        socket.read(elle::WeakBuffer(content.mutable_contents(), length));
-        return content;
+        Headers headers = this->_headers;
+        std::string answer = elle::sprintf(
+          "HTTP/1.1 %s %s\r\n"
+          "Server: Custom HTTP of doom\r\n",
+          (int) code, code);
+        headers["Transfer-Encoding"] = "chunked";
+        headers["Connection"] =
+          this->_persistent.count(&socket) ? "keep-alive" : "close";
+        for (auto const& value: headers)
+          answer += elle::sprintf("%s: %s\r\n", value.first, value.second);
+        answer += "\r\n";
+        ELLE_TRACE_SCOPE("%s: stream response to %s: %s %s",
+                         *this, socket, static_cast<int>(code), code);
+        try
+        {
+          for (auto chunk: chunks)
+          {
+            // An empty chunk would end the body.
+            if (chunk.empty())
+              continue;
+            ELLE_DEBUG("%s: send chunk of %s bytes", *this, chunk.size());
+            answer += elle::sprintf("%x\r\n", chunk.size());
+            send(socket, std::move(answer), chunk, "\r\n");
+            answer.clear();
+          }
+        }
+        catch (elle::Exception const& e)
+        {
+          // The status is sent already: the truncated body can only be
+          // signaled by closing the connection.
+          ELLE_WARN("%s: error streaming response: %s", *this, e.what());
+          this->_persistent.erase(&socket);
+          if (!answer.empty())
+            socket.write(elle::ConstWeakBuffer(answer));
+          return;
+        }
+        answer += "0\r\n\r\n";
+        socket.write(elle::ConstWeakBuffer(answer));
       }
 
       void
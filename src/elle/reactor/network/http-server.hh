@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <boost/optional.hpp>
 
@@ -13,6 +14,7 @@
 #include <elle/json/exceptions.hh>
 #include <elle/json/json.hh>
 #include <elle/log.hh>
+#include <elle/reactor/Generator.hh>
 #include <elle/reactor/Scope.hh>
 #include <elle/reactor/exception.hh>
 #include <elle/reactor/http/Method.hh>
@@ -34,6 +36,12 @@ namespace elle
       ///
       /// N.B. This is not a fully compliant HTTP Server.
       ///
+      /// Connections are kept alive unless the client asks otherwise, and
+      /// pipelined requests are answered in order. Connections are served by
+      /// a pool of handler threads, reused from one connection to the next,
+      /// of at most `max_connections` threads: further clients wait in the
+      /// listen backlog.
+      ///
       /// \code{.cc}
       ///
       /// HTTPServer server;
@@ -144,9 +152,33 @@ namespace elle
         // e.g.: {"/foo" -> {GET -> get_function, POST -> post_function, ...}}
         using Routes = std::unordered_map<std::string, MethodFunctions>;
         ELLE_ATTRIBUTE_X(Routes, routes);
+        /// Chunks of a streamed response body.
+        using Chunks = reactor::Generator<elle::Buffer>;
+        using StreamFunction = std::function<Chunks (Headers const&,
+                                                     Cookies const&,
+                                                     Parameters const&,
+                                                     elle::Buffer const&)>;
+        using StreamMethodFunctions =
+          std::unordered_map<reactor::http::Method, StreamFunction, enum_hash>;
+        using StreamRoutes =
+          std::unordered_map<std::string, StreamMethodFunctions>;
+        ELLE_ATTRIBUTE_X(StreamRoutes, stream_routes);
         ELLE_ATTRIBUTE(std::unique_ptr<reactor::network::Server>, server);
         ELLE_ATTRIBUTE_R(int, port);
         ELLE_ATTRIBUTE(std::unique_ptr<reactor::Thread>, accepter);
+        /// Maximum number of connections served simultaneously, 1024 by
+        /// default. Changes apply to connections accepted afterwards.
+        ELLE_ATTRIBUTE_RW(int, max_connections);
+        /// How long an idle connection waits for its next request, 30
+        /// seconds by default.
+        ELLE_ATTRIBUTE_RW(DurationOpt, keep_alive_timeout);
+        /// Largest request body accepted, 64 MiB by default. Larger ones are
+        /// answered with Request Entity Too Large.
+        ELLE_ATTRIBUTE_RW(elle::Buffer::Size, max_body_size);
+        /// Number of handler threads spawned so far.
+        ELLE_ATTRIBUTE_R(int, handlers);
+        /// Number of requests answered so far.
+        ELLE_ATTRIBUTE_R(int64_t, requests);
         ELLE_ATTRIBUTE_RW(std::function<void (std::string const&)>,
                           check_version);
         ELLE_ATTRIBUTE_RW(std::function<void (std::string const&)>,
@@ -159,7 +191,8 @@ namespace elle
         struct CommandLine
           : public elle::Printable
         {
-          CommandLine(elle::Buffer const& buffer);
+          /// Parse a request line, without its trailing CRLF.
+          CommandLine(elle::ConstWeakBuffer line);
           /// Path requested.
           ELLE_ATTRIBUTE_R(std::string, path);
           /// Method used.
@@ -177,11 +210,24 @@ namespace elle
           void
           print(std::ostream& output) const;
         };
+        /// Data read from a connection and not consumed yet.
+        class Input;
         void
         _accept();
         virtual
         void
         _serve(std::unique_ptr<reactor::network::Socket> socket);
+        /// Serve the request whose header block, request line included, is
+        /// \a head.
+        ///
+        /// \returns Whether the connection can serve further requests.
+        bool
+        _serve(reactor::network::Socket& socket,
+               Input& input,
+               elle::ConstWeakBuffer head);
+        /// Sockets whose connection outlives the current answer.
+        ELLE_ATTRIBUTE(std::unordered_set<reactor::network::Socket const*>,
+                       persistent);
       public:
         /// Register a function to a pair (route / method).
         ///
@@ -193,6 +239,19 @@ namespace elle
         register_route(std::string const& route,
                        http::Method method,
                        Function const& function);
+        /// Register a function streaming its answer to a pair (route /
+        /// method).
+        ///
+        /// Every Chunk yielded by the function is sent to the client as soon
+        /// as it is produced, with chunked transfer encoding.
+        ///
+        /// \param route The route.
+        /// \param method The Method.
+        /// \param function The StreamFunction to call.
+        void
+        register_stream_route(std::string const& route,
+                              http::Method method,
+                              StreamFunction const& function);
         /// Check if content-type is application/json.
         ///
         /// \param headers The headers of the Request.
@@ -206,9 +265,13 @@ namespace elle
                   http::StatusCode code,
                   elle::ConstWeakBuffer content,
                   Cookies const& cookies = Cookies{});
-        elle::Buffer
-        read_sized_content(reactor::network::Socket& socket,
-                           unsigned int length);
+        /// Answer with a chunked body.
+        virtual
+        void
+        _stream_response(reactor::network::Socket& socket,
+                         http::StatusCode code,
+                         Chunks& chunks,
+                         Cookies const& cookies = Cookies{});
         ELLE_ATTRIBUTE_RX(Headers, headers);
       public:
         virtual
@@ -192,6 +192,9 @@ namespace elle
       class PlainSocket<boost::asio::ip::tcp::socket>;
       template
       class StreamSocket<boost::asio::ip::tcp::socket>;
+      template
+      void
+      StreamSocket<boost::asio::ip::tcp::socket>::write(elle::Buffer&&);
       // SSL
       template
       class PlainSocket<boost::asio::ssl::stream<boost::asio::ip::tcp::socket>,
@@ -199,6 +202,11 @@ namespace elle
       template
       class StreamSocket<boost::asio::ssl::stream<boost::asio::ip::tcp::socket>,
                          boost::asio::ip::tcp::socket::endpoint_type>;
+      template
+      void
+      StreamSocket<boost::asio::ssl::stream<boost::asio::ip::tcp::socket>,
+                   boost::asio::ip::tcp::socket::endpoint_type>::
+      write(elle::Buffer&&);
       // UDP
       template
       class PlainSocket<boost::asio::ip::udp::socket>;
@@ -209,6 +217,10 @@ namespace elle
       class PlainSocket<boost::asio::local::stream_protocol::socket>;
       template
       class StreamSocket<boost::asio::local::stream_protocol::socket>;
+      template
+      void
+      StreamSocket<boost::asio::local::stream_protocol::socket>::
+      write(elle::Buffer&&);
 #endif
     }
   }
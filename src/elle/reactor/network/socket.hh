@@ -340,16 +340,56 @@ namespace elle
       `------*/
       public:
         /// @Socket::write.
+        ///
+        /// Concurrent writes are coalesced: whichever writer gets the socket
+        /// sends every queued buffer, in order, with one vectored write. The
+        /// buffer is not copied.
         void
         write(elle::ConstWeakBuffer buffer) override;
+        /// Write a buffer, taking its ownership.
+        ///
+        /// Outside of the scheduler, the buffer is queued as is instead of
+        /// being copied. Only rvalue Buffers pick this overload, anything else
+        /// is viewed through a ConstWeakBuffer.
+        template <typename B,
+                  std::enable_if_t<std::is_same<B, elle::Buffer>::value, int> = 0>
+        void
+        write(B&& buffer);
+        /// Number of buffers waiting to be written.
+        std::size_t
+        write_queue_depth() const;
+        /// Number of bytes handed to the socket and not yet acknowledged.
+        Size
+        write_bytes_in_flight() const;
+        /// Number of vectored writes issued so far, each possibly
+        /// coalescing several write calls.
+        std::size_t
+        write_batches() const;
+        /// Maximum number of bytes coalesced into one vectored write.
+        ///
+        /// A single larger buffer is still written at once.
+        Size
+        write_coalesce_limit() const;
+        void
+        write_coalesce_limit(Size limit);
+        /// Default for write_coalesce_limit: 1 MiB.
+        static Size const default_write_coalesce_limit;
       protected:
         void
         _final_flush();
       private:
+        /// A write waiting in the queue.
+        struct PendingWrite;
+        void
+        _write(PendingWrite& write);
         void
         _async_write();
         ELLE_ATTRIBUTE(Mutex, write_mutex);
+        ELLE_ATTRIBUTE(std::vector<PendingWrite*>, pending_writes);
         ELLE_ATTRIBUTE(std::list<elle::Buffer>, async_writes);
+        Size _write_coalesce_limit = default_write_coalesce_limit;
+        Size _write_bytes_in_flight = 0;
+        std::size_t _write_batches = 0;
 
       /*-----------------.
       | Concrete sockets |
@@ -1,3 +1,6 @@
+#include <elle/With.hh>
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/exception.hh>
 #include <elle/reactor/network/SocketOperation.hxx>
 
 namespace elle
@@ -510,12 +513,13 @@ namespace elle
         using Socket = typename SocketSpecialization<AsioSocket>::Socket;
         using Super = DataOperation<Socket>;
         using Spe = SocketSpecialization<AsioSocket>;
+        using Buffers = std::vector<boost::asio::const_buffer>;
         Write(PlainSocket& plain,
               AsioSocket& socket,
-              elle::ConstWeakBuffer buffer)
+              Buffers buffers)
           : Super(Spe::socket(socket))
           , _socket(plain)
-          , _buffer(std::move(buffer))
+          , _buffers(std::move(buffers))
           , _written(0)
         {}
 
@@ -525,7 +529,7 @@ namespace elle
         {
           boost::asio::async_write(
             *this->_socket.socket(),
-            boost::asio::buffer(this->_buffer.contents(), this->_buffer.size()),
+            this->_buffers,
             [this](const boost::system::error_code& error,
                    std::size_t written)
             {
@@ -548,24 +552,38 @@ namespace elle
         }
 
         ELLE_ATTRIBUTE(PlainSocket const&, socket);
-        ELLE_ATTRIBUTE(elle::ConstWeakBuffer, buffer);
+        ELLE_ATTRIBUTE(Buffers, buffers);
         ELLE_ATTRIBUTE_R(Size, written);
       };
 
+      template <typename AsioSocket, typename EndPoint>
+      struct StreamSocket<AsioSocket, EndPoint>::PendingWrite
+      {
+        /// The data to write.
+        elle::ConstWeakBuffer buffer;
+        /// The data, if we own it.
+        elle::Buffer owned;
+        /// Whether a writer picked it up.
+        bool taken;
+        /// Whether it was written, successfully or not.
+        bool done;
+        /// Why the write failed, if it did.
+        std::exception_ptr error;
+      };
+
+      template <typename AsioSocket, typename EndPoint>
+      Size const
+      StreamSocket<AsioSocket, EndPoint>::default_write_coalesce_limit =
+        1 << 20;
+
       template <typename AsioSocket, typename EndPoint>
       void
       StreamSocket<AsioSocket, EndPoint>::write(elle::ConstWeakBuffer buffer)
       {
-        ELLE_LOG_COMPONENT("elle.reactor.network.Socket");
         if (reactor::scheduler().current())
         {
-          {
-            Lock lock(this->_write_mutex);
-            ELLE_TRACE_SCOPE("%s: write %s bytes", this, buffer.size());
-            Write<Self, AsioSocket> write(*this, *this->socket(), buffer);
-            write.run();
-          }
-          this->_async_write();
+          auto pending = PendingWrite{buffer, {}, false, false, nullptr};
+          this->_write(pending);
         }
         else
         {
@@ -574,6 +592,164 @@ namespace elle
         }
       }
 
+      template <typename AsioSocket, typename EndPoint>
+      template <typename B,
+                std::enable_if_t<std::is_same<B, elle::Buffer>::value, int>>
+      void
+      StreamSocket<AsioSocket, EndPoint>::write(B&& buffer)
+      {
+        if (reactor::scheduler().current())
+        {
+          auto pending = PendingWrite{{}, std::move(buffer), false, false,
+                                      nullptr};
+          pending.buffer = pending.owned;
+          this->_write(pending);
+        }
+        else
+        {
+          this->_async_writes.emplace_back(std::move(buffer));
+          this->_async_write();
+        }
+      }
+
+      template <typename AsioSocket, typename EndPoint>
+      void
+      StreamSocket<AsioSocket, EndPoint>::_write(PendingWrite& pending)
+      {
+        ELLE_LOG_COMPONENT("elle.reactor.network.Socket");
+        this->_pending_writes.emplace_back(&pending);
+        try
+        {
+          Lock lock(this->_write_mutex);
+          while (!pending.done)
+          {
+            // Take as many queued writes as the limit allows, in order.
+            auto const& queue = this->_pending_writes;
+            auto buffers = typename Write<Self, AsioSocket>::Buffers{};
+            auto size = Size(0);
+            auto end = queue.begin();
+            for (; end != queue.end(); ++end)
+            {
+              if (!buffers.empty() &&
+                  size + (*end)->buffer.size() > this->_write_coalesce_limit)
+                break;
+              (*end)->taken = true;
+              size += (*end)->buffer.size();
+              buffers.emplace_back((*end)->buffer.contents(),
+                                   (*end)->buffer.size());
+            }
+            auto batch = std::vector<PendingWrite*>(queue.begin(), end);
+            this->_pending_writes.erase(this->_pending_writes.begin(), end);
+            ELLE_TRACE_SCOPE("%s: write %s bytes from %s buffers",
+                             this, size, batch.size());
+            this->_write_bytes_in_flight = size;
+            ++this->_write_batches;
+            auto error = std::exception_ptr{};
+            auto finish = [&]
+              {
+                this->_write_bytes_in_flight = 0;
+                for (auto w: batch)
+                {
+                  w->done = true;
+                  w->error = error;
+                }
+              };
+            // We were interrupted while writing: fail the batch, which may
+            // have been partially written, but keep the interruption for
+            // ourselves.
+            auto interrupted = [&]
+              {
+                error = std::make_exception_ptr(
+                  Error(elle::sprintf("%s: write interrupted", *this)));
+                finish();
+              };
+            try
+            {
+              Write<Self, AsioSocket> write(*this, *this->socket(),
+                                            std::move(buffers));
+              write.run();
+            }
+            // Timeouts are elle::Errors too, but target us alone.
+            catch (reactor::Timeout const&)
+            {
+              interrupted();
+              throw;
+            }
+            catch (reactor::Terminate const&)
+            {
+              interrupted();
+              throw;
+            }
+            catch (Error const&)
+            {
+              // An I/O error: every write of the batch failed with it.
+              error = std::current_exception();
+            }
+            catch (...)
+            {
+              interrupted();
+              throw;
+            }
+            finish();
+          }
+        }
+        catch (...)
+        {
+          // We were interrupted while waiting for our turn.
+          if (!pending.taken)
+            this->_pending_writes.erase(
+              std::find(this->_pending_writes.begin(),
+                        this->_pending_writes.end(),
+                        &pending));
+          else if (!pending.done)
+            // Someone is writing our data: stay until it's done, as we own
+            // the memory.
+            elle::With<Thread::NonInterruptible>() << [&]
+            {
+              Lock lock(this->_write_mutex);
+            };
+          throw;
+        }
+        if (pending.error)
+          std::rethrow_exception(pending.error);
+        this->_async_write();
+      }
+
+      template <typename AsioSocket, typename EndPoint>
+      std::size_t
+      StreamSocket<AsioSocket, EndPoint>::write_queue_depth() const
+      {
+        return this->_pending_writes.size() + this->_async_writes.size();
+      }
+
+      template <typename AsioSocket, typename EndPoint>
+      Size
+      StreamSocket<AsioSocket, EndPoint>::write_bytes_in_flight() const
+      {
+        return this->_write_bytes_in_flight;
+      }
+
+      template <typename AsioSocket, typename EndPoint>
+      std::size_t
+      StreamSocket<AsioSocket, EndPoint>::write_batches() const
+      {
+        return this->_write_batches;
+      }
+
+      template <typename AsioSocket, typename EndPoint>
+      Size
+      StreamSocket<AsioSocket, EndPoint>::write_coalesce_limit() const
+      {
+        return this->_write_coalesce_limit;
+      }
+
+      template <typename AsioSocket, typename EndPoint>
+      void
+      StreamSocket<AsioSocket, EndPoint>::write_coalesce_limit(Size limit)
+      {
+        this->_write_coalesce_limit = limit;
+      }
+
       template <typename AsioSocket, typename EndPoint>
       void
       StreamSocket<AsioSocket, EndPoint>::_async_write()
@@ -582,18 +758,29 @@ namespace elle
         if (!this->_async_writes.empty() && !this->_write_mutex.locked())
         {
           this->_write_mutex.acquire();
-          auto& buffer = this->_async_writes.front();
-          ELLE_TRACE_SCOPE(
-            "%s: write %s bytes asynchronously", this, buffer.size());
-          auto asio_buffer =
-            boost::asio::buffer(buffer.contents(), buffer.size());
+          auto buffers = std::vector<boost::asio::const_buffer>{};
+          auto size = Size(0);
+          for (auto const& buffer: this->_async_writes)
+          {
+            if (!buffers.empty() &&
+                size + buffer.size() > this->_write_coalesce_limit)
+              break;
+            size += buffer.size();
+            buffers.emplace_back(buffer.contents(), buffer.size());
+          }
+          ELLE_TRACE_SCOPE("%s: write %s bytes from %s buffers asynchronously",
+                           this, size, buffers.size());
+          this->_write_bytes_in_flight = size;
+          auto const count = buffers.size();
           boost::asio::async_write(
             *this->socket(),
-            asio_buffer,
-            [this]
+            std::move(buffers),
+            [this, count]
             (const boost::system::error_code& error, std::size_t written)
             {
-              this->_async_writes.pop_front();
+              for (auto i = 0u; i < count; ++i)
+                this->_async_writes.pop_front();
+              this->_write_bytes_in_flight = 0;
               if (error == boost::system::errc::operation_canceled)
                 return;
               else if (error)
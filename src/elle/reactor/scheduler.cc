@@ -1,5 +1,9 @@
+#include <algorithm>
+#include <condition_variable>
+
 #include <elle/Measure.hh>
 #include <elle/Plugin.hh>
+#include <elle/With.hh>
 #include <elle/assert.hh>
 #include <elle/attribute.hh>
 #include <elle/finally.hh>
@@ -17,6 +21,8 @@
 #endif
 #include <elle/reactor/exception.hh>
 #include <elle/reactor/Operation.hh>
+#include <elle/reactor/SchedulerPool.hh>
+#include <elle/reactor/Scope.hh>
 #include <elle/reactor/scheduler.hh>
 #include <elle/reactor/Thread.hh>
 
@@ -43,8 +49,17 @@ namespace elle
 
     Scheduler::Scheduler()
       : _done(false)
+      , _blocked(false)
       , _shallstop(false)
       , _current(nullptr)
+      , _inbox(nullptr)
+      , _running()
+      , _round()
+      , _frozen()
+      , _pool(nullptr)
+      , _pool_empty(false)
+      , _pool_threads()
+      , _pool_threads_mutex()
       , _background_service_work(
            std::make_unique<boost::asio::io_service::work>(this->_background_service))
       , _background_pool()
@@ -163,23 +178,29 @@ namespace elle
           // FIXME: Indent the backtrace
           std::cerr << thread.backtrace() << std::endl;
         };
+      auto const starting = [] (Thread const& t)
+        {
+          return t._thread->status() == backend::Thread::Status::starting;
+        };
+      this->_inbox_drain();
       if (!this->_frozen.empty())
       {
         std::cerr << "== FROZEN THREADS ==" << std::endl;
-        for (auto thread: this->_frozen)
-          print_thread(*thread);
+        for (auto& thread: this->_frozen)
+          print_thread(thread);
       }
-      if (!this->_running.empty())
+      if (!this->_running.empty() || !this->_round.empty())
       {
         std::cerr << "== RUNNING THREADS ==" << std::endl;
-        for (auto thread: this->_running)
-          print_thread(*thread);
-      }
-      if (!this->_starting.empty())
-      {
+        for (auto const* list: {&this->_round, &this->_running})
+          for (auto& thread: *list)
+            if (!starting(thread))
+              print_thread(thread);
         std::cerr << "== STARTING THREADS ==" << std::endl;
-        for (auto thread: this->_starting)
-          print_thread(*thread);
+        for (auto const* list: {&this->_round, &this->_running})
+          for (auto& thread: *list)
+            if (starting(thread))
+              print_thread(thread);
       }
     }
 
@@ -242,29 +263,25 @@ namespace elle
     Scheduler::step()
     {
       PushScheduler p(this);
-      // Could avoid locking if no jobs are pending with a boolean.
-      {
-        std::unique_lock<std::mutex> lock(this->_starting_mtx);
-        auto& ordered = this->_starting.get<1>();
-        this->_running.insert(ordered.begin(), ordered.end());
-        this->_starting.clear();
-      }
-      auto& ordered = this->_running.get<1>();
-      auto running = make_vector(ordered);
-      ELLE_TRACE_SCOPE("Scheduler: new round with %s jobs", running.size());
-
-      ELLE_DUMP("%s: starting: %s", this, this->_starting);
-      ELLE_DUMP("%s: running: %s", this, this->_running);
-      ELLE_DUMP("%s: frozen: %s", this, this->_frozen);
+      this->_inbox_drain();
+      if (this->_pool && this->_running.empty())
+        this->_pool->_steal(*this);
+      // Threads woken or spawned during the round land in the running list,
+      // and wait for the next one. Threads are moved back to the running list
+      // just before being stepped, so a thread removed during the round, by
+      // terminate_now for instance, is simply unlinked from wherever it is.
+      this->_round.splice(this->_round.end(), this->_running);
+      ELLE_TRACE_SCOPE("Scheduler: new round with %s jobs",
+                       this->_round.size());
       ELLE_MEASURE("Scheduler round")
-        for (Thread* t: running)
-          // If the thread was stopped during this round, skip. Can be caused by
-          // terminate_now, for instance.
-          if (elle::find(this->_running, t))
-          {
-            ELLE_TRACE("Scheduler: schedule %s", *t);
-            this->_step(t);
-          }
+        while (!this->_round.empty())
+        {
+          auto& t = this->_round.front();
+          this->_round.pop_front();
+          this->_running.push_back(t);
+          ELLE_TRACE("Scheduler: schedule %s", t);
+          this->_step(&t);
+        }
       ELLE_TRACE("%s: run asynchronous jobs", *this)
       {
         ELLE_MEASURE_SCOPE("Asio callbacks");
@@ -288,21 +305,35 @@ namespace elle
           this->terminate();
         }
       }
-      if (this->_running.empty() && this->_starting.empty())
+      auto const idle = [this]
+        {
+          return this->_running.empty() && !this->_inbox.load();
+        };
+      if (idle())
       {
-        if (this->_frozen.empty())
+        if (this->_frozen.empty() &&
+            (!this->_pool || this->_pool->_idle(*this)))
         {
           ELLE_TRACE_SCOPE("%s: no threads left, we're done", *this);
           return false;
         }
         else
-          while (this->_running.empty() && this->_starting.empty())
+          while (idle())
           {
             ELLE_TRACE_SCOPE("%s: nothing to do, "
                        "polling asio in a blocking fashion", *this);
             this->_io_service.reset();
             boost::system::error_code err;
+            // Threads registered from now on wake us up, check none slipped
+            // in before.
+            this->_blocked = true;
+            if (this->_inbox.load())
+            {
+              this->_blocked = false;
+              break;
+            }
             std::size_t run = this->_io_service.run_one(err);
+            this->_blocked = false;
             ELLE_DEBUG("%s: %s callback called", *this, run);
             if (err)
             {
@@ -316,6 +347,9 @@ namespace elle
             }
             else if (this->_shallstop)
               break;
+            // Give stealing from the rest of the pool another try.
+            else if (this->_pool)
+              break;
           }
       }
       else
@@ -350,7 +384,7 @@ namespace elle
       if (thread->state() == Thread::State::done)
       {
         ELLE_TRACE("%s: %s finished", *this, *thread);
-        this->_running.erase(thread);
+        thread->_scheduler_hook.unlink();
         thread->_scheduler_release();
       }
     }
@@ -369,35 +403,95 @@ namespace elle
     Scheduler::_freeze(Thread& thread)
     {
       ELLE_ASSERT_EQ(thread.state(), Thread::State::running);
-      ELLE_ASSERT_NEQ(this->_running.find(&thread), this->_running.end());
-      this->_running.erase(&thread);
-      this->_frozen.insert(&thread);
+      ELLE_ASSERT(thread._scheduler_hook.is_linked());
+      thread._scheduler_hook.unlink();
+      this->_frozen.push_back(thread);
       thread.frozen()();
     }
 
     void
     Scheduler::_thread_register(Thread& thread)
     {
-      // FIXME: be thread safe only if needed
+      if (this->_pool)
       {
-        std::unique_lock<std::mutex> lock(this->_starting_mtx);
-        this->_starting.insert(&thread);
-        // Wake the scheduler.
+        // Push under the pool lock so we cannot be deemed idle in between.
+        this->_pool->_busy(*this, thread);
+        this->_pool->_notify(*this);
+      }
+      else
+        this->_inbox_push(thread, thread);
+    }
+
+    void
+    Scheduler::_inbox_push(Thread& first, Thread& last)
+    {
+      auto head = this->_inbox.load(std::memory_order_relaxed);
+      do
+        last._inbox_next = head;
+      while (!this->_inbox.compare_exchange_weak(head, &first));
+      // Our own threads are picked up at the next round, only wake us up if we
+      // are blocked on asio.
+      if (this->_blocked)
         this->_io_service.post([]{});
+    }
+
+    void
+    Scheduler::_inbox_drain()
+    {
+      auto thread = this->_inbox.exchange(nullptr);
+      if (!thread)
+        return;
+      // The inbox is a stack, restore the registration order.
+      auto fresh = ThreadList{};
+      while (thread)
+      {
+        auto next = thread->_inbox_next;
+        thread->_inbox_next = nullptr;
+        fresh.push_front(*thread);
+        if (this->_pool)
+        {
+          std::unique_lock<std::mutex> lock(this->_pool_threads_mutex);
+          this->_pool_threads.insert(thread);
+        }
+        thread = next;
       }
+      this->_running.splice(this->_running.end(), fresh);
     }
 
     void
     Scheduler::_unfreeze(Thread& thread, std::string const& reason)
     {
       ELLE_ASSERT_EQ(thread.state(), Thread::State::frozen);
-      this->_frozen.erase(&thread);
-      this->_running.insert(&thread);
+      bool const wake = this->_running.empty();
+      thread._scheduler_hook.unlink();
+      this->_running.push_back(thread);
       thread.unfrozen()(reason);
-      if (this->_running.size() == 1)
+      if (wake)
         this->_io_service.post([]{});
     }
 
+    void
+    Scheduler::_wake_remote(Thread& thread,
+                            Waitable* waitable,
+                            std::exception_ptr exception,
+                            std::string description)
+    {
+      this->_io_service.post(
+        [this, t = &thread, waitable, exception, d = std::move(description)]
+        {
+          {
+            // The thread may have been destroyed since.
+            std::unique_lock<std::mutex> lock(this->_pool_threads_mutex);
+            if (this->_pool_threads.find(t) == this->_pool_threads.end())
+              return;
+          }
+          // The wait may have been aborted since.
+          if (t->state() == Thread::State::frozen &&
+              t->_waited.find(waitable) != t->_waited.end())
+            t->_wake(waitable, exception, d);
+        });
+    }
+
     void
     Scheduler::terminate_later()
     {
@@ -410,25 +504,25 @@ namespace elle
     {
       ELLE_TRACE_SCOPE("%s: terminate", *this);
       Threads terminated;
-      for (Thread* t: this->_starting)
-      {
-        // Threads expect to be done when deleted. For this very
-        // particuliar case, hack the state before deletion.
-        t->_state = Thread::State::done;
-        t->_scheduler_release();
-      }
-      this->_starting.clear();
-      for (Thread* t: Threads(this->_running))
-        if (t != this->_current)
+      this->_inbox_drain();
+      auto threads = Threads{};
+      for (auto* list: {&this->_round, &this->_running, &this->_frozen})
+        for (auto& t: *list)
+          threads.insert(&t);
+      for (Thread* t: threads)
+        if (t->_thread->status() == backend::Thread::Status::starting)
+        {
+          // Threads expect to be done when deleted. For this very
+          // particuliar case, hack the state before deletion.
+          t->_scheduler_hook.unlink();
+          t->_state = Thread::State::done;
+          t->_scheduler_release();
+        }
+        else if (t != this->_current)
         {
           t->terminate();
           terminated.insert(t);
         }
-      for (Thread* t: Threads(this->_frozen))
-      {
-        t->terminate();
-        terminated.insert(t);
-      }
       return terminated;
     }
 
@@ -444,6 +538,10 @@ namespace elle
     Scheduler::_terminate(Thread* thread)
     {
       ELLE_TRACE_SCOPE("%s: terminate %s", this, thread);
+      // Only the owner may touch the ready lists, see if the thread is still
+      // pending in the inbox.
+      if (Scheduler::scheduler() == this)
+        this->_inbox_drain();
       if (current() == thread)
       {
         ELLE_DEBUG(
@@ -451,9 +549,12 @@ namespace elle
         throw Terminate(thread->name());
       }
       // If the underlying coroutine was never run, nothing to do.
-      else if (this->_starting.erase(thread))
+      else if (thread->_scheduler_hook.is_linked()
+               && thread->_thread->status() ==
+               backend::Thread::Status::starting)
       {
         ELLE_DEBUG("thread was starting, discard it");
+        thread->_scheduler_hook.unlink();
         thread->_state = Thread::State::done;
         thread->Waitable::_signal();
         thread->_scheduler_release();
@@ -687,6 +788,70 @@ namespace elle
       o.run();
     }
 
+    void
+    background_parallel(std::size_t count,
+                        std::function<void (std::size_t)> const& job)
+    {
+      if (count == 0)
+        return;
+      if (count == 1)
+      {
+        background([&] { job(0); });
+        return;
+      }
+      // Aborted background operations keep running detached: track the
+      // slices that entered so we can wait them out before `job` and the
+      // state it refers to go away.
+      struct State
+      {
+        std::atomic<std::size_t> next{0};
+        bool cancel = false;
+        int running = 0;
+        std::mutex mutex;
+        std::condition_variable done;
+      };
+      auto state = std::make_shared<State>();
+      auto slice = [state, count, &job]
+        {
+          {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            if (state->cancel)
+              return;
+            ++state->running;
+          }
+          elle::SafeFinally leave([&]
+            {
+              std::unique_lock<std::mutex> lock(state->mutex);
+              if (--state->running == 0)
+                state->done.notify_all();
+            });
+          for (auto i = state->next++; i < count; i = state->next++)
+          {
+            {
+              std::unique_lock<std::mutex> lock(state->mutex);
+              if (state->cancel)
+                return;
+            }
+            job(i);
+          }
+        };
+      elle::SafeFinally join([&]
+        {
+          std::unique_lock<std::mutex> lock(state->mutex);
+          state->cancel = true;
+          state->done.wait(lock, [&] { return state->running == 0; });
+        });
+      auto const slices = std::min<std::size_t>(
+        {count, std::max(std::thread::hardware_concurrency(), 1u), 16});
+      elle::With<Scope>() << [&] (Scope& scope)
+      {
+        for (std::size_t i = 0; i < slices; ++i)
+          scope.run_background(elle::sprintf("parallel %s", i),
+                               [&] { background(slice); });
+        reactor::wait(scope);
+      };
+    }
+
     void
     yield()
     {
@@ -812,6 +977,24 @@ namespace
     static CXAThreadMap _cxa_thread_map;
     return _cxa_thread_map;
   }
+
+  /// Exception storage of schedulers outside of any of their threads. Several
+  /// schedulers of a pool run concurrently and cannot share it.
+  using CXASchedulerMap = std::unordered_map<
+    elle::reactor::Scheduler const*,
+    std::unique_ptr<__cxxabiv1::__cxa_eh_globals>>;
+
+  __cxxabiv1::__cxa_eh_globals*
+  cxa_scheduler_globals(elle::reactor::Scheduler const* sched)
+  {
+    static auto map = new CXASchedulerMap;
+    static auto mutex = new std::mutex;
+    std::unique_lock<std::mutex> lock(*mutex);
+    auto& res = (*map)[sched];
+    if (!res)
+      res.reset(new __cxxabiv1::__cxa_eh_globals());
+    return res.get();
+  }
 }
 
 namespace __cxxabiv1
@@ -836,6 +1019,8 @@ namespace __cxxabiv1
       }
       if (t == nullptr)
       {
+        if (sched->pool())
+          return cxa_scheduler_globals(sched);
         static auto* nullthread_ceg = new __cxa_eh_globals();
         return nullthread_ceg;
       }
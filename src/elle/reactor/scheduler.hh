@@ -1,9 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <thread>
 
+#include <unordered_set>
+
+#include <boost/intrusive/list.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/identity.hpp>
@@ -19,6 +23,7 @@
 #include <elle/reactor/asio.hh>
 #include <elle/reactor/duration.hh>
 #include <elle/reactor/fwd.hh>
+#include <elle/reactor/Thread.hh>
 #include <elle/reactor/backend/fwd.hh>
 
 namespace elle
@@ -121,6 +126,10 @@ namespace elle
       _rethrow_exception(std::exception_ptr e) const;
       void _step(Thread* t);
       ELLE_ATTRIBUTE_R(bool, done);
+      /// Whether we are blocked waiting for asio events. Registering a thread
+      /// from another system thread must then wake us up, and a pool may hand
+      /// us Threads to steal.
+      ELLE_ATTRIBUTE(std::atomic<bool>, blocked);
 
     /*-------------------.
     | Threads management |
@@ -160,10 +169,24 @@ namespace elle
     private:
       void
       _freeze(Thread& thread);
+      /// Register a new Thread. Lock-free, callable from any system thread.
       void
       _thread_register(Thread& thread);
+      /// Push the chain from @a first to @a last on top of the inbox.
+      void
+      _inbox_push(Thread& first, Thread& last);
+      /// Move threads registered since last time to the running list.
+      void
+      _inbox_drain();
       void
       _unfreeze(Thread& thread, std::string const& reason);
+      /// Wake @a thread, on behalf of a Waitable signaled from another
+      /// Scheduler, from this Scheduler's system thread.
+      void
+      _wake_remote(Thread& thread,
+                   Waitable* waitable,
+                   std::exception_ptr exception,
+                   std::string description);
     private:
       /// Terminate the given Thread.
       ///
@@ -182,11 +205,36 @@ namespace elle
       void
       _terminate_now(Thread* thread,
                      bool suicide);
+      /// Intrusive list of threads, linked through Thread::_scheduler_hook.
+      using ThreadList = boost::intrusive::list<
+        Thread,
+        boost::intrusive::member_hook<
+          Thread, Thread::SchedulerHook, &Thread::_scheduler_hook>,
+        boost::intrusive::constant_time_size<false>>;
       ELLE_ATTRIBUTE(Thread*, current);
-      ELLE_ATTRIBUTE(Threads, starting);
-      ELLE_ATTRIBUTE(std::mutex, starting_mtx);
-      ELLE_ATTRIBUTE(Threads, running);
-      ELLE_ATTRIBUTE(Threads, frozen);
+      /// Threads registered since the last round, most recent first, chained
+      /// through Thread::_inbox_next.
+      ELLE_ATTRIBUTE(std::atomic<Thread*>, inbox);
+      /// Ready threads, including the ones not started yet.
+      ELLE_ATTRIBUTE(ThreadList, running);
+      /// Ready threads not stepped yet during the current round.
+      ELLE_ATTRIBUTE(ThreadList, round);
+      ELLE_ATTRIBUTE(ThreadList, frozen);
+
+    /*------.
+    | Pools |
+    `------*/
+    public:
+      /// The SchedulerPool this Scheduler belongs to, if any.
+      ELLE_ATTRIBUTE_R(SchedulerPool*, pool);
+    private:
+      friend class SchedulerPool;
+      /// Whether we have no Thread at all. Guarded by the pool mutex.
+      ELLE_ATTRIBUTE(bool, pool_empty);
+      /// Threads that ran here and are not destroyed yet, to discard wakes
+      /// from other Schedulers that arrive too late.
+      ELLE_ATTRIBUTE(std::unordered_set<Thread*>, pool_threads);
+      ELLE_ATTRIBUTE(std::mutex, pool_threads_mutex);
 
     /*-------------------------.
     | Thread Exception Handler |
@@ -318,6 +366,19 @@ namespace elle
     /// @param action The action to run in background.
     void
     background(std::function<void()> const& action);
+    /// Run @a job for every index in [0, @a count) across the background
+    /// pool and yield until all of them completed.
+    ///
+    /// Indexes are handed out dynamically to at most one system thread per
+    /// core, so uneven jobs balance out. The first exception thrown by a job
+    /// is rethrown and remaining indexes are skipped; no job is still running
+    /// once this returns.
+    ///
+    /// @param count The number of jobs.
+    /// @param job   The action to run for each index.
+    void
+    background_parallel(std::size_t count,
+                        std::function<void (std::size_t)> const& job);
     /// Yield execution for this scheduler round.
     void
     yield();
@@ -1,4 +1,7 @@
 #include <elle/serialization/Serializer.hh>
+
+#include <atomic>
+
 #include <elle/serialization/SerializerIn.hh>
 #include <elle/serialization/SerializerOut.hh>
 
@@ -182,5 +185,42 @@ namespace elle
       elle::SafeFinally leave([&] { this->_leave("value");});
       f(index);
     }
+
+    void
+    Serializer::_serialize_type(std::string const& key,
+                                TypeInfo const&,
+                                TypeInfo const&,
+                                std::function<std::string const& ()> const& name)
+    {
+      auto type_name = name();
+      this->serialize(key, type_name);
+    }
+
+    void const*
+    Serializer::_deserialize_type(
+      std::string const& key,
+      TypeInfo const&,
+      std::function<void const* (std::string const&)> const& resolve)
+    {
+      std::string type_name;
+      this->serialize(key, type_name);
+      return resolve(type_name);
+    }
+
+    void
+    Serializer::_serialize_version_tag(elle::Version& version)
+    {
+      this->serialize(".version", version);
+    }
+
+    namespace _details
+    {
+      std::size_t
+      next_type_slot()
+      {
+        static std::atomic<std::size_t> next(0);
+        return next++;
+      }
+    }
   }
 }
@@ -374,6 +374,10 @@ namespace elle
       text() const;
       ELLE_ATTRIBUTE_R(bool, versioned);
       ELLE_ATTRIBUTE_R(boost::optional<Versions>, versions);
+      /// The versions of serialization tags resolved against versions(),
+      /// indexed by _details::type_slot.
+      ELLE_ATTRIBUTE_RX(std::vector<boost::optional<elle::Version>>,
+                        version_tags);
 
     /*--------------.
     | Serialization |
@@ -752,6 +756,36 @@ namespace elle
       _serialize_variant(std::vector<std::string> const& names,
                          int index, // out: filled, in: -1
                          std::function<void(int)> const& f);
+      /// Serialize the dynamic type of a polymorphic object.
+      ///
+      /// @param key The name of the entry.
+      /// @param hierarchy The root of the object hierarchy.
+      /// @param type The dynamic type of the object.
+      /// @param name Return the name @a type is registered under.
+      virtual
+      void
+      _serialize_type(std::string const& key,
+                      TypeInfo const& hierarchy,
+                      TypeInfo const& type,
+                      std::function<std::string const& ()> const& name);
+      /// Deserialize the dynamic type of a polymorphic object.
+      ///
+      /// @param key The name of the entry.
+      /// @param hierarchy The root of the object hierarchy.
+      /// @param resolve Return the factory registered for a type name.
+      /// @return The factory of the type.
+      virtual
+      void const*
+      _deserialize_type(
+        std::string const& key,
+        TypeInfo const& hierarchy,
+        std::function<void const* (std::string const&)> const& resolve);
+      /// Serialize or deserialize the version an object is serialized with.
+      ///
+      /// @param version The version to serialize or to deserialize to.
+      virtual
+      void
+      _serialize_version_tag(elle::Version& version);
 
       /// Serialize or deserialize an arbitrary collection.
       ///
@@ -99,29 +99,55 @@ namespace elle
         : std::true_type
       {};
 
+      /// A new dense index, for type_slot.
+      ELLE_API
+      std::size_t
+      next_type_slot();
+
+      /// A small integer unique to T, to index dense per-type tables.
+      template <typename T>
+      std::size_t
+      type_slot()
+      {
+        static auto const res = next_type_slot();
+        return res;
+      }
+
       template <typename T>
       std::enable_if_t<has_version_tag<T>(), elle::Version>
-      version_tag(boost::optional<Serializer::Versions> const& versions)
+      version_tag(Serializer& s)
       {
         ELLE_LOG_COMPONENT("elle.serialization.Serializer");
-        if (versions)
+        using Tag = typename T::serialization_tag;
+        if (!s.versions())
+          return Tag::version;
+        // Look each tag up once per serializer, not once per object.
+        auto const slot = type_slot<Tag>();
+        auto& tags = s.version_tags();
+        if (tags.size() <= slot)
+          tags.resize(slot + 1);
+        if (!tags[slot])
         {
-          auto it = versions->find(type_info<typename T::serialization_tag>());
-          if (it != versions->end())
+          auto it = s.versions()->find(type_info<Tag>());
+          if (it != s.versions()->end())
           {
             ELLE_DUMP("use local serialization version for %s",
                       elle::type_info<T>());
-            return it->second;
+            tags[slot] = it->second;
+          }
+          else
+          {
+            ELLE_DUMP("use default serialization version for %s",
+                      elle::type_info<T>());
+            tags[slot] = Tag::version;
           }
         }
-        ELLE_DUMP("use default serialization version for %s",
-                  elle::type_info<T>());
-        return T::serialization_tag::version;
+        return *tags[slot];
       }
 
       template <typename T>
       std::enable_if_t<!has_version_tag<T>(), elle::Version>
-      version_tag(boost::optional<Serializer::Versions> const&)
+      version_tag(Serializer&)
       {
         ELLE_LOG_COMPONENT("elle.serialization.Serializer");
         ELLE_WARN("no serialization version tag for %s", elle::type_info<T>());
@@ -214,42 +240,51 @@ namespace elle
       std::enable_if_t<virtually<T>()>
       _smart_virtual_switch(Serializer& s, P& ptr)
       {
+        using H = typename T::Hierarchy;
         if (s.out())
         {
           ELLE_ASSERT(bool(ptr));
-          auto id = elle::type_info(*ptr);
-          auto const& map = Hierarchy<typename T::Hierarchy>::_rmap();
-          auto it = map.find(id);
-          if (it == map.end())
-          {
-            ELLE_LOG_COMPONENT("elle.serialization.Serializer");
-            auto message =
-              elle::sprintf("unknown serialization type: %s", id);
-            ELLE_WARN("%s", message);
-            throw Error(message);
-          }
-          else
-          {
-            auto type_name = it->second;
-            s.serialize(T::virtually_serializable_key, type_name);
-            s.serialize_object(*ptr);
-          }
+          auto const id = elle::type_info(*ptr);
+          s._serialize_type(
+            T::virtually_serializable_key, type_info<H>(), id,
+            [&] () -> std::string const&
+            {
+              auto const& map = Hierarchy<H>::_rmap();
+              auto it = map.find(id);
+              if (it == map.end())
+              {
+                ELLE_LOG_COMPONENT("elle.serialization.Serializer");
+                auto message =
+                  elle::sprintf("unknown serialization type: %s", id);
+                ELLE_WARN("%s", message);
+                throw Error(message);
+              }
+              return it->second;
+            });
+          s.serialize_object(*ptr);
         }
         else
         {
           ELLE_LOG_COMPONENT("elle.serialization.Serializer");
           ELLE_DEBUG_SCOPE("%s: deserialize virtual key%s of type %s",
                            s, _details::current_name(s), type_info<T>());
-          auto const& map = Hierarchy<typename T::Hierarchy>::_map();
-          std::string type_name;
-          s.serialize(T::virtually_serializable_key, type_name);
-          ELLE_DUMP("%s: type: %s", s, type_name);
-          auto it = map.find(type_name);
-          if (it == map.end())
-            throw Error(elle::sprintf("unknown deserialization type: \"%s\"",
-                                      type_name));
+          using Factory = typename Hierarchy<H>::TypeMap::mapped_type;
+          auto const factory = static_cast<Factory const*>(
+            s._deserialize_type(
+              T::virtually_serializable_key, type_info<H>(),
+              [&] (std::string const& type_name) -> void const*
+              {
+                ELLE_DUMP("%s: type: %s", s, type_name);
+                auto const& map = Hierarchy<H>::_map();
+                auto it = map.find(type_name);
+                if (it == map.end())
+                  throw Error(
+                    elle::sprintf("unknown deserialization type: \"%s\"",
+                                  type_name));
+                return &it->second;
+              }));
           _details::_set_ptr(
-            ptr, it->second(static_cast<SerializerIn&>(s)).release());
+            ptr, (*factory)(static_cast<SerializerIn&>(s)).release());
         }
       }
 
@@ -275,13 +310,11 @@ namespace elle
       deserialize(SerializerIn& self, int)
       {
         ELLE_LOG_COMPONENT("elle.serialization.Serializer");
-        auto version = _details::version_tag<T>(self.versions());
+        auto version = _details::version_tag<T>(self);
         if (self.versioned())
         {
-          {
-            ELLE_TRACE_SCOPE("serialize version: %s", version);
-            self.serialize(".version", version);
-          }
+          ELLE_TRACE_SCOPE("serialize version: %s", version);
+          self._serialize_version_tag(version);
         }
         return T(self, version);
       }
@@ -297,11 +330,9 @@ namespace elle
         ELLE_LOG_COMPONENT("elle.serialization.Serializer");
         if (self.versioned())
         {
-          auto version = _details::version_tag<T>(self.versions());
-          {
-            ELLE_TRACE_SCOPE("serialize version: %s", version);
-            self.serialize(".version", version);
-          }
+          auto version = _details::version_tag<T>(self);
+          ELLE_TRACE_SCOPE("serialize version: %s", version);
+          self._serialize_version_tag(version);
         }
         return T(self);
       }
@@ -866,10 +897,10 @@ namespace elle
                        _details::current_name(*this));
       if (this->_versioned)
       {
-        auto version = _details::version_tag<T>(this->versions());
+        auto version = _details::version_tag<T>(*this);
         {
           ELLE_TRACE_SCOPE("%s: serialize version: %s", *this, version);
-          this->serialize(".version", version);
+          this->_serialize_version_tag(version);
         }
         _version_switch(*this, object,
                         [version] { return version; },
@@ -878,7 +909,7 @@ namespace elle
       else
         _version_switch(
           *this, object,
-          [this] { return _details::version_tag<T>(this->versions()); },
+          [this] { return _details::version_tag<T>(*this); },
           ELLE_SFINAE_TRY());
     }
 
@@ -1530,9 +1561,73 @@ namespace elle
       return versions;
     }
 
-    template <typename Serialization, typename T, typename Serializer = void>
-    T
-    deserialize(std::istream& input,
+    namespace _details
+    {
+      /// Whether deserializers can read from \a Input.
+      template <typename Input>
+      using is_input = std::integral_constant<
+        bool,
+        std::is_base_of<std::istream, Input>::value ||
+        std::is_same<Input, elle::ConstWeakBuffer>::value>;
+
+      /// Whether serializers can write to \a Output.
+      template <typename Output>
+      using is_output = std::integral_constant<
+        bool,
+        std::is_base_of<std::ostream, Output>::value ||
+        std::is_same<Output, elle::Buffer>::value>;
+
+      /// Whether Serializer reads from an elle::ConstWeakBuffer, or writes
+      /// to an elle::Buffer, directly rather than through a stream.
+      template <typename Serializer>
+      struct in_memory
+        : public std::false_type
+      {};
+
+      /// Call \a f with \a input, read directly by SerializerIn.
+      template <typename SerializerIn, typename F,
+                std::enable_if_t<in_memory<SerializerIn>::value, int> = 0>
+      auto
+      with_input(elle::Buffer const& input, F const& f)
+      {
+        auto weak = elle::ConstWeakBuffer(input);
+        return f(weak);
+      }
+
+      /// Call \a f with a stream over \a input.
+      template <typename SerializerIn, typename F,
+                std::enable_if_t<!in_memory<SerializerIn>::value, int> = 0>
+      auto
+      with_input(elle::Buffer const& input, F const& f)
+      {
+        elle::IOStream s(input.istreambuf());
+        return f(s);
+      }
+
+      /// Call \a f with \a output, written directly by SerializerOut.
+      template <typename SerializerOut, typename F,
+                std::enable_if_t<in_memory<SerializerOut>::value, int> = 0>
+      void
+      with_output(elle::Buffer& output, F const& f)
+      {
+        f(output);
+      }
+
+      /// Call \a f with a stream over \a output.
+      template <typename SerializerOut, typename F,
+                std::enable_if_t<!in_memory<SerializerOut>::value, int> = 0>
+      void
+      with_output(elle::Buffer& output, F const& f)
+      {
+        elle::IOStream s(output.ostreambuf());
+        f(s);
+      }
+    }
+
+    template <typename Serialization, typename T, typename Serializer = void,
+              typename Input>
+    std::enable_if_t<_details::is_input<Input>::value, T>
+    deserialize(Input& input,
                 elle::Version const& version,
                 bool versioned,
                 boost::optional<Context const&> context = {})
@@ -1548,9 +1643,10 @@ namespace elle
       return s.template deserialize<T, Serializer>();
     }
 
-    template <typename Serialization, typename T, typename Serializer = void>
-    T
-    deserialize(std::istream& input, bool version = true,
+    template <typename Serialization, typename T, typename Serializer = void,
+              typename Input>
+    std::enable_if_t<_details::is_input<Input>::value, T>
+    deserialize(Input& input, bool version = true,
                 boost::optional<Context const&> context = {})
     {
       auto s = typename Serialization::SerializerIn(input, version);
@@ -1559,9 +1655,10 @@ namespace elle
       return s.template deserialize<T, Serializer>();
     }
 
-    template <typename Serialization, typename T, typename Serializer = void>
-    T
-    deserialize(std::istream& input,
+    template <typename Serialization, typename T, typename Serializer = void,
+              typename Input>
+    std::enable_if_t<_details::is_input<Input>::value, T>
+    deserialize(Input& input,
                 std::string const& name,
                 bool version = true)
     {
@@ -1571,9 +1668,10 @@ namespace elle
 
     // Prevent literal string from being converted to boolean and triggerring
     // the nameless overload.
-    template <typename Serialization, typename T, typename Serializer = void>
-    T
-    deserialize(std::istream& input,
+    template <typename Serialization, typename T, typename Serializer = void,
+              typename Input>
+    std::enable_if_t<_details::is_input<Input>::value, T>
+    deserialize(Input& input,
                 char const* name,
                 bool version = true)
     {
@@ -1588,9 +1686,13 @@ namespace elle
                 bool versioned = true,
                 boost::optional<Context const&> context = {})
     {
-      elle::IOStream s(input.istreambuf());
-      return deserialize<Serialization, T, Serializer>(
-        s, version, versioned, context);
+      return _details::with_input<typename Serialization::SerializerIn>(
+        input,
+        [&] (auto& s)
+        {
+          return deserialize<Serialization, T, Serializer>(
+            s, version, versioned, context);
+        });
     }
 
     template <typename Serialization, typename T, typename Serializer = void>
@@ -1598,8 +1700,13 @@ namespace elle
     deserialize(elle::Buffer const& input, bool version = true,
                 boost::optional<Context const&> context = {})
     {
-      elle::IOStream s(input.istreambuf());
-      return deserialize<Serialization, T, Serializer>(s, version, context);
+      return _details::with_input<typename Serialization::SerializerIn>(
+        input,
+        [&] (auto& s)
+        {
+          return deserialize<Serialization, T, Serializer>(
+            s, version, context);
+        });
     }
 
     template <typename Serialization, typename T, typename Serializer = void>
@@ -1607,8 +1714,12 @@ namespace elle
     deserialize(elle::Buffer const& input, std::string const& name,
                 bool version = true)
     {
-      elle::IOStream s(input.istreambuf());
-      return deserialize<Serialization, T, Serializer>(s, name, version);
+      return _details::with_input<typename Serialization::SerializerIn>(
+        input,
+        [&] (auto& s)
+        {
+          return deserialize<Serialization, T, Serializer>(s, name, version);
+        });
     }
 
     // Prevent literal string from being converted to boolean and triggerring
@@ -1625,11 +1736,12 @@ namespace elle
     template <typename Serialization,
               typename Serializer = void,
               typename T,
+              typename Output,
               typename ... Args>
-    void
+    std::enable_if_t<_details::is_output<Output>::value, void>
     serialize(T const& o,
               std::string const& name,
-              std::ostream& output,
+              Output& output,
               Args&&... args)
     {
       typename Serialization::SerializerOut s(
@@ -1656,14 +1768,24 @@ namespace elle
           typename std::remove_reference<First>::type>::type>::value;
     };
 
+    template <typename ... Args>
+    struct FirstArgIsNotOutput
+    {
+      static bool constexpr value =
+        FirstArgIsNot<std::ostream, Args...>::value &&
+        FirstArgIsNot<elle::Buffer, Args...>::value;
+    };
+
     // Stream, anonymous
     template <typename Serialization,
               typename Serializer = void,
               typename T,
+              typename Output,
               typename ... Args>
-    std::enable_if_t<FirstArgIsNot<elle::Version, Args...>::value, void>
+    std::enable_if_t<_details::is_output<Output>::value &&
+                     FirstArgIsNot<elle::Version, Args...>::value, void>
     serialize(T const& o,
-              std::ostream& output,
+              Output& output,
               Args&&... args)
     {
       typename Serialization::SerializerOut s(
@@ -1675,10 +1797,11 @@ namespace elle
     template <typename Serialization,
               typename Serializer = void,
               typename T,
+              typename Output,
               typename ... Args>
-    void
+    std::enable_if_t<_details::is_output<Output>::value, void>
     serialize(std::unique_ptr<T> const& o,
-              std::ostream& output,
+              Output& output,
               elle::Version const& version,
               Args&& ... args)
     {
@@ -1693,10 +1816,11 @@ namespace elle
     template <typename Serialization,
               typename Serializer = void,
               typename T,
+              typename Output,
               typename ... Args>
-    void
+    std::enable_if_t<_details::is_output<Output>::value, void>
     serialize(T const& o,
-              std::ostream& output,
+              Output& output,
               elle::Version const& version,
               Args&& ... args)
     {
@@ -1718,17 +1842,19 @@ namespace elle
               typename Serializer = void,
               typename T,
               typename ... Args>
-    std::enable_if_t<FirstArgIsNot<std::ostream, Args...>::value, elle::Buffer>
+    std::enable_if_t<FirstArgIsNotOutput<Args...>::value, elle::Buffer>
     serialize(T const& o,
               std::string const& name,
               Args&& ... args)
     {
       elle::Buffer res;
-      {
-        elle::IOStream s(res.ostreambuf());
-        serialize<Serialization, Serializer, T>(
-          o, name, s, std::forward<Args>(args)...);
-      }
+      _details::with_output<typename Serialization::SerializerOut>(
+        res,
+        [&] (auto& output)
+        {
+          serialize<Serialization, Serializer, T>(
+            o, name, output, std::forward<Args>(args)...);
+        });
       return res;
     }
 
@@ -1738,7 +1864,7 @@ namespace elle
               typename Serializer = void,
               typename T,
               typename ... Args>
-    std::enable_if_t<FirstArgIsNot<std::ostream, Args...>::value, elle::Buffer>
+    std::enable_if_t<FirstArgIsNotOutput<Args...>::value, elle::Buffer>
     serialize(T const& o, char const* name, Args&& ... args)
     {
       return serialize<Serialization, Serializer, T>(
@@ -1750,15 +1876,17 @@ namespace elle
               typename Serializer = void,
               typename T,
               typename ... Args>
-    std::enable_if_t<FirstArgIsNot<std::ostream, Args...>::value, elle::Buffer>
+    std::enable_if_t<FirstArgIsNotOutput<Args...>::value, elle::Buffer>
     serialize(T const& o, Args&& ... args)
     {
       elle::Buffer res;
-      {
-        elle::IOStream s(res.ostreambuf());
-        serialize<Serialization, Serializer, T>(
-          o, s, std::forward<Args>(args)...);
-      }
+      _details::with_output<typename Serialization::SerializerOut>(
+        res,
+        [&] (auto& output)
+        {
+          serialize<Serialization, Serializer, T>(
+            o, output, std::forward<Args>(args)...);
+        });
       return res;
     }
 
@@ -1,5 +1,8 @@
 #include <elle/serialization/binary/SerializerIn.hh>
 
+#include <cstring>
+
+#include <elle/assert.hh>
 #include <elle/meta.hh> // static_if
 
 #include <elle/serialization/json/Error.hh>
@@ -15,30 +18,129 @@ namespace elle
       SerializerIn::SerializerIn(std::istream& input,
                                  bool versioned)
         : Super(versioned)
-        , _input(input)
+        , _dictionary(false)
+        , _input(&input)
+        , _position(nullptr)
+        , _end(nullptr)
+        , _types()
+        , _version_tags_read()
       {
-        this->_check_magic(input);
+        this->_check_magic();
       }
 
       SerializerIn::SerializerIn(std::istream& input,
                                  Versions versions,
                                  bool versioned)
         : Super(std::move(versions), versioned)
-        , _input(input)
+        , _dictionary(false)
+        , _input(&input)
+        , _position(nullptr)
+        , _end(nullptr)
+        , _types()
+        , _version_tags_read()
+      {
+        this->_check_magic();
+      }
+
+      SerializerIn::SerializerIn(elle::ConstWeakBuffer input,
+                                 bool versioned)
+        : Super(versioned)
+        , _dictionary(false)
+        , _input(nullptr)
+        , _position(input.contents())
+        , _end(input.contents() + input.size())
+        , _types()
+        , _version_tags_read()
       {
-        this->_check_magic(input);
+        this->_check_magic();
+      }
+
+      SerializerIn::SerializerIn(elle::ConstWeakBuffer input,
+                                 Versions versions,
+                                 bool versioned)
+        : Super(std::move(versions), versioned)
+        , _dictionary(false)
+        , _input(nullptr)
+        , _position(input.contents())
+        , _end(input.contents() + input.size())
+        , _types()
+        , _version_tags_read()
+      {
+        this->_check_magic();
       }
 
       void
-      SerializerIn::_check_magic(std::istream& input)
+      SerializerIn::_check_magic()
       {
         char magic;
-        input.read(&magic, 1);
-        if (input.gcount() != 1)
+        if (this->_input)
+        {
+          this->_input->read(&magic, 1);
+          if (this->_input->gcount() != 1)
+            err<Error>("unable to read magic");
+        }
+        else if (this->_position == this->_end)
           err<Error>("unable to read magic");
-        if (magic != 0)
-          err<Error>("wrong magic for binary serialization: 0x%2x (expected 0)",
-                     int(static_cast<unsigned char>(magic)));
+        else
+          magic = *this->_position++;
+        if (magic != 0 && magic != 1)
+          err<Error>(
+            "wrong magic for binary serialization: 0x%2x (expected 0 or 1)",
+            int(static_cast<unsigned char>(magic)));
+        this->_dictionary = magic == 1;
+      }
+
+      std::istream&
+      SerializerIn::input() const
+      {
+        ELLE_ASSERT(this->_input);
+        return *this->_input;
+      }
+
+      bool
+      SerializerIn::in_memory() const
+      {
+        return !this->_input;
+      }
+
+      elle::ConstWeakBuffer
+      SerializerIn::remaining() const
+      {
+        ELLE_ASSERT(this->in_memory());
+        return elle::ConstWeakBuffer(this->_position,
+                                     this->_end - this->_position);
+      }
+
+      void
+      SerializerIn::skip(std::size_t size)
+      {
+        ELLE_ASSERT(this->in_memory());
+        ELLE_ASSERT_LTE(size, std::size_t(this->_end - this->_position));
+        this->_position += size;
+      }
+
+      void
+      SerializerIn::_read(void* data, std::size_t size)
+      {
+        if (this->_input)
+        {
+          this->_input->read(static_cast<char*>(data), size);
+          if (static_cast<std::size_t>(this->_input->gcount()) != size)
+            err<Error>("%s: short read when deserializing \"%s\":"
+                       " expected %s, got %s",
+                       *this, this->current_name(), size,
+                       this->_input->gcount());
+        }
+        else
+        {
+          if (static_cast<std::size_t>(this->_end - this->_position) < size)
+            err<Error>("%s: short read when deserializing \"%s\":"
+                       " expected %s, got %s",
+                       *this, this->current_name(), size,
+                       this->_end - this->_position);
+          std::memcpy(data, this->_position, size);
+          this->_position += size;
+        }
       }
 
       bool
@@ -135,7 +237,7 @@ namespace elle
       void
       SerializerIn::_serialize(double& v)
       {
-        input().read((char*)(void*)&v, sizeof(double));
+        this->_read(&v, sizeof(double));
       }
 
       void
@@ -169,9 +271,18 @@ namespace elle
       void
       SerializerIn::_serialize(std::string& v)
       {
-        elle::Buffer b;
-        this->_serialize(b);
-        v = b.string();
+        if (this->_input)
+        {
+          elle::Buffer b;
+          this->_serialize(b);
+          v = b.string();
+        }
+        else
+        {
+          auto const view = this->deserialize_view();
+          v.assign(reinterpret_cast<char const*>(view.contents()),
+                   view.size());
+        }
       }
 
       void
@@ -179,12 +290,28 @@ namespace elle
       {
         int sz = _serialize_number();
         ELLE_DEBUG("%s: deserialize size: %s", *this, sz);
+        if (sz < 0)
+          err<Error>("%s: negative size when deserializing \"%s\": %s",
+                     *this, this->current_name(), sz);
         buffer.size(sz);
-        input().read((char*)buffer.mutable_contents(), sz);
-        if (input().gcount() != sz)
+        this->_read(buffer.mutable_contents(), sz);
+      }
+
+      elle::ConstWeakBuffer
+      SerializerIn::deserialize_view()
+      {
+        if (this->_input)
+          err<Error>("%s: views require an input in memory", *this);
+        auto const sz = this->_serialize_number();
+        ELLE_DEBUG("%s: deserialize view of size: %s", *this, sz);
+        if (sz < 0 || this->_end - this->_position < sz)
           err<Error>("%s: short read when deserializing \"%s\":"
                      " expected %s, got %s",
-                     *this, this->current_name(), sz, input().gcount());
+                     *this, this->current_name(), sz,
+                     this->_end - this->_position);
+        auto const res = elle::ConstWeakBuffer(this->_position, sz);
+        this->_position += sz;
+        return res;
       }
 
       void
@@ -284,21 +411,132 @@ namespace elle
         }
       }
 
-      static
-      char
-      get(std::istream& s)
+      /*-----------.
+      | Dictionary |
+      `-----------*/
+
+      void const*
+      SerializerIn::_deserialize_type(
+        std::string const& key,
+        TypeInfo const& hierarchy,
+        std::function<void const* (std::string const&)> const& resolve)
       {
-        int res = s.get();
-        if (res == EOF)
-          err<Error>("end of stream while reading number");
-        return res;
+        if (!this->_dictionary)
+          return Super::_deserialize_type(key, hierarchy, resolve);
+        auto const index = this->_serialize_number();
+        if (index == signed(this->_types.size()))
+        {
+          std::string type_name;
+          this->_serialize(type_name);
+          ELLE_DEBUG("deserialize new type %s: %s", index, type_name);
+          auto const factory = resolve(type_name);
+          this->_types.emplace_back(Type{hierarchy, factory});
+          return factory;
+        }
+        if (index < 0 || index >= signed(this->_types.size()))
+          err<Error>("invalid type index: %s", index);
+        auto const& type = this->_types[index];
+        if (!(type.hierarchy == hierarchy))
+          err<Error>("type index %s is not a %s", index, hierarchy);
+        return type.factory;
+      }
+
+      void
+      SerializerIn::_serialize_version_tag(elle::Version& version)
+      {
+        if (!this->_dictionary)
+          return Super::_serialize_version_tag(version);
+        auto& read = this->_version_tags_read;
+        auto const index = this->_serialize_number();
+        if (index == signed(read.size()))
+        {
+          Super::_serialize_version_tag(version);
+          ELLE_DEBUG("deserialize new version tag %s: %s", index, version);
+          read.emplace_back(version);
+        }
+        else if (index < 0 || index >= signed(read.size()))
+          err<Error>("invalid version tag index: %s", index);
+        else
+          version = read[index];
+      }
+
+      namespace
+      {
+        /// Decode a number, fetching bytes one by one with \a get and
+        /// 8 bytes payloads with \a read.
+        template <typename Get, typename Read>
+        size_t
+        read_number(Get const& get, Read const& read, int64_t& res)
+        {
+          ELLE_DEBUG_SCOPE("deserialize number");
+          unsigned char c = get();
+          int64_t value;
+          bool negative = c & 0x80;
+          size_t size = 0;
+          if (!(c & 0x40))
+          {
+            ELLE_DUMP("1-byte coding");
+            value = c&0x3f;
+            size = 1;
+          }
+          else if (! (c&0x20))
+          {
+            ELLE_DUMP("2-bytes coding");
+            unsigned char c2 = get();
+            value = ((c&0x1F) << 8) + c2;
+            size = 2;
+          }
+          else if (! (c&0x10))
+          {
+            ELLE_DUMP("4-bytes coding");
+            unsigned char c2 = get();
+            unsigned char c3 = get();
+            value = ((c&0x0F) << 16) + (c2 << 8) + c3;
+            size = 3;
+          }
+          else
+          {
+            ELLE_DUMP("8-bytes coding");
+            read(&value, 8);
+            size = 9;
+          }
+          res = negative ? - (int64_t)value : value;
+          ELLE_DEBUG("value: %s", res);
+          return size;
+        }
+
+        /// Decode a number from memory, advancing \a position.
+        size_t
+        read_number(elle::Buffer::Byte const*& position,
+                    elle::Buffer::Byte const* end,
+                    int64_t& res)
+        {
+          return read_number(
+            [&]
+            {
+              if (position == end)
+                err<Error>("end of input while reading number");
+              return *position++;
+            },
+            [&] (void* data, std::size_t size)
+            {
+              if (static_cast<std::size_t>(end - position) < size)
+                err<Error>("end of input while reading number");
+              std::memcpy(data, position, size);
+              position += size;
+            },
+            res);
+        }
       }
 
       int64_t
       SerializerIn::_serialize_number()
       {
         int64_t res;
-        SerializerIn::serialize_number(this->input(), res);
+        if (this->_input)
+          SerializerIn::serialize_number(*this->_input, res);
+        else
+          read_number(this->_position, this->_end, res);
         return res;
       }
 
@@ -306,47 +544,27 @@ namespace elle
       SerializerIn::serialize_number(std::istream& input,
                                      int64_t& res)
       {
-        ELLE_DEBUG_SCOPE("deserialize number");
-        unsigned char c = get(input);
-        int64_t value;
-        bool negative = c & 0x80;
-        size_t size = 0;
-        if (!(c & 0x40))
-        {
-          ELLE_DUMP("1-byte coding");
-          value = c&0x3f;
-          size = 1;
-        }
-        else if (! (c&0x20))
-        {
-          ELLE_DUMP("2-bytes coding");
-          unsigned char c2 = get(input);
-          value = ((c&0x1F) << 8) + c2;
-          size = 2;
-        }
-        else if (! (c&0x10))
-        {
-          ELLE_DUMP("4-bytes coding");
-          unsigned char c2 = get(input);
-          unsigned char c3 = get(input);
-          value = ((c&0x0F) << 16) + (c2 << 8) + c3;
-          size = 3;
-        }
-        else
-        {
-          ELLE_DUMP("8-bytes coding");
-          input.read((char*)(void*)&value, 8);
-          size = 9;
-          /*
-          unsigned char elems[8];
-          input.read((char*)elems, 8);
-          value = 0;
-          for (int i=0; i<8; ++i)
-            value += uint64_t(elems[i]) << (8*i);*/
-        }
-        res = negative ? - (int64_t)value : value;
-        ELLE_DEBUG("value: %s", res);
-        return size;
+        return read_number(
+          [&]
+          {
+            int res = input.get();
+            if (res == EOF)
+              err<Error>("end of stream while reading number");
+            return static_cast<unsigned char>(res);
+          },
+          [&] (void* data, std::size_t size)
+          {
+            input.read(static_cast<char*>(data), size);
+          },
+          res);
+      }
+
+      size_t
+      SerializerIn::serialize_number(elle::ConstWeakBuffer input,
+                                     int64_t& res)
+      {
+        auto position = input.contents();
+        return read_number(position, input.contents() + input.size(), res);
       }
     }
   }
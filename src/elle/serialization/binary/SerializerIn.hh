@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include <elle/Buffer.hh>
 #include <elle/attribute.hh>
 #include <elle/serialization/SerializerIn.hh>
 
@@ -15,7 +16,11 @@ namespace elle
       ///
       /// Deserialize objects from their binary representations.
       ///
+      /// Reads either from a stream or, without going through a streambuf,
+      /// directly from memory. The latter is much cheaper for small fields.
       ///
+      /// Streams written in dictionary mode are detected from their magic
+      /// byte.
       class ELLE_API SerializerIn
         : public serialization::SerializerIn
       {
@@ -33,9 +38,20 @@ namespace elle
         SerializerIn(std::istream& input, bool versioned = true);
         SerializerIn(std::istream& input,
                      Versions versions, bool versioned = true);
+        /// Deserialize from memory.
+        ///
+        /// @param input The data, which must outlive the serializer.
+        SerializerIn(elle::ConstWeakBuffer input, bool versioned = true);
+        /// Deserialize from memory.
+        ///
+        /// @param input The data, which must outlive the serializer.
+        SerializerIn(elle::ConstWeakBuffer input,
+                     Versions versions, bool versioned = true);
+        /// Whether the input was written in dictionary mode.
+        ELLE_ATTRIBUTE_R(bool, dictionary);
       private:
         void
-        _check_magic(std::istream& input);
+        _check_magic();
 
       /*--------------.
       | Serialization |
@@ -88,23 +104,88 @@ namespace elle
         void
         _deserialize_dict_key(
           std::function<void (std::string const&)> const& f) override;
+        void const*
+        _deserialize_type(
+          std::string const& key,
+          TypeInfo const& hierarchy,
+          std::function<void const* (std::string const&)> const& resolve)
+          override;
+        void
+        _serialize_version_tag(elle::Version& version) override;
 
         bool
         _enter(std::string const& name) override;
         void
         _leave(std::string const& name) override;
       public:
+        /// Deserialize a string or a buffer without copying it.
+        ///
+        /// Only available when reading from memory.
+        ///
+        /// @return A view into the input, valid as long as the input is.
+        elle::ConstWeakBuffer
+        deserialize_view();
         static
         size_t
         serialize_number(std::istream& output,
                          int64_t& value);
-        ELLE_ATTRIBUTE_R(std::istream&, input);
+        /// Decode a number from the beginning of \a input.
+        ///
+        /// @return The number of bytes used.
+        static
+        size_t
+        serialize_number(elle::ConstWeakBuffer input,
+                         int64_t& value);
+        /// The input stream.
+        ///
+        /// @pre The serializer does not read from memory.
+        std::istream&
+        input() const;
+        /// Whether the serializer reads from memory.
+        bool
+        in_memory() const;
+        /// The input not read yet.
+        ///
+        /// @pre The serializer reads from memory.
+        elle::ConstWeakBuffer
+        remaining() const;
+        /// Skip \a size bytes of the input, decoded by other means.
+        ///
+        /// @pre The serializer reads from memory.
+        void
+        skip(std::size_t size);
       private:
+        /// Read exactly \a size bytes.
+        void
+        _read(void* data, std::size_t size);
         int64_t _serialize_number();
+        ELLE_ATTRIBUTE(std::istream*, input);
+        /// Next byte to read, in memory mode.
+        ELLE_ATTRIBUTE(elle::Buffer::Byte const*, position);
+        /// End of the input, in memory mode.
+        ELLE_ATTRIBUTE(elle::Buffer::Byte const*, end);
+        /// A type read in dictionary mode.
+        struct Type
+        {
+          TypeInfo hierarchy;
+          void const* factory;
+        };
+        /// Types read so far, by index.
+        ELLE_ATTRIBUTE(std::vector<Type>, types);
+        /// Version tags read so far, by index.
+        ELLE_ATTRIBUTE(std::vector<elle::Version>, version_tags_read);
         template <typename T>
         void
         _serialize_int(T& v);
-    };
+      };
+    }
+
+    namespace _details
+    {
+      template <>
+      struct in_memory<binary::SerializerIn>
+        : public std::true_type
+      {};
+    }
   }
 }
-}
@@ -1,5 +1,8 @@
 #include <elle/serialization/binary/SerializerOut.hh>
 
+#include <algorithm>
+#include <cstring>
+
 #include <elle/assert.hh>
 #include <elle/finally.hh>
 #include <elle/format/base64.hh>
@@ -18,27 +21,92 @@ namespace elle
       | Construction |
       `-------------*/
 
-      SerializerOut::SerializerOut(std::ostream& output, bool versioned)
+      SerializerOut::SerializerOut(std::ostream& output,
+                                   bool versioned,
+                                   bool dictionary)
         : Super(versioned)
-        , _output(output)
+        , _dictionary(dictionary)
+        , _output(&output)
+        , _buffer(nullptr)
+        , _types()
+        , _types_count(0)
+        , _version_tags_written()
       {
-        this->_write_magic(output);
+        this->_write_magic();
       }
 
       SerializerOut::SerializerOut(std::ostream& output,
                                    Versions versions,
-                                   bool versioned)
+                                   bool versioned,
+                                   bool dictionary)
         : Super(std::move(versions), versioned)
-        , _output(output)
+        , _dictionary(dictionary)
+        , _output(&output)
+        , _buffer(nullptr)
+        , _types()
+        , _types_count(0)
+        , _version_tags_written()
+      {
+        this->_write_magic();
+      }
+
+      SerializerOut::SerializerOut(elle::Buffer& output,
+                                   bool versioned,
+                                   bool dictionary)
+        : Super(versioned)
+        , _dictionary(dictionary)
+        , _output(nullptr)
+        , _buffer(&output)
+        , _types()
+        , _types_count(0)
+        , _version_tags_written()
+      {
+        this->_write_magic();
+      }
+
+      SerializerOut::SerializerOut(elle::Buffer& output,
+                                   Versions versions,
+                                   bool versioned,
+                                   bool dictionary)
+        : Super(std::move(versions), versioned)
+        , _dictionary(dictionary)
+        , _output(nullptr)
+        , _buffer(&output)
+        , _types()
+        , _types_count(0)
+        , _version_tags_written()
+      {
+        this->_write_magic();
+      }
+
+      void
+      SerializerOut::_write_magic()
       {
-        this->_write_magic(output);
+        char const magic = this->_dictionary ? 1 : 0;
+        this->_write(&magic, 1);
+      }
+
+      std::ostream&
+      SerializerOut::output() const
+      {
+        ELLE_ASSERT(this->_output);
+        return *this->_output;
+      }
+
+      elle::Buffer&
+      SerializerOut::buffer() const
+      {
+        ELLE_ASSERT(this->_buffer);
+        return *this->_buffer;
       }
 
       void
-      SerializerOut::_write_magic(std::ostream& output)
+      SerializerOut::_write(void const* data, std::size_t size)
       {
-        static char const magic = 0;
-        output.write(&magic, 1);
+        if (this->_buffer)
+          this->_buffer->append(data, size);
+        else
+          this->_output->write(static_cast<char const*>(data), size);
       }
 
       SerializerOut::~SerializerOut()
@@ -60,61 +128,76 @@ namespace elle
         return false;
       }
 
+      namespace
+      {
+        /// Encode a number in \a ser.
+        ///
+        /// @return The number of bytes used.
+        size_t
+        encode_number(int64_t n_, unsigned char (&ser)[9])
+        {
+          int64_t n = n_;
+          bool neg = n < 0;
+          if (neg)
+            n = -n;
+          if (n <= 0x3f)
+          { // sgn 0 val
+            ser[0] = (neg ? 0x80 : 0) + n;
+            ELLE_DUMP("serialize %s as 0x%02x", n_, int(ser[0]));
+            return 1;
+          }
+          else if (n <= 0x1fff)
+          { // sgn 1 0 val val2
+            ser[0] = (neg ? 0xC0 : 0x40) + (n >> 8);
+            ser[1] = n;
+            ELLE_DUMP("serialize %s as 0x%02x%02x",
+                      n_, int(ser[0]), int(ser[1]));
+            return 2;
+          } // sgn 1 1 0 val val2 val3
+          else if (n <= 0x0fffff)
+          {
+            ser[0] = (neg ? 0xe0 : 0x60) + (n >> 16);
+            ser[1] = n >> 8;
+            ser[2] = n;
+            ELLE_DUMP("serialize %s as 0x%02x%02x%02x",
+                      n_, int(ser[0]), int(ser[1]), int(ser[2]));
+            return 3;
+          }
+          else
+          {
+            ser[0] = neg? 0xFF : 0x7F;
+            std::memcpy(ser + 1, &n, 8);
+            ELLE_DUMP("serialize %s as 0x%02x%08x", n_, int(ser[0]), n);
+            return 9;
+          }
+        }
+      }
+
       void
-      SerializerOut::_serialize_number(int64_t n_)
+      SerializerOut::_serialize_number(int64_t n)
       {
-        SerializerOut::serialize_number(this->output(), n_);
+        unsigned char ser[9];
+        this->_write(ser, encode_number(n, ser));
       }
 
       size_t
       SerializerOut::serialize_number(std::ostream& output,
-                                      int64_t n_)
-      {
-        int64_t n = n_;
-        bool neg = n < 0;
-        if (neg)
-          n = -n;
-        if (n <= 0x3f)
-        { // sgn 0 val
-          unsigned char ser = (neg ? 0x80 : 0) + n;
-          ELLE_DUMP("serialize %s as 0x%02x", n_, int(ser));
-          output.write((const char*)&ser, 1);
-          return 1;
-        }
-        else if (n <= 0x1fff)
-        { // sgn 1 0 val val2
-          unsigned char ser[2];
-          ser[0] = (neg ? 0xC0 : 0x40) + (n >> 8);
-          ser[1] = n;
-          ELLE_DUMP("serialize %s as 0x%02x%02x", n_, int(ser[0]), int(ser[1]));
-          output.write((const char*)ser, 2);
-          return 2;
-        } // sgn 1 1 0 val val2 val3
-        else if (n <= 0x0fffff)
-        {
-          unsigned char ser[3];
-          ser[0] = (neg ? 0xe0 : 0x60) + (n >> 16);
-          ser[1] = n >> 8;
-          ser[2] = n;
-          ELLE_DUMP("serialize %s as 0x%02x%02x%02x",
-                    n_, int(ser[0]), int(ser[1]), int(ser[2]));
-          output.write((const char*)ser, 3);
-          return 3;
-        }
-        else
-        {
-          unsigned char c = neg? 0xFF : 0x7F;
-          output.write((const char*)&c, 1);
-          output.write((const char*)(const void*)&n, 8);
-          ELLE_DUMP("serialize %s as 0x%02x%08x", n_, int(c), n);
-          return 9;
-          /*
-          unsigned char ser[9];
-          ser[0] = neg? 0xFF : 0x7F;
-          for (int i=1; i<9; ++i)
-            ser[i] = n >> ((i-1)*8);
-          output.write((const char*)ser, 9);*/
-        }
+                                      int64_t n)
+      {
+        unsigned char ser[9];
+        auto const size = encode_number(n, ser);
+        output.write(reinterpret_cast<char const*>(ser), size);
+        return size;
+      }
+
+      size_t
+      SerializerOut::serialize_number(elle::Buffer& output,
+                                      int64_t n)
+      {
+        unsigned char ser[9];
+        auto const size = encode_number(n, ser);
+        output.append(ser, size);
+        return size;
       }
 
       void
@@ -199,7 +282,7 @@ namespace elle
       void
       SerializerOut::_serialize(double& v)
       {
-        output().write((const char*)&v, sizeof(double));
+        this->_write(&v, sizeof(double));
       }
 
       void
@@ -211,8 +294,9 @@ namespace elle
       void
       SerializerOut::_serialize(std::string& v)
       {
-        elle::Buffer buffer(v.c_str(), v.size());
-        this->_serialize(buffer);
+        ELLE_DEBUG("serialize size: %s", v.size())
+          this->_serialize_number(v.size());
+        this->_write(v.data(), v.size());
       }
 
       void
@@ -221,7 +305,7 @@ namespace elle
         ELLE_DEBUG("serialize size: %s", buffer.size())
           this->_serialize_number(buffer.size());
         ELLE_DEBUG("serialize content: %f", buffer)
-          output().write((const char*)buffer.contents(), buffer.size());
+          this->_write(buffer.contents(), buffer.size());
       }
 
       void
@@ -263,6 +347,58 @@ namespace elle
         if (filled)
           f();
       }
+
+      /*-----------.
+      | Dictionary |
+      `-----------*/
+
+      void
+      SerializerOut::_serialize_type(
+        std::string const& key,
+        TypeInfo const& hierarchy,
+        TypeInfo const& type,
+        std::function<std::string const& ()> const& name)
+      {
+        if (!this->_dictionary)
+          return Super::_serialize_type(key, hierarchy, type, name);
+        auto it = this->_types.find(type);
+        if (it != this->_types.end() && it->second.hierarchy == hierarchy)
+        {
+          ELLE_DUMP("serialize known type %s as %s", type, it->second.index);
+          this->_serialize_number(it->second.index);
+          return;
+        }
+        // Fetch the name first: it throws on unregistered types.
+        auto const& type_name = name();
+        auto const index = this->_types_count++;
+        ELLE_DEBUG("serialize new type %s as %s: %s", type, index, type_name);
+        this->_serialize_number(index);
+        this->_serialize(const_cast<std::string&>(type_name));
+        auto const inserted =
+          this->_types.emplace(type, Type{hierarchy, index});
+        if (!inserted.second)
+          inserted.first->second = Type{hierarchy, index};
+      }
+
+      void
+      SerializerOut::_serialize_version_tag(elle::Version& version)
+      {
+        if (!this->_dictionary)
+          return Super::_serialize_version_tag(version);
+        // Objects of a stream use a handful of versions at most.
+        auto& written = this->_version_tags_written;
+        auto it = std::find(written.begin(), written.end(), version);
+        if (it != written.end())
+        {
+          this->_serialize_number(it - written.begin());
+          return;
+        }
+        ELLE_DEBUG("serialize new version tag %s as %s",
+                   version, written.size());
+        this->_serialize_number(written.size());
+        Super::_serialize_version_tag(version);
+        written.emplace_back(version);
+      }
     }
   }
 }
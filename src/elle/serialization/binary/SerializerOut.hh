@@ -1,7 +1,9 @@
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 
+#include <elle/Buffer.hh>
 #include <elle/attribute.hh>
 #include <elle/serialization/SerializerOut.hh>
 
@@ -19,6 +21,11 @@ namespace elle
       /// - In binary, order matters. Do not reorder members afterward,
       ///   otherwise the existing serialized version won't be deserializable
       ///   anymore.
+      /// - Writing directly to an elle::Buffer skips the streambuf and is much
+      ///   cheaper for small fields.
+      /// - In dictionary mode, the name of each polymorphic type and each
+      ///   version tag is written once per stream, then referred to by its
+      ///   index. SerializerIn detects the mode from the magic byte.
       class ELLE_API SerializerOut
         : public serialization::SerializerOut
       {
@@ -36,17 +43,45 @@ namespace elle
         /// Construct a SerializerOut for binary.
         ///
         /// @see elle::serialization::SerializerOut.
-        SerializerOut(std::ostream& output, bool versioned = true);
+        ///
+        /// @param dictionary Whether to use dictionary mode.
+        SerializerOut(std::ostream& output,
+                      bool versioned = true,
+                      bool dictionary = false);
         /// Construct a SerializerOut for binary.
         ///
         /// @see elle::serialization::SerializerOut.
+        ///
+        /// @param dictionary Whether to use dictionary mode.
         SerializerOut(std::ostream& output,
-                      Versions versions, bool versioned = true);
+                      Versions versions,
+                      bool versioned = true,
+                      bool dictionary = false);
+        /// Construct a SerializerOut appending to a buffer.
+        ///
+        /// @see elle::serialization::SerializerOut.
+        ///
+        /// @param dictionary Whether to use dictionary mode.
+        SerializerOut(elle::Buffer& output,
+                      bool versioned = true,
+                      bool dictionary = false);
+        /// Construct a SerializerOut appending to a buffer.
+        ///
+        /// @see elle::serialization::SerializerOut.
+        ///
+        /// @param dictionary Whether to use dictionary mode.
+        SerializerOut(elle::Buffer& output,
+                      Versions versions,
+                      bool versioned = true,
+                      bool dictionary = false);
         virtual
         ~SerializerOut();
+        /// Whether type names and version tags are written once, then
+        /// referred to by index.
+        ELLE_ATTRIBUTE_R(bool, dictionary);
       private:
         void
-        _write_magic(std::ostream& output);
+        _write_magic();
 
       /*--------------.
       | Serialization |
@@ -101,16 +136,64 @@ namespace elle
         void
         _serialize_option(bool filled,
                           std::function<void ()> const& f) override;
+        void
+        _serialize_type(
+          std::string const& key,
+          TypeInfo const& hierarchy,
+          TypeInfo const& type,
+          std::function<std::string const& ()> const& name) override;
+        void
+        _serialize_version_tag(elle::Version& version) override;
       public:
         static
         size_t
         serialize_number(std::ostream& output,
                          int64_t number);
-        ELLE_ATTRIBUTE_R(std::ostream&, output);
+        /// Append the encoding of \a number to \a output.
+        ///
+        /// @return The number of bytes written.
+        static
+        size_t
+        serialize_number(elle::Buffer& output,
+                         int64_t number);
+        /// The output stream.
+        ///
+        /// @pre The serializer does not write to a buffer.
+        std::ostream&
+        output() const;
+        /// The output buffer.
+        ///
+        /// @pre The serializer writes to a buffer.
+        elle::Buffer&
+        buffer() const;
       private:
+        void
+        _write(void const* data, std::size_t size);
         void
         _serialize_number(int64_t number);
+        ELLE_ATTRIBUTE(std::ostream*, output);
+        ELLE_ATTRIBUTE(elle::Buffer*, buffer);
+        /// A type written in dictionary mode.
+        struct Type
+        {
+          TypeInfo hierarchy;
+          int index;
+        };
+        /// Types written so far, by dynamic type.
+        ELLE_ATTRIBUTE((std::unordered_map<TypeInfo, Type>), types);
+        /// Number of types written so far.
+        ELLE_ATTRIBUTE(int, types_count);
+        /// Version tags written so far, by index.
+        ELLE_ATTRIBUTE(std::vector<elle::Version>, version_tags_written);
       };
     }
+
+    namespace _details
+    {
+      template <>
+      struct in_memory<binary::SerializerOut>
+        : public std::true_type
+      {};
+    }
   }
 }
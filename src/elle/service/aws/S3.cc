@@ -1,8 +1,14 @@
+#include <algorithm>
+#include <istream>
+
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
 
+#include <elle/With.hh>
+#include <elle/assert.hh>
 #include <elle/cryptography/hash.hh>
+#include <elle/err.hh>
 #include <elle/finally.hh>
 #include <elle/format/base64.hh>
 #include <elle/format/hexadecimal.hh>
@@ -12,12 +18,16 @@
 #include <elle/service/aws/Keys.hh>
 #include <elle/service/aws/S3.hh>
 #include <elle/service/aws/SigningKey.hh>
+#include <elle/utility/Move.hh>
 
+#include <elle/reactor/Scope.hh>
+#include <elle/reactor/exception.hh>
 #include <elle/reactor/network/Error.hh>
 #include <elle/reactor/http/exceptions.hh>
 #include <elle/reactor/http/EscapedString.hh>
 #include <elle/reactor/http/Request.hh>
 #include <elle/reactor/scheduler.hh>
+#include <elle/reactor/semaphore.hh>
 
 ELLE_LOG_COMPONENT("elle.services.aws.S3");
 
@@ -76,6 +86,40 @@ namespace elle
         return boost::posix_time::milliseconds(factor * 100);
       }
 
+      /// Whether fetching a part again may help: S3 errors that are not
+      /// transient, a missing object for instance, will not go away.
+      static
+      bool
+      retriable(std::exception_ptr e)
+      {
+        try
+        {
+          std::rethrow_exception(e);
+        }
+        catch (AWSException const& error)
+        {
+          return !error.inner_exception() ||
+            retriable(error.inner_exception());
+        }
+        catch (TransientError const&)
+        {
+          return true;
+        }
+        catch (CorruptedData const&)
+        {
+          return true;
+        }
+        catch (RequestError const&)
+        {
+          return false;
+        }
+        catch (...)
+        {
+          // Network and HTTP errors.
+          return true;
+        }
+      }
+
       /*-------------.
       | Construction |
       `-------------*/
@@ -161,6 +205,99 @@ namespace elle
           return etag->second;
       }
 
+      void
+      S3::put_object(std::istream& object,
+                     std::string const& object_name,
+                     FileSize part_size,
+                     int parallelism,
+                     StorageClass storage_class)
+      {
+        ELLE_ASSERT_GT(part_size, 0u);
+        this->put_object(
+          [&]
+          {
+            auto part = elle::Buffer(part_size);
+            object.read(reinterpret_cast<char*>(part.mutable_contents()),
+                        part_size);
+            if (object.bad())
+              elle::err("%s: unable to read %s", *this, object_name);
+            part.size(object.gcount());
+            return part;
+          },
+          object_name, parallelism, storage_class);
+      }
+
+      void
+      S3::put_object(Parts const& parts,
+                     std::string const& object_name,
+                     int parallelism,
+                     StorageClass storage_class)
+      {
+        ELLE_TRACE_SCOPE("%s: PUT multipart object: %s", *this, object_name);
+        ELLE_ASSERT_GT(parallelism, 0);
+        auto const key = this->multipart_initialize(
+          object_name, "binary/octet-stream", storage_class);
+        // Outlive the scope, whose threads use them until terminated.
+        elle::reactor::Semaphore window(parallelism);
+        auto chunks = std::vector<MultiPartChunk>{};
+        try
+        {
+          elle::With<elle::reactor::Scope>() <<
+            [&] (elle::reactor::Scope& scope)
+            {
+              for (int part = 0; ; ++part)
+              {
+                while (!window.acquire())
+                  elle::reactor::wait(window);
+                auto data = parts();
+                // Even an empty object has a part.
+                if (data.empty() && part > 0)
+                  break;
+                ELLE_DEBUG("%s: upload part %s of %s bytes",
+                           *this, part, data.size());
+                auto const last = data.empty();
+                scope.run_background(
+                  elle::sprintf("%s: part %s", object_name, part),
+                  [&, part, data = elle::utility::move_on_copy(std::move(data))]
+                  {
+                    elle::SafeFinally release([&] { window.release(); });
+                    chunks.emplace_back(
+                      part,
+                      this->multipart_upload(object_name, key, *data, part));
+                  });
+                if (last)
+                  break;
+              }
+              elle::reactor::wait(scope);
+            };
+          std::sort(chunks.begin(), chunks.end());
+          this->multipart_finalize(object_name, key, chunks);
+        }
+        catch (elle::reactor::Terminate const&)
+        {
+          throw;
+        }
+        catch (...)
+        {
+          ELLE_TRACE("%s: abort multipart upload of %s: %s",
+                     *this, object_name, elle::exception_string());
+          try
+          {
+            this->multipart_abort(object_name, key);
+          }
+          catch (elle::reactor::Terminate const&)
+          {
+            throw;
+          }
+          catch (elle::Exception const& e)
+          {
+            ELLE_WARN("%s: unable to abort multipart upload of %s: %s",
+                      *this, object_name, e.what());
+          }
+          throw;
+        }
+      }
+
       std::vector<std::pair<std::string, S3::FileSize>>
       S3::list_remote_folder(std::string const& marker)
       {
@@ -207,6 +344,70 @@ namespace elle
         return this->get_object(object_name, headers);
       }
 
+      void
+      S3::get_object(std::string const& object_name,
+                     FileSize size,
+                     Sink const& sink,
+                     FileSize part_size,
+                     int parallelism,
+                     int attempts)
+      {
+        ELLE_TRACE_SCOPE("%s: GET %s bytes of %s in parts of %s",
+                         *this, size, object_name, part_size);
+        ELLE_ASSERT_GT(part_size, 0u);
+        ELLE_ASSERT_GT(parallelism, 0);
+        auto const count = (size + part_size - 1) / part_size;
+        auto fetch = [&] (FileSize offset, FileSize length)
+          {
+            for (int attempt = 1; ; ++attempt)
+            {
+              try
+              {
+                auto data = this->get_object_chunk(object_name, offset, length);
+                if (data.size() != length)
+                  throw CorruptedData(elle::sprintf(
+                    "%s: GET %s at %s: got %s bytes instead of %s",
+                    *this, object_name, offset, data.size(), length));
+                return data;
+              }
+              catch (elle::reactor::Terminate const&)
+              {
+                throw;
+              }
+              catch (elle::Exception const& e)
+              {
+                if (attempt >= attempts ||
+                    !retriable(std::current_exception()))
+                  throw;
+                ELLE_WARN("%s: GET %s at %s failed, retrying (attempt %s): %s",
+                          *this, object_name, offset, attempt, e.what());
+                elle::reactor::sleep(delay(attempt));
+              }
+            }
+          };
+        // Each worker fetches the next part still to fetch, so at most
+        // `parallelism` requests are in flight.
+        auto next = FileSize(0);
+        elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+        {
+          auto const workers = std::min<FileSize>(parallelism, count);
+          for (auto i = 0u; i < workers; ++i)
+            scope.run_background(
+              elle::sprintf("%s: GET worker %s", object_name, i),
+              [&]
+              {
+                while (next < count)
+                {
+                  auto const offset = next++ * part_size;
+                  auto const length = std::min(part_size, size - offset);
+                  auto const data = fetch(offset, length);
+                  sink(offset, data);
+                }
+              });
+          elle::reactor::wait(scope);
+        };
+      }
+
       elle::Buffer
       S3::get_object(std::string const& object_name,
                      RequestHeaders headers)
@@ -794,6 +995,8 @@ namespace elle
         static int max_attempts = elle::os::getenv("INFINIT_S3_MAX_ATTEMPTS", 0);
         // If we receive a temporary redirect, we need to use a different host.
         auto override_host = boost::optional<std::string>{};
+        // The payload does not change across attempts: hash it once.
+        auto const payload_sha256 = this->_sha256_hexdigest(payload);
         while (true)
         {
           URL const hostname(this->hostname(this->_credentials, override_host));
@@ -808,7 +1011,7 @@ namespace elle
           request_time -= this->_credentials.skew();
           RequestHeaders headers(extra_headers);
           headers["x-amz-date"] = this->_amz_date(request_time);
-          headers["x-amz-content-sha256"] = this->_sha256_hexdigest(payload);
+          headers["x-amz-content-sha256"] = payload_sha256;
           if (this->_credentials.session_token())
           {
             headers["x-amz-security-token"] =
@@ -826,7 +1029,7 @@ namespace elle
           // http://docs.aws.amazon.com/AmazonS3/latest/API/sig-v4-header-based-auth.html
           CanonicalRequest canonical_request(
             method, uri_encode(canonical_uri, false), query, headers,
-            this->_signed_headers(headers), this->_sha256_hexdigest(payload)
+            this->_signed_headers(headers), payload_sha256
           );
           elle::reactor::http::Request::Configuration cfg(this->_initialize_request(
             kind, request_time, canonical_request, headers, timeout));
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+#include <iosfwd>
 #include <map>
 #include <vector>
 
@@ -38,6 +40,12 @@ namespace elle
         using ProgressCallback = std::function<void (int)>;
         using FileSize = uint64_t;
         using List = std::vector<std::pair<std::string, FileSize>>;
+        /// Produce the successive parts of an object, an empty Buffer
+        /// marking the end.
+        using Parts = std::function<elle::Buffer ()>;
+        /// Receive the data of an object at a given offset.
+        using Sink = std::function<void (FileSize offset,
+                                         elle::ConstWeakBuffer data)>;
 
         enum class StorageClass
         {
@@ -78,6 +86,28 @@ namespace elle
           StorageClass storage_class = StorageClass::Default,
           boost::optional<ProgressCallback> const& progress_callback = {});
 
+        /// Put an object read from @a object, in parts of @a part_size.
+        /// @see put_object(Parts const&, std::string const&, int,
+        ///      StorageClass)
+        void
+        put_object(std::istream& object,
+                   std::string const& object_name,
+                   FileSize part_size = 5 * 1024 * 1024,
+                   int parallelism = 4,
+                   StorageClass storage_class = StorageClass::Default);
+        /// Put an object produced part by part by @a parts, in a multipart
+        /// upload.
+        /// Parts are uploaded concurrently, at most @a parallelism at a time,
+        /// and the next part is only produced when an upload slot is free, so
+        /// that no more than @a parallelism parts are held in memory. The
+        /// upload is aborted on error. S3 requires all parts but the last to
+        /// be at least 5MiB.
+        void
+        put_object(Parts const& parts,
+                   std::string const& object_name,
+                   int parallelism = 4,
+                   StorageClass storage_class = StorageClass::Default);
+
         /// Returns a list of all files names and their respective sizes inside
         /// the remote folder.
         /// This is limited to 1000 results but a starting offset (marker) can
@@ -97,6 +127,18 @@ namespace elle
         elle::Buffer
         get_object_chunk(std::string const& object_name,
                          FileSize offset, FileSize size);
+        /// Fetch the @a size bytes of an object into @a sink, with ranged GETs
+        /// of @a part_size, at most @a parallelism at a time.
+        /// Parts are fed to @a sink as they arrive, in no particular order. A
+        /// part that comes back incomplete, corrupted or with a transient
+        /// error is fetched again, up to @a attempts times overall.
+        void
+        get_object(std::string const& object_name,
+                   FileSize size,
+                   Sink const& sink,
+                   FileSize part_size = 5 * 1024 * 1024,
+                   int parallelism = 4,
+                   int attempts = 3);
         /// Delete an object in the remote folder.
         /// The folder itself can be deleted only once it is empty. This can be
         /// done by setting the object_name to an empty string.
@@ -307,6 +307,33 @@ range()
   _range<elle::Buffer>();
 }
 
+static
+void
+pop_front()
+{
+  auto buffer = elle::Buffer("0123456789");
+  auto const contents = buffer.contents();
+  buffer.pop_front(3);
+  // Popping does not move the remaining bytes.
+  BOOST_TEST(buffer.contents() == contents + 3);
+  BOOST_TEST(buffer == "3456789");
+  buffer.append("abc", 3);
+  BOOST_TEST(buffer == "3456789abc");
+  // Growing reclaims the dropped bytes.
+  buffer.size(4096);
+  BOOST_TEST(buffer.range(0, 10) == "3456789abc");
+  buffer.pop_front(10);
+  buffer.shrink_to_fit();
+  BOOST_TEST(buffer.size() == 4086);
+  auto released = buffer.release();
+  BOOST_TEST(released.second == 4086);
+  buffer = elle::Buffer("xyz");
+  buffer.pop_front(3);
+  BOOST_TEST(buffer.size() == 0);
+  buffer.append("uvw", 3);
+  BOOST_TEST(buffer == "uvw");
+}
+
 static
 void
 output()
@@ -408,4 +435,5 @@ ELLE_TEST_SUITE()
 
   master.add(BOOST_TEST_CASE(hash), 0, 1);
   master.add(BOOST_TEST_CASE(range), 0, 1);
+  master.add(BOOST_TEST_CASE(pop_front), 0, 1);
 }
@@ -3,6 +3,9 @@
 
 #include <elle/finally.hh>
 #include <elle/log.hh>
+#include <elle/log/AsyncLogger.hh>
+#include <elle/log/BinaryLogger.hh>
+#include <elle/log/CompositeLogger.hh>
 #include <elle/log/Logger.hh>
 #include <elle/log/TextLogger.hh>
 #include <elle/memory.hh>
@@ -13,6 +16,8 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <chrono>
+#include <cstdint>
 #include <sstream>
 #include <thread>
 
@@ -549,6 +554,357 @@ error()
   }
 }
 
+/// Check levels can be changed at runtime, call sites noticing immediately.
+static
+void
+runtime_levels()
+{
+  elle::os::unsetenv("ELLE_LOG_LEVEL");
+  std::stringstream output;
+  auto& logger = [&] () -> elle::log::Logger&
+    {
+      auto l = std::make_unique<elle::log::TextLogger>(output, "LOG");
+      auto& res = *l;
+      elle::log::logger(std::move(l));
+      return res;
+    }();
+  ELLE_LOG_COMPONENT("runtime");
+  auto const log = [&] (int i)
+    {
+      output.str("");
+      ELLE_TRACE("trace %s", i);
+      ELLE_DEBUG("debug %s", i);
+      return output.str();
+    };
+  BOOST_CHECK_EQUAL(log(0), "");
+  logger.levels("runtime:TRACE");
+  BOOST_CHECK_EQUAL(logger.levels(), "runtime:TRACE");
+  BOOST_CHECK_EQUAL(log(1), "[runtime] trace 1\n");
+  logger.levels("DEBUG,runtime:LOG");
+  BOOST_CHECK_EQUAL(log(2), "");
+  logger.levels("DEBUG");
+  BOOST_CHECK_EQUAL(log(3), "[runtime] trace 3\n[runtime] debug 3\n");
+  // Invalid specifications leave levels untouched.
+  BOOST_CHECK_THROW(logger.levels("runtime:LOUD"), elle::Exception);
+  BOOST_CHECK_EQUAL(logger.levels(), "DEBUG");
+  elle::log::logger(std::unique_ptr<elle::log::Logger>(nullptr));
+}
+
+/// Check call site caches survive generations past 32 bits.
+static
+void
+site_generation()
+{
+  elle::os::unsetenv("ELLE_LOG_LEVEL");
+  std::stringstream output;
+  auto& logger = [&] () -> elle::log::Logger&
+    {
+      auto l = std::make_unique<elle::log::TextLogger>(output, "LOG");
+      auto& res = *l;
+      elle::log::logger(std::move(l));
+      return res;
+    }();
+  ELLE_LOG_COMPONENT("generation");
+  // Wrapped to zero, the generation would match sites never refreshed.
+  elle::log::detail::generation = (std::uint64_t(1) << 32) - 1;
+  logger.levels("generation:TRACE");
+  ELLE_TRACE("trace");
+  BOOST_CHECK_EQUAL(output.str(), "[generation] trace\n");
+  elle::log::logger(std::unique_ptr<elle::log::Logger>(nullptr));
+}
+
+/// Check records from concurrent producers all make it, in order for each
+/// of them.
+static
+void
+async()
+{
+  elle::os::unsetenv("ELLE_LOG_LEVEL");
+  std::stringstream output;
+  auto& logger = [&] () -> elle::log::AsyncLogger&
+    {
+      auto l = std::make_unique<elle::log::AsyncLogger>(
+        std::make_unique<elle::log::TextLogger>(output), "TRACE", 64);
+      auto& res = *l;
+      elle::log::logger(std::move(l));
+      return res;
+    }();
+  ELLE_LOG_COMPONENT("async");
+  ELLE_TRACE("outer")
+    ELLE_TRACE("inner");
+  logger.flush();
+  BOOST_CHECK_EQUAL(output.str(), "[async] outer\n[async]   inner\n");
+  output.str("");
+  auto const count = 2000;
+  auto producers = std::vector<std::thread>{};
+  for (int t = 0; t < 4; ++t)
+    producers.emplace_back(
+      [t]
+      {
+        for (int i = 0; i < count; ++i)
+          ELLE_TRACE("%s %s", t, i);
+      });
+  for (auto& producer: producers)
+    producer.join();
+  logger.flush();
+  BOOST_CHECK_EQUAL(logger.written(), 2u + 4 * count);
+  BOOST_CHECK_EQUAL(logger.dropped(), 0u);
+  auto next = std::vector<int>(4, 0);
+  auto line = std::string{};
+  while (std::getline(output, line))
+  {
+    int t = 0;
+    int i = 0;
+    BOOST_CHECK_EQUAL(std::sscanf(line.c_str(), "[async] %d %d", &t, &i), 2);
+    BOOST_CHECK_EQUAL(i, next.at(t)++);
+  }
+  BOOST_CHECK(next == std::vector<int>(4, count));
+}
+
+/// Check overflowing records are dropped, counted and reported.
+static
+void
+async_drop()
+{
+  elle::os::unsetenv("ELLE_LOG_LEVEL");
+  std::stringstream output;
+  auto& logger = [&] () -> elle::log::AsyncLogger&
+    {
+      auto l = std::make_unique<elle::log::AsyncLogger>(
+        std::make_unique<elle::log::TextLogger>(output), "TRACE", 4,
+        elle::log::AsyncLogger::Overflow::drop);
+      auto& res = *l;
+      elle::log::logger(std::move(l));
+      return res;
+    }();
+  ELLE_LOG_COMPONENT("async");
+  auto const count = 10000u;
+  for (auto i = 0u; i < count; ++i)
+    ELLE_TRACE("%s", i);
+  logger.flush();
+  BOOST_CHECK_EQUAL(logger.written() + logger.dropped(), count);
+  if (logger.dropped())
+    BOOST_CHECK(output.str().find("records, queue is full") !=
+                std::string::npos);
+}
+
+namespace
+{
+  /// A target throwing on "boom" and flushing the logging on "flush", from
+  /// the writer thread.
+  class FaultyLogger
+    : public elle::log::TextLogger
+  {
+  public:
+    using elle::log::TextLogger::TextLogger;
+
+  protected:
+    void
+    _message(Level level,
+             elle::log::Logger::Type type,
+             std::string const& component,
+             boost::posix_time::ptime const& time,
+             std::string const& message,
+             Tags const& tags,
+             int indentation,
+             std::string const& file,
+             unsigned int line,
+             std::string const& function) override
+    {
+      if (message == "boom")
+        throw std::runtime_error("target failure");
+      if (message == "flush")
+        elle::log::flush();
+      elle::log::TextLogger::_message(level, type, component, time, message,
+                                      tags, indentation, file, line,
+                                      function);
+    }
+  };
+}
+
+/// Check target failures are counted and reported, and a flush from the
+/// writer thread does not hang.
+static
+void
+async_failure()
+{
+  elle::os::unsetenv("ELLE_LOG_LEVEL");
+  std::stringstream output;
+  auto& logger = [&] () -> elle::log::AsyncLogger&
+    {
+      auto l = std::make_unique<elle::log::AsyncLogger>(
+        std::make_unique<FaultyLogger>(output), "TRACE");
+      auto& res = *l;
+      elle::log::logger(std::move(l));
+      return res;
+    }();
+  ELLE_LOG_COMPONENT("async");
+  ELLE_TRACE("before");
+  ELLE_TRACE("boom");
+  ELLE_TRACE("flush");
+  ELLE_TRACE("after");
+  logger.flush();
+  BOOST_CHECK_EQUAL(logger.written(), 4u);
+  BOOST_CHECK_EQUAL(logger.failed(), 1u);
+  auto const text = output.str();
+  BOOST_CHECK(text.find("[async] before") != std::string::npos);
+  BOOST_CHECK(text.find("[async] flush") != std::string::npos);
+  BOOST_CHECK(text.find("[async] after") != std::string::npos);
+  BOOST_CHECK(text.find("failed to write 1 records: target failure") !=
+              std::string::npos);
+}
+
+/// Check an AsyncLogger can feed a CompositeLogger.
+static
+void
+async_composite()
+{
+  elle::os::unsetenv("ELLE_LOG_LEVEL");
+  std::stringstream first;
+  std::stringstream second;
+  auto composite = std::make_unique<elle::log::CompositeLogger>();
+  composite->loggers().emplace_back(
+    std::make_unique<elle::log::TextLogger>(first, "TRACE"));
+  composite->loggers().emplace_back(
+    std::make_unique<elle::log::TextLogger>(second, "LOG"));
+  elle::log::logger(
+    std::make_unique<elle::log::AsyncLogger>(std::move(composite), "TRACE"));
+  ELLE_LOG_COMPONENT("async");
+  ELLE_LOG("log");
+  ELLE_TRACE("trace");
+  elle::log::flush();
+  BOOST_CHECK_EQUAL(first.str(), "\x1b[1m[async] log\n\x1b[0m[async] trace\n");
+  BOOST_CHECK_EQUAL(second.str(), "\x1b[1m[async] log\n\x1b[0m");
+}
+
+/// Check CompositeLogger children get the record as captured by the caller,
+/// not by the AsyncLogger writer thread.
+static
+void
+async_composite_record()
+{
+  elle::os::unsetenv("ELLE_LOG_LEVEL");
+  std::stringstream output;
+  auto composite = std::make_unique<elle::log::CompositeLogger>();
+  composite->loggers().emplace_back(
+    std::make_unique<elle::log::TextLogger>(output, "TRACE", false, false,
+                                            true));
+  auto& child = *composite->loggers().back();
+  elle::log::logger(
+    std::make_unique<elle::log::AsyncLogger>(std::move(composite), "TRACE"));
+  ELLE_LOG_COMPONENT("async");
+  ELLE_LOG("log")
+    ELLE_TRACE("trace");
+  elle::log::flush();
+  auto const tid = std::this_thread::get_id();
+  BOOST_CHECK_EQUAL(
+    output.str(),
+    elle::sprintf("\x1b[1m[async] [%s] log\n\x1b[0m[async] [%s]   trace\n",
+                  tid, tid));
+  BOOST_TEST(child.buffered());
+}
+
+/// Check binary records read back and render like text ones.
+static
+void
+binary()
+{
+  elle::os::unsetenv("ELLE_LOG_LEVEL");
+  std::stringstream output;
+  elle::log::logger(
+    std::make_unique<elle::log::BinaryLogger>(output, "TRACE"));
+  {
+    ELLE_LOG_COMPONENT("binary");
+    ELLE_LOG("first %s", 1)
+      ELLE_TRACE("nested");
+    ELLE_DEBUG("hidden");
+  }
+  {
+    ELLE_LOG_COMPONENT("binary.other");
+    ELLE_WARN("second");
+  }
+  elle::log::flush();
+  auto const log = output.str();
+  BOOST_CHECK_EQUAL(log.substr(0, elle::log::BinaryLogger::magic.size()),
+                    elle::log::BinaryLogger::magic);
+  {
+    auto reader = elle::log::BinaryLogReader(
+      elle::ConstWeakBuffer(log.data(), log.size()));
+    auto record = elle::log::BinaryLogReader::Record{};
+    BOOST_TEST(reader.next(record));
+    BOOST_TEST(record.component == "binary");
+    BOOST_TEST(record.message == "first 1");
+    BOOST_TEST((record.level == elle::log::Logger::Level::log));
+    BOOST_TEST(record.indentation == 0);
+    BOOST_TEST(reader.next(record));
+    BOOST_TEST(record.message == "nested");
+    BOOST_TEST(record.indentation == 1);
+    BOOST_TEST(reader.next(record));
+    BOOST_TEST(record.component == "binary.other");
+    BOOST_TEST((record.type == elle::log::Logger::Type::warning));
+    BOOST_TEST(!reader.next(record));
+  }
+  // Render, filtered by component and level.
+  {
+    std::stringstream text;
+    elle::log::TextLogger renderer(text, "binary:TRACE,binary.other:NONE");
+    auto reader = elle::log::BinaryLogReader(
+      elle::ConstWeakBuffer(log.data(), log.size()));
+    BOOST_TEST(reader.replay(renderer) == 2u);
+    BOOST_CHECK_EQUAL(text.str(),
+                      "\x1b[1m[binary] first 1\n\x1b[0m[binary]   nested\n");
+  }
+  // A log truncated amid a record ends there.
+  {
+    auto reader = elle::log::BinaryLogReader(
+      elle::ConstWeakBuffer(log.data(), log.size() - 2));
+    auto record = elle::log::BinaryLogReader::Record{};
+    BOOST_TEST(reader.next(record));
+    BOOST_TEST(reader.next(record));
+    BOOST_TEST(!reader.next(record));
+  }
+  BOOST_CHECK_THROW(
+    elle::log::BinaryLogReader(elle::ConstWeakBuffer("garbage", 7)),
+    elle::Error);
+}
+
+/// Not pass/fail checks: report the cost of a log statement.
+static
+void
+_site_performance(std::string const& levels)
+{
+  elle::os::unsetenv("ELLE_LOG_LEVEL");
+  std::stringstream output;
+  elle::log::logger(std::make_unique<elle::log::TextLogger>(output, levels));
+  ELLE_LOG_COMPONENT("performance");
+  auto const count = 1000000;
+  auto const start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; ++i)
+  {
+    ELLE_TRACE("statement %s", i);
+    if (i % 1024 == 0)
+      output.str("");
+  }
+  auto const duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start);
+  BOOST_TEST_MESSAGE(elle::sprintf("%s: %s ns per statement",
+                                   levels, duration.count() / count));
+}
+
+static
+void
+disabled_performance()
+{
+  _site_performance("LOG");
+}
+
+static
+void
+enabled_performance()
+{
+  _site_performance("TRACE");
+}
+
 ELLE_TEST_SUITE()
 {
   elle::log::detail::debug_formats(false);
@@ -559,12 +915,27 @@ ELLE_TEST_SUITE()
   suite.add(logger);
   logger->add(BOOST_TEST_CASE(message_test));
   logger->add(BOOST_TEST_CASE(environment_format_test));
+  logger->add(BOOST_TEST_CASE(runtime_levels));
+  logger->add(BOOST_TEST_CASE(site_generation));
 
 #ifndef INFINIT_ANDROID
   boost::unit_test::test_suite* concurrency = BOOST_TEST_SUITE("concurrency");
   suite.add(concurrency);
   concurrency->add(BOOST_TEST_CASE(std::bind(parallel_write)));
 
+  boost::unit_test::test_suite* performance = BOOST_TEST_SUITE("performance");
+  suite.add(performance);
+  performance->add(BOOST_TEST_CASE(disabled_performance));
+  performance->add(BOOST_TEST_CASE(enabled_performance));
+
+  boost::unit_test::test_suite* async = BOOST_TEST_SUITE("async");
+  suite.add(async);
+  async->add(BOOST_TEST_CASE(::async));
+  async->add(BOOST_TEST_CASE(async_drop));
+  async->add(BOOST_TEST_CASE(async_failure));
+  async->add(BOOST_TEST_CASE(async_composite));
+  async->add(BOOST_TEST_CASE(async_composite_record));
+
   boost::unit_test::test_suite* format = BOOST_TEST_SUITE("format");
   suite.add(format);
   format->add(BOOST_TEST_CASE(error));
@@ -572,5 +943,6 @@ ELLE_TEST_SUITE()
   format->add(BOOST_TEST_CASE(trim));
   format->add(BOOST_TEST_CASE(component_width));
   format->add(BOOST_TEST_CASE(nested));
+  format->add(BOOST_TEST_CASE(binary));
 #endif
 }
@@ -0,0 +1,153 @@
+#include <chrono>
+#include <sstream>
+
+#include <elle/test.hh>
+
+#include <elle/IOStream.hh>
+#include <elle/SegmentedBuffer.hh>
+#include <elle/printf.hh>
+
+static
+void
+append()
+{
+  auto b = elle::SegmentedBuffer(8);
+  BOOST_TEST(b.empty());
+  b.append(elle::ConstWeakBuffer("foo"));
+  b.append(elle::ConstWeakBuffer("barbazqux"));
+  BOOST_TEST(b.size() == 12);
+  BOOST_TEST(b.string() == "foobarbazqux");
+  // The first slab is filled up before allocating another.
+  BOOST_TEST(b.segments().size() == 2);
+  BOOST_TEST(b.front() == elle::ConstWeakBuffer("foobarba"));
+  BOOST_TEST(b[0] == 'f');
+  BOOST_TEST(b[4] == 'a');
+  BOOST_TEST(b[8] == 'z');
+  auto adopted = elle::Buffer("quux");
+  auto const contents = adopted.contents();
+  b.append(std::move(adopted));
+  BOOST_TEST(b.segments().back().contents() == contents);
+  BOOST_TEST(b == elle::ConstWeakBuffer("foobarbazquxquux"));
+}
+
+static
+void
+pop_front()
+{
+  auto b = elle::SegmentedBuffer{};
+  for (auto chunk: {"foo", "bar", "baz"})
+    b.append(elle::Buffer(chunk));
+  b.pop_front(2);
+  BOOST_TEST(b.string() == "obarbaz");
+  b.pop_front(2);
+  BOOST_TEST(b.string() == "arbaz");
+  BOOST_TEST(b.front() == elle::ConstWeakBuffer("ar"));
+  b.pop_front(5);
+  BOOST_TEST(b.empty());
+  BOOST_TEST(b.segments().empty());
+}
+
+static
+void
+range()
+{
+  auto b = elle::SegmentedBuffer{};
+  for (auto chunk: {"foo", "bar", "baz"})
+    b.append(elle::Buffer(chunk));
+  auto r = b.range(3, 7);
+  BOOST_TEST(r.string() == "barb");
+  // Ranges share the slabs.
+  BOOST_TEST(r.front().contents() == b.segments()[1].contents());
+  BOOST_TEST(b.range(9).empty());
+  BOOST_TEST(b.range(0) == b);
+  // Appending to either side does not affect the other.
+  b.append(elle::ConstWeakBuffer("!"));
+  r.append(elle::ConstWeakBuffer("?"));
+  BOOST_TEST(b.string() == "foobarbaz!");
+  BOOST_TEST(r.string() == "barb?");
+  auto copy = b;
+  copy.append(copy);
+  BOOST_TEST(copy.string() == "foobarbaz!foobarbaz!");
+  BOOST_TEST(b.string() == "foobarbaz!");
+}
+
+static
+void
+contiguous()
+{
+  auto b = elle::SegmentedBuffer{};
+  for (auto chunk: {"foo", "bar", "baz"})
+    b.append(elle::Buffer(chunk));
+  BOOST_TEST(b.contiguous(2) == elle::ConstWeakBuffer("fo"));
+  BOOST_TEST(b.segments().size() == 3);
+  BOOST_TEST(b.contiguous(6) == elle::ConstWeakBuffer("foobar"));
+  BOOST_TEST(b.segments().size() == 2);
+  BOOST_TEST(b.string() == "foobarbaz");
+}
+
+static
+void
+find()
+{
+  auto b = elle::SegmentedBuffer(4);
+  b.append(elle::ConstWeakBuffer("GET / HTTP/1.1\r\nHost: foo\r\n"));
+  BOOST_TEST(b.find('\n') == 15);
+  BOOST_TEST(b.find('\n', 16) == 26);
+  BOOST_TEST(b.find('#') == b.size());
+  BOOST_TEST(b.find('G', 100) == b.size());
+}
+
+static
+void
+stream()
+{
+  auto b = elle::SegmentedBuffer(4);
+  b.append(elle::ConstWeakBuffer("foo bar baz"));
+  elle::IOStream input(b.istreambuf());
+  std::string foo, bar, baz;
+  input >> foo >> bar >> baz;
+  BOOST_TEST(foo == "foo");
+  BOOST_TEST(bar == "bar");
+  BOOST_TEST(baz == "baz");
+}
+
+/// Consuming small headers from the front is linear, not quadratic.
+static
+void
+consume()
+{
+  auto const count = 20000;
+  auto const chunk = elle::ConstWeakBuffer("0123456789abcdef");
+  auto measure = [&] (auto& buffer, std::string const& name)
+    {
+      for (int i = 0; i < count; ++i)
+        buffer.append(chunk.contents(), chunk.size());
+      auto const start = std::chrono::steady_clock::now();
+      while (buffer.size())
+        buffer.pop_front(4);
+      auto const duration = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start);
+      BOOST_TEST_MESSAGE(
+        elle::sprintf("%s: %.1f ms", name, duration.count() * 1000));
+    };
+  {
+    auto b = elle::Buffer{};
+    measure(b, "Buffer");
+  }
+  {
+    auto b = elle::SegmentedBuffer{};
+    measure(b, "SegmentedBuffer");
+  }
+}
+
+ELLE_TEST_SUITE()
+{
+  auto& suite = boost::unit_test::framework::master_test_suite();
+  suite.add(BOOST_TEST_CASE(append));
+  suite.add(BOOST_TEST_CASE(pop_front));
+  suite.add(BOOST_TEST_CASE(range));
+  suite.add(BOOST_TEST_CASE(contiguous));
+  suite.add(BOOST_TEST_CASE(find));
+  suite.add(BOOST_TEST_CASE(stream));
+  suite.add(BOOST_TEST_CASE(consume), 0, valgrind(10));
+}
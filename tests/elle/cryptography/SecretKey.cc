@@ -4,6 +4,7 @@
 #include <elle/cryptography/Cipher.hh>
 #include <elle/cryptography/Oneway.hh>
 #include <elle/cryptography/random.hh>
+#include <elle/cryptography/Error.hh>
 
 #include <elle/serialization/json.hh>
 
@@ -234,12 +235,65 @@ _test_operate_idea()
   BOOST_CHECK_EQUAL(input, output);
 }
 
+static
+void
+_test_operate_aead()
+{
+  using elle::cryptography::Cipher;
+  using elle::cryptography::Mode;
+  namespace aead = elle::cryptography::constants::aead;
+  elle::cryptography::SecretKey key =
+    test_generate_x<256>();
+  std::string const input = "Chie du foutre!";
+  for (auto cipher: {Cipher::aes128, Cipher::aes192, Cipher::aes256})
+  {
+    elle::Buffer code = key.encipher(input, cipher, Mode::gcm);
+    BOOST_CHECK_EQUAL(code.size(), input.size() + aead::overhead);
+    // The cipher is read from the code, whatever is asked.
+    BOOST_CHECK_EQUAL(key.decipher(code).string(), input);
+    // Codes are authenticated.
+    code[code.size() / 2] ^= 1;
+    BOOST_CHECK_THROW(key.decipher(code), elle::cryptography::Error);
+  }
+  // In place, without allocation.
+  {
+    elle::Buffer buffer(input.size() + aead::overhead);
+    auto plain = elle::WeakBuffer(
+      buffer.mutable_contents() + aead::header_size, input.size());
+    memcpy(plain.mutable_contents(), input.c_str(), input.size());
+    BOOST_CHECK_EQUAL(key.encipher(plain, buffer), buffer.size());
+    BOOST_CHECK_NE(plain.string(), input);
+    BOOST_CHECK_EQUAL(key.decipher(buffer, plain), input.size());
+    BOOST_CHECK_EQUAL(plain.string(), input);
+  }
+  // Streams, and copies sharing the key schedule.
+  {
+    std::stringstream plain(input);
+    std::stringstream code;
+    key.encipher(plain, code, Cipher::aes256, Mode::gcm);
+    std::stringstream output;
+    elle::cryptography::SecretKey copy(key);
+    copy.decipher(code, output);
+    BOOST_CHECK_EQUAL(output.str(), input);
+  }
+  // Legacy codes are still read.
+  {
+    elle::Buffer code = key.encipher(input);
+    BOOST_CHECK_EQUAL(key.decipher(code, Cipher::aes256, Mode::gcm).string(),
+                      input);
+  }
+  BOOST_CHECK_THROW(key.encipher(input, Cipher::des, Mode::gcm),
+                    elle::cryptography::Error);
+}
+
 static
 void
 test_operate()
 {
   // IDEA.
   _test_operate_idea();
+  // AES-GCM.
+  _test_operate_aead();
 }
 
 /*----------.
@@ -339,6 +393,25 @@ test_serialize()
                    elle::cryptography::Cipher::aes256,
                    elle::cryptography::Mode::ecb,
                    elle::cryptography::Oneway::sha384);
+  // Deserializing into a used key drops what its previous password derived.
+  {
+    using elle::cryptography::Cipher;
+    using elle::cryptography::Mode;
+    elle::cryptography::SecretKey key = test_generate_x<256>();
+    elle::cryptography::SecretKey other = test_generate_x<256>();
+    elle::Buffer code = key.encipher(_message, Cipher::aes256, Mode::gcm);
+    std::stringstream stream;
+    {
+      typename elle::serialization::json::SerializerOut output(stream);
+      other.serialize(output);
+    }
+    typename elle::serialization::json::SerializerIn input(stream);
+    key.serialize(input);
+    BOOST_CHECK(key == other);
+    BOOST_CHECK_THROW(key.decipher(code), elle::cryptography::Error);
+    code = key.encipher(_message, Cipher::aes256, Mode::gcm);
+    BOOST_CHECK_EQUAL(other.decipher(code).string(), _message);
+  }
 }
 
 /*-----.
@@ -4,7 +4,14 @@
 # include <elle/test.hh>
 # include <elle/serialization/json.hh>
 
+# include <elle/cryptography/batch.hh>
+
+# include <algorithm>
+# include <atomic>
+# include <exception>
 # include <functional>
+# include <mutex>
+# include <thread>
 
 namespace elle
 {
@@ -48,6 +55,42 @@ namespace elle
           BOOST_CHECK_EQUAL(*objects[i], _o);
         }
       }
+
+      /// A batch::Runner spreading jobs over one system thread per core,
+      /// standing in for reactor::background_parallel which cryptography
+      /// cannot depend on.
+      inline
+      void
+      threads(std::size_t count, batch::Job const& job)
+      {
+        std::atomic<std::size_t> next(0);
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::vector<std::thread> workers;
+        auto const n = std::min<std::size_t>(
+          count, std::max(std::thread::hardware_concurrency(), 1u));
+        for (std::size_t t = 0; t < n; ++t)
+          workers.emplace_back(
+            [&]
+            {
+              try
+              {
+                for (auto i = next++; i < count; i = next++)
+                  job(i);
+              }
+              catch (...)
+              {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                  error = std::current_exception();
+                next = count;
+              }
+            });
+        for (auto& worker: workers)
+          worker.join();
+        if (error)
+          std::rethrow_exception(error);
+      }
     }
   }
 }
@@ -135,6 +135,34 @@ test_operate()
   }
 }
 
+/*------.
+| Batch |
+`------*/
+
+static
+void
+test_batch()
+{
+  auto const n = RUNNING_ON_VALGRIND ? 4 : 32;
+  auto keypair = elle::cryptography::dsa::keypair::generate(1024);
+  std::vector<elle::Buffer> plains;
+  for (int i = 0; i < n; ++i)
+    plains.emplace_back(elle::sprintf("%s %s", _input, i));
+  std::vector<elle::cryptography::dsa::privatekey::Signing> signings;
+  for (auto const& plain: plains)
+    signings.push_back({keypair.k(), plain});
+  auto signatures = elle::cryptography::dsa::privatekey::sign(
+    signings, elle::cryptography::test::threads);
+  signatures[0].mutable_contents()[signatures[0].size() - 1] ^= 0xff;
+  std::vector<elle::cryptography::dsa::publickey::Verification> verifications;
+  for (int i = 0; i < n; ++i)
+    verifications.push_back({keypair.K(), signatures[i], plains[i]});
+  auto results = elle::cryptography::dsa::publickey::verify(
+    verifications, elle::cryptography::test::threads);
+  for (int i = 0; i < n; ++i)
+    BOOST_CHECK_EQUAL(results[i], i != 0);
+}
+
 /*--------.
 | Compare |
 `--------*/
@@ -204,6 +232,7 @@ ELLE_TEST_SUITE()
   suite->add(BOOST_TEST_CASE(test_operate));
   suite->add(BOOST_TEST_CASE(test_compare));
   suite->add(BOOST_TEST_CASE(test_serialize));
+  suite->add(BOOST_TEST_CASE(test_batch));
 
   boost::unit_test::framework::master_test_suite().add(suite);
 }
@@ -2,12 +2,15 @@
 
 #include <openssl/evp.h>
 
+#include <elle/cryptography/Hasher.hh>
 #include <elle/cryptography/Oneway.hh>
 #include <elle/cryptography/hash.hh>
 #include <elle/cryptography/random.hh>
 
 #include <elle/serialization/json.hh>
 
+#include <chrono>
+
 static std::string const _message(
   "- Do you think she's expecting something big?"
   "- You mean, like anal?");
@@ -157,6 +160,120 @@ test_blocks()
   test_blocks_x<elle::cryptography::Oneway::sha512>();
 }
 
+/*-------.
+| Hasher |
+`-------*/
+
+static
+void
+test_hasher()
+{
+  auto const data =
+    elle::cryptography::random::generate<elle::Buffer>(100000);
+  auto const md5 = elle::cryptography::hash(data, elle::cryptography::Oneway::md5);
+  auto const sha256 =
+    elle::cryptography::hash(data, elle::cryptography::Oneway::sha256);
+  // Single digest, fed in uneven pieces.
+  {
+    elle::cryptography::Hasher hasher(elle::cryptography::Oneway::sha256);
+    for (std::size_t i = 0; i < data.size(); i += 4097)
+      hasher.update(elle::ConstWeakBuffer(
+                      data.contents() + i,
+                      std::min<std::size_t>(4097, data.size() - i)));
+    BOOST_CHECK_EQUAL(hasher.finalize(), sha256);
+    // The hasher is reset by finalization.
+    hasher.update(data);
+    BOOST_CHECK_EQUAL(hasher.finalize(), sha256);
+    BOOST_CHECK_EQUAL(
+      hasher.finalize(),
+      elle::cryptography::hash(elle::ConstWeakBuffer(),
+                               elle::cryptography::Oneway::sha256));
+  }
+  // Several digests in one pass, from a stream.
+  {
+    elle::cryptography::Hasher hasher(
+      {elle::cryptography::Oneway::md5, elle::cryptography::Oneway::sha256});
+    elle::IOStream stream(data.istreambuf());
+    hasher.update(stream);
+    auto digests = hasher.finalize_all();
+    BOOST_CHECK_EQUAL(digests.size(), 2);
+    BOOST_CHECK_EQUAL(digests[0], md5);
+    BOOST_CHECK_EQUAL(digests[1], sha256);
+  }
+  // Many buffers at once.
+  {
+    std::vector<elle::Buffer> plains;
+    for (int i = 0; i < 100; ++i)
+      plains.emplace_back(
+        elle::cryptography::random::generate<elle::Buffer>(i));
+    std::vector<elle::ConstWeakBuffer> weak(plains.begin(), plains.end());
+    auto digests = elle::cryptography::hash(
+      weak, elle::cryptography::Oneway::sha256,
+      elle::cryptography::test::threads);
+    BOOST_CHECK_EQUAL(digests.size(), plains.size());
+    for (std::size_t i = 0; i < plains.size(); ++i)
+      BOOST_CHECK_EQUAL(
+        digests[i],
+        elle::cryptography::hash(plains[i],
+                                 elle::cryptography::Oneway::sha256));
+  }
+}
+
+static
+void
+bench_hasher()
+{
+  using Clock = std::chrono::steady_clock;
+  auto const total = RUNNING_ON_VALGRIND ? (1 << 20) : (256 << 20);
+  auto const data =
+    elle::cryptography::random::generate<elle::Buffer>(
+      RUNNING_ON_VALGRIND ? (1 << 20) : (64 << 20));
+  auto report = [&] (std::string const& name, std::size_t size,
+                     Clock::time_point start)
+    {
+      std::chrono::duration<double> d = Clock::now() - start;
+      BOOST_TEST_MESSAGE(elle::sprintf(
+        "%s, %s B: %s MB/s", name, size,
+        static_cast<int>(total / d.count() / 1e6)));
+    };
+  for (std::size_t size = 64; size <= data.size(); size *= 16)
+  {
+    auto const count = std::max<std::size_t>(total / size, 1);
+    elle::ConstWeakBuffer const plain(data.contents(), size);
+    {
+      auto start = Clock::now();
+      for (std::size_t i = 0; i < count; ++i)
+        elle::cryptography::hash(plain, elle::cryptography::Oneway::sha256);
+      report("sha256", size, start);
+    }
+    {
+      auto start = Clock::now();
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        elle::cryptography::hash(plain, elle::cryptography::Oneway::md5);
+        elle::cryptography::hash(plain, elle::cryptography::Oneway::sha256);
+      }
+      report("md5 + sha256, two passes", size, start);
+    }
+    {
+      elle::cryptography::Hasher hasher(
+        {elle::cryptography::Oneway::md5, elle::cryptography::Oneway::sha256});
+      auto start = Clock::now();
+      for (std::size_t i = 0; i < count; ++i)
+        hasher.update(plain).finalize_all();
+      report("md5 + sha256, one pass", size, start);
+    }
+    if (count > 1)
+    {
+      std::vector<elle::ConstWeakBuffer> plains(count, plain);
+      auto start = Clock::now();
+      elle::cryptography::hash(plains, elle::cryptography::Oneway::sha256,
+                               elle::cryptography::test::threads);
+      report("sha256, threaded batch", size, start);
+    }
+  }
+}
+
 /*-----.
 | Main |
 `-----*/
@@ -169,6 +286,8 @@ ELLE_TEST_SUITE()
   suite->add(BOOST_TEST_CASE(test_operate));
   suite->add(BOOST_TEST_CASE(test_serialize));
   suite->add(BOOST_TEST_CASE(test_blocks));
+  suite->add(BOOST_TEST_CASE(test_hasher));
+  suite->add(BOOST_TEST_CASE(bench_hasher));
 
   boost::unit_test::framework::master_test_suite().add(suite);
 }
@@ -6,6 +6,8 @@
 
 #include <elle/serialization/json.hh>
 
+#include <chrono>
+
 /*----------.
 | Represent |
 `----------*/
@@ -135,6 +137,94 @@ test_operate()
   }
 }
 
+/*------.
+| Batch |
+`------*/
+
+static
+void
+test_batch()
+{
+  auto const n = RUNNING_ON_VALGRIND ? 8 : 64;
+  std::vector<elle::cryptography::rsa::KeyPair> keypairs;
+  for (int i = 0; i < 4; ++i)
+    keypairs.emplace_back(elle::cryptography::rsa::keypair::generate(1024));
+  std::vector<elle::Buffer> plains;
+  for (int i = 0; i < n; ++i)
+    plains.emplace_back(elle::sprintf("%s %s", _input, i));
+  std::vector<elle::cryptography::rsa::privatekey::Signing> signings;
+  for (int i = 0; i < n; ++i)
+    signings.push_back({keypairs[i % keypairs.size()].k(), plains[i]});
+  for (auto run: std::vector<elle::cryptography::batch::Runner>{
+         elle::cryptography::batch::sequential,
+         elle::cryptography::test::threads})
+  {
+    auto signatures = elle::cryptography::rsa::privatekey::sign(signings, run);
+    BOOST_CHECK_EQUAL(signatures.size(), n);
+    std::vector<elle::cryptography::rsa::publickey::Verification>
+      verifications;
+    for (int i = 0; i < n; ++i)
+    {
+      auto const& K = keypairs[i % keypairs.size()].K();
+      BOOST_CHECK(K.verify(signatures[i], plains[i]));
+      verifications.push_back({K, signatures[i], plains[i]});
+    }
+    auto results =
+      elle::cryptography::rsa::publickey::verify(verifications, run);
+    BOOST_CHECK(std::all_of(results.begin(), results.end(),
+                            [] (bool v) { return v; }));
+    // Corrupt one signature and check another against the wrong key.
+    signatures[1].mutable_contents()[0] ^= 0xff;
+    std::vector<elle::cryptography::rsa::publickey::Verification> invalid;
+    for (int i = 0; i < n; ++i)
+      invalid.push_back({keypairs[(i + (i == 2)) % keypairs.size()].K(),
+                         signatures[i], plains[i]});
+    results = elle::cryptography::rsa::publickey::verify(invalid, run);
+    for (int i = 0; i < n; ++i)
+      BOOST_CHECK_EQUAL(results[i], i != 1 && i != 2);
+  }
+}
+
+static
+void
+bench_batch()
+{
+  auto const n = RUNNING_ON_VALGRIND ? 16 : 2048;
+  auto keypair = elle::cryptography::rsa::keypair::generate(2048);
+  std::vector<elle::Buffer> plains;
+  for (int i = 0; i < n; ++i)
+    plains.emplace_back(elle::sprintf("%s %s", _input, i));
+  std::vector<elle::Buffer> signatures;
+  for (auto const& plain: plains)
+    signatures.emplace_back(keypair.k().sign(plain));
+  std::vector<elle::cryptography::rsa::publickey::Verification> verifications;
+  for (int i = 0; i < n; ++i)
+    verifications.push_back({keypair.K(), signatures[i], plains[i]});
+  auto measure = [&] (std::string const& name, std::function<bool ()> run)
+    {
+      auto start = std::chrono::steady_clock::now();
+      BOOST_CHECK(run());
+      std::chrono::duration<double> d =
+        std::chrono::steady_clock::now() - start;
+      BOOST_TEST_MESSAGE(elle::sprintf(
+        "%s: %s verifications/s", name, static_cast<int>(n / d.count())));
+    };
+  measure("loop", [&]
+    {
+      bool res = true;
+      for (auto const& v: verifications)
+        res = v.key.verify(v.signature, v.plain) && res;
+      return res;
+    });
+  measure("batch", [&]
+    {
+      auto results = elle::cryptography::rsa::publickey::verify(
+        verifications, elle::cryptography::test::threads);
+      return std::all_of(results.begin(), results.end(),
+                         [] (bool v) { return v; });
+    });
+}
+
 /*--------.
 | Compare |
 `--------*/
@@ -204,6 +294,8 @@ ELLE_TEST_SUITE()
   suite->add(BOOST_TEST_CASE(test_operate));
   suite->add(BOOST_TEST_CASE(test_compare));
   suite->add(BOOST_TEST_CASE(test_serialize));
+  suite->add(BOOST_TEST_CASE(test_batch));
+  suite->add(BOOST_TEST_CASE(bench_batch));
 
   boost::unit_test::framework::master_test_suite().add(suite);
 }
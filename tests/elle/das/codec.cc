@@ -0,0 +1,436 @@
+#include <chrono>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <boost/preprocessor/arithmetic/mod.hpp>
+#include <boost/preprocessor/cat.hpp>
+#include <boost/preprocessor/punctuation/comma_if.hpp>
+#include <boost/preprocessor/repetition/repeat.hpp>
+
+#include <elle/serialization/binary.hh>
+#include <elle/serialization/json/Error.hh>
+#include <elle/test.hh>
+
+#include <elle/das/Symbol.hh>
+#include <elle/das/codec.hh>
+#include <elle/das/serializer.hh>
+
+ELLE_LOG_COMPONENT("das.codec.test");
+
+namespace symbol
+{
+  ELLE_DAS_SYMBOL(animal);
+  ELLE_DAS_SYMBOL(big);
+  ELLE_DAS_SYMBOL(data);
+  ELLE_DAS_SYMBOL(devices);
+  ELLE_DAS_SYMBOL(flag);
+  ELLE_DAS_SYMBOL(id);
+  ELLE_DAS_SYMBOL(name);
+  ELLE_DAS_SYMBOL(nick);
+  ELLE_DAS_SYMBOL(numbers);
+  ELLE_DAS_SYMBOL(ratio);
+  ELLE_DAS_SYMBOL(small);
+}
+
+/*--------.
+| Records |
+`--------*/
+
+/// A struct with a ctor.
+struct Device
+{
+  Device(int id, std::string name)
+    : id(id)
+    , name(std::move(name))
+  {}
+
+  bool
+  operator ==(Device const& rhs) const
+  {
+    return this->id == rhs.id && this->name == rhs.name;
+  }
+
+  int id;
+  std::string name;
+
+  using Model = elle::das::Model<Device,
+                                 decltype(elle::meta::list(symbol::id,
+                                                           symbol::name))>;
+};
+ELLE_DAS_SERIALIZE(Device);
+
+/// A polymorphic hierarchy, only encoded dynamically.
+class Animal
+  : public elle::serialization::VirtuallySerializable<Animal, false>
+{
+public:
+  Animal(std::string name)
+    : _name(std::move(name))
+  {}
+
+  Animal(elle::serialization::SerializerIn& s)
+  {
+    this->serialize(s);
+  }
+
+  virtual
+  void
+  serialize(elle::serialization::Serializer& s)
+  {
+    s.serialize("name", this->_name);
+  }
+
+  using serialization_tag = elle::serialization_tag;
+  ELLE_ATTRIBUTE_R(std::string, name);
+};
+static const elle::serialization::Hierarchy<Animal>::Register<Animal>
+_register_Animal("Animal");
+
+class Dog
+  : public Animal
+{
+public:
+  Dog(std::string name, int bones)
+    : Animal(std::move(name))
+    , _bones(bones)
+  {}
+
+  Dog(elle::serialization::SerializerIn& s)
+    : Animal(s)
+  {
+    s.serialize("bones", this->_bones);
+  }
+
+  void
+  serialize(elle::serialization::Serializer& s) override
+  {
+    Animal::serialize(s);
+    s.serialize("bones", this->_bones);
+  }
+
+  ELLE_ATTRIBUTE_R(int, bones);
+};
+static const elle::serialization::Hierarchy<Animal>::Register<Dog>
+_register_Dog("Dog");
+
+/// A struct without ctor, with every kind of field.
+struct Rich
+{
+  int32_t id;
+  uint8_t small;
+  int64_t big;
+  bool flag;
+  double ratio;
+  std::string name;
+  elle::Buffer data;
+  std::vector<int> numbers;
+  boost::optional<std::string> nick;
+  std::vector<Device> devices;
+  std::shared_ptr<Animal> animal;
+
+  using Model = elle::das::Model<
+    Rich,
+    decltype(elle::meta::list(symbol::id,
+                              symbol::small,
+                              symbol::big,
+                              symbol::flag,
+                              symbol::ratio,
+                              symbol::name,
+                              symbol::data,
+                              symbol::numbers,
+                              symbol::nick,
+                              symbol::devices,
+                              symbol::animal))>;
+};
+ELLE_DAS_SERIALIZE(Rich);
+
+/// Rich, with a narrower id.
+struct Narrow
+{
+  int8_t id;
+
+  using Model = elle::das::Model<Narrow,
+                                 decltype(elle::meta::list(symbol::id))>;
+};
+ELLE_DAS_SERIALIZE(Narrow);
+
+static
+Rich
+rich(bool filled)
+{
+  auto res = Rich{};
+  res.id = -42;
+  res.small = 200;
+  res.big = int64_t(1) << 40;
+  res.flag = true;
+  res.ratio = 1 / 3.;
+  res.name = "Ford Prefect";
+  res.data = elle::Buffer("\x00\x01\x02\xff", 4);
+  res.numbers = {0, 63, 64, -64, 8191, 8192, 1 << 20, -(1 << 30)};
+  if (filled)
+  {
+    res.nick = std::string("Ix");
+    res.devices = {Device(1, "towel"), Device(2, "guide")};
+    res.animal = std::make_shared<Dog>("Rex", 3);
+  }
+  return res;
+}
+
+static
+void
+check_rich(Rich const& expected, Rich const& actual)
+{
+  BOOST_CHECK_EQUAL(actual.id, expected.id);
+  BOOST_CHECK_EQUAL(actual.small, expected.small);
+  BOOST_CHECK_EQUAL(actual.big, expected.big);
+  BOOST_CHECK_EQUAL(actual.flag, expected.flag);
+  BOOST_CHECK_EQUAL(actual.ratio, expected.ratio);
+  BOOST_CHECK_EQUAL(actual.name, expected.name);
+  BOOST_CHECK_EQUAL(actual.data, expected.data);
+  BOOST_CHECK(actual.numbers == expected.numbers);
+  BOOST_CHECK(actual.nick == expected.nick);
+  BOOST_CHECK(actual.devices == expected.devices);
+  BOOST_CHECK_EQUAL(bool(actual.animal), bool(expected.animal));
+  if (expected.animal)
+  {
+    auto const dog = std::dynamic_pointer_cast<Dog>(actual.animal);
+    BOOST_REQUIRE(dog);
+    BOOST_CHECK_EQUAL(dog->name(), "Rex");
+    BOOST_CHECK_EQUAL(dog->bones(), 3);
+  }
+}
+
+/*------.
+| Tests |
+`------*/
+
+static
+void
+compatibility()
+{
+  using Codec = elle::das::BinaryCodec<Rich>;
+  for (auto filled: {false, true})
+    for (auto versioned: {false, true})
+      ELLE_LOG("filled: %s, versioned: %s", filled, versioned)
+      {
+        auto const r = rich(filled);
+        auto const reference =
+          elle::serialization::binary::serialize(r, versioned);
+        auto const encoded = Codec::encode(r, versioned);
+        BOOST_CHECK_EQUAL(encoded, reference);
+        check_rich(r, Codec::decode(reference, versioned));
+        check_rich(r, elle::serialization::binary::deserialize<Rich>(
+                     encoded, versioned));
+      }
+}
+
+static
+void
+streaming()
+{
+  using Codec = elle::das::BinaryCodec<Rich>;
+  auto const records = std::vector<Rich>{rich(true), rich(false), rich(true)};
+  auto buffer = elle::Buffer{};
+  {
+    elle::serialization::binary::SerializerOut s(buffer, false);
+    for (auto const& r: records)
+    {
+      Codec::encode(r, s);
+      s.serialize("trailer", r.id);
+    }
+  }
+  elle::serialization::binary::SerializerIn s(
+    elle::ConstWeakBuffer(buffer), false);
+  for (auto const& r: records)
+  {
+    check_rich(r, elle::das::Serializer<Rich>::deserialize(s));
+    BOOST_CHECK_EQUAL(s.deserialize<int32_t>("trailer"), r.id);
+  }
+  BOOST_CHECK_EQUAL(s.remaining().size(), 0);
+}
+
+static
+void
+errors()
+{
+  auto const encoded = elle::das::BinaryCodec<Rich>::encode(rich(true));
+  for (auto size: {1, 5, 20, int(encoded.size()) - 1})
+    BOOST_CHECK_THROW(
+      elle::das::BinaryCodec<Rich>::decode(
+        elle::ConstWeakBuffer(encoded).range(0, size)),
+      elle::serialization::Error);
+  auto wide = Rich{};
+  wide.id = 1000;
+  auto const overflowing = elle::das::BinaryCodec<Rich>::encode(wide);
+  BOOST_CHECK_THROW(elle::das::BinaryCodec<Narrow>::decode(overflowing),
+                    elle::serialization::json::Overflow);
+}
+
+/*-----------.
+| Benchmarks |
+`-----------*/
+
+using Field0 = int;
+using Field1 = std::string;
+using Field2 = double;
+using Field3 = bool;
+
+#define CODEC_SYMBOL(Name) ELLE_DAS_SYMBOL(Name)
+#define CODEC_SYMBOLS(z, n, _) CODEC_SYMBOL(BOOST_PP_CAT(f, n));
+#define CODEC_MEMBER(z, n, _)                                   \
+  BOOST_PP_CAT(Field, BOOST_PP_MOD(n, 4)) BOOST_PP_CAT(f, n);
+#define CODEC_FIELD(z, n, _)                                    \
+  BOOST_PP_COMMA_IF(n) symbol::BOOST_PP_CAT(f, n)
+#define CODEC_RECORD(Size)                                      \
+  struct BOOST_PP_CAT(Record, Size)                             \
+  {                                                             \
+    BOOST_PP_REPEAT(Size, CODEC_MEMBER, _)                      \
+                                                                \
+    using Model = elle::das::Model<                             \
+      BOOST_PP_CAT(Record, Size),                               \
+      decltype(elle::meta::list(                                \
+        BOOST_PP_REPEAT(Size, CODEC_FIELD, _)))>;               \
+  };                                                            \
+  ELLE_DAS_SERIALIZE(BOOST_PP_CAT(Record, Size));
+
+namespace symbol
+{
+  BOOST_PP_REPEAT(50, CODEC_SYMBOLS, _)
+}
+
+CODEC_RECORD(5)
+CODEC_RECORD(20)
+CODEC_RECORD(50)
+
+static
+void
+sample(int& v, int i)
+{
+  v = i * 37;
+}
+
+static
+void
+sample(std::string& v, int i)
+{
+  v = elle::sprintf("value %s", i);
+}
+
+static
+void
+sample(double& v, int i)
+{
+  v = i / 3.;
+}
+
+static
+void
+sample(bool& v, int i)
+{
+  v = i % 2;
+}
+
+template <typename R>
+struct Fill
+{
+  template <typename F>
+  struct Field
+  {
+    using type = int;
+    static
+    int
+    value(R& r, int i)
+    {
+      sample(F::attr_get(r), i);
+      return 0;
+    }
+  };
+};
+
+template <typename R>
+static
+std::vector<R>
+records(int count)
+{
+  auto res = std::vector<R>(count);
+  for (int i = 0; i < count; ++i)
+    R::Model::Fields::template map<Fill<R>::template Field>::value(res[i], i);
+  return res;
+}
+
+/// Compare encoding and decoding through the virtual serializer and the
+/// codec.
+template <typename R>
+static
+void
+benchmark()
+{
+  auto const data = records<R>(RUNNING_ON_VALGRIND ? 10 : 20000);
+  auto measure = [&] (std::string const& name, std::function<void ()> f)
+    {
+      auto const start = std::chrono::steady_clock::now();
+      f();
+      auto const duration = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start);
+      BOOST_TEST_MESSAGE(
+        elle::sprintf("%s fields, %s: %.1f ms",
+                      std::tuple_size<
+                        typename R::Model::Fields::template apply<std::tuple>
+                      >::value,
+                      name, duration.count() * 1000));
+    };
+  auto dynamic = elle::Buffer{};
+  measure("encode with serializer", [&] {
+      elle::serialization::binary::SerializerOut s(dynamic, false);
+      for (auto const& r: data)
+        elle::das::serialize(r, s);
+    });
+  auto compiled = elle::Buffer{};
+  measure("encode with codec", [&] {
+      elle::serialization::binary::SerializerOut s(compiled, false);
+      for (auto const& r: data)
+        elle::das::BinaryCodec<R>::encode(r, s);
+    });
+  BOOST_CHECK_EQUAL(compiled, dynamic);
+  measure("decode with serializer", [&] {
+      elle::serialization::binary::SerializerIn s(
+        elle::ConstWeakBuffer(dynamic), false);
+      for (unsigned i = 0; i < data.size(); ++i)
+        elle::das::Serializer<R>::deserialize(s);
+      BOOST_CHECK_EQUAL(s.remaining().size(), 0);
+    });
+  auto decoded = std::vector<R>{};
+  decoded.reserve(data.size());
+  measure("decode with codec", [&] {
+      elle::serialization::binary::SerializerIn s(
+        elle::ConstWeakBuffer(compiled), false);
+      for (unsigned i = 0; i < data.size(); ++i)
+        decoded.emplace_back(elle::das::BinaryCodec<R>::decode(s));
+      BOOST_CHECK_EQUAL(s.remaining().size(), 0);
+    });
+  auto check = elle::Buffer{};
+  {
+    elle::serialization::binary::SerializerOut s(check, false);
+    for (auto const& r: decoded)
+      elle::das::serialize(r, s);
+  }
+  BOOST_CHECK_EQUAL(check, dynamic);
+}
+
+ELLE_TEST_SUITE()
+{
+  auto& suite = boost::unit_test::framework::master_test_suite();
+  suite.add(BOOST_TEST_CASE(compatibility), 0, valgrind(1));
+  suite.add(BOOST_TEST_CASE(streaming), 0, valgrind(1));
+  suite.add(BOOST_TEST_CASE(errors), 0, valgrind(1));
+  {
+    auto* bench = BOOST_TEST_SUITE("benchmark");
+    suite.add(bench);
+    bench->add(BOOST_TEST_CASE(benchmark<Record5>), 0, valgrind(10));
+    bench->add(BOOST_TEST_CASE(benchmark<Record20>), 0, valgrind(10));
+    bench->add(BOOST_TEST_CASE(benchmark<Record50>), 0, valgrind(10));
+  }
+}
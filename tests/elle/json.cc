@@ -1,8 +1,14 @@
+#include <chrono>
+#include <functional>
+#include <locale>
 #include <sstream>
 
+#include <elle/finally.hh>
+#include <elle/json/exceptions.hh>
 #include <elle/json/json.hh>
 #include <elle/test.hh>
 #include <elle/log.hh>
+#include <elle/printf.hh>
 
 ELLE_LOG_COMPONENT("Test");
 
@@ -145,6 +151,116 @@ pretty_printer_utf_8()
   BOOST_CHECK_EQUAL(boost::any_cast<std::string>(read_object["utf-8"]), name);
 }
 
+static
+void
+read_escapes()
+{
+  auto const json = elle::json::read(
+    "\"\\\"\\\\\\/\\b\\f\\n\\r\\t\\u00e9\\ud83d\\ude00\"");
+  BOOST_CHECK_EQUAL(boost::any_cast<std::string>(json),
+                    "\"\\/\b\f\n\r\t\xc3\xa9\xf0\x9f\x98\x80");
+}
+
+static
+void
+read_numbers()
+{
+  BOOST_CHECK_EQUAL(boost::any_cast<int64_t>(elle::json::read("-9437196296")),
+                    -9437196296);
+  BOOST_CHECK_EQUAL(
+    static_cast<uint64_t>(
+      boost::any_cast<int64_t>(elle::json::read("18446744073709551615"))),
+    18446744073709551615ULL);
+  BOOST_CHECK_EQUAL(boost::any_cast<double>(elle::json::read("-0.25")), -0.25);
+  BOOST_CHECK_EQUAL(boost::any_cast<double>(elle::json::read("1.5e3")), 1500);
+}
+
+namespace
+{
+  struct Comma
+    : public std::numpunct<char>
+  {
+    char
+    do_decimal_point() const override
+    {
+      return ',';
+    }
+  };
+}
+
+static
+void
+read_numbers_locale()
+{
+  auto const previous =
+    std::locale::global(std::locale(std::locale::classic(), new Comma));
+  elle::SafeFinally restore([&] { std::locale::global(previous); });
+  BOOST_CHECK_EQUAL(boost::any_cast<double>(elle::json::read("-0.25")), -0.25);
+  BOOST_CHECK_THROW(elle::json::read("0,25"), elle::Error);
+}
+
+static
+void
+read_errors()
+{
+  for (auto const& json: {
+      "", "{,}", "[,]", "[1 2]", "\"abc", "\"a\x01\"", "tru", "-", "1.",
+      "\"\\x\"", "\"\\ud800\"", "{1: 2}", "42 51",
+      "1e999"})
+    BOOST_CHECK_THROW(elle::json::read(std::string(json)), elle::Error);
+  BOOST_CHECK_THROW(elle::json::read(std::string(100000, '[')),
+                    elle::json::ParseError);
+}
+
+static
+void
+read_trailing_comma()
+{
+  auto object = boost::any_cast<elle::json::Object>(
+    elle::json::read("{\"pastis\": [51, ], }"));
+  BOOST_CHECK_EQUAL(
+    boost::any_cast<elle::json::Array>(object["pastis"]).size(), 1);
+}
+
+static
+void
+read_sequence()
+{
+  std::stringstream input("{\"pastis\": 51} [\"Ricard\"]");
+  auto object = boost::any_cast<elle::json::Object>(elle::json::read(input));
+  BOOST_CHECK_EQUAL(boost::any_cast<int64_t>(object["pastis"]), 51);
+  auto array = boost::any_cast<elle::json::Array>(elle::json::read(input));
+  BOOST_CHECK_EQUAL(array.size(), 1);
+  BOOST_CHECK_EQUAL(boost::any_cast<std::string>(array[0]), "Ricard");
+}
+
+static
+void
+read_throughput()
+{
+  auto json = std::string("[");
+  for (int i = 0; i < 20000; ++i)
+    json += elle::sprintf(
+      "%s{\"id\": %s, \"name\": \"user number %s\", \"score\": 3.25, "
+      "\"active\": true, \"tags\": [\"a\", \"b\"]}", i ? "," : "", i, i);
+  json += "]";
+  auto measure = [&] (std::string const& name, std::function<void ()> read)
+    {
+      auto const start = std::chrono::steady_clock::now();
+      read();
+      auto const duration = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start);
+      BOOST_TEST_MESSAGE(
+        elle::sprintf("%s: %.1f MB/s", name,
+                      json.size() / duration.count() / 1e6));
+    };
+  measure("string", [&] { elle::json::read(json); });
+  measure("stream", [&] {
+      std::stringstream input(json);
+      elle::json::read(input);
+    });
+}
+
 ELLE_TEST_SUITE()
 {
   auto timeout = 3;
@@ -159,4 +275,11 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(read_escaped_utf_8), 0, timeout);
   suite.add(BOOST_TEST_CASE(write_utf_8), 0, timeout);
   suite.add(BOOST_TEST_CASE(pretty_printer_utf_8), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_escapes), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_numbers), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_numbers_locale), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_errors), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_trailing_comma), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_sequence), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_throughput), 0, timeout);
 }
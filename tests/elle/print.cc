@@ -1,8 +1,13 @@
+#include <chrono>
 #include <ostream>
 
+#include <elle/log.hh>
 #include <elle/print.hh>
+#include <elle/printf.hh>
 #include <elle/test.hh>
 
+ELLE_LOG_COMPONENT("elle.print.test");
+
 static
 void
 empty()
@@ -149,6 +154,71 @@ namespace
 }
 
 
+namespace
+{
+  struct Nested
+  {
+    friend
+    std::ostream&
+    operator <<(std::ostream& o, Nested const&)
+    {
+      return o << elle::print("<{}>", 42);
+    }
+  };
+}
+
+static
+void
+cached()
+{
+  // The same address with different contents must not reuse the format.
+  char fmt[] = "{} {}";
+  BOOST_TEST(elle::print(fmt, 1, 2) == "1 2");
+  fmt[2] = '-';
+  BOOST_TEST(elle::print(fmt, 1, 2) == "1-2");
+  // Nested formatting must not clobber the outer buffer.
+  BOOST_TEST(elle::print("{}{}", Nested{}, 0) == "<42>0");
+  // Buffers are reset between calls.
+  BOOST_TEST(elle::print("%x", 255) == "ff");
+  BOOST_TEST(elle::print("%s", 255) == "255");
+}
+
+// Log formats per second: cached literals, and formats built at runtime,
+// hence parsed at every call like before caching, against Boost.Format.
+static
+void
+benchmark()
+{
+  auto const n = RUNNING_ON_VALGRIND ? 1000 : 100000;
+  auto const measure = [&] (std::string const& name, auto const& f)
+    {
+      auto const start = std::chrono::steady_clock::now();
+      for (int i = 0; i < n; ++i)
+        f(i);
+      auto const duration = std::chrono::duration_cast<
+        std::chrono::duration<double>>(std::chrono::steady_clock::now() - start);
+      BOOST_TEST_MESSAGE(elle::sprintf(
+        "%s: %.0f formats/s", name, n / duration.count()));
+    };
+  measure("elle::print, literal", [] (int i)
+          {
+            elle::print("{}: {} and {}", i, "string", 4.2);
+          });
+  auto const fmt = std::string("{}: {} and {}");
+  measure("elle::print, string", [&] (int i)
+          {
+            elle::print(fmt, i, "string", 4.2);
+          });
+  measure("elle::print, uncached", [] (int i)
+          {
+            elle::print(std::to_string(i) + ": {} and {}", "string", 4.2);
+          });
+  measure("elle::sprintf", [] (int i)
+          {
+            elle::sprintf("%s: %s and %s", i, "string", 4.2);
+          });
+}
+
 ELLE_TEST_SUITE()
 {
   auto& suite = boost::unit_test::framework::master_test_suite();
@@ -166,4 +236,6 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(conditional));
   suite.add(BOOST_TEST_CASE(conditional_positional));
   suite.add(BOOST_TEST_CASE(legacy));
+  suite.add(BOOST_TEST_CASE(cached));
+  suite.add(BOOST_TEST_CASE(benchmark), 0, valgrind(10));
 }
@@ -2,6 +2,8 @@
 
 ELLE_LOG_COMPONENT("elle.protocol.Channel.test");
 
+#include <chrono>
+
 #include <elle/compiler.hh>
 #include <elle/test.hh>
 
@@ -10,6 +12,7 @@ ELLE_LOG_COMPONENT("elle.protocol.Channel.test");
 #include <elle/reactor/network/Error.hh>
 #include <elle/reactor/network/TCPServer.hh>
 #include <elle/reactor/network/TCPSocket.hh>
+#include <elle/reactor/Scope.hh>
 
 template <typename Server, typename Client>
 void
@@ -80,6 +83,172 @@ ELLE_TEST_SCHEDULED(eof_read)
     });
 }
 
+// Run server and client on both ends of a TCP connection.
+template <typename Server, typename Client>
+void
+_connected(elle::Version const& version, Server server, Client client)
+{
+  auto s = elle::reactor::network::TCPServer{};
+  s.listen();
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+  {
+    scope.run_background("server", [&]
+    {
+      auto socket = s.accept();
+      auto&& ser = elle::protocol::Serializer(*socket, version);
+      auto&& channels = elle::protocol::ChanneledStream(ser);
+      server(channels);
+    });
+    auto socket = elle::reactor::network::TCPSocket(
+      elle::reactor::network::TCPSocket::EndPoint(
+        boost::asio::ip::address::from_string("127.0.0.1"), s.port()));
+    auto&& ser = elle::protocol::Serializer(socket, version);
+    auto&& channels = elle::protocol::ChanneledStream(ser);
+    client(channels);
+    elle::reactor::wait(scope);
+  };
+}
+
+ELLE_TEST_SCHEDULED(flow_control)
+{
+  auto const window = elle::protocol::ChanneledStream::window;
+  auto const packet = elle::Buffer(std::string(window / 4, 'x'));
+  auto const count = 12;
+  auto written = 0;
+  auto done = elle::reactor::Barrier{};
+  _connected(
+    elle::Version(0, 5, 0),
+    [&] (elle::protocol::ChanneledStream& channels)
+    {
+      auto c = elle::protocol::Channel(channels);
+      for (written = 0; written < count; ++written)
+        c.write(packet);
+      elle::reactor::wait(done);
+    },
+    [&] (elle::protocol::ChanneledStream& channels)
+    {
+      auto c = channels.accept();
+      // Without reading, the writer stops at the window.
+      elle::reactor::sleep(valgrind(200_ms, 10));
+      BOOST_TEST(written == 4);
+      for (int i = 0; i < count; ++i)
+        BOOST_TEST(c.read() == packet);
+      done.open();
+    });
+}
+
+ELLE_TEST_SCHEDULED(flow_control_close)
+{
+  auto const window = elle::protocol::ChanneledStream::window;
+  auto const packet = elle::Buffer(std::string(window / 4, 'x'));
+  auto const count = 12;
+  auto written = 0;
+  auto done = elle::reactor::Barrier{};
+  _connected(
+    elle::Version(0, 5, 0),
+    [&] (elle::protocol::ChanneledStream& channels)
+    {
+      auto c = elle::protocol::Channel(channels);
+      for (written = 0; written < count; ++written)
+        c.write(packet);
+      elle::reactor::wait(done);
+    },
+    [&] (elle::protocol::ChanneledStream& channels)
+    {
+      {
+        auto c = channels.accept();
+        elle::reactor::sleep(valgrind(200_ms, 10));
+        BOOST_TEST(written == 4);
+      }
+      // Closing with unread packets grants their credit back: the rest
+      // arrives, as a new channel since ours is gone.
+      auto c = channels.accept();
+      for (int i = 4; i < count; ++i)
+        BOOST_TEST(c.read() == packet);
+      BOOST_TEST(written == count);
+      done.open();
+    });
+}
+
+ELLE_TEST_SCHEDULED(legacy)
+{
+  // Before 0.5.0, the framing is unchanged and writes never wait.
+  auto const packet = elle::Buffer(std::string(1 << 20, 'x'));
+  auto const count = 12;
+  auto done = elle::reactor::Barrier{};
+  _connected(
+    elle::Version(0, 4, 0),
+    [&] (elle::protocol::ChanneledStream& channels)
+    {
+      auto c = elle::protocol::Channel(channels);
+      for (int i = 0; i < count; ++i)
+        c.write(packet);
+      done.open();
+    },
+    [&] (elle::protocol::ChanneledStream& channels)
+    {
+      auto c = channels.accept();
+      elle::reactor::wait(done);
+      for (int i = 0; i < count; ++i)
+        BOOST_TEST(c.read() == packet);
+    });
+}
+
+ELLE_TEST_SCHEDULED(bench)
+{
+  using Clock = std::chrono::steady_clock;
+  auto const channels_count = RUNNING_ON_VALGRIND ? 2 : 32;
+  auto const total = RUNNING_ON_VALGRIND ? (4 << 20) : (256 << 20);
+  for (std::size_t size = 1 << 10; size <= (16 << 20); size *= 16)
+  {
+    auto const packet = elle::Buffer(std::string(size, 'x'));
+    auto const per_channel =
+      std::max<std::size_t>(total / size / channels_count, 1);
+    auto start = Clock::now();
+    _connected(
+      elle::Version(0, 5, 0),
+      [&] (elle::protocol::ChanneledStream& channels)
+      {
+        elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& s)
+        {
+          for (int i = 0; i < channels_count; ++i)
+            s.run_background(elle::sprintf("writer %s", i), [&]
+            {
+              auto c = elle::protocol::Channel(channels);
+              for (std::size_t n = 0; n < per_channel; ++n)
+                c.write(packet);
+              // Wait for the reader to be done before closing.
+              c.read();
+            });
+          elle::reactor::wait(s);
+        };
+      },
+      [&] (elle::protocol::ChanneledStream& channels)
+      {
+        elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& s)
+        {
+          for (int i = 0; i < channels_count; ++i)
+          {
+            auto c = std::make_shared<elle::protocol::Channel>(
+              channels.accept());
+            s.run_background(elle::sprintf("reader %s", i), [&, c]
+            {
+              for (std::size_t n = 0; n < per_channel; ++n)
+                BOOST_TEST(c->read().size() == size);
+              c->write(elle::Buffer("done"));
+            });
+          }
+          elle::reactor::wait(s);
+        };
+      });
+    std::chrono::duration<double> d = Clock::now() - start;
+    BOOST_TEST_MESSAGE(elle::sprintf(
+      "%s channels, %s B messages: %s MB/s",
+      channels_count, size,
+      static_cast<int>(per_channel * channels_count * size / d.count() / 1e6)));
+  }
+}
+
 ELLE_TEST_SUITE()
 {
   auto& suite = boost::unit_test::framework::master_test_suite();
@@ -89,4 +258,8 @@ ELLE_TEST_SUITE()
     eof->add(ELLE_TEST_CASE(eof_accept, "accept"), 0, valgrind(2));
     eof->add(ELLE_TEST_CASE(eof_read, "read"), 0, valgrind(2));
   }
+  suite.add(BOOST_TEST_CASE(flow_control), 0, valgrind(5));
+  suite.add(BOOST_TEST_CASE(flow_control_close), 0, valgrind(5));
+  suite.add(BOOST_TEST_CASE(legacy), 0, valgrind(5));
+  suite.add(BOOST_TEST_CASE(bench), 0, valgrind(120));
 }
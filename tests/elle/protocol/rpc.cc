@@ -1,7 +1,10 @@
+#include <elle/protocol/Channel.hh>
 #include <elle/protocol/ChanneledStream.hh>
 #include <elle/protocol/RPC.hh>
 #include <elle/protocol/Serializer.hh>
 
+#include <elle/serialization/binary.hh>
+
 #include <elle/reactor/asio.hh>
 #include <elle/reactor/network/Error.hh>
 #include <elle/reactor/network/TCPServer.hh>
@@ -20,18 +23,64 @@ struct TestConfig
   bool sync;
   bool checksum;
   elle::Version version;
+  bool pipelined = false;
+  int concurrency = 64;
 };
 
 static
 elle::reactor::Thread* suicide_thread(nullptr);
 
+/// Stream archives over binary serialization, as RPC expects them.
+class Input
+{
+public:
+  Input(std::istream& input)
+    : _input(input, false)
+  {}
+
+  template <typename T>
+  Input&
+  operator >>(T& v)
+  {
+    v = this->_input.deserialize<T>();
+    return *this;
+  }
+
+  Input&
+  operator >>(char& c)
+  {
+    c = this->_input.deserialize<uint8_t>();
+    return *this;
+  }
+
+private:
+  elle::serialization::binary::SerializerIn _input;
+};
+
+class Output
+{
+public:
+  Output(std::ostream& output)
+    : _output(output, false)
+  {}
+
+  template <typename T>
+  Output&
+  operator <<(T const& v)
+  {
+    this->_output.serialize_forward(v);
+    return *this;
+  }
+
+private:
+  elle::serialization::binary::SerializerOut _output;
+};
+
 struct DummyRPC:
-  public elle::protocol::RPC<elle::serialize::InputBinaryArchive,
-                                elle::serialize::OutputBinaryArchive>
+  public elle::protocol::RPC<Input, Output>
 {
   DummyRPC(elle::protocol::ChanneledStream& channels)
-    : elle::protocol::RPC<elle::serialize::InputBinaryArchive,
-                             elle::serialize::OutputBinaryArchive>(channels)
+    : elle::protocol::RPC<Input, Output>(channels)
     , answer("answer", *this)
     , square("square", *this)
     , concat("concat", *this)
@@ -39,6 +88,7 @@ struct DummyRPC:
     , suicide("suicide", *this)
     , count("count", *this)
     , wait("wait", *this)
+    , stop("stop", *this)
   {}
 
   RemoteProcedure<int> answer;
@@ -48,6 +98,7 @@ struct DummyRPC:
   RemoteProcedure<void> suicide;
   RemoteProcedure<int> count;
   RemoteProcedure<void> wait;
+  RemoteProcedure<void> stop;
 };
 
 class RPCServer
@@ -82,10 +133,9 @@ public:
   void
   _run()
   {
-    auto& sched = *elle::reactor::Scheduler::scheduler();
     auto socket = this->_server.accept();
-    elle::protocol::Serializer s(sched, *socket, _config.version, _config.checksum);
-    elle::protocol::ChanneledStream channels(sched, s, _config.version);
+    elle::protocol::Serializer s(*socket, _config.version, _config.checksum);
+    elle::protocol::ChanneledStream channels(s);
 
     DummyRPC rpc(channels);
     rpc.answer = [] { return 42; };
@@ -97,12 +147,9 @@ public:
       {
         suicide_thread->terminate();
         suicide_thread = nullptr;
-        elle::reactor::yield();
-        elle::reactor::yield();
-        elle::reactor::yield();
-        elle::reactor::yield();
-        elle::reactor::yield();
-        elle::reactor::yield();
+        // Terminated with the server once the caller is gone. Procedures run
+        // in their own thread in parallel mode, so give it a few rounds.
+        elle::reactor::sleep(1_sec);
         BOOST_CHECK(false);
       };
     rpc.count =
@@ -113,9 +160,16 @@ public:
         return this->_counter;
       };
     rpc.wait = [this] { ++this->_counter; elle::reactor::sleep(); };
+    rpc.stop = []
+      {
+        throw elle::protocol::LastMessageException("stop requested");
+      };
+    rpc.pipeline_concurrency(this->_config.concurrency);
     try
     {
-      if (this->_config.sync)
+      if (this->_config.pipelined)
+        rpc.pipelined_run();
+      else if (this->_config.sync)
         rpc.run();
       else
         rpc.parallel_run();
@@ -140,7 +194,7 @@ ELLE_TEST_SCHEDULED(rpc, (TestConfig, config))
   RPCServer server(config);
   elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
   elle::protocol::Serializer s(socket, config.version, config.checksum);
-  elle::protocol::ChanneledStream channels(s, config.version);
+  elle::protocol::ChanneledStream channels(s);
   DummyRPC rpc(channels);
   BOOST_CHECK_EQUAL(rpc.answer(), 42);
   BOOST_CHECK_EQUAL(rpc.square(8), 64);
@@ -161,7 +215,7 @@ ELLE_TEST_SCHEDULED(terminate, (TestConfig, config))
     {
       elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
       elle::protocol::Serializer s(socket, config.version, config.checksum);
-      elle::protocol::ChanneledStream channels(s, config.version);
+      elle::protocol::ChanneledStream channels(s);
       DummyRPC rpc(channels);
       suicide_thread = &thread;
       BOOST_CHECK_THROW(rpc.suicide(), std::runtime_error);
@@ -178,7 +232,7 @@ ELLE_TEST_SCHEDULED(parallel, (TestConfig, config))
   RPCServer server(config);
   elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
   elle::protocol::Serializer s(socket, config.version, config.checksum);
-  elle::protocol::ChanneledStream channels(s, config.version);
+  elle::protocol::ChanneledStream channels(s);
   DummyRPC rpc(channels);
   std::vector<elle::reactor::Thread*> threads;
   std::list<int> inserted;
@@ -220,7 +274,7 @@ ELLE_TEST_SCHEDULED(disconnection, (TestConfig, config))
   RPCServer server(config);
   elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
   elle::protocol::Serializer s(socket, config.version, config.checksum);
-  elle::protocol::ChanneledStream channels(s, config.version);
+  elle::protocol::ChanneledStream channels(s);
   DummyRPC rpc(channels);
   elle::reactor::Thread call_1("call 1",
                          [&]
@@ -242,11 +296,198 @@ ELLE_TEST_SCHEDULED(disconnection, (TestConfig, config))
 }
 
 /*-----------.
-| Test suite |
+| Pipelining |
 `-----------*/
 
-#define ELLE_TEST_NAMED_CASE(func, name)\
-  ::boost::unit_test::make_test_case(func, name)
+ELLE_TEST_SCHEDULED(pipelined, (TestConfig, config))
+{
+  RPCServer server(config);
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, config.version, config.checksum);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  // Issued in the same round, thus sent in a single packet.
+  auto answer = rpc.answer.async();
+  auto square = rpc.square.async(8);
+  auto concat = rpc.concat.async("foo", "bar");
+  auto raise = rpc.raise.async();
+  BOOST_CHECK_EQUAL(concat.value(), "foobar");
+  BOOST_CHECK_EQUAL(square.value(), 64);
+  BOOST_CHECK_EQUAL(answer.value(), 42);
+  BOOST_CHECK_THROW(raise.value(), std::runtime_error);
+  BOOST_CHECK_EQUAL(rpc.square.async(3).value(), 9);
+}
+
+// A slow call does not hold back the replies to the calls after it.
+ELLE_TEST_SCHEDULED(out_of_order, (TestConfig, config))
+{
+  RPCServer server(config);
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, config.version, config.checksum);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  auto count = rpc.count.async();
+  BOOST_CHECK_EQUAL(rpc.answer.async().value(), 42);
+  BOOST_CHECK(!count.done());
+  server.count_barrier().open();
+  BOOST_CHECK_EQUAL(count.value(), 1);
+}
+
+ELLE_TEST_SCHEDULED(pipelined_disconnection, (TestConfig, config))
+{
+  RPCServer server(config);
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, config.version, config.checksum);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  auto call_1 = rpc.wait.async();
+  auto call_2 = rpc.wait.async();
+  do
+  {
+    elle::reactor::yield();
+  }
+  while (server.counter() < 2);
+  server.terminate();
+  BOOST_CHECK_THROW(call_1.value(), std::runtime_error);
+  BOOST_CHECK_THROW(call_2.value(), std::runtime_error);
+  BOOST_CHECK_THROW(rpc.answer.async().value(), std::runtime_error);
+}
+
+// A pipeline sending garbage is dropped, the others are still served.
+ELLE_TEST_SCHEDULED(pipelined_malformed, (TestConfig, config))
+{
+  RPCServer server(config);
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, config.version, config.checksum);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  BOOST_CHECK_EQUAL(rpc.answer.async().value(), 42);
+  elle::protocol::Channel garbage(channels);
+  garbage.write(elle::Buffer("\x01\x02"));
+  BOOST_CHECK_EQUAL(rpc.square.async(3).value(), 9);
+}
+
+// Synchronous calls to a pipelined server fail instead of hanging.
+ELLE_TEST_SCHEDULED(pipelined_sync, (TestConfig, config))
+{
+  RPCServer server(config);
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, config.version, config.checksum);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  BOOST_CHECK_THROW(rpc.answer(), elle::protocol::RPCError);
+  BOOST_CHECK_EQUAL(rpc.square.async(3).value(), 9);
+}
+
+// Calls still running when a call asks to stop are answered with an error.
+ELLE_TEST_SCHEDULED(pipelined_stop, (TestConfig, config))
+{
+  RPCServer server(config);
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, config.version, config.checksum);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  auto wait = rpc.wait.async();
+  do
+  {
+    elle::reactor::yield();
+  }
+  while (server.counter() < 1);
+  BOOST_CHECK_THROW(rpc.stop.async().value(), elle::protocol::RPCError);
+  try
+  {
+    wait.value();
+    BOOST_FAIL("pending call was not failed");
+  }
+  catch (elle::protocol::RPCError const& e)
+  {
+    BOOST_TEST(std::string(e.what()).find("RPC server stopped") !=
+               std::string::npos);
+  }
+}
+
+// No more than the configured number of calls run at once on a pipeline.
+ELLE_TEST_SCHEDULED(pipelined_concurrency, (TestConfig, config))
+{
+  config.concurrency = 2;
+  RPCServer server(config);
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, config.version, config.checksum);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  auto futures = std::vector<decltype(rpc.wait.async())>{};
+  for (int i = 0; i < 4; ++i)
+    futures.push_back(rpc.wait.async());
+  do
+  {
+    elle::reactor::yield();
+  }
+  while (server.counter() < 2);
+  for (int i = 0; i < 20; ++i)
+    elle::reactor::yield();
+  BOOST_CHECK_EQUAL(server.counter(), 2);
+  server.terminate();
+  for (auto& f: futures)
+    BOOST_CHECK_THROW(f.value(), std::runtime_error);
+}
+
+// Not a pass/fail check: log the call rate and latency of one call per
+// channel against pipelined calls.
+ELLE_TEST_SCHEDULED(pipelined_bench, (TestConfig, config))
+{
+  using Clock = std::chrono::steady_clock;
+  auto const calls = RUNNING_ON_VALGRIND ? 100 : 10000;
+  auto const report = [&] (std::string const& name,
+                           Clock::time_point start,
+                           double latency)
+    {
+      std::chrono::duration<double> d = Clock::now() - start;
+      BOOST_TEST_MESSAGE(elle::sprintf(
+        "%s: %s calls/s, mean latency %.0fus",
+        name, static_cast<int>(calls / d.count()), latency));
+    };
+  {
+    auto sequential = config;
+    sequential.pipelined = false;
+    sequential.sync = false;
+    RPCServer server(sequential);
+    elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+    elle::protocol::Serializer s(socket, config.version, config.checksum);
+    elle::protocol::ChanneledStream channels(s);
+    DummyRPC rpc(channels);
+    auto const start = Clock::now();
+    for (int i = 0; i < calls; ++i)
+      BOOST_CHECK_EQUAL(rpc.square(i % 1000), (i % 1000) * (i % 1000));
+    std::chrono::duration<double, std::micro> d = Clock::now() - start;
+    report("channel per call", start, d.count() / calls);
+  }
+  {
+    RPCServer server(config);
+    elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+    elle::protocol::Serializer s(socket, config.version, config.checksum);
+    elle::protocol::ChanneledStream channels(s);
+    DummyRPC rpc(channels);
+    auto const start = Clock::now();
+    auto sent = std::vector<Clock::time_point>{};
+    auto futures = std::vector<decltype(rpc.square.async(0))>{};
+    for (int i = 0; i < calls; ++i)
+    {
+      sent.push_back(Clock::now());
+      futures.push_back(rpc.square.async(i % 1000));
+    }
+    auto latency = std::chrono::duration<double, std::micro>{0};
+    for (int i = 0; i < calls; ++i)
+    {
+      BOOST_CHECK_EQUAL(futures[i].value(), (i % 1000) * (i % 1000));
+      latency += futures[i].arrived_at() - sent[i];
+    }
+    report("pipelined", start, latency.count() / calls);
+  }
+}
+
+/*-----------.
+| Test suite |
+`-----------*/
 
 ELLE_TEST_SUITE()
 {
@@ -261,14 +502,51 @@ ELLE_TEST_SUITE()
     {false, false, elle::Version(0, 1, 0)},
     {false, false, elle::Version(0, 2, 0)},
   };
-  auto test = [&](std::string const& name, std::function<void(TestConfig)> f)
+  auto const name = [] (TestConfig const& config)
+    {
+      return elle::sprintf("%s_%s_%s",
+                           config.sync ? "sync" : "parallel",
+                           config.checksum ? "checksum" : "plain",
+                           config.version);
+    };
+  auto test = [&](std::string const& name_,
+                  std::function<void(TestConfig)> f)
   {
-    for (int i=0; i<8; ++i)
-      suite.add(
-        BOOST_TEST_CASE(std::bind(f, configs[i])), 0, valgrind(1, 10));
+    auto sub = BOOST_TEST_SUITE(name_);
+    suite.add(sub);
+    for (auto const& config: configs)
+      sub->add(ELLE_TEST_CASE(std::bind(f, config), name(config)),
+               0, valgrind(1, 10));
   };
   test("rpc", &rpc);
   test("terminate", &terminate);
   test("parallel", &parallel);
   test("disconnection", &disconnection);
+  {
+    auto sub = BOOST_TEST_SUITE("pipelined");
+    suite.add(sub);
+    for (auto checksum: {true, false})
+    {
+      auto const config =
+        TestConfig{false, checksum, elle::Version(0, 5, 0), true};
+      auto const suffix = checksum ? "_checksum" : "_plain";
+      auto add = [&] (std::function<void(TestConfig)> f, std::string n)
+        {
+          sub->add(ELLE_TEST_CASE(std::bind(f, config), n + suffix),
+                   0, valgrind(1, 10));
+        };
+      add(&pipelined, "calls");
+      add(&out_of_order, "out_of_order");
+      add(&pipelined_disconnection, "disconnection");
+      add(&pipelined_malformed, "malformed");
+      add(&pipelined_sync, "sync");
+      add(&pipelined_stop, "stop");
+      add(&pipelined_concurrency, "concurrency");
+    }
+  }
+  suite.add(ELLE_TEST_CASE(std::bind(
+              pipelined_bench,
+              TestConfig{false, true, elle::Version(0, 5, 0), true}),
+                           "pipelined_bench"),
+            0, valgrind(60, 10));
 }
@@ -6,8 +6,10 @@
 #include <elle/cast.hh>
 #include <elle/test.hh>
 
+#include <elle/cryptography/hash.hh>
 #include <elle/cryptography/random.hh>
 
+#include <elle/protocol/CRC32C.hh>
 #include <elle/protocol/Channel.hh>
 #include <elle/protocol/ChanneledStream.hh>
 #include <elle/protocol/exceptions.hh>
@@ -403,7 +405,9 @@ dialog(elle::Version const& version,
 
 #define CASES(function)                                                 \
   for (auto const& version: {elle::Version{0, 1, 0},                    \
-                             elle::Version{0, 2, 0}})                   \
+                             elle::Version{0, 2, 0},                    \
+                             elle::Version{0, 4, 0},                    \
+                             elle::Version{0, 6, 0}})                   \
     for (auto checksum: {true, false})                                  \
       ELLE_LOG("case: version = %s, checksum = %s", version, checksum)  \
         function(version, checksum)                                     \
@@ -1086,6 +1090,294 @@ ELLE_TEST_SCHEDULED(read_interruption, (elle::Version, version))
   elle::reactor::wait(elle::reactor::Waitables({&writer, &reader}));
 }
 
+/*-------------.
+| Interleaving |
+`-------------*/
+
+// Connect two serializers in memory and run @a alice and @a bob on them.
+static
+void
+_interleaved(elle::Version const& version,
+             bool checksum,
+             elle::Buffer::Size chunk_size,
+             std::function<void (elle::protocol::Serializer&,
+                                 Connector&)> const& alice,
+             std::function<void (elle::protocol::Serializer&)> const& bob)
+{
+  Connector sockets;
+  std::unique_ptr<elle::protocol::Serializer> a;
+  std::unique_ptr<elle::protocol::Serializer> b;
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+  {
+    scope.run_background(
+      "alice",
+      [&]
+      {
+        a.reset(new elle::protocol::Serializer(
+                  sockets.alice(), version, checksum, {}, {}, chunk_size));
+      });
+    scope.run_background(
+      "bob",
+      [&]
+      {
+        b.reset(new elle::protocol::Serializer(
+                  sockets.bob(), version, checksum, {}, {}, chunk_size));
+      });
+    scope.wait();
+  };
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+  {
+    scope.run_background("alice", [&] { alice(*a, sockets); });
+    scope.run_background("bob", [&] { bob(*b); });
+    scope.wait();
+  };
+}
+
+// A small packet written while a large one is being sent overtakes it.
+ELLE_TEST_SCHEDULED(interleaving)
+{
+  auto const chunk_size = 1024;
+  auto const large =
+    elle::cryptography::random::generate<elle::Buffer>(64 * chunk_size);
+  auto const small = elle::Buffer("small");
+  for (auto checksum: {true, false})
+    _interleaved(
+      elle::Version(0, 6, 0), checksum, chunk_size,
+      [&] (elle::protocol::Serializer& s, Connector& sockets)
+      {
+        elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+        {
+          scope.run_background("large", [&] { s.write(large); });
+          scope.run_background(
+            "small",
+            [&]
+            {
+              while (sockets.alice().bytes_written() < large.size() / 8)
+                elle::reactor::yield();
+              s.write(small);
+            });
+          scope.wait();
+        };
+      },
+      [&] (elle::protocol::Serializer& s)
+      {
+        BOOST_TEST(s.read() == small);
+        BOOST_TEST(s.read() == large);
+      });
+}
+
+// Interrupting a packet does not disturb the one interleaved with it.
+ELLE_TEST_SCHEDULED(interleaving_interruption)
+{
+  auto const chunk_size = 1024;
+  auto const interrupted =
+    elle::cryptography::random::generate<elle::Buffer>(64 * chunk_size);
+  auto const concurrent =
+    elle::cryptography::random::generate<elle::Buffer>(32 * chunk_size);
+  auto const next = elle::Buffer("next");
+  for (auto checksum: {true, false})
+    _interleaved(
+      elle::Version(0, 6, 0), checksum, chunk_size,
+      [&] (elle::protocol::Serializer& s, Connector& sockets)
+      {
+        elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+        {
+          auto& victim = scope.run_background(
+            "interrupted",
+            [&]
+            {
+              s.write(interrupted);
+              BOOST_FAIL("should have been interrupted");
+            });
+          scope.run_background("concurrent", [&] { s.write(concurrent); });
+          while (sockets.alice().bytes_written() < concurrent.size() / 2)
+            elle::reactor::yield();
+          victim.terminate_now();
+          scope.wait();
+        };
+        s.write(next);
+      },
+      [&] (elle::protocol::Serializer& s)
+      {
+        BOOST_TEST(s.read() == concurrent);
+        BOOST_TEST(s.read() == next);
+      });
+}
+
+// Not a pass/fail check: log the latency of small packets sent alongside a
+// bulk transfer, with and without interleaving.
+ELLE_TEST_SCHEDULED(mixed_load_latency)
+{
+  using Clock = std::chrono::steady_clock;
+  auto const bulk = elle::Buffer(
+    std::string(RUNNING_ON_VALGRIND ? (1 << 20) : (16 << 20), 'x'));
+  auto const bulk_count = RUNNING_ON_VALGRIND ? 2 : 16;
+  auto const small_count = RUNNING_ON_VALGRIND ? 20 : 1000;
+  for (auto const& version: {elle::Version(0, 5, 0), elle::Version(0, 6, 0)})
+  {
+    auto sent = std::vector<Clock::time_point>(small_count);
+    auto latencies = std::vector<double>{};
+    auto server = elle::reactor::network::TCPServer{};
+    server.listen();
+    elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+    {
+      scope.run_background(
+        "receiver",
+        [&]
+        {
+          auto socket = server.accept();
+          elle::protocol::Serializer s(*socket, version, true);
+          for (int i = 0; i < bulk_count + small_count; ++i)
+          {
+            auto const packet = s.read();
+            if (packet.size() == bulk.size())
+              continue;
+            auto const n = std::stoi(packet.string());
+            latencies.push_back(
+              std::chrono::duration<double, std::micro>(
+                Clock::now() - sent[n]).count());
+          }
+        });
+      scope.run_background(
+        "sender",
+        [&]
+        {
+          elle::reactor::network::TCPSocket socket(
+            "127.0.0.1", server.port());
+          elle::protocol::Serializer s(socket, version, true);
+          elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& s2)
+          {
+            s2.run_background(
+              "bulk",
+              [&]
+              {
+                for (int i = 0; i < bulk_count; ++i)
+                  s.write(bulk);
+              });
+            s2.run_background(
+              "small",
+              [&]
+              {
+                for (int i = 0; i < small_count; ++i)
+                {
+                  sent[i] = Clock::now();
+                  s.write(elle::Buffer(std::to_string(i)));
+                  elle::reactor::sleep(1_ms);
+                }
+              });
+            s2.wait();
+          };
+        });
+      scope.wait();
+    };
+    std::sort(latencies.begin(), latencies.end());
+    auto const percentile = [&] (double p)
+      {
+        return latencies[
+          std::min<std::size_t>(latencies.size() * p, latencies.size() - 1)];
+      };
+    BOOST_TEST_MESSAGE(elle::sprintf(
+      "version %s: small packet latency p50 = %.0fus, p99 = %.0fus",
+      version, percentile(0.5), percentile(0.99)));
+  }
+}
+
+/*---------.
+| Checksum |
+`---------*/
+
+ELLE_TEST_SCHEDULED(crc32c)
+{
+  using elle::protocol::crc32c;
+  BOOST_TEST(crc32c(elle::ConstWeakBuffer("")) == 0u);
+  BOOST_TEST(crc32c(elle::ConstWeakBuffer("123456789")) == 0xe3069283);
+  BOOST_TEST(crc32c(std::string(32, '\0')) == 0x8a9136aa);
+  BOOST_TEST(crc32c(std::string(32, '\xff')) == 0x62a8ab43);
+  // Incremental updates match a one-shot computation whatever the split,
+  // including unaligned ones.
+  auto const data = elle::cryptography::random::generate<elle::Buffer>(1031);
+  auto const expected = crc32c(data);
+  for (auto split: {0, 1, 7, 8, 9, 512, 1030, 1031})
+  {
+    auto crc = elle::protocol::CRC32C{};
+    crc.update(elle::ConstWeakBuffer(data.contents(), split));
+    crc.update(elle::ConstWeakBuffer(data.contents() + split,
+                                     data.size() - split));
+    BOOST_TEST(crc.value() == expected);
+  }
+  ELLE_LOG("hardware implementation: %s", elle::protocol::CRC32C::hardware());
+}
+
+// Peers agree on the oldest version, and thus on the checksum algorithm.
+ELLE_TEST_SCHEDULED(checksum_negotiation)
+{
+  auto const data = elle::cryptography::random::generate<elle::Buffer>(4096);
+  for (auto const& versions:
+         {std::make_pair(elle::Version(0, 3, 0), elle::Version(0, 4, 0)),
+          std::make_pair(elle::Version(0, 4, 0), elle::Version(0, 3, 0)),
+          std::make_pair(elle::Version(0, 4, 0), elle::Version(0, 4, 0))})
+  {
+    auto const expected = std::min(versions.first, versions.second);
+    Connector sockets;
+    std::unique_ptr<elle::protocol::Serializer> alice;
+    std::unique_ptr<elle::protocol::Serializer> bob;
+    elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+    {
+      scope.run_background(
+        "alice",
+        [&]
+        {
+          alice.reset(new elle::protocol::Serializer(
+                        sockets.alice(), versions.first, true));
+          BOOST_TEST(alice->version() == expected);
+          alice->write(data);
+          BOOST_TEST(alice->read() == data);
+        });
+      scope.run_background(
+        "bob",
+        [&]
+        {
+          bob.reset(new elle::protocol::Serializer(
+                      sockets.bob(), versions.second, true));
+          BOOST_TEST(bob->version() == expected);
+          auto packet = bob->read();
+          BOOST_TEST(packet == data);
+          bob->write(packet);
+        });
+      scope.wait();
+    };
+  }
+}
+
+// Not a pass/fail check: log how the legacy and current checksums compare.
+ELLE_TEST_SCHEDULED(checksum_throughput)
+{
+  auto const data = elle::Buffer(std::string(16 << 20, 'x'));
+  auto const throughput = [&] (std::string const& name, auto const& f)
+    {
+      auto const start = std::chrono::steady_clock::now();
+      f();
+      auto const duration = std::chrono::duration_cast<
+        std::chrono::duration<double>>(std::chrono::steady_clock::now() - start);
+      BOOST_TEST_MESSAGE(elle::sprintf(
+        "%s: %.0f MiB/s", name,
+        data.size() / (1024. * 1024.) / duration.count()));
+    };
+  throughput("SHA-1", [&]
+             {
+               elle::cryptography::hash(data,
+                                        elle::cryptography::Oneway::sha1);
+             });
+  throughput("CRC-32C", [&]
+             {
+               auto crc = elle::protocol::CRC32C{};
+               for (auto offset = 0u; offset < data.size(); offset += 2 << 16)
+                 crc.update(elle::ConstWeakBuffer(data.contents() + offset,
+                                                  2 << 16));
+               BOOST_TEST(crc.value() == elle::protocol::crc32c(data));
+             });
+}
+
 ELLE_TEST_SUITE()
 {
   auto& suite = boost::unit_test::framework::master_test_suite();
@@ -1101,11 +1393,19 @@ ELLE_TEST_SUITE()
     suite.add(sub);
     for (auto const& version: {elle::Version(0, 1, 0),
                                elle::Version(0, 2, 0),
-                               elle::Version(0, 3, 0)})
+                               elle::Version(0, 3, 0),
+                               elle::Version(0, 4, 0),
+                               elle::Version(0, 6, 0)})
       sub->add(ELLE_TEST_CASE(std::bind(read_interruption, version),
                               elle::sprintf("%s", version)), 0, valgrind(1));
   }
   suite.add(BOOST_TEST_CASE(eof), 0, valgrind(3));
   suite.add(BOOST_TEST_CASE(message), 0, valgrind(3));
   suite.add(BOOST_TEST_CASE(ping), 0, valgrind(3));
+  suite.add(BOOST_TEST_CASE(interleaving), 0, valgrind(3));
+  suite.add(BOOST_TEST_CASE(interleaving_interruption), 0, valgrind(3));
+  suite.add(BOOST_TEST_CASE(mixed_load_latency), 0, valgrind(60));
+  suite.add(BOOST_TEST_CASE(crc32c), 0, valgrind(1));
+  suite.add(BOOST_TEST_CASE(checksum_negotiation), 0, valgrind(3));
+  suite.add(BOOST_TEST_CASE(checksum_throughput), 0, valgrind(10));
 }
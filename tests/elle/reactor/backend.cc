@@ -6,6 +6,8 @@
 # include <elle/reactor/backend/boost/backend.hh>
 #endif
 
+#include <elle/reactor/backend/StackPool.hh>
+
 #include <boost/range/algorithm/for_each.hpp>
 
 using elle::reactor::backend::Thread;
@@ -125,6 +127,64 @@ namespace
     val *= 10;
     t->step();
   }
+
+  /// Check finished coroutines give their stack back for reuse.
+  template <typename Backend>
+  void
+  test_stack_pool()
+  {
+    auto&& m = Backend{64 * 1024};
+    auto const& pool = *m.stacks();
+    BOOST_TEST(pool.stack_size() >= 64u * 1024u);
+    auto const before = pool.statistics();
+    {
+      auto t1 = m.make_thread("one", [&m] { m.current()->yield(); });
+      auto t2 = m.make_thread("two", [&m] { m.current()->yield(); });
+      t1->step();
+      t2->step();
+      t1->step();
+      t2->step();
+    }
+    auto const after_first = pool.statistics();
+    BOOST_TEST(after_first.used == before.used);
+    BOOST_TEST(after_first.peak >= before.used + 2);
+    {
+      auto t = m.make_thread("three", empty);
+      t->step();
+      BOOST_CHECK(t->status() == Thread::Status::done);
+    }
+    auto const after_second = pool.statistics();
+    BOOST_TEST(after_second.hits == after_first.hits + 1);
+    BOOST_TEST(after_second.misses == after_first.misses);
+  }
+
+  /// Check stacks share mappings unless guarded.
+  void
+  test_stack_slabs()
+  {
+    using elle::reactor::backend::StackPool;
+    auto const count = StackPool::slab_stacks + 1;
+    for (auto guard: {false, true})
+    {
+      StackPool pool(64 * 1024, 0, guard);
+      auto stacks = std::vector<StackPool::Stack>{};
+      for (auto i = 0u; i < count; ++i)
+      {
+        stacks.emplace_back(pool.allocate());
+        // Touch both ends.
+        static_cast<char*>(stacks.back().base)[0] = 1;
+        static_cast<char*>(stacks.back().top())[-1] = 1;
+      }
+      BOOST_TEST(pool.statistics().mappings == (guard ? count : 2u));
+      for (auto const& stack: stacks)
+        pool.deallocate(stack);
+      BOOST_TEST(pool.statistics().mappings == (guard ? 0u : 2u));
+      // Released slab stacks are reused, without mapping anything.
+      auto const stack = pool.allocate();
+      BOOST_TEST(pool.statistics().mappings == (guard ? 1u : 2u));
+      pool.deallocate(stack);
+    }
+  }
 }
 
 ELLE_TEST_SUITE()
@@ -146,4 +206,6 @@ ELLE_TEST_SUITE()
   TEST(deadlock_switch);
   TEST(status);
   TEST(stack);
+  TEST(stack_pool);
+  backend->add(BOOST_TEST_CASE(test_stack_slabs), 0, 10);
 }
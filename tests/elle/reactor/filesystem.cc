@@ -3,6 +3,9 @@
 #include <sys/types.h>
 #include <fcntl.h>
 
+#include <atomic>
+#include <random>
+
 #include <boost/filesystem/fstream.hpp>
 
 #include <elle/reactor/filesystem.hh>
@@ -389,10 +392,159 @@ test_xor()
   ELLE_TRACE("finished");
 }
 
+/// fio-like throughput of a bind mount served by the multi-threaded
+/// dispatcher: 4 KiB blocks, sequential then random, from several jobs.
+static
+void
+bench_dispatch()
+{
+  auto tmpmount = fs::temp_directory_path() / fs::unique_path();
+  auto tmpsource = fs::temp_directory_path() / fs::unique_path();
+  elle::SafeFinally remover([&] {
+      boost::system::error_code erc;
+      fs::remove_all(tmpmount, erc);
+      fs::remove_all(tmpsource, erc);
+  });
+  elle::os::setenv("INFINIT_FUSE_THREAD", "4");
+  elle::SafeFinally unset([] { elle::os::unsetenv("INFINIT_FUSE_THREAD"); });
+  elle::reactor::filesystem::FileSystem fs(
+    std::make_unique<elle::reactor::filesystem::BindOperations>(tmpsource),
+    false);
+  fs::create_directories(tmpmount);
+  fs::create_directories(tmpsource);
+  elle::reactor::Barrier* barrier;
+  elle::reactor::Scheduler* sched;
+  std::thread t([&] { run_filesystem(fs, tmpmount, &barrier, sched);});
+  if (sandbox)
+  {
+    t.join();
+    return;
+  }
+  auto const file = (tmpmount / "bench").string();
+  for (int i = 0; i < 10 && !fs::exists(tmpsource / "bench"); ++i)
+  {
+    ::usleep(200000);
+    ::close(::open(file.c_str(), O_WRONLY | O_CREAT, 0644));
+  }
+  BOOST_REQUIRE(fs::exists(tmpsource / "bench"));
+  int const block = 4096;
+  int const jobs = 4;
+  off_t const size = (RUNNING_ON_VALGRIND ? 1 : 64) * 1024 * 1024;
+  off_t const blocks = size / block / jobs;
+  std::atomic<int> failures(0);
+  auto run = [&] (std::string const& name, bool write, bool random)
+    {
+      auto const start = std::chrono::steady_clock::now();
+      std::vector<std::thread> threads;
+      for (int j = 0; j < jobs; ++j)
+        threads.emplace_back(
+          [&, j]
+          {
+            int fd = ::open(file.c_str(), write ? O_WRONLY : O_RDONLY);
+            if (fd < 0)
+            {
+              ++failures;
+              return;
+            }
+            std::minstd_rand gen(j);
+            char buffer[block] = {};
+            for (off_t i = 0; i < blocks; ++i)
+            {
+              auto const offset =
+                (random ? gen() % (blocks * jobs) : j * blocks + i) * block;
+              auto const res = write
+                ? ::pwrite(fd, buffer, block, offset)
+                : ::pread(fd, buffer, block, offset);
+              if (res != block)
+                ++failures;
+            }
+            ::close(fd);
+          });
+      for (auto& thread: threads)
+        thread.join();
+      auto const seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+      BOOST_TEST_MESSAGE(elle::sprintf(
+        "%s: %.0f IOPS, %.1f MB/s",
+        name,
+        blocks * jobs / seconds,
+        size / seconds / 1e6));
+    };
+  run("sequential write", true, false);
+  run("sequential read", false, false);
+  run("random write", true, true);
+  run("random read", false, true);
+  BOOST_CHECK_EQUAL(failures, 0);
+  BOOST_CHECK_EQUAL(fs::file_size(tmpsource / "bench"), size);
+  sched->mt_run<void>("stop", [&] {fs.unmount();});
+  sched->mt_run<void>("stop", [&] {barrier->open();});
+  t.join();
+}
+
+static
+void
+path_cache()
+{
+  using elle::reactor::filesystem::PathCache;
+  using elle::reactor::filesystem::Error;
+  auto const a = std::make_shared<sum::Path>(1);
+  auto const b = std::make_shared<sum::Path>(2);
+  PathCache cache(1024 * 1024, boost::posix_time::milliseconds(100));
+  BOOST_CHECK(!cache.get("/a"));
+  cache.set("/a", a);
+  cache.set("/a/b", b);
+  BOOST_CHECK_EQUAL(cache.get("/a"), a);
+  BOOST_CHECK_EQUAL(cache.get("/a//b/"), b);
+  BOOST_CHECK_EQUAL(cache.statistics().hits, 2);
+  BOOST_CHECK_EQUAL(cache.statistics().misses, 1);
+  BOOST_CHECK_EQUAL(cache.statistics().entries, 2);
+  // Extracting keeps children.
+  BOOST_CHECK_EQUAL(cache.extract("/a"), a);
+  BOOST_CHECK(!cache.get("/a"));
+  BOOST_CHECK_EQUAL(cache.get("/a/b"), b);
+  // Missing entries hide their children, until they expire.
+  cache.missing("/a");
+  BOOST_CHECK_EQUAL(cache.statistics().entries, 1);
+  try
+  {
+    cache.get("/a/b/c");
+    BOOST_FAIL("missing path was found");
+  }
+  catch (Error const& e)
+  {
+    BOOST_CHECK_EQUAL(e.error_code(), ENOENT);
+  }
+  BOOST_CHECK_EQUAL(cache.statistics().negative_hits, 1);
+  ::usleep(150000);
+  BOOST_CHECK(!cache.get("/a"));
+  BOOST_CHECK_EQUAL(cache.statistics().expirations, 1);
+  BOOST_CHECK_EQUAL(cache.statistics().entries, 0);
+  cache.missing("/c");
+  cache.forget_missing("/c");
+  BOOST_CHECK(!cache.get("/c"));
+  // Least recently used leaves go first, and parents only after their
+  // children.
+  cache.set("/d", a);
+  cache.set("/d/e", a);
+  cache.set("/f", b);
+  cache.get("/d/e");
+  auto const bytes = cache.statistics().bytes;
+  cache.set("/g", b);
+  cache.size(bytes);
+  BOOST_CHECK_EQUAL(cache.statistics().evictions, 1);
+  BOOST_CHECK(!cache.get("/f"));
+  BOOST_CHECK_EQUAL(cache.get("/d/e"), a);
+  cache.size(0);
+  BOOST_CHECK_EQUAL(cache.statistics().entries, 0);
+  BOOST_CHECK_EQUAL(cache.statistics().bytes, 0);
+}
+
 ELLE_TEST_SUITE()
 {
   boost::unit_test::test_suite* filesystem = BOOST_TEST_SUITE("filesystem");
   boost::unit_test::framework::master_test_suite().add(filesystem);
+  filesystem->add(BOOST_TEST_CASE(path_cache), 0, 5);
   filesystem->add(BOOST_TEST_CASE(test_sum), 0, sandbox ? 0 : 20);
   filesystem->add(BOOST_TEST_CASE(test_xor), 0, sandbox ? 0 : 20);
+  filesystem->add(BOOST_TEST_CASE(bench_dispatch), 0, sandbox ? 0 : 120);
 }
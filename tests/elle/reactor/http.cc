@@ -1,11 +1,14 @@
 #include <utility>
 
+#include <sys/resource.h>
+
 #include <boost/algorithm/string.hpp>
 #include <elle/reactor/asio.hh>
 #include <boost/test/unit_test.hpp>
 
 #include <elle/Buffer.hh>
 #include <elle/With.hh>
+#include <elle/finally.hh>
 #include <elle/test.hh>
 #include <elle/utility/Move.hh>
 
@@ -17,6 +20,7 @@
 #include <elle/reactor/http/exceptions.hh>
 #include <elle/reactor/network/Error.hh>
 #include <elle/reactor/network/TCPServer.hh>
+#include <elle/reactor/network/TCPSocket.hh>
 #include <elle/reactor/scheduler.hh>
 #include <elle/reactor/semaphore.hh>
 #include <elle/reactor/signal.hh>
@@ -785,6 +789,343 @@ ELLE_TEST_SCHEDULED(redirection)
   BOOST_CHECK_EQUAL(r.headers().at("Location"), "http://example.org/other");
 }
 
+// HTTPServer closes connections after each answer, serve small answers
+// with keep-alive instead.
+ELLE_TEST_SCHEDULED(client_benchmark)
+{
+  auto const count = RUNNING_ON_VALGRIND ? 100 : 2000;
+  auto const parallel = 8;
+  elle::reactor::network::TCPServer server;
+  server.listen();
+  auto connections = 0;
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+  {
+    scope.run_background(
+      "server",
+      [&]
+      {
+        while (true)
+        {
+          auto socket = elle::utility::move_on_copy(server.accept());
+          ++connections;
+          scope.run_background(
+            elle::sprintf("serve %s", **socket),
+            [socket]
+            {
+              try
+              {
+                while (true)
+                {
+                  while ((*socket)->read_until("\r\n").string() != "\r\n")
+                    ;
+                  (*socket)->write(elle::ConstWeakBuffer(
+                    "HTTP/1.1 200 OK\r\n"
+                    "Content-Length: 2\r\n"
+                    "\r\n"
+                    "ok"));
+                }
+              }
+              catch (elle::reactor::network::ConnectionClosed const&)
+              {}
+            });
+        }
+      });
+    auto const url = elle::sprintf("http://127.0.0.1:%s/small", server.port());
+    elle::reactor::http::Client client;
+    auto report = [&] (std::string const& what, auto start)
+      {
+        auto const elapsed =
+          boost::posix_time::microsec_clock::universal_time() - start;
+        auto const stats = client.statistics();
+        ELLE_LOG("%s: %s GETs in %s (%s/s), %s connections, %s reused",
+                 what, stats.requests, elapsed,
+                 stats.requests * 1000000 / elapsed.total_microseconds(),
+                 stats.connections, stats.reused);
+      };
+    auto start = boost::posix_time::microsec_clock::universal_time();
+    for (int i = 0; i < count; ++i)
+      BOOST_CHECK_EQUAL(client.get(url), "ok");
+    report("sequential", start);
+    BOOST_CHECK_EQUAL(connections, 1);
+    BOOST_CHECK_EQUAL(client.statistics().reused, count - 1);
+    client.max_host_connections(4);
+    start = boost::posix_time::microsec_clock::universal_time();
+    elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& s)
+    {
+      for (int t = 0; t < parallel; ++t)
+        s.run_background(
+          elle::sprintf("client %s", t),
+          [&]
+          {
+            for (int i = 0; i < count / parallel; ++i)
+              BOOST_CHECK_EQUAL(client.get(url), "ok");
+          });
+      elle::reactor::wait(s);
+    };
+    report("parallel", start);
+    auto const stats = client.statistics();
+    BOOST_CHECK_EQUAL(stats.requests, 2 * count);
+    BOOST_CHECK_EQUAL(stats.connections + stats.reused, stats.requests);
+    BOOST_CHECK_EQUAL(stats.connections, connections);
+    BOOST_CHECK_LE(connections, 4);
+    scope.terminate_now();
+  };
+}
+
+namespace
+{
+  /// Read one response with a Content-Length from a raw socket.
+  std::string
+  read_response(elle::reactor::network::Socket& socket)
+  {
+    auto const head = socket.read_until("\r\n\r\n").string();
+    auto const marker = std::string("Content-Length: ");
+    auto const pos = head.find(marker);
+    BOOST_REQUIRE(pos != std::string::npos);
+    auto const length = std::stoul(head.substr(pos + marker.size()));
+    BOOST_CHECK_EQUAL(head.find("Connection: close") == std::string::npos,
+                      head.find("Connection: keep-alive") != std::string::npos);
+    return socket.read(length).string();
+  }
+}
+
+ELLE_TEST_SCHEDULED(server_pipelining)
+{
+  HTTPServer server;
+  server.register_route(
+    "/echo", elle::reactor::http::Method::POST,
+    [&] (HTTPServer::Headers const&,
+         HTTPServer::Cookies const&,
+         HTTPServer::Parameters const& params,
+         elle::Buffer const& body) -> std::string
+    {
+      return params.at("n") + ":" + body.string();
+    });
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  // Three pipelined requests in a single write, the last one chunked.
+  socket.write(elle::ConstWeakBuffer(
+    "POST /echo?n=0 HTTP/1.1\r\n"
+    "Content-Length: 3\r\n"
+    "\r\n"
+    "foo"
+    "POST /echo?n=1 HTTP/1.1\r\n"
+    "Content-Length: 0\r\n"
+    "\r\n"
+    "POST /echo?n=2 HTTP/1.1\r\n"
+    "Transfer-Encoding: chunked\r\n"
+    "\r\n"
+    "2\r\nba\r\n"
+    "1\r\nr\r\n"
+    "0\r\n"
+    "\r\n"));
+  BOOST_CHECK_EQUAL(read_response(socket), "0:foo");
+  BOOST_CHECK_EQUAL(read_response(socket), "1:");
+  BOOST_CHECK_EQUAL(read_response(socket), "2:bar");
+  // Split the next request across writes.
+  socket.write(elle::ConstWeakBuffer("GET /nowhere HTT"));
+  elle::reactor::sleep(10_ms);
+  socket.write(elle::ConstWeakBuffer("P/1.1\r\n\r\n"));
+  read_response(socket);
+  socket.write(elle::ConstWeakBuffer(
+    "POST /echo?n=3 HTTP/1.1\r\n"
+    "Connection: close\r\n"
+    "Content-Length: 3\r\n"
+    "\r\n"
+    "baz"));
+  BOOST_CHECK_EQUAL(read_response(socket), "3:baz");
+  BOOST_CHECK_THROW(socket.read(1), elle::reactor::network::ConnectionClosed);
+  BOOST_CHECK_EQUAL(server.requests(), 5);
+  BOOST_CHECK_EQUAL(server.handlers(), 1);
+}
+
+ELLE_TEST_SCHEDULED(server_max_connections)
+{
+  HTTPServer server;
+  server.max_connections(1);
+  server.register_route(
+    "/hello", elle::reactor::http::Method::GET,
+    [&] (HTTPServer::Headers const&,
+         HTTPServer::Cookies const&,
+         HTTPServer::Parameters const&,
+         elle::Buffer const&) -> std::string
+    {
+      return "hello";
+    });
+  auto const request = elle::ConstWeakBuffer("GET /hello HTTP/1.1\r\n\r\n");
+  elle::reactor::network::TCPSocket first("127.0.0.1", server.port());
+  first.write(request);
+  BOOST_CHECK_EQUAL(read_response(first), "hello");
+  elle::reactor::network::TCPSocket second("127.0.0.1", server.port());
+  second.write(request);
+  // The second connection waits in the backlog until the first one closes.
+  BOOST_CHECK_THROW(second.read_some(1, 100_ms),
+                    elle::reactor::network::TimeOut);
+  first.close();
+  BOOST_CHECK_EQUAL(read_response(second), "hello");
+  // The handler of the first connection serves the second one.
+  BOOST_CHECK_EQUAL(server.handlers(), 1);
+}
+
+ELLE_TEST_SCHEDULED(server_max_body_size)
+{
+  HTTPServer server;
+  server.max_body_size(8);
+  server.register_route(
+    "/echo", elle::reactor::http::Method::POST,
+    [&] (HTTPServer::Headers const&,
+         HTTPServer::Cookies const&,
+         HTTPServer::Parameters const&,
+         elle::Buffer const& body) -> std::string
+    {
+      return body.string();
+    });
+  server.register_route(
+    "/throw", elle::reactor::http::Method::GET,
+    [&] (HTTPServer::Headers const&,
+         HTTPServer::Cookies const&,
+         HTTPServer::Parameters const&,
+         elle::Buffer const&) -> std::string
+    {
+      throw std::runtime_error("not an elle error");
+    });
+  auto const status = [&] (std::string const& request)
+    {
+      elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+      socket.write(elle::ConstWeakBuffer(request));
+      auto const head = socket.read_until("\r\n\r\n").string();
+      return head.substr(0, head.find("\r\n"));
+    };
+  BOOST_CHECK_EQUAL(
+    status("POST /echo HTTP/1.1\r\n"
+           "Content-Length: 9\r\n"
+           "\r\n"),
+    "HTTP/1.1 413 Request Entity Too Large");
+  BOOST_CHECK_EQUAL(
+    status("POST /echo HTTP/1.1\r\n"
+           "Content-Length: lots\r\n"
+           "\r\n"),
+    "HTTP/1.1 400 Bad Request");
+  // Would overflow the body size if added naively.
+  BOOST_CHECK_EQUAL(
+    status("POST /echo HTTP/1.1\r\n"
+           "Transfer-Encoding: chunked\r\n"
+           "\r\n"
+           "2\r\nab\r\n"
+           "ffffffffffffffff\r\n"),
+    "HTTP/1.1 413 Request Entity Too Large");
+  BOOST_CHECK_EQUAL(
+    status("POST /echo HTTP/1.1\r\n"
+           "Transfer-Encoding: chunked\r\n"
+           "\r\n"
+           "5\r\nabcde\r\n"
+           "5\r\nfghij\r\n"),
+    "HTTP/1.1 413 Request Entity Too Large");
+  // An unexpected error only drops its connection.
+  {
+    elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+    socket.write(elle::ConstWeakBuffer("GET /throw HTTP/1.1\r\n\r\n"));
+    BOOST_CHECK_THROW(socket.read(1),
+                      elle::reactor::network::ConnectionClosed);
+  }
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  socket.write(elle::ConstWeakBuffer(
+    "POST /echo HTTP/1.1\r\n"
+    "Content-Length: 8\r\n"
+    "\r\n"
+    "12345678"));
+  BOOST_CHECK_EQUAL(read_response(socket), "12345678");
+}
+
+ELLE_TEST_SCHEDULED(server_stream)
+{
+  HTTPServer server;
+  server.register_stream_route(
+    "/stream", elle::reactor::http::Method::GET,
+    [&] (HTTPServer::Headers const&,
+         HTTPServer::Cookies const&,
+         HTTPServer::Parameters const&,
+         elle::Buffer const&) -> HTTPServer::Chunks
+    {
+      return HTTPServer::Chunks(
+        [] (elle::reactor::yielder<elle::Buffer> const& yield)
+        {
+          yield(elle::Buffer("stream"));
+          yield(elle::Buffer());
+          yield(elle::Buffer(std::string(100000, 'a')));
+          yield(elle::Buffer("ed"));
+        });
+    });
+  elle::reactor::http::Request r(server.url("stream"));
+  r.finalize();
+  BOOST_CHECK_EQUAL(r.status(), elle::reactor::http::StatusCode::OK);
+  BOOST_CHECK_EQUAL(r.response().string(),
+                    "stream" + std::string(100000, 'a') + "ed");
+  BOOST_CHECK_EQUAL(r.headers().at("Transfer-Encoding"), "chunked");
+}
+
+// Requests per second of keep-alive clients each running small GETs in
+// sequence.
+ELLE_TEST_SCHEDULED(server_benchmark)
+{
+  auto clients = RUNNING_ON_VALGRIND ? 10 : 1000;
+  auto const requests = RUNNING_ON_VALGRIND ? 10 : 50;
+  // Both ends of each connection live in this process. Restore the limit
+  // once the server and its clients are gone.
+  struct rlimit previous;
+  auto const limited = getrlimit(RLIMIT_NOFILE, &previous) == 0;
+  elle::SafeFinally restore([&] {
+      if (limited)
+        setrlimit(RLIMIT_NOFILE, &previous);
+  });
+  if (limited)
+  {
+    auto limit = previous;
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    getrlimit(RLIMIT_NOFILE, &limit);
+    clients = std::min<int>(clients, (limit.rlim_cur - 64) / 2);
+  }
+  HTTPServer server;
+  server.register_route(
+    "/metrics", elle::reactor::http::Method::GET,
+    [&] (HTTPServer::Headers const&,
+         HTTPServer::Cookies const&,
+         HTTPServer::Parameters const&,
+         elle::Buffer const&) -> std::string
+    {
+      return "requests 42\n";
+    });
+  auto const start = boost::posix_time::microsec_clock::universal_time();
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+  {
+    for (int c = 0; c < clients; ++c)
+      scope.run_background(
+        elle::sprintf("client %s", c),
+        [&]
+        {
+          elle::reactor::network::TCPSocket socket(
+            "127.0.0.1", server.port());
+          for (int i = 0; i < requests; ++i)
+          {
+            socket.write(elle::ConstWeakBuffer(
+              "GET /metrics HTTP/1.1\r\n"
+              "Host: 127.0.0.1\r\n"
+              "\r\n"));
+            BOOST_CHECK_EQUAL(read_response(socket), "requests 42\n");
+          }
+        });
+    elle::reactor::wait(scope);
+  };
+  auto const elapsed =
+    boost::posix_time::microsec_clock::universal_time() - start;
+  ELLE_LOG("%s clients, %s requests in %s (%s/s) with %s handlers",
+           clients, server.requests(), elapsed,
+           server.requests() * 1000000 / elapsed.total_microseconds(),
+           server.handlers());
+  BOOST_CHECK_EQUAL(server.requests(), clients * requests);
+  BOOST_CHECK_LE(server.handlers(), clients);
+}
+
 ELLE_TEST_SUITE()
 {
   auto& suite = boost::unit_test::framework::master_test_suite();
@@ -815,4 +1156,10 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(query_string), 0, valgrind(1));
   suite.add(BOOST_TEST_CASE(keep_alive), 0, valgrind(1));
   suite.add(BOOST_TEST_CASE(redirection), 0, valgrind(1));
+  suite.add(BOOST_TEST_CASE(client_benchmark), 0, valgrind(10));
+  suite.add(BOOST_TEST_CASE(server_pipelining), 0, valgrind(1));
+  suite.add(BOOST_TEST_CASE(server_max_connections), 0, valgrind(1));
+  suite.add(BOOST_TEST_CASE(server_max_body_size), 0, valgrind(1));
+  suite.add(BOOST_TEST_CASE(server_stream), 0, valgrind(1));
+  suite.add(BOOST_TEST_CASE(server_benchmark), 0, valgrind(30));
 }
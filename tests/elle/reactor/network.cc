@@ -1,4 +1,5 @@
 #include <memory>
+#include <numeric>
 #include <utility>
 
 #include <boost/bind.hpp>
@@ -12,6 +13,7 @@
 
 #include <elle/reactor/asio.hh>
 #include <elle/reactor/Scope.hh>
+#include <elle/reactor/for-each.hh>
 #include <elle/reactor/network/Error.hh>
 #include <elle/reactor/network/resolve.hh>
 #include <elle/reactor/network/TCPServer.hh>
@@ -24,6 +26,7 @@
 #endif
 #include <elle/reactor/signal.hh>
 #include <elle/reactor/Thread.hh>
+#include <elle/reactor/TimeoutGuard.hh>
 
 #include "reactor.hh"
 
@@ -799,6 +802,168 @@ ELLE_TEST_SCHEDULED(async_write)
   elle::reactor::wait(read);
 }
 
+ELLE_TEST_SCHEDULED(coalesced_writes)
+{
+  elle::reactor::network::TCPServer server;
+  server.listen();
+  auto const writers = 16;
+  auto const chunk = 4096;
+  elle::reactor::Barrier read;
+  elle::reactor::Thread accept(
+    "accept",
+    [&]
+    {
+      auto socket = server.accept();
+      auto buffer = socket->read(writers * chunk);
+      // Every write must be contiguous, whatever the order.
+      for (int i = 0; i < writers; ++i)
+        BOOST_TEST(std::string(chunk, buffer[i * chunk]) ==
+                   std::string(reinterpret_cast<char const*>(
+                                 buffer.contents()) + i * chunk, chunk));
+      read.open();
+    });
+  elle::reactor::network::TCPSocket socket(
+    "localhost", server.local_endpoint().port());
+  socket.write_coalesce_limit(4 * chunk);
+  auto ids = std::vector<int>(writers);
+  std::iota(ids.begin(), ids.end(), 0);
+  elle::reactor::for_each_parallel(
+    ids,
+    [&] (int i)
+    {
+      if (i % 2)
+        socket.write(elle::ConstWeakBuffer(std::string(chunk, 'a' + i)));
+      else
+        socket.write(elle::Buffer(std::string(chunk, 'a' + i)));
+    });
+  BOOST_TEST(socket.write_queue_depth() == 0u);
+  BOOST_TEST(socket.write_bytes_in_flight() == 0u);
+  // Writers queued behind the first one are sent by at most 4 per batch.
+  BOOST_TEST(socket.write_batches() <= 1u + (writers - 1 + 3) / 4);
+  elle::reactor::wait(read);
+}
+
+ELLE_TEST_SCHEDULED(coalesced_writes_interruption)
+{
+  elle::reactor::network::TCPServer server;
+  server.listen();
+  // The peer never reads, so large writes block.
+  auto peer = decltype(server.accept()){};
+  elle::reactor::Barrier accepted;
+  elle::reactor::Thread accept(
+    "accept",
+    [&]
+    {
+      peer = server.accept();
+      accepted.open();
+    });
+  elle::reactor::network::TCPSocket socket(
+    "localhost", server.local_endpoint().port());
+  elle::reactor::wait(accepted);
+  auto const big = elle::Buffer(std::string(16 << 20, 'x'));
+  socket.write_coalesce_limit(4 * big.size());
+  auto wait_in_flight = [&] (std::size_t size)
+    {
+      while (socket.write_bytes_in_flight() != size)
+        elle::reactor::yield();
+    };
+  elle::reactor::Thread first(
+    "first", [&] { socket.write(elle::ConstWeakBuffer(big)); });
+  wait_in_flight(big.size());
+  elle::reactor::Thread holder(
+    "holder", [&] { socket.write(elle::ConstWeakBuffer(big)); });
+  auto other_failed = false;
+  elle::reactor::Thread other(
+    "other",
+    [&]
+    {
+      try
+      {
+        socket.write(elle::ConstWeakBuffer(big));
+      }
+      catch (elle::reactor::network::Error const&)
+      {
+        other_failed = true;
+      }
+    });
+  while (socket.write_queue_depth() != 2)
+    elle::reactor::yield();
+  first.terminate_now();
+  // The holder now writes its data and the other thread's.
+  wait_in_flight(2 * big.size());
+  holder.terminate_now();
+  elle::reactor::wait(other);
+  BOOST_TEST(other_failed);
+  BOOST_TEST(socket.write_queue_depth() == 0u);
+  BOOST_TEST(socket.write_bytes_in_flight() == 0u);
+}
+
+// A timeout of the batch holder is not broadcast to the other writers.
+ELLE_TEST_SCHEDULED(coalesced_writes_timeout)
+{
+  elle::reactor::network::TCPServer server;
+  server.listen();
+  auto peer = decltype(server.accept()){};
+  elle::reactor::Barrier accepted;
+  elle::reactor::Thread accept(
+    "accept",
+    [&]
+    {
+      peer = server.accept();
+      accepted.open();
+    });
+  elle::reactor::network::TCPSocket socket(
+    "localhost", server.local_endpoint().port());
+  elle::reactor::wait(accepted);
+  auto const big = elle::Buffer(std::string(16 << 20, 'x'));
+  socket.write_coalesce_limit(4 * big.size());
+  elle::reactor::Barrier release;
+  elle::reactor::Thread first(
+    "first", [&] { socket.write(elle::ConstWeakBuffer(big)); });
+  while (socket.write_bytes_in_flight() != big.size())
+    elle::reactor::yield();
+  auto holder_timed_out = false;
+  elle::reactor::Thread holder(
+    "holder",
+    [&]
+    {
+      try
+      {
+        elle::reactor::wait(release);
+        elle::reactor::TimeoutGuard guard(100_ms);
+        socket.write(elle::ConstWeakBuffer(big));
+      }
+      catch (elle::reactor::Timeout const&)
+      {
+        holder_timed_out = true;
+      }
+    });
+  auto other_failed = false;
+  elle::reactor::Thread other(
+    "other",
+    [&]
+    {
+      elle::reactor::wait(release);
+      elle::reactor::yield();
+      try
+      {
+        socket.write(elle::ConstWeakBuffer(big));
+      }
+      catch (elle::reactor::network::Error const&)
+      {
+        other_failed = true;
+      }
+    });
+  release.open();
+  while (socket.write_queue_depth() != 2)
+    elle::reactor::yield();
+  first.terminate_now();
+  elle::reactor::wait({holder, other});
+  BOOST_TEST(holder_timed_out);
+  BOOST_TEST(other_failed);
+  BOOST_TEST(socket.write_queue_depth() == 0u);
+}
+
 /*-----------.
 | Test suite |
 `-----------*/
@@ -838,4 +1003,7 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(read_terminate_recover_iostream), 0, 1);
   suite.add(BOOST_TEST_CASE(read_terminate_deadlock), 0, 1);
   suite.add(BOOST_TEST_CASE(async_write), 0, 10);
+  suite.add(BOOST_TEST_CASE(coalesced_writes), 0, 10);
+  suite.add(BOOST_TEST_CASE(coalesced_writes_interruption), 0, 10);
+  suite.add(BOOST_TEST_CASE(coalesced_writes_timeout), 0, 10);
 }
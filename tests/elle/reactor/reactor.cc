@@ -1,6 +1,8 @@
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <set>
 
 #include "reactor.hh"
 
@@ -12,6 +14,7 @@
 #include <elle/reactor/Channel.hh>
 #include <elle/reactor/MultiLockBarrier.hh>
 #include <elle/reactor/OrWaitable.hh>
+#include <elle/reactor/SchedulerPool.hh>
 #include <elle/reactor/Scope.hh>
 #include <elle/reactor/TimeoutGuard.hh>
 #include <elle/reactor/asio.hh>
@@ -1463,6 +1466,220 @@ test_multithread_deadlock_assert()
   sched.run();
 }
 
+/*------.
+| Pools |
+`------*/
+
+namespace pool
+{
+  static
+  void
+  crunch(int rounds)
+  {
+    // Keep the CPU busy without yielding.
+    auto volatile x = 0u;
+    for (int i = 0; i < rounds; ++i)
+      x = x * 33 + i;
+  }
+
+  // Pending threads of a busy scheduler are stolen by the idle ones.
+  static
+  void
+  steal()
+  {
+    elle::reactor::SchedulerPool pool(4);
+    std::mutex mutex;
+    auto schedulers = std::set<elle::reactor::Scheduler*>{};
+    std::atomic<int> count(0);
+    elle::reactor::Thread spawner(
+      pool.scheduler(0), "spawner",
+      [&]
+      {
+        for (int i = 0; i < 64; ++i)
+          new elle::reactor::Thread(
+            "job",
+            [&]
+            {
+              crunch(100000);
+              std::unique_lock<std::mutex> lock(mutex);
+              schedulers.insert(elle::reactor::Scheduler::scheduler());
+              ++count;
+            },
+            elle::reactor::dispose = true);
+        // Hog our scheduler until the others took their share.
+        auto const deadline =
+          std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (count < 32 && std::chrono::steady_clock::now() < deadline)
+          crunch(1000);
+      });
+    pool.run();
+    BOOST_TEST(count == 64);
+    BOOST_TEST(schedulers.size() > 1u);
+  }
+
+  // Non migratable and non disposed threads stay on their scheduler.
+  static
+  void
+  pinned()
+  {
+    elle::reactor::SchedulerPool pool(4);
+    auto& home = pool.scheduler(0);
+    std::atomic<int> elsewhere(0);
+    std::atomic<int> count(0);
+    elle::reactor::Thread spawner(
+      home, "spawner",
+      [&]
+      {
+        auto job = [&]
+          {
+            crunch(100000);
+            if (elle::reactor::Scheduler::scheduler() != &home)
+              ++elsewhere;
+            ++count;
+          };
+        auto owned = std::vector<elle::reactor::Thread::unique_ptr>{};
+        for (int i = 0; i < 16; ++i)
+        {
+          new elle::reactor::Thread("pinned", job,
+                                    elle::reactor::dispose = true,
+                                    elle::reactor::migratable = false);
+          owned.emplace_back(new elle::reactor::Thread("owned", job));
+        }
+        crunch(10000000);
+        for (auto const& t: owned)
+          elle::reactor::wait(*t);
+      });
+    pool.run();
+    BOOST_TEST(count == 32);
+    BOOST_TEST(elsewhere == 0);
+  }
+
+  // Barrier, Mutex and Signal wake threads of other schedulers.
+  static
+  void
+  wake()
+  {
+    elle::reactor::SchedulerPool pool(2);
+    elle::reactor::Barrier opened;
+    elle::reactor::Signal signal;
+    elle::reactor::Mutex mutex;
+    // Boost.Test is not thread safe: only check from the main thread.
+    auto inside = false;
+    auto overlap = false;
+    auto count = 0;
+    auto locker = [&]
+      {
+        for (int i = 0; i < 16; ++i)
+        {
+          elle::reactor::Lock lock(mutex);
+          overlap = overlap || inside;
+          inside = true;
+          elle::reactor::yield();
+          ++count;
+          inside = false;
+        }
+      };
+    elle::reactor::Thread waiter(
+      pool.scheduler(0), "waiter",
+      [&]
+      {
+        elle::reactor::wait(opened);
+        locker();
+        elle::reactor::wait(signal);
+      });
+    elle::reactor::Thread opener(
+      pool.scheduler(1), "opener",
+      [&]
+      {
+        elle::reactor::sleep(10_ms);
+        opened.open();
+        locker();
+        while (!signal.signal())
+          elle::reactor::sleep(1_ms);
+      });
+    pool.run();
+    BOOST_TEST(count == 32);
+    BOOST_TEST(!overlap);
+  }
+
+  // Not a pass/fail check: log how throughput scales with the pool size.
+  static
+  void
+  throughput()
+  {
+    auto const jobs = RUNNING_ON_VALGRIND ? 256 : 4096;
+    for (auto size: {1, 2, 4, 8, 16})
+    {
+      elle::reactor::SchedulerPool pool(size);
+      std::atomic<int> count(0);
+      elle::reactor::Thread spawner(
+        pool.scheduler(0), "spawner",
+        [&]
+        {
+          for (int i = 0; i < jobs; ++i)
+            new elle::reactor::Thread(
+              "job",
+              [&]
+              {
+                for (int j = 0; j < 4; ++j)
+                {
+                  crunch(10000);
+                  elle::reactor::yield();
+                }
+                ++count;
+              },
+              elle::reactor::dispose = true);
+        });
+      auto const start = std::chrono::steady_clock::now();
+      pool.run();
+      auto const duration = std::chrono::duration_cast<
+        std::chrono::duration<double>>(std::chrono::steady_clock::now() - start);
+      BOOST_TEST(count == jobs);
+      BOOST_TEST_MESSAGE(elle::sprintf(
+        "%s schedulers: %.0f jobs/s", size, jobs / duration.count()));
+    }
+  }
+}
+
+/*-----------------.
+| Context switches |
+`-----------------*/
+
+// Not a pass/fail check: log how many context switches per second a single
+// scheduler achieves with many ready coroutines.
+static
+void
+test_context_switches()
+{
+  auto const yields = RUNNING_ON_VALGRIND ? 2 : 64;
+  for (auto threads: {10000, 100000})
+  {
+    if (RUNNING_ON_VALGRIND)
+      threads /= 100;
+    elle::reactor::Scheduler sched;
+    auto count = 0l;
+    auto jobs = std::vector<std::unique_ptr<elle::reactor::Thread>>{};
+    for (int i = 0; i < threads; ++i)
+      jobs.emplace_back(std::make_unique<elle::reactor::Thread>(
+        sched, "yielder",
+        [&]
+        {
+          for (int j = 0; j < yields; ++j)
+          {
+            ++count;
+            elle::reactor::yield();
+          }
+        }));
+    auto const start = std::chrono::steady_clock::now();
+    sched.run();
+    auto const duration = std::chrono::duration_cast<
+      std::chrono::duration<double>>(std::chrono::steady_clock::now() - start);
+    BOOST_TEST(count == long(threads) * yields);
+    BOOST_TEST_MESSAGE(elle::sprintf(
+      "%s coroutines: %.0f switches/s", threads, count / duration.count()));
+  }
+}
+
 /*----------.
 | Semaphore |
 `----------*/
@@ -2664,6 +2881,33 @@ namespace background
     }
   }
 
+  ELLE_TEST_SCHEDULED(parallel)
+  {
+    auto const count = 1000;
+    std::vector<int> results(count, 0);
+    elle::reactor::background_parallel(
+      count, [&] (std::size_t i) { results[i] = i * 2; });
+    for (int i = 0; i < count; ++i)
+      BOOST_CHECK_EQUAL(results[i], i * 2);
+    std::atomic<int> ran(0);
+    BOOST_CHECK_THROW(
+      elle::reactor::background_parallel(
+        count,
+        [&] (std::size_t i)
+        {
+          ++ran;
+          if (i == 0)
+            throw BeaconException();
+          ::usleep(1000);
+        }),
+      std::exception);
+    auto const after = ran.load();
+    BOOST_CHECK_LT(after, count);
+    ::usleep(10000);
+    BOOST_CHECK_EQUAL(ran, after);
+    elle::reactor::background_parallel(0, [] (std::size_t) { BOOST_FAIL("ran"); });
+  }
+
   ELLE_TEST_SCHEDULED(future)
   {
     ELLE_LOG("test plain value")
@@ -3537,8 +3781,22 @@ ELLE_TEST_SUITE()
   mt->add(BOOST_TEST_CASE(test_multithread_run), 0, valgrind(1, 5));
   mt->add(BOOST_TEST_CASE(test_multithread_run_exception), 0, valgrind(1, 5));
   mt->add(BOOST_TEST_CASE(test_multithread_deadlock_assert), 0, valgrind(1, 5));
+
+  {
+    boost::unit_test::test_suite* pool = BOOST_TEST_SUITE("pool");
+    boost::unit_test::framework::master_test_suite().add(pool);
+    pool->add(BOOST_TEST_CASE(pool::steal), 0, valgrind(3, 5));
+    pool->add(BOOST_TEST_CASE(pool::pinned), 0, valgrind(3, 5));
+    pool->add(BOOST_TEST_CASE(pool::wake), 0, valgrind(1, 5));
+    pool->add(BOOST_TEST_CASE(pool::throughput), 0, valgrind(10, 5));
+  }
 #endif
 
+  boost::unit_test::test_suite* switches =
+    BOOST_TEST_SUITE("context_switches");
+  boost::unit_test::framework::master_test_suite().add(switches);
+  switches->add(BOOST_TEST_CASE(test_context_switches), 0, valgrind(30, 5));
+
   boost::unit_test::test_suite* sem = BOOST_TEST_SUITE("Semaphore");
   boost::unit_test::framework::master_test_suite().add(sem);
   sem->add(BOOST_TEST_CASE(test_semaphore_noblock), 0, valgrind(1, 5));
@@ -3586,6 +3844,7 @@ ELLE_TEST_SUITE()
     background->add(BOOST_TEST_CASE(future), 0, valgrind(2, 5));
     background->add(BOOST_TEST_CASE(operation), 0, valgrind(3, 10));
     background->add(BOOST_TEST_CASE(operations), 0, valgrind(3, 10));
+    background->add(BOOST_TEST_CASE(parallel), 0, valgrind(1, 5));
     background->add(BOOST_TEST_CASE(thread_exception_yield), 0, valgrind(1, 5));
   }
 
@@ -1,4 +1,7 @@
+#include <chrono>
 #include <deque>
+#include <functional>
+#include <limits>
 #include <list>
 #include <sstream>
 #include <string>
@@ -7,7 +10,9 @@
 #include <vector>
 
 #include <elle/attribute.hh>
+#include <elle/IOStream.hh>
 #include <elle/filesystem/path.hh>
+#include <elle/printf.hh>
 #include <elle/serialization/binary.hh>
 #include <elle/serialization/json.hh>
 #include <elle/serialization/json/Error.hh>
@@ -1742,6 +1747,255 @@ convert()
   }
 }
 
+static
+void
+binary_memory()
+{
+  using Data = std::vector<std::pair<int64_t, std::string>>;
+  auto data = Data{{0, ""}, {-42, "foo"}, {1 << 20, "bar"},
+                   {std::numeric_limits<int64_t>::min() + 1, "baz"}};
+  auto pi = 3.14;
+  std::stringstream stream;
+  {
+    elle::serialization::binary::SerializerOut output(stream);
+    output.serialize("data", data);
+    output.serialize("pi", pi);
+  }
+  auto buffer = elle::Buffer{};
+  {
+    elle::serialization::binary::SerializerOut output(buffer);
+    output.serialize("data", data);
+    output.serialize("pi", pi);
+  }
+  BOOST_CHECK_EQUAL(buffer, elle::Buffer(stream.str()));
+  elle::serialization::binary::SerializerIn input{
+    elle::ConstWeakBuffer(buffer)};
+  BOOST_CHECK(input.in_memory());
+  BOOST_CHECK(input.deserialize<Data>("data") == data);
+  BOOST_CHECK_EQUAL(input.deserialize<double>("pi"), pi);
+  auto truncated = [&] (int size)
+    {
+      elle::serialization::binary::SerializerIn input{
+        elle::ConstWeakBuffer(buffer.contents(), size)};
+      input.deserialize<Data>("data");
+      input.deserialize<double>("pi");
+    };
+  for (auto size: {0, 1, 5, int(buffer.size()) - 1})
+    BOOST_CHECK_THROW(truncated(size), elle::serialization::Error);
+}
+
+static
+void
+binary_view()
+{
+  auto const buffer = elle::serialization::binary::serialize(
+    std::string("Ricard"), false);
+  elle::serialization::binary::SerializerIn input{
+    elle::ConstWeakBuffer(buffer), false};
+  auto const view = input.deserialize_view();
+  BOOST_CHECK_EQUAL(view, elle::ConstWeakBuffer("Ricard"));
+  BOOST_CHECK(view.contents() >= buffer.contents());
+  BOOST_CHECK(view.contents() + view.size() <=
+              buffer.contents() + buffer.size());
+  std::stringstream stream(buffer.string());
+  elle::serialization::binary::SerializerIn streamed(stream, false);
+  BOOST_CHECK_THROW(streamed.deserialize_view(),
+                    elle::serialization::Error);
+}
+
+static
+void
+binary_memory_throughput()
+{
+  using Data = std::vector<std::pair<int64_t, double>>;
+  auto data = Data{};
+  for (int i = 0; i < 100000; ++i)
+    data.emplace_back(i * 37, i / 3.);
+  auto measure = [&] (std::string const& name, std::function<void ()> f)
+    {
+      auto const start = std::chrono::steady_clock::now();
+      f();
+      auto const duration = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start);
+      BOOST_TEST_MESSAGE(
+        elle::sprintf("%s: %.1f ms", name, duration.count() * 1000));
+    };
+  auto buffer = elle::Buffer{};
+  measure("serialize to stream", [&] {
+      elle::IOStream stream(buffer.ostreambuf());
+      elle::serialization::binary::SerializerOut output(stream, false);
+      output.serialize("data", data);
+    });
+  measure("serialize to memory", [&] {
+      buffer.size(0);
+      elle::serialization::binary::SerializerOut output(buffer, false);
+      output.serialize("data", data);
+    });
+  measure("deserialize from stream", [&] {
+      elle::IOStream stream(buffer.istreambuf());
+      elle::serialization::binary::SerializerIn input(stream, false);
+      BOOST_CHECK_EQUAL(input.deserialize<Data>("data").size(), data.size());
+    });
+  measure("deserialize from memory", [&] {
+      elle::serialization::binary::SerializerIn input(
+        elle::ConstWeakBuffer(buffer), false);
+      BOOST_CHECK_EQUAL(input.deserialize<Data>("data").size(), data.size());
+    });
+}
+
+template <bool Versioned>
+static
+std::vector<std::unique_ptr<Super<Versioned>>>
+_hierarchy_objects(int count)
+{
+  auto res = std::vector<std::unique_ptr<Super<Versioned>>>{};
+  for (int i = 0; i < count; ++i)
+    if (i % 3 == 0)
+      res.emplace_back(new Super<Versioned>(i));
+    else if (i % 3 == 1)
+      res.emplace_back(new Sub1<Versioned>(i));
+    else
+      res.emplace_back(new Sub2<Versioned>(i));
+  return res;
+}
+
+template <bool Versioned>
+static
+void
+_check_hierarchy_objects(
+  std::vector<std::unique_ptr<Super<Versioned>>> const& expected,
+  std::vector<std::unique_ptr<Super<Versioned>>> const& actual)
+{
+  BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+  for (unsigned i = 0; i < actual.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(elle::type_info(*actual[i]),
+                      elle::type_info(*expected[i]));
+    BOOST_CHECK_EQUAL(actual[i]->type(), expected[i]->type());
+  }
+}
+
+static
+void
+binary_dictionary()
+{
+  using Binary = elle::serialization::binary::SerializerOut;
+  using Objects = std::vector<std::unique_ptr<Super<true>>>;
+  auto objects = _hierarchy_objects<true>(300);
+  auto legacy = elle::Buffer{};
+  {
+    Binary output(legacy, true);
+    BOOST_CHECK(!output.dictionary());
+    output.serialize("objects", objects);
+  }
+  auto dictionary = elle::Buffer{};
+  {
+    Binary output(dictionary, true, true);
+    BOOST_CHECK(output.dictionary());
+    output.serialize("objects", objects);
+  }
+  BOOST_TEST_MESSAGE(elle::sprintf("legacy: %s bytes, dictionary: %s bytes",
+                                   legacy.size(), dictionary.size()));
+  BOOST_CHECK_LT(dictionary.size(), legacy.size());
+  ELLE_LOG("read legacy stream")
+  {
+    elle::serialization::binary::SerializerIn input(
+      elle::ConstWeakBuffer(legacy), true);
+    BOOST_CHECK(!input.dictionary());
+    _check_hierarchy_objects(objects, input.deserialize<Objects>("objects"));
+  }
+  ELLE_LOG("read dictionary from memory")
+  {
+    elle::serialization::binary::SerializerIn input(
+      elle::ConstWeakBuffer(dictionary), true);
+    BOOST_CHECK(input.dictionary());
+    _check_hierarchy_objects(objects, input.deserialize<Objects>("objects"));
+  }
+  ELLE_LOG("read dictionary from stream")
+  {
+    std::stringstream stream(dictionary.string());
+    elle::serialization::binary::SerializerIn input(stream, true);
+    _check_hierarchy_objects(objects, input.deserialize<Objects>("objects"));
+  }
+  ELLE_LOG("unversioned hierarchy")
+  {
+    auto unversioned = _hierarchy_objects<false>(30);
+    auto buffer = elle::Buffer{};
+    {
+      Binary output(buffer, false, true);
+      output.serialize("objects", unversioned);
+    }
+    elle::serialization::binary::SerializerIn input(
+      elle::ConstWeakBuffer(buffer), false);
+    _check_hierarchy_objects(
+      unversioned,
+      input.deserialize<std::vector<std::unique_ptr<Super<false>>>>(
+        "objects"));
+  }
+  ELLE_LOG("corrupt type index")
+  {
+    auto buffer = elle::Buffer{};
+    auto offset = elle::Buffer::Size{0};
+    {
+      Binary output(buffer, false, true);
+      auto ptr = std::unique_ptr<Super<false>>(new Sub1<false>(1));
+      output.serialize("first", ptr);
+      offset = buffer.size();
+      output.serialize("second", ptr);
+    }
+    // The second pointer is its filled flag followed by the index of its
+    // type, already defined by the first one.
+    BOOST_REQUIRE_EQUAL(buffer[offset], 1);
+    BOOST_REQUIRE_EQUAL(buffer[offset + 1], 0);
+    buffer[offset + 1] = 7;
+    elle::serialization::binary::SerializerIn input(
+      elle::ConstWeakBuffer(buffer), false);
+    input.deserialize<std::unique_ptr<Super<false>>>("first");
+    BOOST_CHECK_THROW(
+      input.deserialize<std::unique_ptr<Super<false>>>("second"),
+      elle::serialization::Error);
+    buffer[0] = 2;
+    BOOST_CHECK_THROW(
+      elle::serialization::binary::SerializerIn(
+        elle::ConstWeakBuffer(buffer), false),
+      elle::serialization::Error);
+  }
+}
+
+static
+void
+binary_dictionary_throughput()
+{
+  using Objects = std::vector<std::unique_ptr<Super<true>>>;
+  auto objects = _hierarchy_objects<true>(100000);
+  auto measure = [&] (std::string const& name, std::function<void ()> f)
+    {
+      auto const start = std::chrono::steady_clock::now();
+      f();
+      auto const duration = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start);
+      BOOST_TEST_MESSAGE(
+        elle::sprintf("%s: %.1f ms", name, duration.count() * 1000));
+    };
+  for (auto dictionary: {false, true})
+  {
+    auto const mode = dictionary ? "dictionary" : "legacy";
+    auto buffer = elle::Buffer{};
+    measure(elle::sprintf("%s: serialize", mode), [&] {
+        elle::serialization::binary::SerializerOut output(
+          buffer, true, dictionary);
+        output.serialize("objects", objects);
+      });
+    BOOST_TEST_MESSAGE(elle::sprintf("%s: %s bytes", mode, buffer.size()));
+    measure(elle::sprintf("%s: deserialize", mode), [&] {
+        elle::serialization::binary::SerializerIn input(
+          elle::ConstWeakBuffer(buffer), true);
+        BOOST_CHECK_EQUAL(input.deserialize<Objects>("objects").size(),
+                          objects.size());
+      });
+  }
+}
+
 #define FOR_ALL_SERIALIZATION_TYPES(Name)                               \
   {                                                                     \
     boost::unit_test::test_suite* subsuite = BOOST_TEST_SUITE(#Name);   \
@@ -1815,4 +2069,9 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(json_iso8601));
   suite.add(BOOST_TEST_CASE(json_unicode_surrogate));
   suite.add(BOOST_TEST_CASE(json_optionals));
+  suite.add(BOOST_TEST_CASE(binary_memory));
+  suite.add(BOOST_TEST_CASE(binary_view));
+  suite.add(BOOST_TEST_CASE(binary_memory_throughput));
+  suite.add(BOOST_TEST_CASE(binary_dictionary));
+  suite.add(BOOST_TEST_CASE(binary_dictionary_throughput));
 }